@@ -0,0 +1,349 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+
+#include "audio_core/algorithm/dsp_kernels.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#ifdef _MSC_VER
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace AudioCore::DSP {
+
+namespace {
+
+constexpr float S16_MIN_FLOAT{-32768.0f};
+constexpr float S16_MAX_FLOAT{32767.0f};
+
+s16 SaturateToS16(float value) {
+    return static_cast<s16>(std::clamp(value, S16_MIN_FLOAT, S16_MAX_FLOAT));
+}
+
+#ifdef ARCHITECTURE_x86_64
+bool HasAVX2() {
+    static const bool has_avx2 = Common::GetCPUCaps().avx2;
+    return has_avx2;
+}
+
+AVX2_TARGET std::size_t MixAccumulateAVX2(float* dst, const float* src, float gain,
+                                          std::size_t count) {
+    const __m256 gains = _mm256_set1_ps(gain);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 mixed = _mm256_mul_ps(_mm256_loadu_ps(src + i), gains);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), mixed));
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t MixAccumulateRampAVX2(float* dst, const float* src, float gain,
+                                              float gain_step, std::size_t count) {
+    const __m256 steps = _mm256_set1_ps(gain_step);
+    const __m256 lanes = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 base = _mm256_set1_ps(gain);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lanes);
+        const __m256 gains = _mm256_add_ps(base, _mm256_mul_ps(steps, index));
+        const __m256 mixed = _mm256_mul_ps(_mm256_loadu_ps(src + i), gains);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), mixed));
+    }
+    return i;
+}
+
+AVX2_TARGET __m256 ReorderPairs(__m256 value) {
+    const __m256d pairs = _mm256_castps_pd(value);
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(pairs, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+AVX2_TARGET std::size_t MixStereoS16AVX2(float* left, float* right, const s16* interleaved,
+                                         float gain, float gain_step, std::size_t frame_count) {
+    const __m256 steps = _mm256_set1_ps(gain_step);
+    const __m256 lanes = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 base = _mm256_set1_ps(gain);
+    std::size_t i = 0;
+    for (; i + 8 <= frame_count; i += 8) {
+        const __m128i* const src = reinterpret_cast<const __m128i*>(interleaved + i * 2);
+        const __m256 a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(src)));
+        const __m256 b = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(src + 1)));
+        // The lane-wise shuffle yields {0, 1, 4, 5, 2, 3, 6, 7}, swap the middle pairs back.
+        const __m256 l = ReorderPairs(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m256 r = ReorderPairs(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        const __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lanes);
+        const __m256 gains = _mm256_add_ps(base, _mm256_mul_ps(steps, index));
+        _mm256_storeu_ps(left + i,
+                         _mm256_add_ps(_mm256_loadu_ps(left + i), _mm256_mul_ps(l, gains)));
+        _mm256_storeu_ps(right + i,
+                         _mm256_add_ps(_mm256_loadu_ps(right + i), _mm256_mul_ps(r, gains)));
+    }
+    return i;
+}
+
+std::size_t MixAccumulateSSE2(float* dst, const float* src, float gain, std::size_t count) {
+    const __m128 gains = _mm_set1_ps(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 mixed = _mm_mul_ps(_mm_loadu_ps(src + i), gains);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), mixed));
+    }
+    return i;
+}
+
+std::size_t MixAccumulateRampSSE2(float* dst, const float* src, float gain, float gain_step,
+                                  std::size_t count) {
+    const __m128 steps = _mm_set1_ps(gain_step);
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 base = _mm_set1_ps(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lanes);
+        const __m128 gains = _mm_add_ps(base, _mm_mul_ps(steps, index));
+        const __m128 mixed = _mm_mul_ps(_mm_loadu_ps(src + i), gains);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), mixed));
+    }
+    return i;
+}
+
+std::size_t MixStereoS16SSE2(float* left, float* right, const s16* interleaved, float gain,
+                             float gain_step, std::size_t frame_count) {
+    const __m128 steps = _mm_set1_ps(gain_step);
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 base = _mm_set1_ps(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= frame_count; i += 4) {
+        const __m128i samples =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(interleaved + i * 2));
+        // Sign extend by unpacking into the upper half of each 32-bit lane.
+        const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+        const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+        const __m128 l = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 r = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+
+        const __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lanes);
+        const __m128 gains = _mm_add_ps(base, _mm_mul_ps(steps, index));
+        _mm_storeu_ps(left + i, _mm_add_ps(_mm_loadu_ps(left + i), _mm_mul_ps(l, gains)));
+        _mm_storeu_ps(right + i, _mm_add_ps(_mm_loadu_ps(right + i), _mm_mul_ps(r, gains)));
+    }
+    return i;
+}
+
+__m128i SaturateToS32(__m128 value) {
+    const __m128 clamped =
+        _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(S16_MIN_FLOAT)), _mm_set1_ps(S16_MAX_FLOAT));
+    return _mm_cvttps_epi32(clamped);
+}
+
+std::size_t InterleaveS16SSE2(s16* out, const float* left, const float* right,
+                              std::size_t frame_count) {
+    std::size_t i = 0;
+    for (; i + 4 <= frame_count; i += 4) {
+        const __m128i l = SaturateToS32(_mm_loadu_ps(left + i));
+        const __m128i r = SaturateToS32(_mm_loadu_ps(right + i));
+        const __m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(l, r), _mm_unpackhi_epi32(l, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), packed);
+    }
+    return i;
+}
+
+std::size_t ApplyVolumeS16SSE2(s16* samples, float volume, std::size_t count) {
+    const __m128 volumes = _mm_set1_ps(volume);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto* const ptr = reinterpret_cast<__m128i*>(samples + i);
+        const __m128i value = _mm_loadu_si128(ptr);
+        const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16));
+        const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16));
+        const __m128i scaled_lo = SaturateToS32(_mm_mul_ps(lo, volumes));
+        const __m128i scaled_hi = SaturateToS32(_mm_mul_ps(hi, volumes));
+        _mm_storeu_si128(ptr, _mm_packs_epi32(scaled_lo, scaled_hi));
+    }
+    return i;
+}
+
+std::size_t UpmixMonoToStereoSSE2(s16* out, const s16* in, std::size_t frame_count) {
+    std::size_t i = 0;
+    for (; i + 8 <= frame_count; i += 8) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        auto* const dst = reinterpret_cast<__m128i*>(out + i * 2);
+        _mm_storeu_si128(dst, _mm_unpacklo_epi16(value, value));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(value, value));
+    }
+    return i;
+}
+#endif
+
+} // Anonymous namespace
+
+void Scale(float* dst, float gain, std::size_t count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    const __m128 gains = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), gains));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] *= gain;
+    }
+}
+
+void ConvertFloatToS32(s32* out, const float* in, std::size_t count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    for (; i + 4 <= count; i += 4) {
+        const __m128i samples = _mm_cvtps_epi32(_mm_loadu_ps(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), samples);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<s32>(std::lrint(in[i]));
+    }
+}
+
+void ConvertS32ToFloat(float* out, const s32* in, std::size_t count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    for (; i + 4 <= count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_ps(out + i, _mm_cvtepi32_ps(samples));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<float>(in[i]);
+    }
+}
+
+void MixAccumulate(float* dst, const float* src, float gain, std::size_t count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    i = HasAVX2() ? MixAccumulateAVX2(dst, src, gain, count)
+                  : MixAccumulateSSE2(dst, src, gain, count);
+#endif
+    for (; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+void MixAccumulateRamp(float* dst, const float* src, float gain, float gain_step,
+                       std::size_t count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    i = HasAVX2() ? MixAccumulateRampAVX2(dst, src, gain, gain_step, count)
+                  : MixAccumulateRampSSE2(dst, src, gain, gain_step, count);
+#endif
+    for (; i < count; ++i) {
+        dst[i] += src[i] * (gain + gain_step * static_cast<float>(i));
+    }
+}
+
+void MixStereoS16(float* left, float* right, const s16* interleaved, float gain, float gain_step,
+                  std::size_t frame_count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    i = HasAVX2() ? MixStereoS16AVX2(left, right, interleaved, gain, gain_step, frame_count)
+                  : MixStereoS16SSE2(left, right, interleaved, gain, gain_step, frame_count);
+#endif
+    for (; i < frame_count; ++i) {
+        const float frame_gain = gain + gain_step * static_cast<float>(i);
+        left[i] += static_cast<float>(interleaved[i * 2]) * frame_gain;
+        right[i] += static_cast<float>(interleaved[i * 2 + 1]) * frame_gain;
+    }
+}
+
+void InterleaveS16(s16* out, const float* left, const float* right, std::size_t frame_count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    i = InterleaveS16SSE2(out, left, right, frame_count);
+#endif
+    for (; i < frame_count; ++i) {
+        out[i * 2] = SaturateToS16(left[i]);
+        out[i * 2 + 1] = SaturateToS16(right[i]);
+    }
+}
+
+void ApplyVolumeS16(s16* samples, float volume, std::size_t count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    i = ApplyVolumeS16SSE2(samples, volume, count);
+#endif
+    for (; i < count; ++i) {
+        samples[i] = SaturateToS16(static_cast<float>(samples[i]) * volume);
+    }
+}
+
+void UpmixMonoToStereo(s16* out, const s16* in, std::size_t frame_count) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    i = UpmixMonoToStereoSSE2(out, in, frame_count);
+#endif
+    for (; i < frame_count; ++i) {
+        out[i * 2] = in[i];
+        out[i * 2 + 1] = in[i];
+    }
+}
+
+BiquadCoefficients BiquadCoefficientsFromQ14(const std::array<s16, 3>& numerator,
+                                             const std::array<s16, 2>& denominator) {
+    constexpr float Q14_SCALE{1.0f / (1 << 14)};
+    return {numerator[0] * Q14_SCALE, numerator[1] * Q14_SCALE, numerator[2] * Q14_SCALE,
+            denominator[0] * Q14_SCALE, denominator[1] * Q14_SCALE};
+}
+
+void BiquadFilter(float* samples, std::size_t count, const BiquadCoefficients& coeffs,
+                  BiquadState& state) {
+    float s0 = state[0];
+    float s1 = state[1];
+    for (std::size_t i = 0; i < count; ++i) {
+        const float in = samples[i];
+        const float out = coeffs.b0 * in + s0;
+        s0 = coeffs.b1 * in + coeffs.a1 * out + s1;
+        s1 = coeffs.b2 * in + coeffs.a2 * out;
+        samples[i] = out;
+    }
+    state = {s0, s1};
+}
+
+void BiquadFilterStereo(float* left, float* right, std::size_t count,
+                        const BiquadCoefficients& coeffs, BiquadState& left_state,
+                        BiquadState& right_state) {
+#ifdef ARCHITECTURE_x86_64
+    // The recurrence prevents vectorizing over time, so the channels share a register instead.
+    const __m128 b0 = _mm_set1_ps(coeffs.b0);
+    const __m128 b1 = _mm_set1_ps(coeffs.b1);
+    const __m128 b2 = _mm_set1_ps(coeffs.b2);
+    const __m128 a1 = _mm_set1_ps(coeffs.a1);
+    const __m128 a2 = _mm_set1_ps(coeffs.a2);
+    __m128 s0 = _mm_set_ps(0.0f, 0.0f, right_state[0], left_state[0]);
+    __m128 s1 = _mm_set_ps(0.0f, 0.0f, right_state[1], left_state[1]);
+    for (std::size_t i = 0; i < count; ++i) {
+        const __m128 in = _mm_unpacklo_ps(_mm_load_ss(left + i), _mm_load_ss(right + i));
+        const __m128 out = _mm_add_ps(_mm_mul_ps(b0, in), s0);
+        s0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b1, in), _mm_mul_ps(a1, out)), s1);
+        s1 = _mm_add_ps(_mm_mul_ps(b2, in), _mm_mul_ps(a2, out));
+        _mm_store_ss(left + i, out);
+        _mm_store_ss(right + i, _mm_shuffle_ps(out, out, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+    alignas(16) std::array<float, 4> s0_lanes;
+    alignas(16) std::array<float, 4> s1_lanes;
+    _mm_store_ps(s0_lanes.data(), s0);
+    _mm_store_ps(s1_lanes.data(), s1);
+    left_state = {s0_lanes[0], s1_lanes[0]};
+    right_state = {s0_lanes[1], s1_lanes[1]};
+#else
+    BiquadFilter(left, count, coeffs, left_state);
+    BiquadFilter(right, count, coeffs, right_state);
+#endif
+}
+
+} // namespace AudioCore::DSP
@@ -0,0 +1,108 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
+/**
+ * Vectorized audio DSP kernels. SSE2 is used on x86-64 hosts, where it is always available, and
+ * the float kernels switch to AVX2 at runtime when the host supports it. Other hosts use scalar
+ * implementations producing the same results.
+ */
+namespace AudioCore::DSP {
+
+/// dst[i] += src[i] * gain
+void MixAccumulate(float* dst, const float* src, float gain, std::size_t count);
+
+/// dst[i] += src[i] * (gain + gain_step * i), used to ramp between volumes without clicks
+void MixAccumulateRamp(float* dst, const float* src, float gain, float gain_step,
+                       std::size_t count);
+
+/**
+ * Deinterleaves stereo PCM16 and accumulates it into a pair of float mix buffers, ramping the
+ * gain as in MixAccumulateRamp.
+ */
+void MixStereoS16(float* left, float* right, const s16* interleaved, float gain, float gain_step,
+                  std::size_t frame_count);
+
+/// Interleaves a pair of float mix buffers into stereo PCM16, truncating and saturating
+void InterleaveS16(s16* out, const float* left, const float* right, std::size_t frame_count);
+
+/// Scales PCM16 samples in place, truncating and saturating
+void ApplyVolumeS16(s16* samples, float volume, std::size_t count);
+
+/// Duplicates mono PCM16 samples into interleaved stereo
+void UpmixMonoToStereo(s16* out, const s16* in, std::size_t frame_count);
+
+/// dst[i] *= gain
+void Scale(float* dst, float gain, std::size_t count);
+
+/// Rounds float samples to the nearest s32, as exchanged with the guest by aux effects
+void ConvertFloatToS32(s32* out, const float* in, std::size_t count);
+
+/// Converts s32 samples from the guest to float
+void ConvertS32ToFloat(float* out, const s32* in, std::size_t count);
+
+/**
+ * Biquad filter coefficients normalized to a0 = 1. As on hardware the feedback coefficients are
+ * added rather than subtracted: y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]
+ */
+struct BiquadCoefficients {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+};
+
+/// Converts the Q14 fixed point coefficients used by the guest
+BiquadCoefficients BiquadCoefficientsFromQ14(const std::array<s16, 3>& numerator,
+                                             const std::array<s16, 2>& denominator);
+
+/// State of a biquad filter between blocks, in transposed direct form II
+using BiquadState = std::array<float, 2>;
+
+/// Applies a biquad filter in place
+void BiquadFilter(float* samples, std::size_t count, const BiquadCoefficients& coeffs,
+                  BiquadState& state);
+
+/// Applies the same biquad filter in place to two channels at once, one per SIMD lane
+void BiquadFilterStereo(float* left, float* right, std::size_t count,
+                        const BiquadCoefficients& coeffs, BiquadState& left_state,
+                        BiquadState& right_state);
+
+/**
+ * Applies a 4-tap Q15 filter to both channels of stereo PCM16 history.
+ * @param history Interleaved stereo frames, newest first, at least 4 frames long
+ * @param taps    Filter taps, taps[0] is applied to the newest frame
+ * @returns The unshifted Q15 sums for the left and right channels
+ */
+inline std::array<s32, 2> Filter4TapStereo(const s16* history, const s16* taps) {
+#ifdef ARCHITECTURE_x86_64
+    // Reorder to {L0, L1, R0, R1, L2, L3, R2, R3} so PMADDWD sums pairs of taps per channel.
+    __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(history));
+    samples = _mm_shufflelo_epi16(samples, _MM_SHUFFLE(3, 1, 2, 0));
+    samples = _mm_shufflehi_epi16(samples, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i coeffs = _mm_set_epi16(taps[3], taps[2], taps[3], taps[2], taps[1], taps[0],
+                                         taps[1], taps[0]);
+    __m128i sums = _mm_madd_epi16(samples, coeffs);
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 8));
+    return {_mm_cvtsi128_si32(sums), _mm_cvtsi128_si32(_mm_srli_si128(sums, 4))};
+#else
+    return {history[0] * taps[0] + history[2] * taps[1] + history[4] * taps[2] +
+                history[6] * taps[3],
+            history[1] * taps[0] + history[3] * taps[1] + history[5] * taps[2] +
+                history[7] * taps[3]};
+#endif
+}
+
+} // namespace AudioCore::DSP
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <vector>
 
+#include "audio_core/algorithm/dsp_kernels.h"
 #include "audio_core/algorithm/interpolate.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
@@ -141,58 +142,86 @@ constexpr std::array<s16, 512> curve_lut2{
     26230, 2688,  -42,   3751,  26253, 2811,  -38,   3608,  26270, 2936,  -34,   3467,  26281,
     3064,  -32,   3329,  26287, 3195};
 
-std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16> input, double ratio) {
-    if (input.size() < 2)
-        return {};
-
-    if (ratio <= 0) {
-        LOG_CRITICAL(Audio, "Nonsensical interpolation ratio {}", ratio);
-        return input;
+static const std::array<s16, 512>& SelectCurve(s32 step) {
+    if (step > 0xaaaa) {
+        return curve_lut0;
+    }
+    if (step <= 0x8000) {
+        return curve_lut1;
     }
+    return curve_lut2;
+}
 
+InterpolationResult Interpolate(InterpolationState& state, const s16* input,
+                                std::size_t input_frames, s16* output, std::size_t output_frames,
+                                double ratio) {
     const s32 step{static_cast<s32>(ratio * 0x8000)};
-    const std::array<s16, 512>& lut = [step] {
-        if (step > 0xaaaa) {
-            return curve_lut0;
+    const std::array<s16, 512>& lut = SelectCurve(step);
+
+    std::size_t consumed{};
+    std::size_t produced{};
+    while (produced < output_frames) {
+        if (!state.is_frame_pending) {
+            if (consumed == input_frames) {
+                break;
+            }
+            std::rotate(state.history.begin(), state.history.end() - 1, state.history.end());
+            state.history[0][0] = input[consumed * 2 + 0];
+            state.history[0][1] = input[consumed * 2 + 1];
+            state.is_frame_pending = true;
+            ++consumed;
         }
-        if (step <= 0x8000) {
-            return curve_lut1;
+
+        if (state.position > 1.0) {
+            state.position -= 1.0;
+            state.is_frame_pending = false;
+            continue;
         }
-        return curve_lut2;
-    }();
 
-    const std::size_t num_frames{input.size() / 2};
+        const std::size_t lut_index{(state.fraction >> 8) * InterpolationState::taps};
+        const auto [left, right] =
+            DSP::Filter4TapStereo(state.history[0].data(), &lut[lut_index]);
 
-    std::vector<s16> output;
-    output.reserve(static_cast<std::size_t>(input.size() / ratio + InterpolationState::taps));
+        state.fraction = (state.fraction + step) & 0x7fff;
 
-    for (std::size_t frame{}; frame < num_frames; ++frame) {
-        const std::size_t lut_index{(state.fraction >> 8) * InterpolationState::taps};
+        output[produced * 2 + 0] = static_cast<s16>(std::clamp(left >> 15, SHRT_MIN, SHRT_MAX));
+        output[produced * 2 + 1] = static_cast<s16>(std::clamp(right >> 15, SHRT_MIN, SHRT_MAX));
+        ++produced;
 
-        std::rotate(state.history.begin(), state.history.end() - 1, state.history.end());
-        state.history[0][0] = input[frame * 2 + 0];
-        state.history[0][1] = input[frame * 2 + 1];
+        state.position += ratio;
+    }
 
-        while (state.position <= 1.0) {
-            const s32 left{state.history[0][0] * lut[lut_index + 0] +
-                           state.history[1][0] * lut[lut_index + 1] +
-                           state.history[2][0] * lut[lut_index + 2] +
-                           state.history[3][0] * lut[lut_index + 3]};
-            const s32 right{state.history[0][1] * lut[lut_index + 0] +
-                            state.history[1][1] * lut[lut_index + 1] +
-                            state.history[2][1] * lut[lut_index + 2] +
-                            state.history[3][1] * lut[lut_index + 3]};
-            const s32 new_offset{state.fraction + step};
+    return {consumed, produced};
+}
 
-            state.fraction = new_offset & 0x7fff;
+std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16> input, double ratio) {
+    if (input.size() < 2)
+        return {};
 
-            output.emplace_back(static_cast<s16>(std::clamp(left >> 15, SHRT_MIN, SHRT_MAX)));
-            output.emplace_back(static_cast<s16>(std::clamp(right >> 15, SHRT_MIN, SHRT_MAX)));
+    if (ratio <= 0) {
+        LOG_CRITICAL(Audio, "Nonsensical interpolation ratio {}", ratio);
+        return input;
+    }
 
-            state.position += ratio;
+    const std::size_t num_frames{input.size() / 2};
+    const std::size_t max_frames{static_cast<std::size_t>(num_frames / ratio) +
+                                 InterpolationState::taps};
+
+    std::vector<s16> output(max_frames * 2);
+    std::size_t consumed{};
+    std::size_t produced{};
+    while (true) {
+        const std::size_t capacity{output.size() / 2};
+        const auto result = Interpolate(state, input.data() + consumed * 2, num_frames - consumed,
+                                        output.data() + produced * 2, capacity - produced, ratio);
+        consumed += result.consumed_frames;
+        produced += result.produced_frames;
+        if (produced < capacity) {
+            break;
         }
-        state.position -= 1.0;
+        output.resize(output.size() * 2);
     }
+    output.resize(produced * 2);
 
     return output;
 }
@@ -17,8 +17,28 @@ struct InterpolationState {
     std::array<std::array<s16, 2>, history_size> history{};
     double position{};
     s32 fraction{};
+    /// Whether the newest frame in history can still produce output frames
+    bool is_frame_pending{};
 };
 
+struct InterpolationResult {
+    std::size_t consumed_frames;
+    std::size_t produced_frames;
+};
+
+/// Incrementally interpolates interleaved stereo frames, without allocating.
+/// Stops once the output is full or every input frame has been consumed, whichever comes first.
+/// Frames that were consumed but not fully resampled yet are kept in the state.
+/// @param input         Interleaved stereo input frames.
+/// @param input_frames  Number of input frames available.
+/// @param output        Buffer receiving the interleaved stereo output frames.
+/// @param output_frames Maximum number of frames to write to the output.
+/// @param ratio         Interpolation ratio, see below.
+/// @returns The number of input frames consumed and output frames produced.
+InterpolationResult Interpolate(InterpolationState& state, const s16* input,
+                                std::size_t input_frames, s16* output, std::size_t output_frames,
+                                double ratio);
+
 /// Interpolates input signal to produce output signal.
 /// @param input The signal to interpolate.
 /// @param ratio Interpolation ratio.
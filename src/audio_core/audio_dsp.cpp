@@ -0,0 +1,330 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "audio_core/algorithm/dsp_kernels.h"
+#include "audio_core/audio_dsp.h"
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
+
+MICROPROFILE_DEFINE(Audio_DSP, "Audio", "DSP Command List", MP_RGB(96, 160, 224));
+MICROPROFILE_DEFINE(Audio_EffectAux, "Audio", "Effect Aux", MP_RGB(160, 96, 224));
+
+namespace AudioCore {
+
+/// Number of command lists in flight, covers the stream buffers released by one update
+constexpr std::size_t COMMAND_LIST_COUNT{4};
+
+/// Number of channels of the final mix output
+constexpr std::size_t OUTPUT_NUM_CHANNELS{2};
+
+/// Number of preallocated output buffers, rendered buffers can wait for the service thread while
+/// every command list is being executed again
+constexpr std::size_t OUTPUT_COUNT{COMMAND_LIST_COUNT * 2};
+
+AudioDSP::AudioDSP(std::size_t voice_count, std::size_t effect_count, std::size_t instance_number)
+    : command_lists(COMMAND_LIST_COUNT), voice_out_status(voice_count),
+      voice_contexts(voice_count), voice_volumes(voice_count), voice_biquad_states(voice_count),
+      effect_processors(effect_count), effect_types(effect_count) {
+    free_lists.reserve(COMMAND_LIST_COUNT);
+    for (auto& list : command_lists) {
+        // Clears, per-voice commands, effects and the final mix
+        list.commands.reserve(MIX_BUFFER_COUNT + voice_count * 3 + effect_count + 1);
+        list.voice_parameters.reserve(voice_count);
+        list.voice_sources.reserve(voice_count);
+        list.effect_parameters.reserve(effect_count);
+        free_lists.push_back(&list);
+    }
+    for (auto& buffer : mix_buffers) {
+        buffer.resize(MIX_BUFFER_SAMPLE_COUNT);
+    }
+    free_outputs.resize(OUTPUT_COUNT);
+    for (auto& buffer : free_outputs) {
+        buffer.samples.reserve(MIX_BUFFER_SAMPLE_COUNT * OUTPUT_NUM_CHANNELS);
+        buffer.aux_sends.reserve(effect_count);
+    }
+
+    thread = std::thread(&AudioDSP::ThreadLoop, this,
+                         fmt::format("yuzu:AudioDSP{}", instance_number));
+}
+
+AudioDSP::~AudioDSP() {
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    work_condition.notify_all();
+    thread.join();
+}
+
+CommandList& AudioDSP::AcquireCommandList() {
+    std::unique_lock lock{mutex};
+    done_condition.wait(lock, [this] { return !free_lists.empty(); });
+
+    CommandList& list = *free_lists.back();
+    free_lists.pop_back();
+    list.commands.clear();
+    list.voice_parameters.clear();
+    list.voice_sources.clear();
+    list.effect_parameters.clear();
+    list.aux_samples.clear();
+    return list;
+}
+
+void AudioDSP::Submit(CommandList& list) {
+    {
+        std::lock_guard lock{mutex};
+        pending_lists.push(&list);
+    }
+    work_condition.notify_one();
+}
+
+void AudioDSP::WaitIdle() {
+    std::unique_lock lock{mutex};
+    done_condition.wait(lock, [this] { return pending_lists.empty() && executing_count == 0; });
+}
+
+void AudioDSP::PopRenderedBuffers(const std::function<void(const RenderedBuffer&)>& func) {
+    std::unique_lock lock{mutex};
+    while (!rendered_buffers.empty()) {
+        RenderedBuffer buffer = std::move(rendered_buffers.front());
+        rendered_buffers.pop();
+
+        lock.unlock();
+        func(buffer);
+        lock.lock();
+
+        free_outputs.push_back(std::move(buffer));
+    }
+}
+
+VoiceOutStatus AudioDSP::GetVoiceOutStatus(std::size_t voice_index) const {
+    std::lock_guard lock{mutex};
+    return voice_out_status[voice_index];
+}
+
+DSPStatistics AudioDSP::GetStatistics() const {
+    std::lock_guard lock{mutex};
+    return statistics;
+}
+
+void AudioDSP::ThreadLoop(std::string thread_name) {
+    Common::SetCurrentThreadName(thread_name.c_str());
+    MicroProfileOnThreadCreate(thread_name.c_str());
+
+    while (true) {
+        CommandList* list;
+        {
+            std::unique_lock lock{mutex};
+            work_condition.wait(lock, [this] { return stop || !pending_lists.empty(); });
+            if (stop && pending_lists.empty()) {
+                break;
+            }
+            list = pending_lists.front();
+            pending_lists.pop();
+            ++executing_count;
+
+            // Only allocates when the service thread has fallen behind by more than the pool
+            if (!free_outputs.empty()) {
+                output = std::move(free_outputs.back());
+                free_outputs.pop_back();
+            }
+        }
+        output.tag = list->tag;
+        output.samples.clear();
+        output.aux_sends.clear();
+        output.aux_samples.clear();
+
+        const auto start_time{std::chrono::steady_clock::now()};
+        Execute(*list);
+        const auto execution_time{std::chrono::steady_clock::now() - start_time};
+
+        {
+            std::lock_guard lock{mutex};
+            ++statistics.command_lists;
+            statistics.mixed_voices += list->voice_parameters.size();
+            statistics.execution_time +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(execution_time);
+            rendered_buffers.push(std::move(output));
+            for (std::size_t index = 0; index < voice_contexts.size(); ++index) {
+                voice_out_status[index] = voice_contexts[index].GetOutStatus();
+            }
+            free_lists.push_back(list);
+            --executing_count;
+        }
+        done_condition.notify_all();
+    }
+
+    MicroProfileOnThreadExit();
+}
+
+void AudioDSP::Execute(const CommandList& list) {
+    MICROPROFILE_SCOPE(Audio_DSP);
+
+    if (list.generation != generation) {
+        // The guest has updated the voice parameters, voices paused at the end of their stream
+        // are resumed according to their new play state.
+        generation = list.generation;
+        for (auto& context : voice_contexts) {
+            context.ClearPause();
+        }
+    }
+
+    for (const Command& command : list.commands) {
+        switch (command.type) {
+        case CommandType::ClearMixBuffer:
+            std::fill(mix_buffers[command.mix_buffer].begin(),
+                      mix_buffers[command.mix_buffer].end(), 0.0f);
+            break;
+        case CommandType::ResetVoice:
+            voice_contexts[command.voice_index].Reset();
+            voice_volumes[command.voice_index] = 0.0f;
+            voice_biquad_states[command.voice_index] = {};
+            break;
+        case CommandType::SetWaveIndex:
+            voice_contexts[command.voice_index].SetWaveIndex(command.wave_index);
+            break;
+        case CommandType::DataSourceVoice:
+            MixVoice(command, list.voice_parameters[command.parameter_index],
+                     list.voice_sources[command.parameter_index]);
+            break;
+        case CommandType::Effect:
+            ApplyEffect(command, list.effect_parameters[command.parameter_index]);
+            break;
+        case CommandType::Aux:
+            MixAux(command, list.effect_parameters[command.parameter_index], list);
+            break;
+        case CommandType::FinalMixOutput:
+            FinalMixOutput(command);
+            break;
+        default:
+            UNREACHABLE_MSG("Unknown command type {}", static_cast<u32>(command.type));
+            break;
+        }
+    }
+}
+
+void AudioDSP::MixVoice(const Command& command, const VoiceInfo& info, const VoiceSource& source) {
+    auto& context = voice_contexts[command.voice_index];
+    float* const left = mix_buffers[command.mix_buffer].data();
+    float* const right = mix_buffers[command.mix_buffer + 1].data();
+
+    // Ramp from the volume of the previous mix to avoid clicks when the guest changes it
+    const float start_volume{voice_volumes[command.voice_index]};
+    const float volume_step{(command.volume - start_volume) / MIX_BUFFER_SAMPLE_COUNT};
+    voice_volumes[command.voice_index] = command.volume;
+
+    // Filtered voices are decoded unscaled into scratch buffers and ramped into the mix after
+    const bool has_biquad_filter{std::any_of(info.biquad_filter.begin(), info.biquad_filter.end(),
+                                             [](const auto& filter) { return filter.enable; })};
+    float* const voice_left = has_biquad_filter ? voice_samples[0].data() : left;
+    float* const voice_right = has_biquad_filter ? voice_samples[1].data() : right;
+    const float gain{has_biquad_filter ? 1.0f : start_volume};
+    const float gain_step{has_biquad_filter ? 0.0f : volume_step};
+    if (has_biquad_filter) {
+        voice_samples = {};
+    }
+
+    std::size_t offset{};
+    while (offset < MIX_BUFFER_SAMPLE_COUNT) {
+        const s16* samples;
+        const std::size_t frames{
+            context.DequeueSamples(info, MIX_BUFFER_SAMPLE_COUNT - offset, source, samples)};
+        if (frames == 0) {
+            break;
+        }
+
+        const float volume{gain + gain_step * static_cast<float>(offset)};
+        DSP::MixStereoS16(voice_left + offset, voice_right + offset, samples, volume, gain_step,
+                          frames);
+        offset += frames;
+    }
+
+    if (!has_biquad_filter) {
+        return;
+    }
+
+    auto& states = voice_biquad_states[command.voice_index];
+    for (std::size_t index = 0; index < info.biquad_filter.size(); ++index) {
+        const auto& filter = info.biquad_filter[index];
+        if (!filter.enable) {
+            continue;
+        }
+        const auto coeffs{DSP::BiquadCoefficientsFromQ14(filter.numerator, filter.denominator)};
+        DSP::BiquadFilterStereo(voice_left, voice_right, offset, coeffs, states[index][0],
+                                states[index][1]);
+    }
+    DSP::MixAccumulateRamp(left, voice_left, start_volume, volume_step, offset);
+    DSP::MixAccumulateRamp(right, voice_right, start_volume, volume_step, offset);
+}
+
+void AudioDSP::ApplyEffect(const Command& command, const EffectInStatus& info) {
+    auto& processor = effect_processors[command.effect_index];
+    if (command.is_reset || info.type != effect_types[command.effect_index]) {
+        processor = EffectProcessor::Create(info.type);
+        effect_types[command.effect_index] = info.type;
+    }
+    if (processor) {
+        processor->Process(info, mix_buffers);
+    }
+}
+
+void AudioDSP::MixAux(const Command& command, const EffectInStatus& info,
+                      const CommandList& list) {
+    MICROPROFILE_SCOPE(Audio_EffectAux);
+
+    const auto& params = info.aux_info;
+    const std::size_t channel_count{GetAuxChannelCount(params)};
+    if (channel_count == 0 || params.sample_count == 0) {
+        return;
+    }
+
+    if (params.send_buffer_info != 0 && params.send_buffer_base != 0) {
+        AuxSend send{};
+        send.info_address = params.send_buffer_info;
+        send.ring_address = params.send_buffer_base;
+        send.ring_size = params.sample_count;
+        send.channel_count = channel_count;
+        send.sample_offset = output.aux_samples.size();
+        output.aux_samples.resize(send.sample_offset + channel_count * MIX_BUFFER_SAMPLE_COUNT);
+        for (std::size_t channel = 0; channel < channel_count; ++channel) {
+            s32* const samples =
+                output.aux_samples.data() + send.sample_offset + channel * MIX_BUFFER_SAMPLE_COUNT;
+            const u8 index{params.input_mix_buffers[channel]};
+            if (index < MIX_BUFFER_COUNT) {
+                DSP::ConvertFloatToS32(samples, mix_buffers[index].data(),
+                                       MIX_BUFFER_SAMPLE_COUNT);
+            } else {
+                std::fill_n(samples, MIX_BUFFER_SAMPLE_COUNT, 0);
+            }
+        }
+        output.aux_sends.push_back(send);
+    }
+
+    if (params.return_buffer_info != 0 && params.return_buffer_base != 0) {
+        const s32* const samples = list.aux_samples.data() + command.aux_offset;
+        for (std::size_t channel = 0; channel < channel_count; ++channel) {
+            const u8 index{params.output_mix_buffers[channel]};
+            if (index < MIX_BUFFER_COUNT) {
+                DSP::ConvertS32ToFloat(mix_buffers[index].data(),
+                                       samples + channel * MIX_BUFFER_SAMPLE_COUNT,
+                                       MIX_BUFFER_SAMPLE_COUNT);
+            }
+        }
+    }
+}
+
+void AudioDSP::FinalMixOutput(const Command& command) {
+    const float* const left = mix_buffers[command.mix_buffer].data();
+    const float* const right = mix_buffers[command.mix_buffer + 1].data();
+
+    output.samples.resize(MIX_BUFFER_SAMPLE_COUNT * OUTPUT_NUM_CHANNELS);
+    DSP::InterleaveS16(output.samples.data(), left, right, MIX_BUFFER_SAMPLE_COUNT);
+}
+
+} // namespace AudioCore
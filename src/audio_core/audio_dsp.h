@@ -0,0 +1,129 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "audio_core/algorithm/dsp_kernels.h"
+#include "audio_core/audio_renderer.h"
+#include "audio_core/buffer.h"
+#include "audio_core/command_list.h"
+#include "audio_core/effect_processor.h"
+#include "audio_core/voice_context.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/// Execution statistics of the DSP thread, used to measure its throughput
+struct DSPStatistics {
+    u64 command_lists{};                       ///< Number of executed command lists
+    u64 mixed_voices{};                        ///< Number of voices mixed by those lists
+    std::chrono::nanoseconds execution_time{}; ///< Time spent executing those lists
+};
+
+/// Samples sent to an aux effect by a command list, to be written to the guest's send ring
+struct AuxSend {
+    VAddr info_address{};        ///< Guest address of the AuxBufferInfo of the send ring
+    VAddr ring_address{};        ///< Guest address of the first channel of the send ring
+    std::size_t ring_size{};     ///< Number of samples per channel in the ring
+    std::size_t channel_count{}; ///< Number of channels sent
+    std::size_t sample_offset{}; ///< Offset of the samples in RenderedBuffer::aux_samples
+};
+
+/// Output of an executed command list
+struct RenderedBuffer {
+    Buffer::Tag tag{};              ///< Tag of the stream buffer rendered
+    std::vector<s16> samples;       ///< Interleaved PCM16 output
+    std::vector<AuxSend> aux_sends; ///< Aux sends made by the list, in command order
+    std::vector<s32> aux_samples;   ///< Samples sent to the aux effects, per channel
+};
+
+/**
+ * Executes renderer command lists on a dedicated host thread, mixing into preallocated float mix
+ * buffers. Command lists are recycled from a fixed pool, so generating and executing them does
+ * not allocate once the pool has been filled.
+ *
+ * The DSP never accesses guest memory: voices are mixed from the wave buffer copies held by the
+ * command lists and aux effects read the return samples copied into them. Samples sent to aux
+ * effects are handed back with the rendered buffer, for the renderer to write to the guest. The
+ * renderer does not wait for the lists it submits, its update request returns once they are
+ * queued.
+ */
+class AudioDSP {
+public:
+    explicit AudioDSP(std::size_t voice_count, std::size_t effect_count,
+                      std::size_t instance_number);
+    ~AudioDSP();
+
+    AudioDSP(const AudioDSP&) = delete;
+    AudioDSP& operator=(const AudioDSP&) = delete;
+
+    /// Returns an empty command list to be filled, blocking while every list is in flight
+    CommandList& AcquireCommandList();
+
+    /// Queues a command list acquired with AcquireCommandList for execution
+    void Submit(CommandList& list);
+
+    /// Blocks until every submitted command list has been executed
+    void WaitIdle();
+
+    /// Calls func with every rendered buffer, in submission order.
+    /// The buffer is only valid during the call, its storage is reused for later buffers.
+    void PopRenderedBuffers(const std::function<void(const RenderedBuffer&)>& func);
+
+    /// Returns the playback status of a voice as of the last executed command list
+    VoiceOutStatus GetVoiceOutStatus(std::size_t voice_index) const;
+
+    /// Returns the statistics accumulated since the DSP was created
+    DSPStatistics GetStatistics() const;
+
+private:
+    void ThreadLoop(std::string thread_name);
+    void Execute(const CommandList& list);
+    void MixVoice(const Command& command, const VoiceInfo& info, const VoiceSource& source);
+    void ApplyEffect(const Command& command, const EffectInStatus& info);
+    void MixAux(const Command& command, const EffectInStatus& info, const CommandList& list);
+    void FinalMixOutput(const Command& command);
+
+    std::vector<CommandList> command_lists;
+    std::vector<CommandList*> free_lists;
+    std::queue<CommandList*> pending_lists;
+    std::queue<RenderedBuffer> rendered_buffers;
+    /// Preallocated output buffers not holding a rendered buffer
+    std::vector<RenderedBuffer> free_outputs;
+    std::vector<VoiceOutStatus> voice_out_status;
+    DSPStatistics statistics;
+    std::size_t executing_count{};
+    bool stop{};
+
+    mutable std::mutex mutex;
+    std::condition_variable work_condition;
+    std::condition_variable done_condition;
+
+    // State below is only accessed by the DSP thread
+    u64 generation{};
+    std::vector<VoiceContext> voice_contexts;
+    std::vector<float> voice_volumes;
+    /// State of the voice biquad filters, per filter and per channel
+    std::vector<std::array<std::array<DSP::BiquadState, 2>, 2>> voice_biquad_states;
+    std::array<std::array<float, MIX_BUFFER_SAMPLE_COUNT>, 2> voice_samples{};
+    std::vector<std::unique_ptr<EffectProcessor>> effect_processors;
+    std::vector<Effect> effect_types;
+    MixBuffers mix_buffers;
+    RenderedBuffer output;
+
+    std::thread thread;
+};
+
+} // namespace AudioCore
@@ -2,15 +2,25 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include "audio_core/algorithm/interpolate.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#include "audio_core/audio_dsp.h"
 #include "audio_core/audio_out.h"
 #include "audio_core/audio_renderer.h"
-#include "audio_core/codec.h"
+#include "audio_core/command_list.h"
+#include "audio_core/renderer_capture.h"
 #include "common/assert.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
 #include "common/logging/log.h"
 #include "core/core.h"
+#include "core/core_timing.h"
 #include "core/hle/kernel/writable_event.h"
 #include "core/memory.h"
+#include "core/settings.h"
 
 namespace AudioCore {
 
@@ -23,10 +33,6 @@ public:
         return is_in_use && info.play_state == PlayState::Started;
     }
 
-    const VoiceOutStatus& GetOutStatus() const {
-        return out_status;
-    }
-
     const VoiceInfo& GetInfo() const {
         return info;
     }
@@ -35,21 +41,31 @@ public:
         return info;
     }
 
-    void SetWaveIndex(std::size_t index);
-    std::vector<s16> DequeueSamples(std::size_t sample_count, Memory::Memory& memory);
+    /// Returns true if the DSP state of the voice is to be reset by the next command list
+    bool IsResetPending() const {
+        return is_reset_pending;
+    }
+
+    const VoiceSource& GetSource() const {
+        return source;
+    }
+
     void UpdateState();
-    void RefreshBuffer(Memory::Memory& memory);
+
+    /// Copies the wave buffers submitted by the guest since the last update and the coefficients
+    void UpdateSource(Memory::Memory& memory);
+
+    /// Appends the commands applying state changes made by the guest since the last command list
+    void GeneratePendingCommands(CommandList& list, u32 voice_index);
 
 private:
     bool is_in_use{};
-    bool is_refresh_pending{};
-    std::size_t wave_index{};
-    std::size_t offset{};
-    Codec::ADPCMState adpcm_state{};
-    InterpolationState interp_state{};
-    std::vector<s16> samples;
-    VoiceOutStatus out_status{};
+    bool is_reset_pending{};
+    bool is_wave_index_pending{};
+    u32 pending_wave_index{};
     VoiceInfo info{};
+    VoiceSource source{};
+    std::array<VAddr, 4> wave_buffer_addresses{}; ///< Guest addresses of the copied wave buffers
 };
 
 class AudioRenderer::EffectState {
@@ -66,28 +82,64 @@ public:
         return info;
     }
 
-    void UpdateState(Memory::Memory& memory);
+    bool IsEnabled() const {
+        return info.is_enabled && info.type != Effect::None;
+    }
+
+    void UpdateState();
+
+    /// Appends the command applying the effect, resetting its DSP state if the guest recreated it.
+    /// Aux effects read the samples they return from guest memory into the list.
+    void GenerateCommand(CommandList& list, u32 effect_index, Memory::Memory& memory);
 
 private:
+    /// Reads the samples of the next command list from the return ring of an aux effect
+    void ReadAuxReturn(CommandList& list, Memory::Memory& memory) const;
+
+    bool is_reset_pending{};
     EffectOutStatus out_status{};
     EffectInStatus info{};
 };
-AudioRenderer::AudioRenderer(Core::Timing::CoreTiming& core_timing, Memory::Memory& memory_,
+
+AudioRenderer::AudioRenderer(Core::Timing::CoreTiming& core_timing_, Memory::Memory& memory_,
                              AudioRendererParameter params,
                              std::shared_ptr<Kernel::WritableEvent> buffer_event,
                              std::size_t instance_number)
     : worker_params{params}, buffer_event{buffer_event}, voices(params.voice_count),
-      effects(params.effect_count), memory{memory_} {
+      effects(params.effect_count), core_timing{core_timing_}, memory{memory_},
+      dsp{std::make_unique<AudioDSP>(params.voice_count, params.effect_count, instance_number)} {
+    if (Settings::values.dump_audio_renderer) {
+        const auto dump_dir{FileUtil::GetUserPath(FileUtil::UserPath::DumpDir) + "audio_renderer" +
+                            DIR_SEP};
+        const auto timestamp{std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch())};
+        const auto path{
+            fmt::format("{}{}_{}.bin", dump_dir, timestamp.count(), instance_number)};
+        if (FileUtil::CreateFullPath(path)) {
+            capture = std::make_unique<RendererCaptureWriter>(path, params);
+        }
+    }
 
     audio_out = std::make_unique<AudioCore::AudioOut>();
-    stream = audio_out->OpenStream(core_timing, STREAM_SAMPLE_RATE, STREAM_NUM_CHANNELS,
+    stream = audio_out->OpenStream(core_timing_, STREAM_SAMPLE_RATE, STREAM_NUM_CHANNELS,
                                    fmt::format("AudioRenderer-Instance{}", instance_number),
-                                   [=]() { buffer_event->Signal(); });
+                                   [this, buffer_event] {
+                                       QueueRenderedBuffers();
+                                       if (stream->GetQueueSize() == 0) {
+                                           // The DSP has fallen behind, wait for it rather than
+                                           // let the stream run dry and stop releasing buffers
+                                           dsp->WaitIdle();
+                                           QueueRenderedBuffers();
+                                       }
+                                       buffer_event->Signal();
+                                   });
     audio_out->StartStream(stream);
 
-    QueueMixedBuffer(0);
-    QueueMixedBuffer(1);
-    QueueMixedBuffer(2);
+    // No voice or effect is in use yet, so the initial buffers are silent and need no rendering
+    for (Buffer::Tag tag = 0; tag < 3; ++tag) {
+        audio_out->QueueBuffer(stream, tag,
+                               std::vector<s16>(MIX_BUFFER_SAMPLE_COUNT * STREAM_NUM_CHANNELS));
+    }
 }
 
 AudioRenderer::~AudioRenderer() = default;
@@ -108,11 +160,60 @@ Stream::State AudioRenderer::GetStreamState() const {
     return stream->GetState();
 }
 
+void AudioRenderer::Flush() {
+    dsp->WaitIdle();
+}
+
+void AudioRenderer::SetRenderedBufferCallback(
+    std::function<void(const std::vector<s16>&)> callback) {
+    rendered_buffer_callback = std::move(callback);
+}
+
+DSPStatistics AudioRenderer::GetDSPStatistics() const {
+    return dsp->GetStatistics();
+}
+
 static constexpr u32 VersionFromRevision(u32_le rev) {
     // "REV7" -> 7
     return ((rev >> 24) & 0xff) - 0x30;
 }
 
+/// Reads MIX_BUFFER_SAMPLE_COUNT samples from a guest aux ring, wrapping around its end
+static void ReadAuxRing(Memory::Memory& memory, VAddr base, std::size_t ring_size,
+                        std::size_t offset, s32* samples) {
+    std::size_t done{};
+    while (done < MIX_BUFFER_SAMPLE_COUNT) {
+        const std::size_t count{std::min(MIX_BUFFER_SAMPLE_COUNT - done, ring_size - offset)};
+        const VAddr address{base + offset * sizeof(s32)};
+        const std::size_t size{count * sizeof(s32)};
+        if (const u8* const pointer = memory.GetContiguousPointer(address, size)) {
+            std::memcpy(samples + done, pointer, size);
+        } else {
+            memory.ReadBlock(address, samples + done, size);
+        }
+        done += count;
+        offset = (offset + count) % ring_size;
+    }
+}
+
+/// Writes MIX_BUFFER_SAMPLE_COUNT samples to a guest aux ring, wrapping around its end
+static void WriteAuxRing(Memory::Memory& memory, VAddr base, std::size_t ring_size,
+                         std::size_t offset, const s32* samples) {
+    std::size_t done{};
+    while (done < MIX_BUFFER_SAMPLE_COUNT) {
+        const std::size_t count{std::min(MIX_BUFFER_SAMPLE_COUNT - done, ring_size - offset)};
+        const VAddr address{base + offset * sizeof(s32)};
+        const std::size_t size{count * sizeof(s32)};
+        if (u8* const pointer = memory.GetContiguousPointer(address, size)) {
+            std::memcpy(pointer, samples + done, size);
+        } else {
+            memory.WriteBlock(address, samples + done, size);
+        }
+        done += count;
+        offset = (offset + count) % ring_size;
+    }
+}
+
 std::vector<u8> AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_params) {
     // Copy UpdateDataHeader struct
     UpdateDataHeader config{};
@@ -141,6 +242,21 @@ std::vector<u8> AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_
         effect_offset += sizeof(EffectInStatus);
     }
 
+    if (capture) {
+        // Record the guest memory the voices read before the update referencing it
+        for (const auto& voice : voices) {
+            const auto& info = voice.GetInfo();
+            if (!info.is_in_use) {
+                continue;
+            }
+            for (const auto& wave_buffer : info.wave_buffer) {
+                capture->RecordMemory(memory, wave_buffer.buffer_addr, wave_buffer.buffer_sz);
+            }
+            capture->RecordMemory(memory, info.additional_params_addr, info.additional_params_sz);
+        }
+        capture->RecordUpdate(core_timing.GetTicks(), input_params);
+    }
+
     // Update memory pool state
     std::vector<MemoryPoolEntry> memory_pool(memory_pool_count);
     for (std::size_t index = 0; index < memory_pool.size(); ++index) {
@@ -152,21 +268,18 @@ std::vector<u8> AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_
     }
 
     // Update voices
+    ++update_generation;
     for (auto& voice : voices) {
         voice.UpdateState();
-        if (!voice.GetInfo().is_in_use) {
-            continue;
-        }
-        if (voice.GetInfo().is_new) {
-            voice.SetWaveIndex(voice.GetInfo().wave_buffer_head);
-        }
+        voice.UpdateSource(memory);
     }
 
     for (auto& effect : effects) {
-        effect.UpdateState(memory);
+        effect.UpdateState();
     }
 
-    // Release previous buffers and queue next ones for playback
+    // Queue buffers rendered since the last update, then render the next ones from the new state
+    QueueRenderedBuffers();
     ReleaseAndQueueBuffers();
 
     // Copy output header
@@ -185,8 +298,11 @@ std::vector<u8> AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_
 
     // Copy output voice status
     std::size_t voice_out_status_offset{sizeof(UpdateDataHeader) + response_data.memory_pools_size};
-    for (const auto& voice : voices) {
-        std::memcpy(output_params.data() + voice_out_status_offset, &voice.GetOutStatus(),
+    for (std::size_t index = 0; index < voices.size(); ++index) {
+        // Voices being reset report a cleared status even if the DSP has not caught up yet.
+        const VoiceOutStatus out_status =
+            voices[index].IsResetPending() ? VoiceOutStatus{} : dsp->GetVoiceOutStatus(index);
+        std::memcpy(output_params.data() + voice_out_status_offset, &out_status,
                     sizeof(VoiceOutStatus));
         voice_out_status_offset += sizeof(VoiceOutStatus);
     }
@@ -202,163 +318,194 @@ std::vector<u8> AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_
     return output_params;
 }
 
-void AudioRenderer::VoiceState::SetWaveIndex(std::size_t index) {
-    wave_index = index & 3;
-    is_refresh_pending = true;
-}
-
-std::vector<s16> AudioRenderer::VoiceState::DequeueSamples(std::size_t sample_count,
-                                                           Memory::Memory& memory) {
-    if (!IsPlaying()) {
-        return {};
+void AudioRenderer::VoiceState::UpdateState() {
+    if (is_in_use && !info.is_in_use) {
+        // No longer in use, reset state
+        is_reset_pending = true;
+        is_wave_index_pending = false;
     }
+    is_in_use = info.is_in_use;
 
-    if (is_refresh_pending) {
-        RefreshBuffer(memory);
+    if (is_in_use && info.is_new) {
+        is_wave_index_pending = true;
+        pending_wave_index = info.wave_buffer_head;
     }
+}
 
-    const std::size_t max_size{samples.size() - offset};
-    const std::size_t dequeue_offset{offset};
-    std::size_t size{sample_count * STREAM_NUM_CHANNELS};
-    if (size > max_size) {
-        size = max_size;
+void AudioRenderer::VoiceState::UpdateSource(Memory::Memory& memory) {
+    if (!is_in_use) {
+        // Command lists still mixing the voice keep their own references to the copies
+        source = {};
+        wave_buffer_addresses = {};
+        return;
     }
 
-    out_status.played_sample_count += size / STREAM_NUM_CHANNELS;
-    offset += size;
+    if (static_cast<Codec::PcmFormat>(info.sample_format) == Codec::PcmFormat::Adpcm) {
+        memory.ReadBlock(info.additional_params_addr, source.adpcm_coeff.data(),
+                         sizeof(source.adpcm_coeff));
+    }
 
-    const auto& wave_buffer{info.wave_buffer[wave_index]};
-    if (offset == samples.size()) {
-        offset = 0;
+    for (std::size_t index = 0; index < info.wave_buffer.size(); ++index) {
+        const auto& wave_buffer = info.wave_buffer[index];
+        auto& data = source.wave_buffers[index];
 
-        if (!wave_buffer.is_looping && wave_buffer.buffer_sz) {
-            SetWaveIndex(wave_index + 1);
+        // The guest does not modify wave buffers once they have been sent, so only buffers that
+        // are new or were not copied yet are read
+        const bool is_copied{data && wave_buffer_addresses[index] == wave_buffer.buffer_addr &&
+                             data->size() == wave_buffer.buffer_sz};
+        if (wave_buffer.sent_to_server && is_copied) {
+            continue;
         }
 
-        if (wave_buffer.buffer_sz) {
-            out_status.wave_buffer_consumed++;
+        wave_buffer_addresses[index] = wave_buffer.buffer_addr;
+        if (wave_buffer.buffer_addr == 0 || wave_buffer.buffer_sz == 0) {
+            data.reset();
+            continue;
         }
 
-        if (wave_buffer.end_of_stream || wave_buffer.buffer_sz == 0) {
-            info.play_state = PlayState::Paused;
-        }
+        // Lists in flight may still read the previous copy, so a new one is always made
+        auto copy = std::make_shared<std::vector<u8>>(wave_buffer.buffer_sz);
+        memory.ReadBlock(wave_buffer.buffer_addr, copy->data(), copy->size());
+        data = std::move(copy);
     }
-
-    return {samples.begin() + dequeue_offset, samples.begin() + dequeue_offset + size};
 }
 
-void AudioRenderer::VoiceState::UpdateState() {
-    if (is_in_use && !info.is_in_use) {
-        // No longer in use, reset state
-        is_refresh_pending = true;
-        wave_index = 0;
-        offset = 0;
-        out_status = {};
+void AudioRenderer::VoiceState::GeneratePendingCommands(CommandList& list, u32 voice_index) {
+    if (is_reset_pending) {
+        Command command{};
+        command.type = CommandType::ResetVoice;
+        command.voice_index = voice_index;
+        list.commands.push_back(command);
+        is_reset_pending = false;
+    }
+    if (is_wave_index_pending) {
+        Command command{};
+        command.type = CommandType::SetWaveIndex;
+        command.voice_index = voice_index;
+        command.wave_index = pending_wave_index;
+        list.commands.push_back(command);
+        is_wave_index_pending = false;
     }
-    is_in_use = info.is_in_use;
 }
 
-void AudioRenderer::VoiceState::RefreshBuffer(Memory::Memory& memory) {
-    const auto wave_buffer_address = info.wave_buffer[wave_index].buffer_addr;
-    const auto wave_buffer_size = info.wave_buffer[wave_index].buffer_sz;
-    std::vector<s16> new_samples(wave_buffer_size / sizeof(s16));
-    memory.ReadBlock(wave_buffer_address, new_samples.data(), wave_buffer_size);
-
-    switch (static_cast<Codec::PcmFormat>(info.sample_format)) {
-    case Codec::PcmFormat::Int16: {
-        // PCM16 is played as-is
-        break;
-    }
-    case Codec::PcmFormat::Adpcm: {
-        // Decode ADPCM to PCM16
-        Codec::ADPCM_Coeff coeffs;
-        memory.ReadBlock(info.additional_params_addr, coeffs.data(), sizeof(Codec::ADPCM_Coeff));
-        new_samples = Codec::DecodeADPCM(reinterpret_cast<u8*>(new_samples.data()),
-                                         new_samples.size() * sizeof(s16), coeffs, adpcm_state);
-        break;
-    }
-    default:
-        UNIMPLEMENTED_MSG("Unimplemented sample_format={}", info.sample_format);
-        break;
-    }
-
-    switch (info.channel_count) {
-    case 1:
-        // 1 channel is upsampled to 2 channel
-        samples.resize(new_samples.size() * 2);
-        for (std::size_t index = 0; index < new_samples.size(); ++index) {
-            samples[index * 2] = new_samples[index];
-            samples[index * 2 + 1] = new_samples[index];
-        }
-        break;
-    case 2: {
-        // 2 channel is played as is
-        samples = std::move(new_samples);
-        break;
-    }
-    default:
-        UNIMPLEMENTED_MSG("Unimplemented channel_count={}", info.channel_count);
-        break;
+void AudioRenderer::EffectState::UpdateState() {
+    if (info.is_new) {
+        out_status.state = EffectStatus::New;
+        is_reset_pending = true;
     }
+}
 
-    // Only interpolate when necessary, expensive.
-    if (GetInfo().sample_rate != STREAM_SAMPLE_RATE) {
-        samples = Interpolate(interp_state, std::move(samples), GetInfo().sample_rate,
-                              STREAM_SAMPLE_RATE);
+void AudioRenderer::EffectState::GenerateCommand(CommandList& list, u32 effect_index,
+                                                 Memory::Memory& memory) {
+    Command command{};
+    command.type = info.type == Effect::Aux ? CommandType::Aux : CommandType::Effect;
+    command.effect_index = effect_index;
+    command.parameter_index = static_cast<u32>(list.effect_parameters.size());
+    command.mix_buffer = 0;
+    command.is_reset = is_reset_pending;
+    command.aux_offset = static_cast<u32>(list.aux_samples.size());
+    if (info.type == Effect::Aux) {
+        ReadAuxReturn(list, memory);
     }
-
-    is_refresh_pending = false;
+    list.effect_parameters.push_back(info);
+    list.commands.push_back(command);
+    is_reset_pending = false;
 }
 
-void AudioRenderer::EffectState::UpdateState(Memory::Memory& memory) {
-    if (info.is_new) {
-        out_status.state = EffectStatus::New;
-    } else {
-        if (info.type == Effect::Aux) {
-            ASSERT_MSG(memory.Read32(info.aux_info.return_buffer_info) == 0,
-                       "Aux buffers tried to update");
-            ASSERT_MSG(memory.Read32(info.aux_info.send_buffer_info) == 0,
-                       "Aux buffers tried to update");
-            ASSERT_MSG(memory.Read32(info.aux_info.return_buffer_base) == 0,
-                       "Aux buffers tried to update");
-            ASSERT_MSG(memory.Read32(info.aux_info.send_buffer_base) == 0,
-                       "Aux buffers tried to update");
-        }
+void AudioRenderer::EffectState::ReadAuxReturn(CommandList& list, Memory::Memory& memory) const {
+    const auto& params = info.aux_info;
+    const std::size_t channel_count{GetAuxChannelCount(params)};
+    const std::size_t ring_size{params.sample_count};
+    if (channel_count == 0 || ring_size == 0 || params.return_buffer_info == 0 ||
+        params.return_buffer_base == 0) {
+        return;
     }
-}
 
-static constexpr s16 ClampToS16(s32 value) {
-    return static_cast<s16>(std::clamp(value, -32768, 32767));
+    const VAddr offset_address{params.return_buffer_info + offsetof(AuxBufferInfo, read_offset)};
+    const std::size_t read_offset{memory.Read32(offset_address) % ring_size};
+    const std::size_t first_sample{list.aux_samples.size()};
+    list.aux_samples.resize(first_sample + channel_count * MIX_BUFFER_SAMPLE_COUNT);
+    for (std::size_t channel = 0; channel < channel_count; ++channel) {
+        ReadAuxRing(memory, params.return_buffer_base + channel * ring_size * sizeof(s32),
+                    ring_size, read_offset,
+                    list.aux_samples.data() + first_sample + channel * MIX_BUFFER_SAMPLE_COUNT);
+    }
+    memory.Write32(offset_address,
+                   static_cast<u32>((read_offset + MIX_BUFFER_SAMPLE_COUNT) % ring_size));
 }
 
-void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag) {
-    constexpr std::size_t BUFFER_SIZE{512};
-    std::vector<s16> buffer(BUFFER_SIZE * stream->GetNumChannels());
+void AudioRenderer::GenerateCommandList(CommandList& list, Buffer::Tag tag) {
+    list.tag = tag;
+    list.generation = update_generation;
 
-    for (auto& voice : voices) {
+    for (u32 mix_buffer = 0; mix_buffer < MIX_BUFFER_COUNT; ++mix_buffer) {
+        Command command{};
+        command.type = CommandType::ClearMixBuffer;
+        command.mix_buffer = mix_buffer;
+        list.commands.push_back(command);
+    }
+
+    for (u32 index = 0; index < static_cast<u32>(voices.size()); ++index) {
+        auto& voice = voices[index];
+        voice.GeneratePendingCommands(list, index);
         if (!voice.IsPlaying()) {
             continue;
         }
 
-        std::size_t offset{};
-        s64 samples_remaining{BUFFER_SIZE};
-        while (samples_remaining > 0) {
-            const std::vector<s16> samples{voice.DequeueSamples(samples_remaining, memory)};
+        Command command{};
+        command.type = CommandType::DataSourceVoice;
+        command.voice_index = index;
+        command.parameter_index = static_cast<u32>(list.voice_parameters.size());
+        command.mix_buffer = 0;
+        command.volume = voice.GetInfo().volume;
+        list.voice_parameters.push_back(voice.GetInfo());
+        list.voice_sources.push_back(voice.GetSource());
+        list.commands.push_back(command);
+    }
 
-            if (samples.empty()) {
-                break;
-            }
+    // Every effect is applied to the final mix, after all of the voices
+    for (u32 index = 0; index < static_cast<u32>(effects.size()); ++index) {
+        auto& effect = effects[index];
+        if (effect.IsEnabled()) {
+            effect.GenerateCommand(list, index, memory);
+        }
+    }
 
-            samples_remaining -= samples.size() / stream->GetNumChannels();
+    Command command{};
+    command.type = CommandType::FinalMixOutput;
+    command.mix_buffer = 0;
+    list.commands.push_back(command);
+}
 
-            for (const auto& sample : samples) {
-                const s32 buffer_sample{buffer[offset]};
-                buffer[offset++] =
-                    ClampToS16(buffer_sample + static_cast<s32>(sample * voice.GetInfo().volume));
-            }
+void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag) {
+    CommandList& list = dsp->AcquireCommandList();
+    GenerateCommandList(list, tag);
+    dsp->Submit(list);
+}
+
+void AudioRenderer::QueueRenderedBuffers() {
+    dsp->PopRenderedBuffers([this](const RenderedBuffer& buffer) {
+        // The aux effects receive what the list sent them once it has been executed
+        for (const AuxSend& send : buffer.aux_sends) {
+            WriteAuxSend(send, buffer.aux_samples.data() + send.sample_offset);
+        }
+        if (rendered_buffer_callback) {
+            rendered_buffer_callback(buffer.samples);
         }
+        // The stream owns its buffers, so the samples leave the DSP pool as a copy
+        audio_out->QueueBuffer(stream, buffer.tag, std::vector<s16>(buffer.samples));
+    });
+}
+
+void AudioRenderer::WriteAuxSend(const AuxSend& send, const s32* samples) {
+    const VAddr offset_address{send.info_address + offsetof(AuxBufferInfo, write_offset)};
+    const std::size_t write_offset{memory.Read32(offset_address) % send.ring_size};
+    for (std::size_t channel = 0; channel < send.channel_count; ++channel) {
+        WriteAuxRing(memory, send.ring_address + channel * send.ring_size * sizeof(s32),
+                     send.ring_size, write_offset, samples + channel * MIX_BUFFER_SAMPLE_COUNT);
     }
-    audio_out->QueueBuffer(stream, tag, std::move(buffer));
+    memory.Write32(offset_address,
+                   static_cast<u32>((write_offset + MIX_BUFFER_SAMPLE_COUNT) % send.ring_size));
 }
 
 void AudioRenderer::ReleaseAndQueueBuffers() {
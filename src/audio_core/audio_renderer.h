@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -28,7 +29,12 @@ class Memory;
 
 namespace AudioCore {
 
+class AudioDSP;
 class AudioOut;
+struct AuxSend;
+class RendererCaptureWriter;
+struct CommandList;
+struct DSPStatistics;
 
 enum class PlayState : u8 {
     Started = 0,
@@ -38,7 +44,12 @@ enum class PlayState : u8 {
 
 enum class Effect : u8 {
     None = 0,
+    BufferMixer = 1,
     Aux = 2,
+    Delay = 3,
+    Reverb = 4,
+    I3dl2Reverb = 5,
+    BiquadFilter = 6,
 };
 
 enum class EffectStatus : u8 {
@@ -162,6 +173,98 @@ struct AuxInfo {
 };
 static_assert(sizeof(AuxInfo) == 0x60, "AuxInfo is an invalid size");
 
+/// Ring buffer state shared with the guest at the start of aux send and return buffers
+struct AuxBufferInfo {
+    u32_le read_offset;
+    u32_le write_offset;
+    u32_le remaining;
+    INSERT_PADDING_WORDS(13);
+};
+static_assert(sizeof(AuxBufferInfo) == 0x40, "AuxBufferInfo is an invalid size");
+
+/// Maximum number of channels processed by an effect
+constexpr std::size_t EFFECT_MAX_CHANNELS{6};
+
+/// Coefficients are Q14 fixed point, in the same form as the voice biquad filters
+struct BiquadFilterEffectInfo {
+    std::array<s8, EFFECT_MAX_CHANNELS> input;
+    std::array<s8, EFFECT_MAX_CHANNELS> output;
+    std::array<s16_le, 3> numerator;
+    std::array<s16_le, 2> denominator;
+    s8 channel_count;
+    u8 status;
+};
+static_assert(sizeof(BiquadFilterEffectInfo) == 0x18, "BiquadFilterEffectInfo is an invalid size");
+
+/// Gains and ratios are Q14 fixed point, delay times in milliseconds
+struct DelayInfo {
+    std::array<s8, EFFECT_MAX_CHANNELS> input;
+    std::array<s8, EFFECT_MAX_CHANNELS> output;
+    u16_le max_channels;
+    u16_le channel_count;
+    s32_le max_delay;
+    s32_le delay;
+    s32_le sample_rate;
+    s32_le in_gain;
+    s32_le feedback_gain;
+    s32_le out_gain;
+    s32_le dry_gain;
+    s32_le channel_spread;
+    s32_le low_pass;
+    u8 status;
+    INSERT_PADDING_BYTES(3);
+};
+static_assert(sizeof(DelayInfo) == 0x38, "DelayInfo is an invalid size");
+
+/// Gains and ratios are Q14 fixed point, pre_delay is in Q14 milliseconds and decay_time in Q14
+/// seconds
+struct ReverbInfo {
+    std::array<s8, EFFECT_MAX_CHANNELS> input;
+    std::array<s8, EFFECT_MAX_CHANNELS> output;
+    u16_le max_channels;
+    u16_le channel_count;
+    s32_le sample_rate;
+    s32_le early_mode;
+    s32_le early_gain;
+    s32_le pre_delay;
+    s32_le late_mode;
+    s32_le late_gain;
+    s32_le decay_time;
+    s32_le hf_decay_ratio;
+    s32_le coloration;
+    s32_le reverb_gain;
+    s32_le out_gain;
+    s32_le dry_gain;
+    u8 status;
+    INSERT_PADDING_BYTES(3);
+};
+static_assert(sizeof(ReverbInfo) == 0x44, "ReverbInfo is an invalid size");
+
+/// Levels are in millibels, times in seconds and diffusion and density in percent, as in I3DL2
+struct I3dl2ReverbInfo {
+    std::array<s8, EFFECT_MAX_CHANNELS> input;
+    std::array<s8, EFFECT_MAX_CHANNELS> output;
+    u16_le max_channels;
+    u16_le channel_count;
+    INSERT_PADDING_BYTES(4);
+    u32_le sample_rate;
+    float_le room_hf;
+    float_le hf_reference;
+    float_le decay_time;
+    float_le hf_decay_ratio;
+    float_le room;
+    float_le reflection;
+    float_le reverb;
+    float_le diffusion;
+    float_le reflection_delay;
+    float_le reverb_delay;
+    float_le density;
+    float_le dry_gain;
+    u8 status;
+    INSERT_PADDING_BYTES(3);
+};
+static_assert(sizeof(I3dl2ReverbInfo) == 0x4c, "I3dl2ReverbInfo is an invalid size");
+
 struct EffectInStatus {
     Effect type;
     u8 is_new;
@@ -175,6 +278,10 @@ struct EffectInStatus {
     union {
         std::array<u8, 0xa0> raw;
         AuxInfo aux_info;
+        BiquadFilterEffectInfo biquad_info;
+        DelayInfo delay_info;
+        ReverbInfo reverb_info;
+        I3dl2ReverbInfo i3dl2_reverb_info;
     };
 };
 static_assert(sizeof(EffectInStatus) == 0xc0, "EffectInStatus is an invalid size");
@@ -234,17 +341,40 @@ public:
     u32 GetMixBufferCount() const;
     Stream::State GetStreamState() const;
 
+    /// Blocks until every queued buffer has been rendered by the DSP thread, for offline rendering
+    void Flush();
+
+    /// Sets a callback receiving every rendered buffer before it is queued to the output stream
+    void SetRenderedBufferCallback(std::function<void(const std::vector<s16>&)> callback);
+
+    /// Returns the throughput statistics of the DSP thread
+    DSPStatistics GetDSPStatistics() const;
+
 private:
     class EffectState;
     class VoiceState;
 
+    /// Generates the command list rendering the stream buffer with the given tag
+    void GenerateCommandList(CommandList& list, Buffer::Tag tag);
+
+    /// Queues the buffers rendered by the DSP thread into the output stream
+    void QueueRenderedBuffers();
+
+    /// Writes the samples a command list sent to an aux effect to its guest send ring
+    void WriteAuxSend(const AuxSend& send, const s32* samples);
+
     AudioRendererParameter worker_params;
     std::shared_ptr<Kernel::WritableEvent> buffer_event;
     std::vector<VoiceState> voices;
     std::vector<EffectState> effects;
     std::unique_ptr<AudioOut> audio_out;
     StreamPtr stream;
+    u64 update_generation{};
+    Core::Timing::CoreTiming& core_timing;
     Memory::Memory& memory;
+    std::unique_ptr<AudioDSP> dsp;
+    std::unique_ptr<RendererCaptureWriter> capture;
+    std::function<void(const std::vector<s16>&)> rendered_buffer_callback;
 };
 
 } // namespace AudioCore
@@ -41,4 +41,22 @@ using ADPCM_Coeff = std::array<s16, 16>;
 std::vector<s16> DecodeADPCM(const u8* const data, std::size_t size, const ADPCM_Coeff& coeff,
                              ADPCMState& state);
 
+/// Size in bytes of an ADPCM frame
+constexpr std::size_t ADPCM_FRAME_SIZE = 8;
+
+/// Number of samples in an ADPCM frame
+constexpr std::size_t ADPCM_SAMPLES_PER_FRAME = 14;
+
+/**
+ * Decodes a range of ADPCM samples into a caller provided buffer, without allocating.
+ * @param data Pointer to the ADPCM frame containing the first sample to decode
+ * @param sample_offset Index of the first sample to decode within that frame
+ * @param out Buffer receiving sample_count decoded samples
+ * @param sample_count Number of samples to decode
+ * @param coeff ADPCM coefficients
+ * @param state ADPCM state, this is updated with new state
+ */
+void DecodeADPCM(const u8* data, std::size_t sample_offset, s16* out, std::size_t sample_count,
+                 const ADPCM_Coeff& coeff, ADPCMState& state);
+
 }; // namespace AudioCore::Codec
@@ -0,0 +1,77 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "audio_core/audio_renderer.h"
+#include "audio_core/buffer.h"
+#include "audio_core/codec.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/// Number of sample frames rendered by each command list
+constexpr std::size_t MIX_BUFFER_SAMPLE_COUNT{512};
+
+/// Number of float mix buffers available to a command list, the stereo final mix
+constexpr std::size_t MIX_BUFFER_COUNT{2};
+
+enum class CommandType : u8 {
+    ClearMixBuffer,  ///< Zeroes a mix buffer
+    ResetVoice,      ///< Resets the playback state of a voice that is no longer in use
+    SetWaveIndex,    ///< Restarts a voice from the given wave buffer
+    DataSourceVoice, ///< Decodes a voice and mixes it into a pair of mix buffers
+    Effect,          ///< Applies an effect in place to the mix buffers
+    Aux,             ///< Sends the mix buffers to an aux effect and replaces them with its return
+    FinalMixOutput,  ///< Converts a pair of mix buffers into interleaved PCM16 output
+};
+
+struct Command {
+    CommandType type{};
+    u32 voice_index{};     ///< Voice the command operates on
+    u32 effect_index{};    ///< Effect the command operates on
+    u32 parameter_index{}; ///< Index of the voice or effect parameters in the command list
+    u32 wave_index{};      ///< Wave buffer to restart from, for SetWaveIndex
+    u32 mix_buffer{};      ///< First mix buffer written or read by the command
+    u32 aux_offset{};      ///< Offset of the aux return samples in the command list, for Aux
+    float volume{};        ///< Gain applied while mixing
+    bool is_reset{};       ///< Whether the effect state is to be reset before processing
+};
+
+/**
+ * Guest data a voice reads while being mixed. The contents of each wave buffer are copied by
+ * AudioRenderer once, when the guest submits the buffer, and shared by every list mixing it.
+ */
+struct VoiceSource {
+    std::array<std::shared_ptr<const std::vector<u8>>, 4> wave_buffers; ///< Wave buffer contents
+    Codec::ADPCM_Coeff adpcm_coeff{};                                    ///< ADPCM coefficients
+};
+
+/**
+ * Sequence of commands rendering one output buffer. Command lists are generated from the guest's
+ * renderer parameters by AudioRenderer and executed by AudioDSP on its own thread, so every guest
+ * parameter and every piece of guest memory a command needs is copied into the list. The DSP
+ * never accesses guest memory.
+ */
+struct CommandList {
+    Buffer::Tag tag{};                             ///< Tag of the stream buffer this list renders
+    u64 generation{};                              ///< Renderer update this list was generated from
+    std::vector<Command> commands;                 ///< Commands, executed in order
+    std::vector<VoiceInfo> voice_parameters;       ///< Parameters of the mixed voices
+    std::vector<VoiceSource> voice_sources;        ///< Guest data of the mixed voices
+    std::vector<EffectInStatus> effect_parameters; ///< Parameters of the applied effects
+    std::vector<s32> aux_samples;                  ///< Aux return ring samples, per channel
+};
+
+/// Returns the number of channels an aux effect exchanges with the guest
+inline std::size_t GetAuxChannelCount(const AuxInfo& params) {
+    return std::min<std::size_t>(params.mix_buffer_count, params.input_mix_buffers.size());
+}
+
+} // namespace AudioCore
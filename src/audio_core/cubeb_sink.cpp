@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <cstring>
 #include "audio_core/cubeb_sink.h"
+#include "audio_core/sink_timing.h"
 #include "audio_core/stream.h"
 #include "audio_core/time_stretch.h"
 #include "common/assert.h"
@@ -19,12 +21,16 @@
 
 namespace AudioCore {
 
+/// Smallest latency requested from cubeb in low latency mode, in frames
+constexpr u32 LOW_LATENCY_MIN_FRAMES{128};
+
 class CubebSinkStream final : public SinkStream {
 public:
     CubebSinkStream(cubeb* ctx, u32 sample_rate, u32 num_channels_, cubeb_devid output_device,
                     const std::string& name)
-        : ctx{ctx}, num_channels{std::min(num_channels_, 2u)}, time_stretch{sample_rate,
-                                                                            num_channels} {
+        : ctx{ctx}, num_channels{std::min(num_channels_, 2u)}, sample_rate{sample_rate},
+          is_low_latency{Settings::values.enable_low_latency_audio},
+          time_stretch{sample_rate, num_channels}, timing{sample_rate} {
 
         cubeb_stream_params params{};
         params.rate = sample_rate;
@@ -37,8 +43,12 @@ public:
             LOG_CRITICAL(Audio_Sink, "Error getting minimum latency");
         }
 
+        // In low latency mode the queue is sized from the measured callback timing instead
+        const u32 latency_frames{is_low_latency ? std::max(LOW_LATENCY_MIN_FRAMES, minimum_latency)
+                                                : std::max(512u, minimum_latency)};
+
         if (cubeb_stream_init(ctx, &stream_backend, name.c_str(), nullptr, nullptr, output_device,
-                              &params, std::max(512u, minimum_latency),
+                              &params, latency_frames,
                               &CubebSinkStream::DataCallback, &CubebSinkStream::StateCallback,
                               this) != CUBEB_OK) {
             LOG_CRITICAL(Audio_Sink, "Error initializing cubeb stream");
@@ -64,6 +74,8 @@ public:
     }
 
     void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples) override {
+        timing.RecordEnqueue(samples.size() / source_num_channels);
+
         if (source_num_channels > num_channels) {
             // Downsample 6 channels to 2
             ASSERT_MSG(source_num_channels == 6, "Channel count must be 6");
@@ -93,17 +105,38 @@ public:
         queue.Push(samples);
     }
 
-    std::size_t SamplesInQueue(u32 channel_count) const override {
+    std::size_t SamplesInQueue(u32 /*channel_count*/) const override {
         if (!ctx)
             return 0;
 
-        return queue.Size() / channel_count;
+        // Samples with more channels than the output are downmixed before being queued
+        return queue.Size() / num_channels;
     }
 
     void Flush() override {
         should_flush = true;
     }
 
+    std::size_t GetTargetQueueFrames() const override {
+        if (!ctx || !is_low_latency) {
+            return 0;
+        }
+        return timing.GetTargetQueueFrames();
+    }
+
+    std::chrono::microseconds GetLatency() const override {
+        if (!ctx || !stream_backend) {
+            return {};
+        }
+
+        u32 device_latency{};
+        if (cubeb_stream_get_latency(stream_backend, &device_latency) != CUBEB_OK) {
+            device_latency = 0;
+        }
+        const u64 frames{SamplesInQueue(num_channels) + device_latency};
+        return std::chrono::microseconds{frames * 1000000 / sample_rate};
+    }
+
     u32 GetNumChannels() const {
         return num_channels;
     }
@@ -114,11 +147,28 @@ private:
     cubeb* ctx{};
     cubeb_stream* stream_backend{};
     u32 num_channels{};
+    u32 sample_rate{};
+    bool is_low_latency{};
 
     Common::RingBuffer<s16, 0x10000> queue;
     std::array<s16, 2> last_frame{};
     std::atomic<bool> should_flush{};
     TimeStretcher time_stretch;
+    bool is_stretching{};
+    SinkTiming timing;
+
+    /// Returns whether the samples of the current callback should go through the time stretcher
+    bool ShouldStretch() const {
+        if (!Settings::values.enable_audio_stretching) {
+            return false;
+        }
+        if (!is_low_latency) {
+            return true;
+        }
+        // Only stretch once production is far enough off the output rate for it to be audible
+        const double threshold{Settings::values.audio_stretch_threshold / 100.0};
+        return std::abs(timing.GetProductionRatio() - 1.0) > threshold;
+    }
 
     static long DataCallback(cubeb_stream* stream, void* user_data, const void* input_buffer,
                              void* output_buffer, long num_frames);
@@ -189,11 +239,20 @@ long CubebSinkStream::DataCallback(cubeb_stream* stream, void* user_data, const
         return {};
     }
 
+    impl->timing.RecordCallback(static_cast<std::size_t>(num_frames));
+
     const std::size_t num_channels = impl->GetNumChannels();
     const std::size_t samples_to_write = num_channels * num_frames;
     std::size_t samples_written;
 
-    if (Settings::values.enable_audio_stretching) {
+    const bool should_stretch = impl->ShouldStretch();
+    if (impl->is_stretching && !should_stretch) {
+        // Drop the stretcher's backlog rather than letting it add latency later on
+        impl->time_stretch.Clear();
+    }
+    impl->is_stretching = should_stretch;
+
+    if (should_stretch) {
         const std::vector<s16> in{impl->queue.Pop()};
         const std::size_t num_in{in.size() / num_channels};
         s16* const out{reinterpret_cast<s16*>(buffer)};
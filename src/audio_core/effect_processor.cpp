@@ -0,0 +1,441 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "audio_core/algorithm/dsp_kernels.h"
+#include "audio_core/effect_processor.h"
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+
+MICROPROFILE_DEFINE(Audio_EffectBiquadFilter, "Audio", "Effect Biquad Filter",
+                    MP_RGB(128, 96, 224));
+MICROPROFILE_DEFINE(Audio_EffectDelay, "Audio", "Effect Delay", MP_RGB(96, 128, 224));
+MICROPROFILE_DEFINE(Audio_EffectReverb, "Audio", "Effect Reverb", MP_RGB(96, 192, 160));
+MICROPROFILE_DEFINE(Audio_EffectI3dl2Reverb, "Audio", "Effect I3DL2 Reverb", MP_RGB(96, 224, 128));
+
+namespace AudioCore {
+namespace {
+
+/// Sample rate of the mix buffers
+constexpr float MIX_SAMPLE_RATE{48000.0f};
+
+/// Maximum delay before the first reflection plus the start of the late reverb
+constexpr float MAX_REVERB_PRE_DELAY_MS{450.0f};
+
+/// Number of delay lines in the late reverb feedback delay network
+constexpr std::size_t FDN_LINE_COUNT{4};
+
+/// Lengths of the late reverb delay lines at 48kHz, mutually prime to avoid resonances
+constexpr std::array<std::size_t, FDN_LINE_COUNT> FDN_LINE_LENGTHS{1433, 1601, 1867, 2053};
+constexpr float MIN_FDN_LINE_SCALE{0.5f};
+constexpr float MAX_FDN_LINE_SCALE{2.0f};
+
+/// Orthogonal feedback matrix of the network, once scaled by 1/2
+constexpr std::array<std::array<float, FDN_LINE_COUNT>, FDN_LINE_COUNT> HADAMARD_MATRIX{{
+    {1.0f, 1.0f, 1.0f, 1.0f},
+    {1.0f, -1.0f, 1.0f, -1.0f},
+    {1.0f, 1.0f, -1.0f, -1.0f},
+    {1.0f, -1.0f, -1.0f, 1.0f},
+}};
+
+/// Early reflection pattern, times are in milliseconds relative to the first reflection
+constexpr std::array<float, 4> EARLY_TAP_TIMES{0.0f, 4.3f, 9.1f, 14.7f};
+constexpr std::array<float, 4> EARLY_TAP_GAINS{0.8f, 0.6f, 0.45f, 0.3f};
+/// Extra delay of the reflections on odd channels, decorrelates the stereo image
+constexpr float EARLY_ODD_CHANNEL_DELAY_MS{1.3f};
+
+/// Early reflection spacing of the guest's early modes: small room, large room, hall, cathedral
+/// and no early reflections
+constexpr std::array<float, 5> REVERB_EARLY_SPACINGS{1.0f, 1.5f, 2.0f, 3.0f, 0.0f};
+/// Delay line scale of the guest's late modes: room, hall, plate, cathedral and maximum delay
+constexpr std::array<float, 5> REVERB_LATE_SCALES{0.6f, 1.0f, 0.8f, 1.6f, 2.0f};
+
+constexpr float Q14ToFloat(s32 value) {
+    return static_cast<float>(value) / (1 << 14);
+}
+
+float MillibelsToGain(float millibels) {
+    return std::pow(10.0f, millibels / 2000.0f);
+}
+
+std::size_t MillisecondsToSamples(float milliseconds) {
+    return static_cast<std::size_t>(std::max(milliseconds, 0.0f) * MIX_SAMPLE_RATE / 1000.0f);
+}
+
+std::size_t ClampChannelCount(s32 channel_count) {
+    return static_cast<std::size_t>(
+        std::clamp<s32>(channel_count, 0, static_cast<s32>(EFFECT_MAX_CHANNELS)));
+}
+
+template <typename T, std::size_t N>
+T SelectMode(const std::array<T, N>& table, s32 mode) {
+    return table[std::clamp<s32>(mode, 0, static_cast<s32>(N) - 1)];
+}
+
+/// One-pole lowpass y[n] = (1 - damping) x[n] + damping y[n-1], expressed as a biquad
+DSP::BiquadCoefficients OnePoleLowPass(float damping) {
+    const float coefficient{std::clamp(damping, 0.0f, 0.95f)};
+    return {1.0f - coefficient, 0.0f, 0.0f, coefficient, 0.0f};
+}
+
+class BiquadFilterProcessor final : public EffectProcessor {
+public:
+    void Process(const EffectInStatus& info, MixBuffers& mix_buffers) override {
+        MICROPROFILE_SCOPE(Audio_EffectBiquadFilter);
+
+        const auto& params = info.biquad_info;
+        const std::size_t channel_count{ClampChannelCount(params.channel_count)};
+        const auto coeffs{DSP::BiquadCoefficientsFromQ14(params.numerator, params.denominator)};
+
+        GatherInputs(params.input, channel_count, mix_buffers);
+        std::size_t channel{};
+        for (; channel + 2 <= channel_count; channel += 2) {
+            DSP::BiquadFilterStereo(channels[channel].data(), channels[channel + 1].data(),
+                                    MIX_BUFFER_SAMPLE_COUNT, coeffs, states[channel],
+                                    states[channel + 1]);
+        }
+        for (; channel < channel_count; ++channel) {
+            DSP::BiquadFilter(channels[channel].data(), MIX_BUFFER_SAMPLE_COUNT, coeffs,
+                              states[channel]);
+        }
+        ScatterOutputs(params.output, channel_count, mix_buffers);
+    }
+
+private:
+    std::array<DSP::BiquadState, EFFECT_MAX_CHANNELS> states{};
+};
+
+class DelayProcessor final : public EffectProcessor {
+public:
+    void Process(const EffectInStatus& info, MixBuffers& mix_buffers) override {
+        MICROPROFILE_SCOPE(Audio_EffectDelay);
+
+        const auto& params = info.delay_info;
+        const std::size_t channel_count{ClampChannelCount(params.channel_count)};
+        const std::size_t max_delay{
+            std::max<std::size_t>(MillisecondsToSamples(static_cast<float>(params.max_delay)), 1)};
+        if (max_delay != line_max_delay) {
+            for (auto& line : lines) {
+                line.Resize(max_delay);
+            }
+            line_max_delay = max_delay;
+        }
+
+        const std::size_t delay{std::clamp<std::size_t>(
+            MillisecondsToSamples(static_cast<float>(params.delay)), 1, max_delay)};
+        const float in_gain{Q14ToFloat(params.in_gain)};
+        const float feedback_gain{Q14ToFloat(params.feedback_gain)};
+        const float spread{channel_count > 1 ? Q14ToFloat(params.channel_spread) : 0.0f};
+        const float direct_gain{feedback_gain * (1.0f - spread)};
+        // Split between both neighbouring channels
+        const float cross_gain{feedback_gain * spread * 0.5f};
+        const float out_gain{Q14ToFloat(params.out_gain)};
+        const float dry_gain{Q14ToFloat(params.dry_gain)};
+        const auto low_pass{OnePoleLowPass(Q14ToFloat(params.low_pass))};
+
+        GatherInputs(params.input, channel_count, mix_buffers);
+
+        // Blocks are never longer than the delay, so the taps of a block only read samples that
+        // were written by earlier blocks and can be processed by the vector kernels as a whole.
+        for (std::size_t offset = 0; offset < MIX_BUFFER_SAMPLE_COUNT;) {
+            const std::size_t count{std::min(delay, MIX_BUFFER_SAMPLE_COUNT - offset)};
+
+            for (std::size_t channel = 0; channel < channel_count; ++channel) {
+                float* const feedback = line_inputs[channel].data();
+                float* const samples = channels[channel].data() + offset;
+
+                std::fill_n(feedback, count, 0.0f);
+                DSP::MixAccumulate(feedback, samples, in_gain, count);
+                lines[channel].AccumulateTap(feedback, count, delay, direct_gain);
+                if (spread != 0.0f) {
+                    const std::size_t next{(channel + 1) % channel_count};
+                    const std::size_t previous{(channel + channel_count - 1) % channel_count};
+                    lines[next].AccumulateTap(feedback, count, delay, cross_gain);
+                    lines[previous].AccumulateTap(feedback, count, delay, cross_gain);
+                }
+
+                DSP::Scale(samples, dry_gain, count);
+                lines[channel].AccumulateTap(samples, count, delay, out_gain);
+            }
+
+            // Lines are only written once every channel has read its neighbours
+            for (std::size_t channel = 0; channel < channel_count; ++channel) {
+                DSP::BiquadFilter(line_inputs[channel].data(), count, low_pass,
+                                  low_pass_states[channel]);
+                lines[channel].Write(line_inputs[channel].data(), count);
+            }
+
+            offset += count;
+        }
+
+        ScatterOutputs(params.output, channel_count, mix_buffers);
+    }
+
+private:
+    std::size_t line_max_delay{};
+    std::array<DelayLine, EFFECT_MAX_CHANNELS> lines;
+    std::array<ChannelBuffer, EFFECT_MAX_CHANNELS> line_inputs{};
+    std::array<DSP::BiquadState, EFFECT_MAX_CHANNELS> low_pass_states{};
+};
+
+/// Parameters of the reverb model shared by the reverb and I3DL2 reverb effects
+struct ReverbParameters {
+    float input_gain;
+    float input_damping;     ///< Lowpass coefficient applied to the reverb input
+    std::size_t early_delay; ///< Samples before the first early reflection
+    float early_spacing;     ///< Scale of the early reflection pattern, zero disables them
+    float early_gain;
+    std::size_t late_delay; ///< Samples before the input reaches the late reverb
+    float line_scale;       ///< Scale of the late reverb delay line lengths
+    float decay_time;       ///< Seconds for the late reverb to decay by 60dB
+    float hf_decay_ratio;   ///< Decay time of high frequencies relative to decay_time
+    float late_gain;
+    float out_gain;
+    float dry_gain;
+};
+
+/**
+ * Reverb made of a tapped pre-delay line for the early reflections and a feedback delay network
+ * with Hadamard mixing and per-line high frequency damping for the late reverb. Every line of the
+ * network is longer than a mix buffer, so the network is processed a whole buffer at a time.
+ */
+class ReverbModel : public EffectProcessor {
+protected:
+    ReverbModel() {
+        pre_delay.Resize(MillisecondsToSamples(MAX_REVERB_PRE_DELAY_MS) + MIX_BUFFER_SAMPLE_COUNT);
+        for (std::size_t line = 0; line < FDN_LINE_COUNT; ++line) {
+            const auto max_length{FDN_LINE_LENGTHS[line] * MAX_FDN_LINE_SCALE};
+            lines[line].Resize(static_cast<std::size_t>(max_length));
+        }
+    }
+
+    /// Renders the reverb of the channel buffers in place
+    void Render(const ReverbParameters& params, std::size_t channel_count) {
+        constexpr std::size_t count{MIX_BUFFER_SAMPLE_COUNT};
+        if (channel_count == 0) {
+            return;
+        }
+
+        // The reverb is fed with the mono downmix of its inputs
+        input.fill(0.0f);
+        for (std::size_t channel = 0; channel < channel_count; ++channel) {
+            DSP::MixAccumulate(input.data(), channels[channel].data(),
+                               params.input_gain / static_cast<float>(channel_count), count);
+        }
+        DSP::BiquadFilter(input.data(), count, OnePoleLowPass(params.input_damping), input_state);
+        pre_delay.Write(input.data(), count);
+
+        // Taps are relative to the start of the block that was just written
+        const std::size_t max_pre_delay{MillisecondsToSamples(MAX_REVERB_PRE_DELAY_MS)};
+        for (std::size_t parity = 0; parity < std::min<std::size_t>(channel_count, 2); ++parity) {
+            early[parity].fill(0.0f);
+            if (params.early_spacing == 0.0f || params.early_gain == 0.0f) {
+                continue;
+            }
+            for (std::size_t tap = 0; tap < EARLY_TAP_TIMES.size(); ++tap) {
+                const float tap_time{EARLY_TAP_TIMES[tap] * params.early_spacing +
+                                     EARLY_ODD_CHANNEL_DELAY_MS * static_cast<float>(parity)};
+                const std::size_t delay{
+                    std::min(params.early_delay + MillisecondsToSamples(tap_time), max_pre_delay)};
+                pre_delay.AccumulateTap(early[parity].data(), count, delay + count,
+                                        params.early_gain * EARLY_TAP_GAINS[tap]);
+            }
+        }
+
+        late_input.fill(0.0f);
+        pre_delay.AccumulateTap(late_input.data(), count,
+                                std::min(params.late_delay, max_pre_delay) + count, 1.0f);
+
+        // Read the output of every line, then feed the network back through the mixing matrix
+        const float decay_time{std::max(params.decay_time, 0.1f)};
+        const auto damping{OnePoleLowPass(1.0f - params.hf_decay_ratio)};
+        const float line_scale{
+            std::clamp(params.line_scale, MIN_FDN_LINE_SCALE, MAX_FDN_LINE_SCALE)};
+        std::array<std::size_t, FDN_LINE_COUNT> lengths;
+        std::array<float, FDN_LINE_COUNT> decay_gains;
+        for (std::size_t line = 0; line < FDN_LINE_COUNT; ++line) {
+            lengths[line] = std::max(
+                static_cast<std::size_t>(FDN_LINE_LENGTHS[line] * line_scale), count);
+            // -60dB after decay_time seconds
+            decay_gains[line] = std::pow(
+                10.0f, -3.0f * static_cast<float>(lengths[line]) / (decay_time * MIX_SAMPLE_RATE));
+
+            line_outputs[line].fill(0.0f);
+            lines[line].AccumulateTap(line_outputs[line].data(), count, lengths[line], 1.0f);
+            DSP::BiquadFilter(line_outputs[line].data(), count, damping, damping_states[line]);
+        }
+        for (std::size_t line = 0; line < FDN_LINE_COUNT; ++line) {
+            feedback = late_input;
+            for (std::size_t source = 0; source < FDN_LINE_COUNT; ++source) {
+                DSP::MixAccumulate(feedback.data(), line_outputs[source].data(),
+                                   0.5f * HADAMARD_MATRIX[line][source] * decay_gains[source],
+                                   count);
+            }
+            lines[line].Write(feedback.data(), count);
+        }
+
+        // Even and odd channels take different lines of the network
+        const float late_gain{params.out_gain * params.late_gain * 0.5f};
+        for (std::size_t channel = 0; channel < channel_count; ++channel) {
+            const std::size_t parity{channel % 2};
+            float* const samples = channels[channel].data();
+            DSP::Scale(samples, params.dry_gain, count);
+            DSP::MixAccumulate(samples, early[parity].data(), params.out_gain, count);
+            DSP::MixAccumulate(samples, line_outputs[parity].data(), late_gain, count);
+            DSP::MixAccumulate(samples, line_outputs[parity + 2].data(),
+                               parity == 0 ? late_gain : -late_gain, count);
+        }
+    }
+
+private:
+    DelayLine pre_delay;
+    std::array<DelayLine, FDN_LINE_COUNT> lines;
+    DSP::BiquadState input_state{};
+    std::array<DSP::BiquadState, FDN_LINE_COUNT> damping_states{};
+
+    ChannelBuffer input{};
+    ChannelBuffer late_input{};
+    ChannelBuffer feedback{};
+    std::array<ChannelBuffer, 2> early{};
+    std::array<ChannelBuffer, FDN_LINE_COUNT> line_outputs{};
+};
+
+class ReverbProcessor final : public ReverbModel {
+public:
+    void Process(const EffectInStatus& info, MixBuffers& mix_buffers) override {
+        MICROPROFILE_SCOPE(Audio_EffectReverb);
+
+        const auto& info_params = info.reverb_info;
+        const std::size_t channel_count{ClampChannelCount(info_params.channel_count)};
+        const float pre_delay{std::clamp(Q14ToFloat(info_params.pre_delay), 0.0f, 300.0f)};
+        const float early_spacing{SelectMode(REVERB_EARLY_SPACINGS, info_params.early_mode)};
+
+        ReverbParameters params{};
+        params.input_gain = Q14ToFloat(info_params.reverb_gain);
+        params.early_delay = MillisecondsToSamples(pre_delay);
+        params.early_spacing = early_spacing;
+        params.early_gain = Q14ToFloat(info_params.early_gain);
+        params.late_delay =
+            MillisecondsToSamples(pre_delay + EARLY_TAP_TIMES.back() * early_spacing);
+        params.line_scale = SelectMode(REVERB_LATE_SCALES, info_params.late_mode);
+        params.decay_time = Q14ToFloat(info_params.decay_time);
+        params.hf_decay_ratio = Q14ToFloat(info_params.hf_decay_ratio);
+        params.late_gain = Q14ToFloat(info_params.late_gain);
+        params.out_gain = Q14ToFloat(info_params.out_gain);
+        params.dry_gain = Q14ToFloat(info_params.dry_gain);
+
+        GatherInputs(info_params.input, channel_count, mix_buffers);
+        Render(params, channel_count);
+        ScatterOutputs(info_params.output, channel_count, mix_buffers);
+    }
+};
+
+class I3dl2ReverbProcessor final : public ReverbModel {
+public:
+    void Process(const EffectInStatus& info, MixBuffers& mix_buffers) override {
+        MICROPROFILE_SCOPE(Audio_EffectI3dl2Reverb);
+
+        const auto& info_params = info.i3dl2_reverb_info;
+        const std::size_t channel_count{ClampChannelCount(info_params.channel_count)};
+        const float reflection_delay{std::clamp<float>(info_params.reflection_delay, 0.0f, 0.3f)};
+        const float reverb_delay{std::clamp<float>(info_params.reverb_delay, 0.0f, 0.1f)};
+        const float diffusion{std::clamp<float>(info_params.diffusion, 0.0f, 100.0f) / 100.0f};
+        const float density{std::clamp<float>(info_params.density, 0.0f, 100.0f) / 100.0f};
+
+        // The high frequency reference is not modelled, room_hf sets the input lowpass directly
+        ReverbParameters params{};
+        params.input_gain = MillibelsToGain(info_params.room);
+        params.input_damping = 1.0f - MillibelsToGain(info_params.room_hf);
+        params.early_delay = MillisecondsToSamples(reflection_delay * 1000.0f);
+        params.early_spacing = 0.5f + diffusion;
+        params.early_gain = MillibelsToGain(info_params.reflection);
+        params.late_delay = MillisecondsToSamples((reflection_delay + reverb_delay) * 1000.0f);
+        params.line_scale = MIN_FDN_LINE_SCALE + 1.5f * density;
+        params.decay_time = info_params.decay_time;
+        params.hf_decay_ratio = info_params.hf_decay_ratio;
+        params.late_gain = MillibelsToGain(info_params.reverb);
+        params.out_gain = 1.0f;
+        params.dry_gain = info_params.dry_gain;
+
+        GatherInputs(info_params.input, channel_count, mix_buffers);
+        Render(params, channel_count);
+        ScatterOutputs(info_params.output, channel_count, mix_buffers);
+    }
+};
+
+} // Anonymous namespace
+
+void DelayLine::Resize(std::size_t max_delay) {
+    // Leaves room for a whole block to be tapped after it has been written
+    buffer.assign(max_delay + MIX_BUFFER_SAMPLE_COUNT, 0.0f);
+    position = 0;
+}
+
+void DelayLine::Write(const float* samples, std::size_t count) {
+    ASSERT(count <= buffer.size());
+    const std::size_t first{std::min(count, buffer.size() - position)};
+    std::memcpy(buffer.data() + position, samples, first * sizeof(float));
+    std::memcpy(buffer.data(), samples + first, (count - first) * sizeof(float));
+    position = (position + count) % buffer.size();
+}
+
+void DelayLine::AccumulateTap(float* out, std::size_t count, std::size_t delay,
+                              float gain) const {
+    ASSERT(delay <= buffer.size() && count <= buffer.size());
+    const std::size_t start{(position + buffer.size() - delay) % buffer.size()};
+    const std::size_t first{std::min(count, buffer.size() - start)};
+    DSP::MixAccumulate(out, buffer.data() + start, gain, first);
+    DSP::MixAccumulate(out + first, buffer.data(), gain, count - first);
+}
+
+EffectProcessor::~EffectProcessor() = default;
+
+std::unique_ptr<EffectProcessor> EffectProcessor::Create(Effect type) {
+    switch (type) {
+    case Effect::Delay:
+        return std::make_unique<DelayProcessor>();
+    case Effect::Reverb:
+        return std::make_unique<ReverbProcessor>();
+    case Effect::I3dl2Reverb:
+        return std::make_unique<I3dl2ReverbProcessor>();
+    case Effect::BiquadFilter:
+        return std::make_unique<BiquadFilterProcessor>();
+    case Effect::None:
+        return nullptr;
+    default:
+        LOG_WARNING(Audio, "Unimplemented effect type {}", static_cast<u32>(type));
+        return nullptr;
+    }
+}
+
+void EffectProcessor::GatherInputs(const std::array<s8, EFFECT_MAX_CHANNELS>& input,
+                                   std::size_t channel_count, const MixBuffers& mix_buffers) {
+    for (std::size_t channel = 0; channel < channel_count; ++channel) {
+        const s8 index{input[channel]};
+        if (index >= 0 && static_cast<std::size_t>(index) < MIX_BUFFER_COUNT) {
+            std::copy_n(mix_buffers[index].begin(), MIX_BUFFER_SAMPLE_COUNT,
+                        channels[channel].begin());
+        } else {
+            channels[channel].fill(0.0f);
+        }
+    }
+}
+
+void EffectProcessor::ScatterOutputs(const std::array<s8, EFFECT_MAX_CHANNELS>& output,
+                                     std::size_t channel_count, MixBuffers& mix_buffers) const {
+    for (std::size_t channel = 0; channel < channel_count; ++channel) {
+        const s8 index{output[channel]};
+        if (index >= 0 && static_cast<std::size_t>(index) < MIX_BUFFER_COUNT) {
+            std::copy(channels[channel].begin(), channels[channel].end(),
+                      mix_buffers[index].begin());
+        }
+    }
+}
+
+} // namespace AudioCore
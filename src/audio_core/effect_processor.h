@@ -0,0 +1,74 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "audio_core/audio_renderer.h"
+#include "audio_core/command_list.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+using MixBuffers = std::array<std::vector<float>, MIX_BUFFER_COUNT>;
+
+/**
+ * Ring buffer of float samples that is written and tapped a block at a time, so every access is
+ * at most two contiguous runs that the vector kernels can work on.
+ */
+class DelayLine {
+public:
+    /// Resizes and clears the line so it can be tapped up to max_delay samples back
+    void Resize(std::size_t max_delay);
+
+    /// Appends count samples to the line
+    void Write(const float* samples, std::size_t count);
+
+    /**
+     * Accumulates gain times count samples starting delay samples before the write position into
+     * out. The delay must be at least count when tapping samples that have not been written yet.
+     */
+    void AccumulateTap(float* out, std::size_t count, std::size_t delay, float gain) const;
+
+private:
+    std::vector<float> buffer;
+    std::size_t position{};
+};
+
+/**
+ * Host implementation of a renderer effect. Processors keep the state of the effect between
+ * command lists and are recreated by AudioDSP whenever the guest resets the effect.
+ */
+class EffectProcessor {
+public:
+    virtual ~EffectProcessor();
+
+    /// Applies the effect in place to the mix buffers
+    virtual void Process(const EffectInStatus& info, MixBuffers& mix_buffers) = 0;
+
+    /// Creates a processor for the effect type, nullptr if the type is not supported. Aux effects
+    /// have no processor, AudioDSP exchanges their samples itself.
+    static std::unique_ptr<EffectProcessor> Create(Effect type);
+
+protected:
+    using ChannelBuffer = std::array<float, MIX_BUFFER_SAMPLE_COUNT>;
+
+    /**
+     * Copies the input mix buffers of the effect into the channel buffers, inputs outside of the
+     * rendered mix buffers read as silence.
+     */
+    void GatherInputs(const std::array<s8, EFFECT_MAX_CHANNELS>& input, std::size_t channel_count,
+                      const MixBuffers& mix_buffers);
+
+    /// Copies the channel buffers into the output mix buffers of the effect
+    void ScatterOutputs(const std::array<s8, EFFECT_MAX_CHANNELS>& output,
+                        std::size_t channel_count, MixBuffers& mix_buffers) const;
+
+    std::array<ChannelBuffer, EFFECT_MAX_CHANNELS> channels{};
+};
+
+} // namespace AudioCore
@@ -27,6 +27,14 @@ private:
         }
 
         void Flush() override {}
+
+        std::size_t GetTargetQueueFrames() const override {
+            return 0;
+        }
+
+        std::chrono::microseconds GetLatency() const override {
+            return {};
+        }
     } null_sink_stream;
 };
 
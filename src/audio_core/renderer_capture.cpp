@@ -0,0 +1,139 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "audio_core/renderer_capture.h"
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
+#include "core/memory.h"
+
+namespace AudioCore {
+
+namespace {
+
+constexpr u32 CAPTURE_MAGIC{Common::MakeMagic('Y', 'A', 'R', 'C')};
+constexpr u32 CAPTURE_VERSION{1};
+
+/// Ranges larger than this are not worth recording, they are not wave buffers
+constexpr u64 MAX_RECORDED_RANGE_SIZE{64 * 1024 * 1024};
+
+struct CaptureHeader {
+    u32_le magic;
+    u32_le version;
+    AudioRendererParameter params;
+};
+static_assert(sizeof(CaptureHeader) == 0x3c, "CaptureHeader is an invalid size");
+
+struct CaptureRecordHeader {
+    CaptureRecordType type;
+    INSERT_PADDING_WORDS(1);
+    u64_le address_or_ticks;
+    u64_le size;
+};
+static_assert(sizeof(CaptureRecordHeader) == 0x18, "CaptureRecordHeader is an invalid size");
+
+} // Anonymous namespace
+
+RendererCaptureWriter::RendererCaptureWriter(const std::string& path,
+                                             const AudioRendererParameter& params)
+    : file{path, "wb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(Audio, "Failed to create audio renderer capture {}", path);
+        return;
+    }
+
+    const CaptureHeader header{CAPTURE_MAGIC, CAPTURE_VERSION, params};
+    file.WriteObject(header);
+    LOG_INFO(Audio, "Recording audio renderer updates to {}", path);
+}
+
+void RendererCaptureWriter::RecordMemory(Memory::Memory& memory, VAddr address, u64 size) {
+    if (!IsOpen() || address == 0 || size == 0) {
+        return;
+    }
+    if (size > MAX_RECORDED_RANGE_SIZE) {
+        LOG_WARNING(Audio, "Not recording {} bytes at {:016X}", size, address);
+        return;
+    }
+
+    const u8* data = memory.GetContiguousPointer(address, size);
+    if (data == nullptr) {
+        scratch.resize(size);
+        memory.ReadBlock(address, scratch.data(), size);
+        data = scratch.data();
+    }
+
+    // Wave buffers are usually static or streamed, so most updates record nothing new
+    const u64 hash{Common::CityHash64(reinterpret_cast<const char*>(data), size)};
+    auto& hashes = recorded_hashes[address];
+    const auto iter = hashes.find(size);
+    if (iter != hashes.end() && iter->second == hash) {
+        return;
+    }
+    hashes.insert_or_assign(size, hash);
+
+    WriteRecord(CaptureRecordType::Memory, address, data, size);
+}
+
+void RendererCaptureWriter::RecordUpdate(u64 ticks, const std::vector<u8>& input_params) {
+    if (!IsOpen()) {
+        return;
+    }
+    WriteRecord(CaptureRecordType::Update, ticks, input_params.data(), input_params.size());
+}
+
+void RendererCaptureWriter::WriteRecord(CaptureRecordType type, u64 address_or_ticks,
+                                        const u8* data, u64 size) {
+    CaptureRecordHeader header{};
+    header.type = type;
+    header.address_or_ticks = address_or_ticks;
+    header.size = size;
+    file.WriteObject(header);
+    file.WriteBytes(data, size);
+}
+
+RendererCaptureReader::RendererCaptureReader(const std::string& path) : file{path, "rb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(Audio, "Failed to open audio renderer capture {}", path);
+        return;
+    }
+
+    CaptureHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != CAPTURE_MAGIC) {
+        LOG_ERROR(Audio, "{} is not an audio renderer capture", path);
+        return;
+    }
+    if (header.version != CAPTURE_VERSION) {
+        LOG_ERROR(Audio, "Unsupported audio renderer capture version {}", header.version);
+        return;
+    }
+
+    params = header.params;
+    is_valid = true;
+}
+
+bool RendererCaptureReader::ReadRecord(CaptureRecord& record) {
+    if (!is_valid) {
+        return false;
+    }
+
+    CaptureRecordHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    if (header.size > MAX_RECORDED_RANGE_SIZE) {
+        LOG_ERROR(Audio, "Audio renderer capture record is too large, {} bytes", header.size);
+        return false;
+    }
+
+    record.type = header.type;
+    record.address = header.type == CaptureRecordType::Memory ? header.address_or_ticks : 0;
+    record.ticks = header.type == CaptureRecordType::Update ? header.address_or_ticks : 0;
+    record.data.resize(header.size);
+    return file.ReadBytes(record.data.data(), record.data.size()) == record.data.size();
+}
+
+} // namespace AudioCore
@@ -0,0 +1,86 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "audio_core/audio_renderer.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+
+namespace Memory {
+class Memory;
+}
+
+namespace AudioCore {
+
+/**
+ * A renderer capture is a header holding the parameters the renderer was opened with, followed by
+ * a stream of records. Memory records hold guest memory referenced by the voices, such as wave
+ * buffers, and precede the update record that first references them. Update records hold the
+ * input parameters of an UpdateAudioRenderer call and the CoreTiming ticks at which it was made.
+ */
+enum class CaptureRecordType : u32 {
+    Memory = 0,
+    Update = 1,
+};
+
+struct CaptureRecord {
+    CaptureRecordType type{};
+    u64 address{}; ///< Guest address of a memory record
+    u64 ticks{};   ///< CoreTiming ticks of an update record
+    std::vector<u8> data;
+};
+
+/// Records the updates made to a renderer, so they can be replayed offline by the audio harness
+class RendererCaptureWriter {
+public:
+    RendererCaptureWriter(const std::string& path, const AudioRendererParameter& params);
+
+    bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /// Records a range of guest memory, unless it is unchanged since it was last recorded
+    void RecordMemory(Memory::Memory& memory, VAddr address, u64 size);
+
+    /// Records the input parameters of an update
+    void RecordUpdate(u64 ticks, const std::vector<u8>& input_params);
+
+private:
+    void WriteRecord(CaptureRecordType type, u64 address_or_ticks, const u8* data, u64 size);
+
+    FileUtil::IOFile file;
+    std::vector<u8> scratch;
+    /// Hash of the last recorded contents of every recorded range, keyed by address and size
+    std::unordered_map<u64, std::unordered_map<u64, u64>> recorded_hashes;
+};
+
+/// Reads back a capture made by RendererCaptureWriter
+class RendererCaptureReader {
+public:
+    explicit RendererCaptureReader(const std::string& path);
+
+    /// Returns true if the capture was opened and its header is valid
+    bool IsValid() const {
+        return is_valid;
+    }
+
+    const AudioRendererParameter& GetParameters() const {
+        return params;
+    }
+
+    /// Reads the next record, returns false at the end of the capture or if it is truncated
+    bool ReadRecord(CaptureRecord& record);
+
+private:
+    FileUtil::IOFile file;
+    AudioRendererParameter params{};
+    bool is_valid{};
+};
+
+} // namespace AudioCore
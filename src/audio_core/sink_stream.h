@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -29,6 +30,16 @@ public:
     virtual std::size_t SamplesInQueue(u32 num_channels) const = 0;
 
     virtual void Flush() = 0;
+
+    /**
+     * Gets the number of frames the sink needs queued to play without underruns, measured from
+     * the timing of its output.
+     * @returns The number of frames, or zero if the sink does not measure it.
+     */
+    virtual std::size_t GetTargetQueueFrames() const = 0;
+
+    /// Gets the time until samples enqueued now are heard, including the output device latency
+    virtual std::chrono::microseconds GetLatency() const = 0;
 };
 
 using SinkStreamPtr = std::unique_ptr<SinkStream>;
@@ -0,0 +1,72 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+
+#include "audio_core/sink_timing.h"
+
+namespace AudioCore {
+
+/// Decay of the peaks applied on every callback, forgets a spike after a few seconds
+constexpr double PEAK_DECAY{0.998};
+
+/// Multiple of the peak jitter kept queued on top of the largest callback
+constexpr double JITTER_MARGIN{2.0};
+
+/// Length of the window over which the production rate is measured, in seconds
+constexpr double PRODUCTION_WINDOW{0.25};
+
+/// Weight given to the newest production rate measurement
+constexpr double PRODUCTION_SMOOTHING{0.5};
+
+SinkTiming::SinkTiming(u32 sample_rate_)
+    : sample_rate{sample_rate_}, target_queue_frames{sample_rate_ / 50} {}
+
+void SinkTiming::RecordCallback(std::size_t num_frames) {
+    const auto now = Clock::now();
+
+    if (last_callback != Clock::time_point{}) {
+        // Each callback should come once the frames requested by the previous one have played
+        const double interval_frames{std::chrono::duration<double>(now - last_callback).count() *
+                                     sample_rate};
+        const double jitter{std::abs(interval_frames - static_cast<double>(last_callback_frames))};
+        peak_jitter_frames = std::max(jitter, peak_jitter_frames * PEAK_DECAY);
+    }
+    peak_callback_frames =
+        std::max(static_cast<double>(num_frames), peak_callback_frames * PEAK_DECAY);
+    last_callback = now;
+    last_callback_frames = num_frames;
+
+    // Keep at least 2ms of headroom and never more than 200ms
+    const double min_frames{sample_rate / 500.0};
+    const double max_frames{sample_rate / 5.0};
+    const double target{peak_callback_frames + peak_jitter_frames * JITTER_MARGIN + min_frames};
+    target_queue_frames.store(static_cast<std::size_t>(std::min(target, max_frames)),
+                              std::memory_order_relaxed);
+}
+
+void SinkTiming::RecordEnqueue(std::size_t num_frames) {
+    const auto now = Clock::now();
+
+    if (window_start == Clock::time_point{}) {
+        window_start = now;
+        return;
+    }
+
+    window_frames += num_frames;
+    const double elapsed{std::chrono::duration<double>(now - window_start).count()};
+    if (elapsed < PRODUCTION_WINDOW) {
+        return;
+    }
+
+    const double ratio{static_cast<double>(window_frames) / (elapsed * sample_rate)};
+    const double previous{production_ratio.load(std::memory_order_relaxed)};
+    production_ratio.store(previous + PRODUCTION_SMOOTHING * (ratio - previous),
+                           std::memory_order_relaxed);
+    window_start = now;
+    window_frames = 0;
+}
+
+} // namespace AudioCore
@@ -0,0 +1,62 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/**
+ * Measures when a sink stream's callbacks run and how fast samples are queued to it. This is used
+ * to size the sink's queue from the observed callback jitter instead of a fixed amount, and to
+ * tell whether emulation is producing samples fast enough to need time stretching.
+ *
+ * RecordCallback is called from the sink's thread and RecordEnqueue from the emulation thread,
+ * the getters may be called from any thread.
+ */
+class SinkTiming {
+public:
+    explicit SinkTiming(u32 sample_rate);
+
+    /// Records a sink callback requesting num_frames frames
+    void RecordCallback(std::size_t num_frames);
+
+    /// Records num_frames frames being queued to the sink
+    void RecordEnqueue(std::size_t num_frames);
+
+    /// Returns the number of frames to keep queued so that callbacks are not starved by jitter
+    std::size_t GetTargetQueueFrames() const {
+        return target_queue_frames.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the rate frames are queued at relative to the rate the sink consumes them
+    double GetProductionRatio() const {
+        return production_ratio.load(std::memory_order_relaxed);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    u32 sample_rate;
+
+    // Sink thread state
+    Clock::time_point last_callback{};
+    std::size_t last_callback_frames{};
+    double peak_jitter_frames{};
+    double peak_callback_frames{};
+
+    // Emulation thread state
+    Clock::time_point window_start{};
+    std::size_t window_frames{};
+
+    std::atomic<std::size_t> target_queue_frames;
+    std::atomic<double> production_ratio{1.0};
+};
+
+} // namespace AudioCore
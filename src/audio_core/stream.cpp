@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include "audio_core/algorithm/dsp_kernels.h"
 #include "audio_core/sink.h"
 #include "audio_core/sink_details.h"
 #include "audio_core/sink_stream.h"
@@ -20,6 +21,7 @@
 namespace AudioCore {
 
 constexpr std::size_t MaxAudioBufferCount{32};
+constexpr u64 MinSinkPollUs{500};
 
 u32 Stream::GetNumChannels() const {
     switch (format) {
@@ -40,7 +42,7 @@ Stream::Stream(Core::Timing::CoreTiming& core_timing, u32 sample_rate, Format fo
       sink_stream{sink_stream}, core_timing{core_timing}, name{std::move(name_)} {
 
     release_event = Core::Timing::CreateEvent(
-        name, [this](u64 userdata, s64 cycles_late) { ReleaseActiveBuffer(); });
+        name, [this](u64 userdata, s64 cycles_late) { OnReleaseEvent(); });
 }
 
 void Stream::Play() {
@@ -71,6 +73,24 @@ s64 Stream::GetBufferReleaseCycles(const Buffer& buffer) const {
     return Core::Timing::usToCycles(us);
 }
 
+bool Stream::IsSinkPaced() const {
+    // Sinks only report a target queue size in low latency mode
+    return sink_stream.GetTargetQueueFrames() != 0;
+}
+
+s64 Stream::GetSinkDrainCycles() const {
+    const std::size_t target{sink_stream.GetTargetQueueFrames()};
+    const std::size_t queued{sink_stream.SamplesInQueue(GetNumChannels())};
+    if (queued <= target) {
+        return 0;
+    }
+
+    // Poll no more often than every half millisecond while waiting for the sink
+    const u64 excess_us{(static_cast<u64>(queued - target) * 1000000) / sample_rate};
+    return Core::Timing::usToCycles(
+        std::chrono::microseconds(std::max<u64>(excess_us, MinSinkPollUs)));
+}
+
 static void VolumeAdjustSamples(std::vector<s16>& samples, float game_volume) {
     const float volume{std::clamp(Settings::values.volume - (1.0f - game_volume), 0.0f, 1.0f)};
 
@@ -80,9 +100,7 @@ static void VolumeAdjustSamples(std::vector<s16>& samples, float game_volume) {
 
     // Implementation of a volume slider with a dynamic range of 60 dB
     const float volume_scale_factor = volume == 0 ? 0 : std::exp(6.90775f * volume) * 0.001f;
-    for (auto& sample : samples) {
-        sample = static_cast<s16>(sample * volume_scale_factor);
-    }
+    DSP::ApplyVolumeS16(samples.data(), volume_scale_factor, samples.size());
 }
 
 void Stream::PlayNextBuffer() {
@@ -110,7 +128,21 @@ void Stream::PlayNextBuffer() {
 
     sink_stream.EnqueueSamples(GetNumChannels(), active_buffer->GetSamples());
 
-    core_timing.ScheduleEvent(GetBufferReleaseCycles(*active_buffer), release_event, {});
+    const s64 release_cycles{IsSinkPaced() ? GetSinkDrainCycles()
+                                           : GetBufferReleaseCycles(*active_buffer)};
+    core_timing.ScheduleEvent(release_cycles, release_event, {});
+}
+
+void Stream::OnReleaseEvent() {
+    if (IsSinkPaced()) {
+        if (const s64 cycles = GetSinkDrainCycles(); cycles != 0) {
+            // The sink still has more than it needs queued, wait for it to consume more
+            core_timing.ScheduleEvent(cycles, release_event, {});
+            return;
+        }
+        Core::System::GetInstance().GetPerfStats().AddAudioLatency(sink_stream.GetLatency());
+    }
+    ReleaseActiveBuffer();
 }
 
 void Stream::ReleaseActiveBuffer() {
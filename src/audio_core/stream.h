@@ -95,9 +95,18 @@ private:
     /// Releases the actively playing buffer, signalling that it has been completed
     void ReleaseActiveBuffer();
 
+    /// Releases the active buffer once the sink has consumed enough of its queue, if sink paced
+    void OnReleaseEvent();
+
     /// Gets the number of core cycles when the specified buffer will be released
     s64 GetBufferReleaseCycles(const Buffer& buffer) const;
 
+    /// Returns whether buffers are released as the sink consumes them, in low latency mode
+    bool IsSinkPaced() const;
+
+    /// Gets the number of core cycles until the sink queue drains to its target size
+    s64 GetSinkDrainCycles() const;
+
     u32 sample_rate;                  ///< Sample rate of the stream
     Format format;                    ///< Format of the stream
     float game_volume = 1.0f;         ///< The volume the game currently has set
@@ -0,0 +1,175 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include "audio_core/algorithm/dsp_kernels.h"
+#include "audio_core/voice_context.h"
+#include "common/assert.h"
+#include "common/logging/log.h"
+
+namespace AudioCore {
+
+constexpr u32 STREAM_SAMPLE_RATE{48000};
+constexpr u32 STREAM_NUM_CHANNELS{2};
+
+void VoiceContext::Reset() {
+    is_refresh_pending = true;
+    wave_index = 0;
+    out_status = {};
+}
+
+void VoiceContext::SetWaveIndex(std::size_t index) {
+    wave_index = index & 3;
+    is_refresh_pending = true;
+}
+
+std::size_t VoiceContext::DequeueSamples(const VoiceInfo& info, std::size_t frame_count,
+                                         const VoiceSource& source, const s16*& out) {
+    // A sample rate of zero is nonsensical, play such voices as-is rather than resampling
+    const bool is_resampled{info.sample_rate != STREAM_SAMPLE_RATE && info.sample_rate != 0};
+    const double ratio{static_cast<double>(info.sample_rate) / STREAM_SAMPLE_RATE};
+    frame_count = std::min(frame_count, MIX_BUFFER_SAMPLE_COUNT);
+
+    std::size_t produced{};
+    while (produced < frame_count && !is_paused) {
+        if (is_refresh_pending) {
+            StartWaveBuffer(info, source);
+        }
+
+        if (!is_resampled && decoded_count != 0) {
+            // Hand out the decoded frames directly, they may point straight into a wave buffer
+            const std::size_t count{std::min(decoded_count, frame_count)};
+            out = decoded;
+            decoded += count * STREAM_NUM_CHANNELS;
+            decoded_count -= count;
+            out_status.played_sample_count += count;
+            return count;
+        }
+
+        if (is_resampled) {
+            const auto result = Interpolate(
+                interp_state, decoded, decoded_count,
+                resample_buffer.data() + produced * STREAM_NUM_CHANNELS, frame_count - produced,
+                ratio);
+            decoded += result.consumed_frames * STREAM_NUM_CHANNELS;
+            decoded_count -= result.consumed_frames;
+            produced += result.produced_frames;
+            if (produced == frame_count) {
+                break;
+            }
+        }
+
+        if (!DecodeNextChunk(info, source)) {
+            const bool was_empty{source_offset == 0};
+            FinishWaveBuffer(info);
+            if (was_empty) {
+                // Nothing could be decoded from the wave buffer, avoid spinning on it
+                break;
+            }
+        }
+    }
+
+    out = resample_buffer.data();
+    out_status.played_sample_count += produced;
+    return produced;
+}
+
+void VoiceContext::StartWaveBuffer(const VoiceInfo& info, const VoiceSource& source) {
+    adpcm_coeff = source.adpcm_coeff;
+    source_offset = 0;
+    decoded_count = 0;
+    is_refresh_pending = false;
+}
+
+void VoiceContext::FinishWaveBuffer(const VoiceInfo& info) {
+    const auto& wave_buffer{info.wave_buffer[wave_index]};
+
+    if (!wave_buffer.is_looping && wave_buffer.buffer_sz) {
+        SetWaveIndex(wave_index + 1);
+    } else {
+        // Looping buffers start over
+        is_refresh_pending = true;
+    }
+
+    if (wave_buffer.buffer_sz) {
+        out_status.wave_buffer_consumed++;
+    }
+
+    if (wave_buffer.end_of_stream || wave_buffer.buffer_sz == 0) {
+        is_paused = true;
+    }
+}
+
+bool VoiceContext::DecodeNextChunk(const VoiceInfo& info, const VoiceSource& source) {
+    const auto& wave_data{source.wave_buffers[wave_index]};
+    const std::size_t channel_count{info.channel_count};
+    if (channel_count != 1 && channel_count != 2) {
+        UNIMPLEMENTED_MSG("Unimplemented channel_count={}", info.channel_count);
+        return false;
+    }
+    if (!wave_data) {
+        return false;
+    }
+
+    // Mono samples are decoded to mono_buffer, or read in place, and upmixed afterwards
+    s16* const samples = channel_count == 1 ? mono_buffer.data() : decode_buffer.data();
+    const s16* mono_samples = mono_buffer.data();
+    std::size_t frames{};
+
+    switch (static_cast<Codec::PcmFormat>(info.sample_format)) {
+    case Codec::PcmFormat::Int16: {
+        const std::size_t total_frames{wave_data->size() / (sizeof(s16) * channel_count)};
+        frames = std::min(total_frames - std::min(source_offset, total_frames), DECODE_FRAME_COUNT);
+        if (frames == 0) {
+            return false;
+        }
+
+        // PCM16 is played as-is
+        const auto* const pcm = reinterpret_cast<const s16*>(wave_data->data()) +
+                                source_offset * channel_count;
+        if (channel_count == 2) {
+            decoded = pcm;
+            decoded_count = frames;
+            source_offset += frames;
+            return true;
+        }
+        mono_samples = pcm;
+        break;
+    }
+    case Codec::PcmFormat::Adpcm: {
+        const std::size_t total_samples{(wave_data->size() / Codec::ADPCM_FRAME_SIZE) *
+                                        Codec::ADPCM_SAMPLES_PER_FRAME};
+        const std::size_t total_frames{total_samples / channel_count};
+        frames = std::min(total_frames - std::min(source_offset, total_frames), DECODE_FRAME_COUNT);
+        if (frames == 0) {
+            return false;
+        }
+
+        // Only the ADPCM frames covering this chunk are decoded
+        const std::size_t first_sample{source_offset * channel_count};
+        const std::size_t sample_count{frames * channel_count};
+        const std::size_t first_frame{first_sample / Codec::ADPCM_SAMPLES_PER_FRAME};
+        Codec::DecodeADPCM(wave_data->data() + first_frame * Codec::ADPCM_FRAME_SIZE,
+                           first_sample % Codec::ADPCM_SAMPLES_PER_FRAME, samples, sample_count,
+                           adpcm_coeff, adpcm_state);
+        break;
+    }
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented sample_format={}", info.sample_format);
+        return false;
+    }
+
+    if (channel_count == 1) {
+        // 1 channel is upsampled to 2 channel
+        DSP::UpmixMonoToStereo(decode_buffer.data(), mono_samples, frames);
+    }
+
+    decoded = decode_buffer.data();
+    decoded_count = frames;
+    source_offset += frames;
+    return true;
+}
+
+} // namespace AudioCore
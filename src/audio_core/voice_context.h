@@ -0,0 +1,88 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+
+#include "audio_core/algorithm/interpolate.h"
+#include "audio_core/audio_renderer.h"
+#include "audio_core/codec.h"
+#include "audio_core/command_list.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/**
+ * Playback state of a voice, owned by the DSP thread. Decodes the wave buffers of the voice and
+ * resamples them to stereo PCM16 at the output sample rate.
+ *
+ * Samples are streamed: only the part of the wave buffer needed for the frames being dequeued is
+ * decoded, one chunk at a time, into fixed per-voice buffers. The wave buffers are read from the
+ * copies held by the command list, stereo PCM16 at the output sample rate is handed out straight
+ * from them. No allocations are made once the voice exists.
+ */
+class VoiceContext {
+public:
+    /// Resets the playback state, used when the voice is no longer in use
+    void Reset();
+
+    /// Restarts playback from the given wave buffer
+    void SetWaveIndex(std::size_t index);
+
+    /// Resumes a voice paused by reaching the end of its stream, done on every renderer update
+    void ClearPause() {
+        is_paused = false;
+    }
+
+    /**
+     * Dequeues up to frame_count stereo frames of the voice.
+     * @param info        Current guest parameters of the voice
+     * @param frame_count Maximum number of frames to dequeue
+     * @param source      Wave buffer contents and coefficients of the voice
+     * @param out         Set to the dequeued interleaved samples, valid until the next call
+     * @returns The number of frames dequeued, zero when the voice has nothing left to play
+     */
+    std::size_t DequeueSamples(const VoiceInfo& info, std::size_t frame_count,
+                               const VoiceSource& source, const s16*& out);
+
+    const VoiceOutStatus& GetOutStatus() const {
+        return out_status;
+    }
+
+private:
+    /// Maximum number of source frames decoded at once
+    static constexpr std::size_t DECODE_FRAME_COUNT{256};
+
+    /// Prepares decoding of the current wave buffer from its start
+    void StartWaveBuffer(const VoiceInfo& info, const VoiceSource& source);
+
+    /// Advances to the next wave buffer, or pauses, once the current one has been played
+    void FinishWaveBuffer(const VoiceInfo& info);
+
+    /**
+     * Decodes the next chunk of the current wave buffer to interleaved stereo frames.
+     * @returns False once the wave buffer has been fully decoded
+     */
+    bool DecodeNextChunk(const VoiceInfo& info, const VoiceSource& source);
+
+    bool is_refresh_pending{};
+    bool is_paused{};
+    std::size_t wave_index{};
+    std::size_t source_offset{}; ///< Frames of the current wave buffer decoded so far
+    Codec::ADPCMState adpcm_state{};
+    Codec::ADPCM_Coeff adpcm_coeff{};
+    InterpolationState interp_state{};
+    VoiceOutStatus out_status{};
+
+    // Decoded frames not consumed yet, pointing into decode_buffer or a wave buffer copy
+    const s16* decoded{};
+    std::size_t decoded_count{};
+
+    std::array<s16, DECODE_FRAME_COUNT> mono_buffer{};
+    std::array<s16, DECODE_FRAME_COUNT * 2> decode_buffer{};
+    std::array<s16, MIX_BUFFER_SAMPLE_COUNT * 2> resample_buffer{};
+};
+
+} // namespace AudioCore
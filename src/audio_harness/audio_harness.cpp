@@ -0,0 +1,320 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+// Replays audio renderer captures recorded with the dump_audio_renderer setting against the null
+// sink, without a game or a host audio device. The mixed output can be written to a file and
+// compared against a golden file, and the throughput of the DSP thread is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "audio_core/audio_dsp.h"
+#include "audio_core/audio_renderer.h"
+#include "audio_core/renderer_capture.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/core_timing_util.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/writable_event.h"
+#include "core/memory.h"
+#include "core/settings.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Output format of the renderer, interleaved stereo PCM16 at 48kHz
+constexpr std::size_t OUTPUT_NUM_CHANNELS{2};
+constexpr u64 OUTPUT_SAMPLE_RATE{48000};
+
+/// Time advanced past the last update so the buffers it queued are released
+constexpr std::chrono::milliseconds DRAIN_TIME{50};
+
+/// Longest CoreTiming step, short enough for buffer releases to fire close to their deadline
+constexpr std::chrono::microseconds MAX_TIMING_STEP{500};
+
+/**
+ * Guest memory backing the ranges recorded in a capture. Pages are mapped into an otherwise empty
+ * process the first time a record touches them, each run of new pages as one host allocation so
+ * the renderer can access wave buffers directly.
+ */
+class GuestMemory {
+public:
+    explicit GuestMemory(Core::System& system_) : system{system_} {
+        process = Kernel::Process::Create(system, "AudioHarness",
+                                          Kernel::Process::ProcessType::Userland);
+        system.Kernel().MakeCurrentProcess(process.get());
+    }
+
+    ~GuestMemory() {
+        for (const auto& [base, size] : mapped_runs) {
+            system.Memory().UnmapRegion(process->VMManager().page_table, base, size);
+        }
+        system.Kernel().MakeCurrentProcess(nullptr);
+    }
+
+    void Write(VAddr address, const std::vector<u8>& data) {
+        const VAddr first_page{address & ~Memory::PAGE_MASK};
+        const VAddr end_page{(address + data.size() + Memory::PAGE_MASK) & ~Memory::PAGE_MASK};
+
+        VAddr run_start{first_page};
+        for (VAddr page = first_page; page <= end_page; page += Memory::PAGE_SIZE) {
+            const bool is_mapped{page == end_page || mapped_pages.count(page) != 0};
+            if (is_mapped) {
+                MapRun(run_start, page);
+                run_start = page + Memory::PAGE_SIZE;
+            }
+        }
+
+        system.Memory().WriteBlock(address, data.data(), data.size());
+    }
+
+private:
+    void MapRun(VAddr start, VAddr end) {
+        if (start >= end) {
+            return;
+        }
+        const u64 size{end - start};
+        auto& allocation = allocations.emplace_back(size);
+        system.Memory().MapMemoryRegion(process->VMManager().page_table, start, size,
+                                        allocation.data());
+        for (VAddr page = start; page < end; page += Memory::PAGE_SIZE) {
+            mapped_pages.insert(page);
+        }
+        mapped_runs.emplace_back(start, size);
+    }
+
+    Core::System& system;
+    std::shared_ptr<Kernel::Process> process;
+    std::vector<std::vector<u8>> allocations;
+    std::vector<std::pair<VAddr, u64>> mapped_runs;
+    std::unordered_set<VAddr> mapped_pages;
+};
+
+/// Runs CoreTiming up to the given tick, firing the stream buffer releases along the way
+void AdvanceTiming(Core::Timing::CoreTiming& core_timing, u64 target_ticks) {
+    const u64 max_step{static_cast<u64>(Core::Timing::usToCycles(MAX_TIMING_STEP))};
+    while (core_timing.GetTicks() < target_ticks) {
+        core_timing.AddTicks(std::min(max_step, target_ticks - core_timing.GetTicks()));
+        core_timing.Advance();
+    }
+}
+
+/// Compares the output against a golden file, returns true if every sample is within tolerance
+bool CompareWithGolden(const std::vector<s16>& output, const std::string& golden_path,
+                       u32 tolerance) {
+    FileUtil::IOFile file{golden_path, "rb"};
+    if (!file.IsOpen()) {
+        LOG_CRITICAL(Audio, "Failed to open golden file {}", golden_path);
+        return false;
+    }
+    std::vector<s16> golden(file.GetSize() / sizeof(s16));
+    file.ReadArray(golden.data(), golden.size());
+
+    if (golden.size() != output.size()) {
+        LOG_ERROR(Audio, "Output has {} samples, golden file has {}", output.size(),
+                  golden.size());
+        return false;
+    }
+
+    std::size_t mismatches{};
+    std::size_t first_mismatch{};
+    u32 max_difference{};
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        const u32 difference{static_cast<u32>(std::abs(output[i] - golden[i]))};
+        if (difference > tolerance) {
+            if (mismatches == 0) {
+                first_mismatch = i;
+            }
+            ++mismatches;
+        }
+        max_difference = std::max(max_difference, difference);
+    }
+
+    if (mismatches != 0) {
+        LOG_ERROR(Audio,
+                  "{} samples differ from the golden file by more than {}, first at frame {}, "
+                  "maximum difference {}",
+                  mismatches, tolerance, first_mismatch / OUTPUT_NUM_CHANNELS, max_difference);
+        return false;
+    }
+    LOG_INFO(Audio, "Output matches the golden file, maximum difference {}", max_difference);
+    return true;
+}
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <capture>\n"
+                 "-o, --output=FILE     Write the mixed output to FILE as raw stereo PCM16\n"
+                 "-g, --golden=FILE     Compare the mixed output against FILE\n"
+                 "-t, --tolerance=N     Allow samples to differ from the golden file by N\n"
+                 "-h, --help            Display this help and exit\n";
+}
+
+void InitializeLogging() {
+    Log::Filter log_filter(Log::Level::Info);
+    Log::SetGlobalFilter(log_filter);
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    InitializeLogging();
+
+    std::string capture_path;
+    std::string output_path;
+    std::string golden_path;
+    u32 tolerance{};
+
+    int option_index = 0;
+    static struct option long_options[] = {
+        {"output", required_argument, 0, 'o'},
+        {"golden", required_argument, 0, 'g'},
+        {"tolerance", required_argument, 0, 't'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "o:g:t:h", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'g':
+                golden_path = optarg;
+                break;
+            case 't':
+                tolerance = static_cast<u32>(std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            default:
+                PrintHelp(argv[0]);
+                return -1;
+            }
+        } else {
+            capture_path = argv[optind];
+            optind++;
+        }
+    }
+
+    if (capture_path.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    AudioCore::RendererCaptureReader reader{capture_path};
+    if (!reader.IsValid()) {
+        return -1;
+    }
+
+    // Render through the null sink at full volume, nothing is played back
+    Settings::values.sink_id = "null";
+    Settings::values.audio_device_id = "auto";
+    Settings::values.volume = 1.0f;
+    Settings::values.enable_audio_stretching = false;
+
+    auto& system = Core::System::GetInstance();
+    auto& core_timing = system.CoreTiming();
+    core_timing.Initialize();
+    system.Kernel().Initialize();
+
+    std::vector<s16> output;
+    std::size_t update_count{};
+    AudioCore::DSPStatistics statistics;
+    {
+        GuestMemory guest_memory{system};
+        const auto buffer_event =
+            Kernel::WritableEvent::CreateEventPair(system.Kernel(), "AudioHarness:BufferEvent");
+        AudioCore::AudioRenderer renderer{core_timing, system.Memory(), reader.GetParameters(),
+                                          buffer_event.writable, 0};
+        renderer.SetRenderedBufferCallback([&output](const std::vector<s16>& samples) {
+            output.insert(output.end(), samples.begin(), samples.end());
+        });
+
+        // Replay updates at the same pace as the guest made them, relative to the first one
+        std::optional<u64> first_update_ticks;
+        AudioCore::CaptureRecord record;
+        while (reader.ReadRecord(record)) {
+            switch (record.type) {
+            case AudioCore::CaptureRecordType::Memory:
+                guest_memory.Write(record.address, record.data);
+                break;
+            case AudioCore::CaptureRecordType::Update:
+                if (!first_update_ticks) {
+                    first_update_ticks = record.ticks;
+                }
+                AdvanceTiming(core_timing, record.ticks - *first_update_ticks);
+                renderer.UpdateAudioRenderer(record.data);
+                // Render before time advances, so the output does not depend on thread timing
+                renderer.Flush();
+                ++update_count;
+                break;
+            default:
+                LOG_ERROR(Audio, "Unknown capture record type {}",
+                          static_cast<u32>(record.type));
+                break;
+            }
+        }
+
+        AdvanceTiming(core_timing, core_timing.GetTicks() +
+                                       static_cast<u64>(Core::Timing::msToCycles(DRAIN_TIME)));
+        renderer.Flush();
+        statistics = renderer.GetDSPStatistics();
+    }
+
+    system.Kernel().Shutdown();
+    core_timing.Shutdown();
+
+    const double execution_ms{
+        std::chrono::duration<double, std::milli>(statistics.execution_time).count()};
+    const double output_ms{static_cast<double>(output.size() / OUTPUT_NUM_CHANNELS) * 1000.0 /
+                           OUTPUT_SAMPLE_RATE};
+    std::cout << fmt::format("Replayed {} updates into {:.1f} ms of audio\n", update_count,
+                             output_ms);
+    std::cout << fmt::format("DSP executed {} command lists mixing {} voices in {:.3f} ms\n",
+                             statistics.command_lists, statistics.mixed_voices, execution_ms);
+    if (execution_ms > 0.0) {
+        std::cout << fmt::format("Throughput: {:.1f} voices/ms, {:.1f}x realtime\n",
+                                 static_cast<double>(statistics.mixed_voices) / execution_ms,
+                                 output_ms / execution_ms);
+    }
+
+    if (!output_path.empty()) {
+        FileUtil::IOFile file{output_path, "wb"};
+        if (!file.IsOpen() || file.WriteArray(output.data(), output.size()) != output.size()) {
+            LOG_CRITICAL(Audio, "Failed to write output to {}", output_path);
+            return -1;
+        }
+    }
+
+    if (!golden_path.empty() && !CompareWithGolden(output, golden_path, tolerance)) {
+        return 1;
+    }
+    return 0;
+}
@@ -43,7 +43,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <dirent.h>
+#include <fcntl.h>
 #include <pwd.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -344,6 +346,25 @@ u64 GetSize(const std::string& filename) {
     return 0;
 }
 
+std::optional<FileStatus> GetFileStatus(const std::string& filename) {
+    std::string copy(filename);
+    StripTailDirSlashes(copy);
+
+    struct stat buf;
+#ifdef _WIN32
+    if (_wstat64(Common::UTF8ToUTF16W(copy).c_str(), &buf) != 0)
+#else
+    if (stat(copy.c_str(), &buf) != 0)
+#endif
+    {
+        LOG_DEBUG(Common_Filesystem, "stat failed on {}: {}", filename, GetLastErrorMsg());
+        return std::nullopt;
+    }
+
+    return FileStatus{static_cast<u64>(buf.st_size), static_cast<s64>(buf.st_mtime),
+                      S_ISDIR(buf.st_mode)};
+}
+
 u64 GetSize(const int fd) {
     struct stat buf;
     if (fstat(fd, &buf) != 0) {
@@ -980,4 +1001,65 @@ bool IOFile::Resize(u64 size) {
         ;
 }
 
+MappedFile::MappedFile(u8* data, std::size_t size) : m_data(data), m_size(size) {}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(m_data, m_size);
+#endif
+}
+
+std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& filename) {
+#ifdef _WIN32
+    // The file is shared for deletion so that a live mapping does not keep it from being deleted
+    // or renamed, the view and its section keep the contents alive on their own.
+    const HANDLE file_handle =
+        CreateFileW(Common::UTF8ToUTF16W(filename).c_str(), GENERIC_READ,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_handle, &size) || size.QuadPart == 0 ||
+        static_cast<u64>(size.QuadPart) > std::numeric_limits<std::size_t>::max()) {
+        CloseHandle(file_handle);
+        return nullptr;
+    }
+    const HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file_handle);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        return nullptr;
+    }
+    const auto mapped_size = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return nullptr;
+    }
+    const u64 size = GetSize(fd);
+    if (size == 0 || size > std::numeric_limits<std::size_t>::max()) {
+        close(fd);
+        return nullptr;
+    }
+    // The mapping keeps the file alive on its own
+    void* const view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+    const auto mapped_size = static_cast<std::size_t>(size);
+#endif
+
+    // Cannot use make_shared as the constructor is private
+    return std::shared_ptr<const MappedFile>(new MappedFile(static_cast<u8*>(view), mapped_size));
+}
+
 } // namespace FileUtil
@@ -9,12 +9,14 @@
 #include <fstream>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <vector>
 #include "common/common_types.h"
+#include "common/span.h"
 #ifdef _MSC_VER
 #include "common/string_util.h"
 #endif
@@ -61,6 +63,16 @@ u64 GetSize(const int fd);
 // Overloaded GetSize, accepts FILE*
 u64 GetSize(FILE* f);
 
+struct FileStatus {
+    u64 size;
+    s64 modification_time; ///< Seconds since the epoch
+    bool is_directory;
+};
+
+// Returns the size, modification time and type of filename with a single stat, or std::nullopt if
+// it does not exist
+std::optional<FileStatus> GetFileStatus(const std::string& filename);
+
 // Returns true if successful, or path already exists.
 bool CreateDir(const std::string& filename);
 
@@ -281,6 +293,30 @@ private:
     std::FILE* m_file = nullptr;
 };
 
+/**
+ * Read-only memory mapping of a whole host file. The mapping is independent of any IOFile opened
+ * on the same path and stays valid until the object is destroyed, even if the file is deleted or
+ * renamed meanwhile, so readers keep it alive by holding a shared_ptr to it. It does not observe
+ * resizes, so only files that are opened for reading alone should be mapped.
+ */
+class MappedFile : public NonCopyable {
+public:
+    ~MappedFile();
+
+    /// Maps the file at filename, returns nullptr if it is empty or can't be mapped.
+    static std::shared_ptr<const MappedFile> Open(const std::string& filename);
+
+    Common::Span<const u8> GetContents() const {
+        return {m_data, m_size};
+    }
+
+private:
+    MappedFile(u8* data, std::size_t size);
+
+    u8* m_data;
+    std::size_t m_size;
+};
+
 } // namespace FileUtil
 
 // To deal with Windows being dumb at unicode:
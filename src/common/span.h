@@ -0,0 +1,87 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace Common {
+
+/**
+ * Non-owning view over a contiguous sequence of objects, loosely modeled after C++20's std::span
+ * with a dynamic extent. It is used to hand out host memory (for example guest memory or mapped
+ * files) without copying it into a temporary container.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T* data, std::size_t size) noexcept : ptr{data}, count{size} {}
+
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))> (*)[],
+                  T (*)[]>>>
+    constexpr Span(Container& container) noexcept
+        : ptr{std::data(container)}, count{std::size(container)} {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : ptr{other.data()}, count{other.size()} {}
+
+    constexpr T* data() const noexcept {
+        return ptr;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return count;
+    }
+
+    constexpr std::size_t size_bytes() const noexcept {
+        return count * sizeof(T);
+    }
+
+    constexpr bool empty() const noexcept {
+        return count == 0;
+    }
+
+    constexpr T& operator[](std::size_t index) const noexcept {
+        return ptr[index];
+    }
+
+    constexpr iterator begin() const noexcept {
+        return ptr;
+    }
+
+    constexpr iterator end() const noexcept {
+        return ptr + count;
+    }
+
+    /// Returns a view over the first `size` elements of this view.
+    constexpr Span first(std::size_t size) const noexcept {
+        return {ptr, size};
+    }
+
+    /// Returns a view over `size` elements starting at `offset`, clamped to the end of this view.
+    constexpr Span subspan(std::size_t offset, std::size_t size = SIZE_MAX) const noexcept {
+        const std::size_t remaining = offset < count ? count - offset : 0;
+        return {ptr + (offset < count ? offset : count), size < remaining ? size : remaining};
+    }
+
+private:
+    T* ptr = nullptr;
+    std::size_t count = 0;
+};
+
+} // namespace Common
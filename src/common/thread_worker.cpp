@@ -0,0 +1,72 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include "common/thread.h"
+#include "common/thread_worker.h"
+
+namespace Common {
+
+ThreadWorker::ThreadWorker(std::size_t num_workers, const std::string& name) : thread_name{name} {
+    if (num_workers == 0) {
+        num_workers = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    threads.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        threads.emplace_back(&ThreadWorker::WorkerLoop, this);
+    }
+}
+
+ThreadWorker::~ThreadWorker() {
+    {
+        std::unique_lock lock{queue_mutex};
+        stop = true;
+    }
+    condition.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadWorker::QueueWork(std::function<void()>&& work) {
+    {
+        std::unique_lock lock{queue_mutex};
+        requests.emplace(std::move(work));
+        ++work_pending;
+    }
+    condition.notify_one();
+}
+
+void ThreadWorker::WaitForRequests() {
+    std::unique_lock lock{queue_mutex};
+    wait_condition.wait(lock, [this] { return work_pending == 0; });
+}
+
+void ThreadWorker::WorkerLoop() {
+    SetCurrentThreadName(thread_name.c_str());
+
+    while (true) {
+        std::function<void()> work;
+        {
+            std::unique_lock lock{queue_mutex};
+            condition.wait(lock, [this] { return stop || !requests.empty(); });
+            if (stop && requests.empty()) {
+                return;
+            }
+            work = std::move(requests.front());
+            requests.pop();
+        }
+
+        work();
+
+        {
+            std::unique_lock lock{queue_mutex};
+            --work_pending;
+        }
+        wait_condition.notify_all();
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,59 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Common {
+
+/**
+ * A fixed-size pool of host threads that executes queued work in FIFO order. Work items must not
+ * throw. All queued work is completed before the pool is destroyed.
+ */
+class ThreadWorker final {
+public:
+    /**
+     * Creates the pool.
+     * @param num_workers Number of host threads, zero to use the number of host hardware threads.
+     * @param name        Name given to the host threads, used for debugging purposes.
+     */
+    explicit ThreadWorker(std::size_t num_workers, const std::string& name);
+    ~ThreadWorker();
+
+    ThreadWorker(const ThreadWorker&) = delete;
+    ThreadWorker& operator=(const ThreadWorker&) = delete;
+
+    /// Queues work to be executed by one of the host threads of this pool.
+    void QueueWork(std::function<void()>&& work);
+
+    /// Blocks until all the work queued so far has been executed.
+    void WaitForRequests();
+
+    /// Returns the number of host threads in this pool.
+    std::size_t NumWorkers() const {
+        return threads.size();
+    }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> requests;
+    std::mutex queue_mutex;
+    std::condition_variable condition;
+    std::condition_variable wait_condition;
+    std::size_t work_pending{};
+    bool stop{};
+    std::string thread_name;
+};
+
+} // namespace Common
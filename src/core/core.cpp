@@ -14,6 +14,7 @@
 #include "core/core_manager.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
+#include "core/crypto/sector_cache.h"
 #include "core/file_sys/bis_factory.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/mode.h"
@@ -244,6 +245,24 @@ struct System::Impl {
         return status;
     }
 
+    ResultStatus LoadEmptyProcess(System& system, Frontend::EmuWindow& emu_window) {
+        ResultStatus init_result{Init(system, emu_window)};
+        if (init_result != ResultStatus::Success) {
+            LOG_CRITICAL(Core, "Failed to initialize system (Error {})!",
+                         static_cast<int>(init_result));
+            Shutdown();
+            return init_result;
+        }
+
+        // The process is never run, it only owns the address space the caller maps memory into
+        auto main_process =
+            Kernel::Process::Create(system, "main", Kernel::Process::ProcessType::Userland);
+        kernel.MakeCurrentProcess(main_process.get());
+
+        status = ResultStatus::Success;
+        return status;
+    }
+
     void Shutdown() {
         // Log last frame performance stats if game was loded
         if (perf_stats) {
@@ -290,6 +309,9 @@ struct System::Impl {
         // Clear all applets
         applet_manager.ClearAll();
 
+        // Forget sectors decrypted for this session, the files may change before the next one
+        Crypto::DecryptedSectorCache::Instance().Clear();
+
         LOG_DEBUG(Core, "Shutdown OK");
     }
 
@@ -406,6 +428,10 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
     return impl->Load(*this, emu_window, filepath);
 }
 
+System::ResultStatus System::LoadEmptyProcess(Frontend::EmuWindow& emu_window) {
+    return impl->LoadEmptyProcess(*this, emu_window);
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on;
 }
@@ -174,6 +174,14 @@ public:
      */
     ResultStatus Load(Frontend::EmuWindow& emu_window, const std::string& filepath);
 
+    /**
+     * Initializes the emulated system with an empty process that is never run, for tools that
+     * drive the emulated hardware directly instead of running an application.
+     * @param emu_window Reference to the host-system window used for video output.
+     * @returns ResultStatus code, indicating if the operation succeeded.
+     */
+    ResultStatus LoadEmptyProcess(Frontend::EmuWindow& emu_window);
+
     /**
      * Indicates if the emulated system is powered on (all subsystems initialized and able to run an
      * application).
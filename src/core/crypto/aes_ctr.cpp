@@ -0,0 +1,212 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <mbedtls/aes.h>
+#include "common/assert.h"
+#include "common/swap.h"
+#include "core/crypto/aes_ctr.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <wmmintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#ifdef _MSC_VER
+#define AESNI_TARGET
+#else
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+#endif
+#endif
+
+namespace Core::Crypto {
+
+// Structure to hide mbedtls types from header file
+struct CTRSoftwareContext {
+    mbedtls_aes_context context;
+};
+
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 0x10;
+
+u64 ReadNonce(const std::array<u8, 8>& nonce) {
+    u64 value;
+    std::memcpy(&value, nonce.data(), sizeof(value));
+    return value;
+}
+
+#ifdef ARCHITECTURE_x86_64
+constexpr std::size_t NUM_ROUND_KEYS = 11;
+constexpr std::size_t INTERLEAVE = 8;
+
+AESNI_TARGET __m128i ExpandKeyStep(__m128i key, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, _MM_SHUFFLE(3, 3, 3, 3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+AESNI_TARGET void ExpandKeyAESNI(const Key128& key, u8* out) {
+    __m128i rk[NUM_ROUND_KEYS];
+    rk[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key.data()));
+    // The round constant has to be an immediate, hence the unrolling.
+    rk[1] = ExpandKeyStep(rk[0], _mm_aeskeygenassist_si128(rk[0], 0x01));
+    rk[2] = ExpandKeyStep(rk[1], _mm_aeskeygenassist_si128(rk[1], 0x02));
+    rk[3] = ExpandKeyStep(rk[2], _mm_aeskeygenassist_si128(rk[2], 0x04));
+    rk[4] = ExpandKeyStep(rk[3], _mm_aeskeygenassist_si128(rk[3], 0x08));
+    rk[5] = ExpandKeyStep(rk[4], _mm_aeskeygenassist_si128(rk[4], 0x10));
+    rk[6] = ExpandKeyStep(rk[5], _mm_aeskeygenassist_si128(rk[5], 0x20));
+    rk[7] = ExpandKeyStep(rk[6], _mm_aeskeygenassist_si128(rk[6], 0x40));
+    rk[8] = ExpandKeyStep(rk[7], _mm_aeskeygenassist_si128(rk[7], 0x80));
+    rk[9] = ExpandKeyStep(rk[8], _mm_aeskeygenassist_si128(rk[8], 0x1B));
+    rk[10] = ExpandKeyStep(rk[9], _mm_aeskeygenassist_si128(rk[9], 0x36));
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(out + i * BLOCK_SIZE), rk[i]);
+    }
+}
+
+AESNI_TARGET __m128i MakeCounterBlock(u64 nonce, u64 block_index) {
+    // Bytes 0-7 hold the nonce as-is and bytes 8-15 the big-endian block index.
+    return _mm_set_epi64x(static_cast<s64>(Common::swap64(block_index)), static_cast<s64>(nonce));
+}
+
+AESNI_TARGET void TranscodeAESNI(const u8* round_keys, const u8* in, u8* out,
+                                 std::size_t num_blocks, u64 nonce, u64 block_index) {
+    __m128i rk[NUM_ROUND_KEYS];
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        rk[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(round_keys + i * BLOCK_SIZE));
+    }
+
+    // Several independent blocks are kept in flight to hide the latency of AESENC.
+    while (num_blocks >= INTERLEAVE) {
+        __m128i blocks[INTERLEAVE];
+        for (std::size_t i = 0; i < INTERLEAVE; ++i) {
+            blocks[i] = _mm_xor_si128(MakeCounterBlock(nonce, block_index + i), rk[0]);
+        }
+        for (std::size_t round = 1; round < NUM_ROUND_KEYS - 1; ++round) {
+            for (std::size_t i = 0; i < INTERLEAVE; ++i) {
+                blocks[i] = _mm_aesenc_si128(blocks[i], rk[round]);
+            }
+        }
+        for (std::size_t i = 0; i < INTERLEAVE; ++i) {
+            const auto* const src = reinterpret_cast<const __m128i*>(in + i * BLOCK_SIZE);
+            auto* const dst = reinterpret_cast<__m128i*>(out + i * BLOCK_SIZE);
+            const __m128i keystream = _mm_aesenclast_si128(blocks[i], rk[NUM_ROUND_KEYS - 1]);
+            _mm_storeu_si128(dst, _mm_xor_si128(_mm_loadu_si128(src), keystream));
+        }
+        in += INTERLEAVE * BLOCK_SIZE;
+        out += INTERLEAVE * BLOCK_SIZE;
+        block_index += INTERLEAVE;
+        num_blocks -= INTERLEAVE;
+    }
+
+    for (; num_blocks > 0; --num_blocks) {
+        __m128i block = _mm_xor_si128(MakeCounterBlock(nonce, block_index), rk[0]);
+        for (std::size_t round = 1; round < NUM_ROUND_KEYS - 1; ++round) {
+            block = _mm_aesenc_si128(block, rk[round]);
+        }
+        block = _mm_aesenclast_si128(block, rk[NUM_ROUND_KEYS - 1]);
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(source, block));
+        in += BLOCK_SIZE;
+        out += BLOCK_SIZE;
+        ++block_index;
+    }
+}
+
+AESNI_TARGET void GenerateKeystreamAESNI(const u8* round_keys, u8* out, u64 nonce,
+                                         u64 block_index) {
+    std::memset(out, 0, BLOCK_SIZE);
+    TranscodeAESNI(round_keys, out, out, 1, nonce, block_index);
+}
+#endif
+
+} // Anonymous namespace
+
+CTRCipher::CTRCipher(const Key128& key) : software(std::make_unique<CTRSoftwareContext>()) {
+    mbedtls_aes_init(&software->context);
+    ASSERT_MSG(mbedtls_aes_setkey_enc(&software->context, key.data(), 128) == 0,
+               "Failed to set key on mbedtls AES context.");
+
+#ifdef ARCHITECTURE_x86_64
+    use_aesni = Common::GetCPUCaps().aes;
+    if (use_aesni) {
+        ExpandKeyAESNI(key, round_keys.data());
+    }
+#endif
+}
+
+CTRCipher::~CTRCipher() {
+    mbedtls_aes_free(&software->context);
+}
+
+void CTRCipher::GenerateKeystream(u8* out, const std::array<u8, 8>& nonce, u64 block_index) const {
+#ifdef ARCHITECTURE_x86_64
+    if (use_aesni) {
+        GenerateKeystreamAESNI(round_keys.data(), out, ReadNonce(nonce), block_index);
+        return;
+    }
+#endif
+
+    std::array<u8, BLOCK_SIZE> counter;
+    std::memcpy(counter.data(), nonce.data(), nonce.size());
+    for (std::size_t i = 0; i < 8; ++i) {
+        counter[BLOCK_SIZE - i - 1] = static_cast<u8>(block_index >> (i * 8));
+    }
+    mbedtls_aes_crypt_ecb(&software->context, MBEDTLS_AES_ENCRYPT, counter.data(), out);
+}
+
+void CTRCipher::Transcode(const u8* in, u8* out, std::size_t size, const std::array<u8, 8>& nonce,
+                          u64 offset) const {
+    std::array<u8, BLOCK_SIZE> keystream;
+    u64 block_index = offset / BLOCK_SIZE;
+
+    // Leading partial block
+    const std::size_t block_offset = offset % BLOCK_SIZE;
+    if (block_offset != 0 && size != 0) {
+        const std::size_t length = std::min(BLOCK_SIZE - block_offset, size);
+        GenerateKeystream(keystream.data(), nonce, block_index);
+        for (std::size_t i = 0; i < length; ++i) {
+            out[i] = in[i] ^ keystream[block_offset + i];
+        }
+        in += length;
+        out += length;
+        size -= length;
+        ++block_index;
+    }
+
+    const std::size_t num_blocks = size / BLOCK_SIZE;
+#ifdef ARCHITECTURE_x86_64
+    if (use_aesni) {
+        TranscodeAESNI(round_keys.data(), in, out, num_blocks, ReadNonce(nonce), block_index);
+        in += num_blocks * BLOCK_SIZE;
+        out += num_blocks * BLOCK_SIZE;
+        block_index += num_blocks;
+    } else
+#endif
+    {
+        for (std::size_t block = 0; block < num_blocks; ++block) {
+            GenerateKeystream(keystream.data(), nonce, block_index);
+            for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+                out[i] = in[i] ^ keystream[i];
+            }
+            in += BLOCK_SIZE;
+            out += BLOCK_SIZE;
+            ++block_index;
+        }
+    }
+
+    // Trailing partial block
+    const std::size_t remainder = size % BLOCK_SIZE;
+    if (remainder != 0) {
+        GenerateKeystream(keystream.data(), nonce, block_index);
+        for (std::size_t i = 0; i < remainder; ++i) {
+            out[i] = in[i] ^ keystream[i];
+        }
+    }
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,62 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include "common/common_types.h"
+#include "core/crypto/key_manager.h"
+
+namespace Core::Crypto {
+
+struct CTRSoftwareContext;
+
+/**
+ * AES-128 in CTR mode as used by NCA sections: the upper 8 bytes of the counter block are a fixed
+ * nonce and the lower 8 bytes are the big-endian index of the 0x10-byte block being transcoded.
+ *
+ * Unlike AESCipher this holds no per-operation state, so a single instance can be used from
+ * several threads at once. AES-NI is used when the host supports it.
+ */
+class CTRCipher {
+public:
+    explicit CTRCipher(const Key128& key);
+    ~CTRCipher();
+
+    CTRCipher(const CTRCipher&) = delete;
+    CTRCipher& operator=(const CTRCipher&) = delete;
+
+    /**
+     * Encrypts or decrypts (the operations are identical in CTR) a buffer in place.
+     * @param data   Buffer to transcode.
+     * @param size   Size of the buffer in bytes.
+     * @param nonce  Upper 8 bytes of the counter block.
+     * @param offset Absolute byte offset of data[0] within the stream, need not be block aligned.
+     */
+    void Transcode(u8* data, std::size_t size, const std::array<u8, 8>& nonce, u64 offset) const {
+        Transcode(data, data, size, nonce, offset);
+    }
+
+    /**
+     * Encrypts or decrypts a buffer into another one, which may be the same buffer. This avoids
+     * copying data that can be read in place, such as a memory mapped file, before transcoding it.
+     */
+    void Transcode(const u8* in, u8* out, std::size_t size, const std::array<u8, 8>& nonce,
+                   u64 offset) const;
+
+    /// Returns whether this cipher uses the host's AES instructions.
+    bool IsHardwareAccelerated() const {
+        return use_aesni;
+    }
+
+private:
+    void GenerateKeystream(u8* out, const std::array<u8, 8>& nonce, u64 block_index) const;
+
+    bool use_aesni = false;
+    alignas(16) std::array<u8, 11 * 0x10> round_keys{};
+    std::unique_ptr<CTRSoftwareContext> software;
+};
+
+} // namespace Core::Crypto
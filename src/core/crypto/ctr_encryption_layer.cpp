@@ -2,54 +2,101 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
 #include "common/assert.h"
+#include "common/cityhash.h"
 #include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/sector_cache.h"
 
 namespace Core::Crypto {
 
+constexpr std::size_t SECTOR_SIZE = DecryptedSectorCache::SECTOR_SIZE;
+
+// Reads smaller than this go through the decrypted sector cache, larger ones are decrypted in
+// place, in parallel chunks of PARALLEL_CHUNK_SIZE bytes.
+constexpr std::size_t MAX_CACHED_READ_SIZE = SECTOR_SIZE * 4;
+constexpr std::size_t PARALLEL_CHUNK_SIZE = 0x40000;
+
 CTREncryptionLayer::CTREncryptionLayer(FileSys::VirtualFile base_, Key128 key_,
                                        std::size_t base_offset)
-    : EncryptionLayer(std::move(base_)), base_offset(base_offset), cipher(key_, Mode::CTR),
-      iv(16, 0) {}
+    : EncryptionLayer(std::move(base_)), key(key_), base_offset(base_offset), cipher(key_) {
+    UpdateLayerID();
+}
 
 std::size_t CTREncryptionLayer::Read(u8* data, std::size_t length, std::size_t offset) const {
     if (length == 0)
         return 0;
 
-    const auto sector_offset = offset & 0xF;
-    if (sector_offset == 0) {
-        UpdateIV(base_offset + offset);
-        std::vector<u8> raw = base->ReadBytes(length, offset);
-        cipher.Transcode(raw.data(), raw.size(), data, Op::Decrypt);
-        return length;
+    if (length >= MAX_CACHED_READ_SIZE) {
+        // Decrypt straight from the base file when it can lend its contents, otherwise in place.
+        const auto source = base->BorrowBytes(length, offset);
+        const u8* const in = source.empty() ? data : source.data();
+        const std::size_t read = source.empty() ? base->Read(data, length, offset) : source.size();
+        ForEachChunk(read, PARALLEL_CHUNK_SIZE, [&](std::size_t chunk_offset, std::size_t size) {
+            cipher.Transcode(in + chunk_offset, data + chunk_offset, size, nonce,
+                             base_offset + offset + chunk_offset);
+        });
+        return read;
     }
 
-    // offset does not fall on block boundary (0x10)
-    std::vector<u8> block = base->ReadBytes(0x10, offset - sector_offset);
-    UpdateIV(base_offset + offset - sector_offset);
-    cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
-    std::size_t read = 0x10 - sector_offset;
+    std::array<u8, SECTOR_SIZE> sector_buffer;
+    std::size_t total = 0;
+    while (total < length) {
+        const u64 sector = (offset + total) / SECTOR_SIZE;
+        const std::size_t sector_offset = (offset + total) % SECTOR_SIZE;
+        const std::size_t valid = ReadSector(sector, sector_buffer.data());
+        if (valid <= sector_offset)
+            break;
 
-    if (length + sector_offset < 0x10) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
+        const std::size_t copy = std::min(length - total, valid - sector_offset);
+        std::memcpy(data + total, sector_buffer.data() + sector_offset, copy);
+        total += copy;
+        if (valid < SECTOR_SIZE)
+            break;
     }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
+    return total;
 }
 
 void CTREncryptionLayer::SetIV(const std::vector<u8>& iv_) {
-    const auto length = std::min(iv_.size(), iv.size());
-    iv.assign(iv_.cbegin(), iv_.cbegin() + length);
+    const auto length = std::min(iv_.size(), nonce.size());
+    std::copy_n(iv_.cbegin(), length, nonce.begin());
+    UpdateLayerID();
 }
 
-void CTREncryptionLayer::UpdateIV(std::size_t offset) const {
-    offset >>= 4;
-    for (std::size_t i = 0; i < 8; ++i) {
-        iv[16 - i - 1] = offset & 0xFF;
-        offset >>= 8;
-    }
-    cipher.SetIV(iv);
+std::size_t CTREncryptionLayer::ReadSector(u64 sector, u8* out) const {
+    auto& cache = DecryptedSectorCache::Instance();
+    const std::size_t cached = cache.Lookup(layer_id, sector, out);
+    if (cached != 0)
+        return cached;
+
+    const std::size_t sector_start = sector * SECTOR_SIZE;
+    const auto source = base->BorrowBytes(SECTOR_SIZE, sector_start);
+    const std::size_t read =
+        source.empty() ? base->Read(out, SECTOR_SIZE, sector_start) : source.size();
+    cipher.Transcode(source.empty() ? out : source.data(), out, read, nonce,
+                     base_offset + sector_start);
+    cache.Insert(layer_id, sector, out, read);
+    return read;
 }
+
+void CTREncryptionLayer::UpdateLayerID() {
+    // Identifies the decrypted stream independently of this object, so that layers recreated over
+    // the same data (e.g. when an NCA is parsed again) share cached sectors.
+    const std::string path = base->GetFullPath();
+    const u64 base_size = base->GetSize();
+    const u64 offset = base_offset;
+    const u64 modification_time = DecryptedSectorCache::Instance().GetHostModificationTime(path);
+
+    u64 hash = Common::CityHash64(reinterpret_cast<const char*>(key.data()), key.size());
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(nonce.data()), nonce.size(),
+                                      hash);
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&offset), sizeof(offset), hash);
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&base_size), sizeof(base_size),
+                                      hash);
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&modification_time),
+                                      sizeof(modification_time), hash);
+    layer_id = Common::CityHash64WithSeed(path.data(), path.size(), hash);
+}
+
 } // namespace Core::Crypto
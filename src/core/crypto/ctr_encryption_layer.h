@@ -4,8 +4,9 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
-#include "core/crypto/aes_util.h"
+#include "core/crypto/aes_ctr.h"
 #include "core/crypto/encryption_layer.h"
 #include "core/crypto/key_manager.h"
 
@@ -21,13 +22,16 @@ public:
     void SetIV(const std::vector<u8>& iv);
 
 private:
-    std::size_t base_offset;
+    /// Reads and decrypts one sector through the decrypted sector cache, returns its valid size.
+    std::size_t ReadSector(u64 sector, u8* out) const;
 
-    // Must be mutable as operations modify cipher contexts.
-    mutable AESCipher<Key128> cipher;
-    mutable std::vector<u8> iv;
+    void UpdateLayerID();
 
-    void UpdateIV(std::size_t offset) const;
+    Key128 key;
+    std::size_t base_offset;
+    CTRCipher cipher;
+    std::array<u8, 8> nonce{};
+    u64 layer_id{};
 };
 
 } // namespace Core::Crypto
@@ -2,10 +2,21 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include "common/thread_worker.h"
 #include "core/crypto/encryption_layer.h"
 
 namespace Core::Crypto {
 
+namespace {
+Common::ThreadWorker& GetDecryptionWorker() {
+    static Common::ThreadWorker worker(0, "yuzu:Decryption");
+    return worker;
+}
+} // Anonymous namespace
+
 EncryptionLayer::EncryptionLayer(FileSys::VirtualFile base_) : base(std::move(base_)) {}
 
 std::string EncryptionLayer::GetName() const {
@@ -39,4 +50,37 @@ std::size_t EncryptionLayer::Write(const u8* data, std::size_t length, std::size
 bool EncryptionLayer::Rename(std::string_view name) {
     return base->Rename(name);
 }
+void EncryptionLayer::ForEachChunk(std::size_t length, std::size_t chunk_size,
+                                   const std::function<void(std::size_t, std::size_t)>& func) {
+    const std::size_t num_chunks = (length + chunk_size - 1) / chunk_size;
+    if (num_chunks <= 1) {
+        if (length != 0) {
+            func(0, length);
+        }
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t pending = num_chunks - 1;
+
+    auto& worker = GetDecryptionWorker();
+    for (std::size_t chunk = 1; chunk < num_chunks; ++chunk) {
+        worker.QueueWork([&, chunk] {
+            const std::size_t offset = chunk * chunk_size;
+            func(offset, std::min(chunk_size, length - offset));
+
+            std::lock_guard lock{mutex};
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        });
+    }
+
+    func(0, chunk_size);
+
+    std::unique_lock lock{mutex};
+    done.wait(lock, [&pending] { return pending == 0; });
+}
+
 } // namespace Core::Crypto
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -27,6 +28,15 @@ public:
     bool Rename(std::string_view name) override;
 
 protected:
+    /**
+     * Splits [0, length) into chunks of at most chunk_size bytes and calls func(offset, size) for
+     * each of them. When there is more than one chunk they are processed in parallel on a pool of
+     * host threads shared by all layers, the calling thread included. Returns once every chunk is
+     * done. func must be safe to call concurrently and must not read from any VfsFile.
+     */
+    static void ForEachChunk(std::size_t length, std::size_t chunk_size,
+                             const std::function<void(std::size_t, std::size_t)>& func);
+
     FileSys::VirtualFile base;
 };
 
@@ -0,0 +1,105 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <iterator>
+#include "common/assert.h"
+#include "common/file_util.h"
+#include "core/crypto/sector_cache.h"
+
+namespace Core::Crypto {
+
+constexpr std::size_t MAX_CACHED_SECTORS =
+    DecryptedSectorCache::MAX_CACHED_BYTES / DecryptedSectorCache::SECTOR_SIZE;
+
+DecryptedSectorCache::DecryptedSectorCache() {
+    lookup.reserve(MAX_CACHED_SECTORS);
+}
+
+DecryptedSectorCache& DecryptedSectorCache::Instance() {
+    static DecryptedSectorCache instance;
+    return instance;
+}
+
+std::size_t DecryptedSectorCache::Lookup(u64 layer_id, u64 sector, u8* out) {
+    std::lock_guard lock{mutex};
+
+    const auto iter = lookup.find({layer_id, sector});
+    if (iter == lookup.end()) {
+        return 0;
+    }
+
+    entries.splice(entries.begin(), entries, iter->second);
+    const auto& data = iter->second->data;
+    std::memcpy(out, data.data(), data.size());
+    return data.size();
+}
+
+void DecryptedSectorCache::Insert(u64 layer_id, u64 sector, const u8* data, std::size_t size) {
+    ASSERT(size <= SECTOR_SIZE);
+    if (size == 0) {
+        return;
+    }
+
+    std::lock_guard lock{mutex};
+
+    const Key key{layer_id, sector};
+    if (lookup.find(key) != lookup.end()) {
+        // Another thread decrypted the same sector concurrently.
+        return;
+    }
+
+    if (entries.size() >= MAX_CACHED_SECTORS) {
+        // Recycle the least recently used entry along with its storage.
+        lookup.erase(entries.back().key);
+        entries.splice(entries.begin(), entries, std::prev(entries.end()));
+        entries.front().key = key;
+    } else {
+        entries.push_front({key, {}});
+        entries.front().data.reserve(SECTOR_SIZE);
+    }
+
+    entries.front().data.assign(data, data + size);
+    lookup.emplace(key, entries.begin());
+}
+
+void DecryptedSectorCache::Clear() {
+    std::lock_guard lock{mutex};
+    lookup.clear();
+    entries.clear();
+    modification_times.clear();
+}
+
+u64 DecryptedSectorCache::GetHostModificationTime(const std::string& path) {
+    {
+        std::lock_guard lock{mutex};
+        const auto iter = modification_times.find(path);
+        if (iter != modification_times.end()) {
+            return iter->second;
+        }
+    }
+
+    // Files inside containers (e.g. NCAs in an NSP) are named after the host file holding them.
+    u64 modification_time = 0;
+    std::string host_path = path;
+    while (!host_path.empty()) {
+        if (const auto status = FileUtil::GetFileStatus(host_path)) {
+            if (!status->is_directory) {
+                modification_time = static_cast<u64>(status->modification_time);
+            }
+            break;
+        }
+        const std::size_t separator = host_path.find_last_of('/');
+        if (separator == std::string::npos) {
+            break;
+        }
+        host_path.resize(separator);
+    }
+
+    std::lock_guard lock{mutex};
+    modification_times.emplace(path, modification_time);
+    return modification_time;
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,78 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core::Crypto {
+
+/**
+ * Bounded LRU cache of decrypted sectors shared by every encryption layer, emptied when emulation
+ * shuts down. Sectors are identified by an opaque layer ID, derived from the key, counter and
+ * backing file of the layer, and the index of the sector within that layer.
+ */
+class DecryptedSectorCache {
+public:
+    static constexpr std::size_t SECTOR_SIZE = 0x4000;
+    static constexpr std::size_t MAX_CACHED_BYTES = 32 * 1024 * 1024;
+
+    static DecryptedSectorCache& Instance();
+
+    /**
+     * Copies a cached sector, marking it as most recently used.
+     * @returns The number of valid bytes in the sector, or zero if it is not cached.
+     */
+    std::size_t Lookup(u64 layer_id, u64 sector, u8* out);
+
+    /// Caches `size` decrypted bytes of a sector, evicting the least recently used one if full.
+    void Insert(u64 layer_id, u64 sector, const u8* data, std::size_t size);
+
+    /// Drops every cached sector and modification time and releases their storage.
+    void Clear();
+
+    /**
+     * Returns the modification time of the host file a virtual file at `path` is read from, or
+     * zero if there is none. Layers mix it into their ID, so that a file replaced on disk between
+     * sessions doesn't hit sectors decrypted from its previous contents. The host file is only
+     * looked up the first time a path is seen in a session.
+     */
+    u64 GetHostModificationTime(const std::string& path);
+
+private:
+    struct Key {
+        u64 layer_id;
+        u64 sector;
+
+        bool operator==(const Key& rhs) const {
+            return layer_id == rhs.layer_id && sector == rhs.sector;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return static_cast<std::size_t>(key.layer_id ^ (key.sector * 0x9E3779B97F4A7C15ULL));
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<u8> data;
+    };
+
+    DecryptedSectorCache();
+
+    std::mutex mutex;
+    // Most recently used entries are at the front.
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+    std::unordered_map<std::string, u64> modification_times;
+};
+
+} // namespace Core::Crypto
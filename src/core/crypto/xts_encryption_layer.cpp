@@ -3,56 +3,146 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <mbedtls/aes.h>
 #include "common/assert.h"
+#include "common/cityhash.h"
+#include "core/crypto/sector_cache.h"
 #include "core/crypto/xts_encryption_layer.h"
 
 namespace Core::Crypto {
 
 constexpr u64 XTS_SECTOR_SIZE = 0x4000;
+static_assert(XTS_SECTOR_SIZE == DecryptedSectorCache::SECTOR_SIZE,
+              "XTS sectors must map to cached sectors.");
+
+// Reads smaller than this go through the decrypted sector cache, larger ones are decrypted in
+// place, in parallel chunks of PARALLEL_CHUNK_SIZE bytes.
+constexpr std::size_t MAX_CACHED_READ_SIZE = XTS_SECTOR_SIZE * 4;
+constexpr std::size_t PARALLEL_CHUNK_SIZE = XTS_SECTOR_SIZE * 16;
+
+// Structure to hide mbedtls types from header file
+struct XTSContext {
+    mbedtls_aes_xts_context context;
+};
+
+namespace {
+std::array<u8, 0x10> CalculateNintendoTweak(u64 sector_id) {
+    std::array<u8, 0x10> out{};
+    for (std::size_t i = 0xF; i <= 0xF; --i) {
+        out[i] = sector_id & 0xFF;
+        sector_id >>= 8;
+    }
+    return out;
+}
+} // Anonymous namespace
 
 XTSEncryptionLayer::XTSEncryptionLayer(FileSys::VirtualFile base_, Key256 key_)
-    : EncryptionLayer(std::move(base_)), cipher(key_, Mode::XTS) {}
+    : EncryptionLayer(std::move(base_)), ctx(std::make_unique<XTSContext>()) {
+    mbedtls_aes_xts_init(&ctx->context);
+    ASSERT_MSG(mbedtls_aes_xts_setkey_dec(&ctx->context, key_.data(), key_.size() * 8) == 0,
+               "Failed to set key on mbedtls XTS context.");
+
+    const std::string path = base->GetFullPath();
+    const u64 modification_time = DecryptedSectorCache::Instance().GetHostModificationTime(path);
+    u64 hash = Common::CityHash64(reinterpret_cast<const char*>(key_.data()), key_.size());
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&modification_time),
+                                      sizeof(modification_time), hash);
+    layer_id = Common::CityHash64WithSeed(path.data(), path.size(), hash ^ base->GetSize());
+}
+
+XTSEncryptionLayer::~XTSEncryptionLayer() {
+    mbedtls_aes_xts_free(&ctx->context);
+}
 
 std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t offset) const {
     if (length == 0)
         return 0;
 
-    const auto sector_offset = offset & 0x3FFF;
-    if (sector_offset == 0) {
-        if (length % XTS_SECTOR_SIZE == 0) {
-            std::vector<u8> raw = base->ReadBytes(length, offset);
-            cipher.XTSTranscode(raw.data(), raw.size(), data, offset / XTS_SECTOR_SIZE,
-                                XTS_SECTOR_SIZE, Op::Decrypt);
-            return raw.size();
-        }
-        if (length > XTS_SECTOR_SIZE) {
-            const auto rem = length % XTS_SECTOR_SIZE;
-            const auto read = length - rem;
-            return Read(data, read, offset) + Read(data + read, rem, offset + read);
+    std::array<u8, XTS_SECTOR_SIZE> sector_buffer;
+    std::size_t total = 0;
+    while (total < length) {
+        const std::size_t position = offset + total;
+        const std::size_t remaining = length - total;
+        const std::size_t sector_offset = position % XTS_SECTOR_SIZE;
+
+        if (sector_offset == 0 && remaining >= MAX_CACHED_READ_SIZE) {
+            // Whole sectors are decrypted straight into the caller's buffer, from the base file
+            // when it can lend its contents and in place otherwise.
+            const std::size_t aligned = remaining - remaining % XTS_SECTOR_SIZE;
+            u8* const sectors = data + total;
+            const auto source = base->BorrowBytes(aligned, position);
+            const u8* const in = source.empty() ? sectors : source.data();
+            const std::size_t read =
+                source.empty() ? base->Read(sectors, aligned, position) : source.size();
+            const std::size_t whole = read - read % XTS_SECTOR_SIZE;
+            const u64 first_sector = position / XTS_SECTOR_SIZE;
+            ForEachChunk(whole, PARALLEL_CHUNK_SIZE, [&](std::size_t chunk, std::size_t size) {
+                DecryptSectors(in + chunk, sectors + chunk, size / XTS_SECTOR_SIZE,
+                               first_sector + chunk / XTS_SECTOR_SIZE);
+            });
+            total += whole;
+            if (read != aligned) {
+                // The base file ended inside a sector, decrypt its zero-padded remainder.
+                const std::size_t tail = read - whole;
+                if (tail != 0) {
+                    sector_buffer.fill(0);
+                    std::memcpy(sector_buffer.data(), in + whole, tail);
+                    DecryptSectors(sector_buffer.data(), sector_buffer.data(), 1,
+                                   first_sector + whole / XTS_SECTOR_SIZE);
+                    std::memcpy(data + total, sector_buffer.data(), tail);
+                }
+                return total + tail;
+            }
+            continue;
         }
-        std::vector<u8> buffer = base->ReadBytes(XTS_SECTOR_SIZE, offset);
-        if (buffer.size() < XTS_SECTOR_SIZE)
-            buffer.resize(XTS_SECTOR_SIZE);
-        cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), offset / XTS_SECTOR_SIZE,
-                            XTS_SECTOR_SIZE, Op::Decrypt);
-        std::memcpy(data, buffer.data(), std::min(buffer.size(), length));
-        return std::min(buffer.size(), length);
+
+        const std::size_t valid = ReadSector(position / XTS_SECTOR_SIZE, sector_buffer.data());
+        if (valid <= sector_offset)
+            break;
+
+        const std::size_t copy = std::min(remaining, valid - sector_offset);
+        std::memcpy(data + total, sector_buffer.data() + sector_offset, copy);
+        total += copy;
+        if (valid < XTS_SECTOR_SIZE)
+            break;
     }
+    return total;
+}
 
-    // offset does not fall on block boundary (0x4000)
-    std::vector<u8> block = base->ReadBytes(0x4000, offset - sector_offset);
-    if (block.size() < XTS_SECTOR_SIZE)
-        block.resize(XTS_SECTOR_SIZE);
-    cipher.XTSTranscode(block.data(), block.size(), block.data(),
-                        (offset - sector_offset) / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, Op::Decrypt);
-    const std::size_t read = XTS_SECTOR_SIZE - sector_offset;
-
-    if (length + sector_offset < XTS_SECTOR_SIZE) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
+void XTSEncryptionLayer::DecryptSectors(const u8* in, u8* out, std::size_t num_sectors,
+                                        u64 sector) const {
+    for (std::size_t i = 0; i < num_sectors; ++i) {
+        const auto tweak = CalculateNintendoTweak(sector + i);
+        const std::size_t block = i * XTS_SECTOR_SIZE;
+        ASSERT(mbedtls_aes_crypt_xts(&ctx->context, MBEDTLS_AES_DECRYPT, XTS_SECTOR_SIZE,
+                                     tweak.data(), in + block, out + block) == 0);
     }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
 }
+
+std::size_t XTSEncryptionLayer::ReadSector(u64 sector, u8* out) const {
+    auto& cache = DecryptedSectorCache::Instance();
+    const std::size_t cached = cache.Lookup(layer_id, sector, out);
+    if (cached != 0)
+        return cached;
+
+    const auto source = base->BorrowBytes(XTS_SECTOR_SIZE, sector * XTS_SECTOR_SIZE);
+    if (source.size() == XTS_SECTOR_SIZE) {
+        DecryptSectors(source.data(), out, 1, sector);
+        cache.Insert(layer_id, sector, out, XTS_SECTOR_SIZE);
+        return XTS_SECTOR_SIZE;
+    }
+
+    const std::size_t read = base->Read(out, XTS_SECTOR_SIZE, sector * XTS_SECTOR_SIZE);
+    if (read == 0)
+        return 0;
+
+    // Partial sectors at the end of the file are decrypted as if they were zero-padded.
+    std::memset(out + read, 0, XTS_SECTOR_SIZE - read);
+    DecryptSectors(out, out, 1, sector);
+    cache.Insert(layer_id, sector, out, read);
+    return read;
+}
+
 } // namespace Core::Crypto
@@ -4,22 +4,33 @@
 
 #pragma once
 
-#include "core/crypto/aes_util.h"
+#include <memory>
 #include "core/crypto/encryption_layer.h"
 #include "core/crypto/key_manager.h"
 
 namespace Core::Crypto {
 
+struct XTSContext;
+
 // Sits on top of a VirtualFile and provides XTS-mode AES decription.
 class XTSEncryptionLayer : public EncryptionLayer {
 public:
     XTSEncryptionLayer(FileSys::VirtualFile base, Key256 key);
+    ~XTSEncryptionLayer() override;
 
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
 
 private:
-    // Must be mutable as operations modify cipher contexts.
-    mutable AESCipher<Key256> cipher;
+    /// Decrypts whole sectors from in to out, which may be the same buffer. sector is the index of
+    /// the first one.
+    void DecryptSectors(const u8* in, u8* out, std::size_t num_sectors, u64 sector) const;
+
+    /// Reads and decrypts one sector through the decrypted sector cache, returns its valid size.
+    std::size_t ReadSector(u64 sector, u8* out) const;
+
+    // The mbedtls XTS context is not modified when transcoding, so it can be shared by threads.
+    std::unique_ptr<XTSContext> ctx;
+    u64 layer_id{};
 };
 
 } // namespace Core::Crypto
@@ -0,0 +1,80 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <fmt/format.h>
+#include "common/logging/log.h"
+#include "core/file_sys/extracted_content_cache.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/nca_metadata.h"
+
+namespace FileSys {
+
+// Large blocks keep the encryption layers on their parallel, uncached read path while copying.
+constexpr std::size_t COPY_BLOCK_SIZE = 0x800000;
+
+namespace {
+std::string GetImageName(ContentRecordType type, u64 hash) {
+    return fmt::format("{:02X}_{:016X}.bin", static_cast<u8>(type), hash);
+}
+
+std::string GetImagePrefix(ContentRecordType type) {
+    return fmt::format("{:02X}_", static_cast<u8>(type));
+}
+} // Anonymous namespace
+
+ExtractedContentCache::ExtractedContentCache(VirtualFilesystem vfs_, std::string root_path_)
+    : vfs(std::move(vfs_)), root_path(std::move(root_path_)) {}
+
+ExtractedContentCache::~ExtractedContentCache() = default;
+
+VirtualFile ExtractedContentCache::Open(u64 title_id, ContentRecordType type, u64 hash) const {
+    return vfs->OpenFile(GetTitlePath(title_id) + '/' + GetImageName(type, hash), Mode::Read);
+}
+
+VirtualFile ExtractedContentCache::Store(u64 title_id, ContentRecordType type, u64 hash,
+                                         const VirtualFile& image) const {
+    if (image == nullptr)
+        return nullptr;
+
+    const auto title_path = GetTitlePath(title_id);
+    const auto dir = vfs->CreateDirectory(title_path, Mode::ReadWrite);
+    if (dir == nullptr) {
+        LOG_ERROR(Loader, "Failed to create extracted content cache directory {}", title_path);
+        return nullptr;
+    }
+
+    // Older images of this content are stale now.
+    const auto prefix = GetImagePrefix(type);
+    for (const auto& file : dir->GetFiles()) {
+        if (file->GetName().compare(0, prefix.size(), prefix) == 0)
+            dir->DeleteFile(file->GetName());
+    }
+
+    // Write to a temporary file first so an interrupted copy is never mistaken for an image.
+    const auto name = GetImageName(type, hash);
+    const auto temp_path = title_path + '/' + name + ".tmp";
+    const auto path = title_path + '/' + name;
+    auto temp = vfs->CreateFile(temp_path, Mode::ReadWrite);
+    if (temp == nullptr || !VfsRawCopy(image, temp, COPY_BLOCK_SIZE)) {
+        LOG_ERROR(Loader, "Failed to write extracted content image {}", temp_path);
+        temp = nullptr;
+        vfs->DeleteFile(temp_path);
+        return nullptr;
+    }
+    temp = nullptr;
+
+    if (vfs->MoveFile(temp_path, path) == nullptr) {
+        LOG_ERROR(Loader, "Failed to move extracted content image to {}", path);
+        vfs->DeleteFile(temp_path);
+        return nullptr;
+    }
+
+    return vfs->OpenFile(path, Mode::Read);
+}
+
+std::string ExtractedContentCache::GetTitlePath(u64 title_id) const {
+    return fmt::format("{}/{:016X}", root_path, title_id);
+}
+
+} // namespace FileSys
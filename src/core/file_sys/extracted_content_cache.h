@@ -0,0 +1,47 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include "common/common_types.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+enum class ContentRecordType : u8;
+
+/**
+ * On-disk cache of decrypted and patched content images, enabled by the
+ * use_extracted_content_cache setting. The first boot of a title writes the fully patched RomFS
+ * (update and LayeredFS applied) to the cache directory; later boots read it back as a plain host
+ * file, bypassing the NCA crypto, BKTR and LayeredFS layers entirely.
+ *
+ * Images are indexed by title ID, content type and a hash of everything PatchManager::PatchRomFS
+ * depends on (see PatchManager::GetRomFSPatchHash), so stale images are never served and are
+ * replaced when the inputs change.
+ */
+class ExtractedContentCache {
+public:
+    ExtractedContentCache(VirtualFilesystem vfs, std::string root_path);
+    ~ExtractedContentCache();
+
+    /// Returns the cached image for the given identity, or nullptr if there is none.
+    VirtualFile Open(u64 title_id, ContentRecordType type, u64 hash) const;
+
+    /**
+     * Writes an image to the cache, replacing any older image of the same title and type.
+     * @returns The cached copy of the image, or nullptr if it could not be written.
+     */
+    VirtualFile Store(u64 title_id, ContentRecordType type, u64 hash,
+                      const VirtualFile& image) const;
+
+private:
+    std::string GetTitlePath(u64 title_id) const;
+
+    VirtualFilesystem vfs;
+    std::string root_path;
+};
+
+} // namespace FileSys
@@ -22,6 +22,7 @@
  * Refer to the license.txt file included.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <string_view>
 #include "common/alignment.h"
@@ -103,7 +104,7 @@ static u32 romfs_calc_path_hash(u32 parent, std::string_view path, u32 start,
     u32 hash = parent ^ 123456789;
     for (u32 i = 0; i < path_len; i++) {
         hash = (hash >> 5) | (hash << 27);
-        hash ^= path[start + i];
+        hash ^= static_cast<u8>(path[start + i]);
     }
 
     return hash;
@@ -227,17 +228,69 @@ bool RomFSBuildContext::AddFile(std::shared_ptr<RomFSBuildDirectoryContext> pare
     return true;
 }
 
-RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
-    : base(std::move(base_)), ext(std::move(ext_)) {
+void RomFSBuildContext::InitializeRoot() {
     root = std::make_shared<RomFSBuildDirectoryContext>();
     root->path = "\0";
     directories.emplace(root->path, root);
     num_dirs = 1;
     dir_table_size = 0x18;
+}
+
+std::shared_ptr<RomFSBuildDirectoryContext> RomFSBuildContext::GetParentDirectory(
+    std::string_view path) const {
+    const auto parent = directories.find(path.substr(0, path.rfind('/')));
+    return parent == directories.end() ? nullptr : parent->second;
+}
 
+RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
+    : base(std::move(base_)), ext(std::move(ext_)) {
+    InitializeRoot();
     VisitDirectory(base, ext, root);
 }
 
+RomFSBuildContext::RomFSBuildContext(
+    std::vector<std::string> directory_paths,
+    std::vector<std::pair<std::string, VirtualFile>> file_sources) {
+    InitializeRoot();
+
+    // A path sorts after all of its parents, so they are always added first.
+    std::sort(directory_paths.begin(), directory_paths.end());
+    for (auto& path : directory_paths) {
+        const auto parent = GetParentDirectory(path);
+        if (parent == nullptr)
+            continue;
+
+        const auto child = std::make_shared<RomFSBuildDirectoryContext>();
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = static_cast<u32>(path.size());
+        child->path = std::move(path);
+
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
+
+        AddDirectory(parent, child);
+    }
+
+    for (auto& [path, source] : file_sources) {
+        const auto parent = GetParentDirectory(path);
+        if (parent == nullptr || source == nullptr)
+            continue;
+
+        const auto child = std::make_shared<RomFSBuildFileContext>();
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = static_cast<u32>(path.size());
+        child->path = std::move(path);
+
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
+
+        child->source = std::move(source);
+        child->size = child->source->GetSize();
+
+        AddFile(parent, child);
+    }
+}
+
 RomFSBuildContext::~RomFSBuildContext() = default;
 
 std::map<u64, VirtualFile> RomFSBuildContext::Build() {
@@ -27,6 +27,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -40,6 +42,11 @@ struct RomFSFileEntry;
 class RomFSBuildContext {
 public:
     explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
+
+    // Lays out a RomFS from already resolved entries instead of walking a directory. Paths are
+    // relative to the root and start with a '/', and the parent of every entry must be listed.
+    RomFSBuildContext(std::vector<std::string> directory_paths,
+                      std::vector<std::pair<std::string, VirtualFile>> file_sources);
     ~RomFSBuildContext();
 
     // This finalizes the context.
@@ -59,9 +66,13 @@ private:
     u64 file_hash_table_size = 0;
     u64 file_partition_size = 0;
 
+    void InitializeRoot();
+
     void VisitDirectory(VirtualDir filesys, VirtualDir ext,
                         std::shared_ptr<RomFSBuildDirectoryContext> parent);
 
+    std::shared_ptr<RomFSBuildDirectoryContext> GetParentDirectory(std::string_view path) const;
+
     bool AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
                       std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx);
     bool AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
@@ -0,0 +1,617 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
+#include "core/file_sys/ips_layer.h"
+#include "core/file_sys/layered_romfs_cache.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_layered.h"
+#include "core/file_sys/vfs_real.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+namespace {
+
+constexpr u32 CACHE_MAGIC = Common::MakeMagic('Y', 'L', 'F', 'S');
+constexpr u32 CACHE_VERSION = 2;
+
+/// Layer of the entries provided by the base RomFS, mod layers are numbered from zero.
+constexpr u32 BASE_LAYER = 0xFFFFFFFF;
+/// IPS layer of the entries that are not patched.
+constexpr u32 NO_IPS_LAYER = 0xFFFFFFFF;
+
+constexpr std::string_view STUB_SUFFIX = ".stub";
+constexpr std::string_view IPS_SUFFIX = ".ips";
+
+/// A file or directory found under the host directory of a mod.
+struct ScannedEntry {
+    std::string path; ///< Relative to the mod directory, starting with a '/'
+    u64 size;
+    s64 modification_time;
+    bool is_directory;
+};
+
+/// The entries found under a top-level entry of the host directory of a mod.
+struct ScannedTree {
+    std::string host_path;
+    std::vector<ScannedEntry> entries;
+    u64 hash = 0;
+};
+
+/// A file or directory of the merged RomFS, along with the layer its contents come from.
+struct ResolvedEntry {
+    std::string path; ///< Relative to the root of the RomFS, starting with a '/'
+    u32 layer;        ///< Index of the mod layer providing the file, or BASE_LAYER
+    u32 ips_layer; ///< Index of the ext layer patching the file, or NO_IPS_LAYER
+    bool is_directory;
+};
+
+/// The merged entries under a top-level entry of the RomFS, the unit the cache is updated in.
+struct Subtree {
+    u64 fingerprint = 0;
+    std::vector<ResolvedEntry> entries;
+};
+
+using SubtreeMap = std::map<std::string, Subtree, std::less<>>;
+
+/// A part of the built RomFS, either metadata generated by RomFSBuildContext or a file.
+struct LayoutPart {
+    u64 offset;
+    bool is_file;
+    ResolvedEntry entry;  ///< Source of the part if it is a file
+    std::vector<u8> data; ///< Contents of the part otherwise
+};
+
+/// The built RomFS, valid as long as every subtree it was built from is unchanged.
+struct Layout {
+    u64 hash = 0; ///< Hash of the names and fingerprints of all subtrees
+    std::vector<LayoutPart> parts;
+};
+
+struct Cache {
+    SubtreeMap subtrees;
+    Layout layout;
+};
+
+bool EndsWith(std::string_view str, std::string_view suffix) {
+    return str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+/// Returns the top-level entry of the RomFS that an entry of a mod layer applies to.
+std::string_view GetSubtreeName(std::string_view top_level_name, bool is_ext) {
+    if (is_ext) {
+        for (const auto suffix : {STUB_SUFFIX, IPS_SUFFIX}) {
+            if (EndsWith(top_level_name, suffix))
+                return top_level_name.substr(0, top_level_name.size() - suffix.size());
+        }
+    }
+    return top_level_name;
+}
+
+void ScanHostDirectory(const std::string& host_path, const std::string& path,
+                       std::vector<ScannedEntry>& out) {
+    FileUtil::ForeachDirectoryEntry(
+        nullptr, host_path,
+        [&out, &path](u64*, const std::string& directory, const std::string& name) {
+            const std::string host_entry = directory + DIR_SEP + name;
+            const auto status = FileUtil::GetFileStatus(host_entry);
+            if (!status)
+                return true;
+
+            std::string entry_path = path + '/' + name;
+            out.push_back({entry_path, status->is_directory ? 0 : status->size,
+                           status->modification_time, status->is_directory});
+            if (status->is_directory)
+                ScanHostDirectory(host_entry, entry_path, out);
+            return true;
+        });
+}
+
+/// Scans the rest of a tree whose top-level entry was already stat'ed, then hashes it.
+void ScanTree(ScannedTree& tree) {
+    if (tree.entries.front().is_directory) {
+        // Copied, the entries are appended to while the directory is scanned.
+        const std::string path = tree.entries.front().path;
+        ScanHostDirectory(tree.host_path, path, tree.entries);
+    }
+
+    // Directory listings are not ordered, the hash must not depend on their order.
+    std::sort(tree.entries.begin(), tree.entries.end(),
+              [](const ScannedEntry& lhs, const ScannedEntry& rhs) { return lhs.path < rhs.path; });
+
+    std::vector<u8> data;
+    for (const auto& entry : tree.entries) {
+        // Paths are hashed with their null terminator, which separates them from the values.
+        data.insert(data.end(), entry.path.c_str(), entry.path.c_str() + entry.path.size() + 1);
+        const u64 values[] = {entry.size, static_cast<u64>(entry.modification_time),
+                              entry.is_directory ? 1ULL : 0ULL};
+        const auto* bytes = reinterpret_cast<const u8*>(values);
+        data.insert(data.end(), bytes, bytes + sizeof(values));
+    }
+    tree.hash = Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+/// Lists the top-level entries of the host directory of a mod, keyed by name.
+std::map<std::string, ScannedTree> ListLayer(const std::string& host_path) {
+    std::map<std::string, ScannedTree> out;
+    FileUtil::ForeachDirectoryEntry(
+        nullptr, host_path, [&out](u64*, const std::string& directory, const std::string& name) {
+            const std::string host_entry = directory + DIR_SEP + name;
+            const auto status = FileUtil::GetFileStatus(host_entry);
+            if (!status)
+                return true;
+
+            ScannedTree tree;
+            tree.host_path = host_entry;
+            tree.entries.push_back({'/' + name, status->is_directory ? 0 : status->size,
+                                    status->modification_time, status->is_directory});
+            out.emplace(name, std::move(tree));
+            return true;
+        });
+    return out;
+}
+
+void AddBaseEntries(const VirtualDir& dir, const std::string& path,
+                    std::vector<ResolvedEntry>& out) {
+    for (const auto& file : dir->GetFiles())
+        out.push_back({path + '/' + file->GetName(), BASE_LAYER, NO_IPS_LAYER, false});
+    for (const auto& subdir : dir->GetSubdirectories()) {
+        const std::string subdir_path = path + '/' + subdir->GetName();
+        out.push_back({subdir_path, BASE_LAYER, NO_IPS_LAYER, true});
+        AddBaseEntries(subdir, subdir_path, out);
+    }
+}
+
+VirtualFile OpenSource(const ResolvedEntry& entry, const VirtualDir& base,
+                       const std::vector<VirtualDir>& layers,
+                       const std::vector<VirtualDir>& ext_layers) {
+    auto source = entry.layer == BASE_LAYER ? base->GetFileRelative(entry.path)
+                                            : layers[entry.layer]->GetFileRelative(entry.path);
+    if (source == nullptr || entry.ips_layer == NO_IPS_LAYER)
+        return source;
+
+    const auto ips =
+        ext_layers[entry.ips_layer]->GetFileRelative(entry.path + std::string(IPS_SUFFIX));
+    auto patched = PatchIPS(source, ips);
+    return patched != nullptr ? patched : source;
+}
+
+/**
+ * Merges the entries of the mods and the base RomFS under a top-level entry of the RomFS, the
+ * same way a LayeredVfsDirectory of them would be packed by RomFSBuildContext. Files of higher
+ * priority layers replace the ones below, directories are merged, stubs remove entries and IPS
+ * patches are recorded, to be applied when the file is opened.
+ */
+std::vector<ResolvedEntry> ResolveSubtree(
+    std::string_view name, const VirtualDir& base, const std::vector<VirtualDir>& layers,
+    const std::vector<VirtualDir>& ext_layers,
+    const std::vector<std::map<std::string, ScannedTree>>& scans) {
+    std::map<std::string, ResolvedEntry, std::less<>> merged;
+    const auto add_entry = [&merged](ResolvedEntry entry) {
+        const auto [iter, inserted] = merged.try_emplace(entry.path, entry);
+        // A directory hides a file of the same name regardless of their layers.
+        if (!inserted && entry.is_directory && !iter->second.is_directory)
+            iter->second = std::move(entry);
+    };
+
+    for (u32 layer = 0; layer < layers.size(); ++layer) {
+        const auto tree = scans[layer].find(std::string(name));
+        if (tree == scans[layer].end())
+            continue;
+        for (const auto& entry : tree->second.entries)
+            add_entry({entry.path, layer, NO_IPS_LAYER, entry.is_directory});
+    }
+
+    std::vector<ResolvedEntry> base_entries;
+    if (const auto dir = base->GetSubdirectory(name); dir != nullptr) {
+        const std::string path = '/' + std::string(name);
+        base_entries.push_back({path, BASE_LAYER, NO_IPS_LAYER, true});
+        AddBaseEntries(dir, path, base_entries);
+    } else if (base->GetFile(name) != nullptr) {
+        base_entries.push_back({'/' + std::string(name), BASE_LAYER, NO_IPS_LAYER, false});
+    }
+    for (auto& entry : base_entries)
+        add_entry(std::move(entry));
+
+    // Ext layers hold stub files removing entries and IPS patches of files, in any of them.
+    std::vector<std::unordered_set<std::string>> ips_paths(ext_layers.size());
+    for (std::size_t ext = 0; ext < ext_layers.size(); ++ext) {
+        for (const auto& [top_level_name, tree] : scans[layers.size() + ext]) {
+            if (GetSubtreeName(top_level_name, true) != name)
+                continue;
+
+            for (const auto& entry : tree.entries) {
+                if (entry.is_directory)
+                    continue;
+
+                if (EndsWith(entry.path, STUB_SUFFIX)) {
+                    const std::string path =
+                        entry.path.substr(0, entry.path.size() - STUB_SUFFIX.size());
+                    merged.erase(path);
+
+                    // A stubbed directory is removed along with everything under it.
+                    const std::string prefix = path + '/';
+                    auto iter = merged.lower_bound(prefix);
+                    while (iter != merged.end() &&
+                           iter->first.compare(0, prefix.size(), prefix) == 0) {
+                        iter = merged.erase(iter);
+                    }
+                } else if (EndsWith(entry.path, IPS_SUFFIX)) {
+                    ips_paths[ext].insert(
+                        entry.path.substr(0, entry.path.size() - IPS_SUFFIX.size()));
+                }
+            }
+        }
+    }
+
+    std::vector<ResolvedEntry> out;
+    out.reserve(merged.size());
+    for (auto& [path, entry] : merged) {
+        if (!entry.is_directory) {
+            for (u32 ext = 0; ext < ext_layers.size(); ++ext) {
+                if (ips_paths[ext].count(path) != 0) {
+                    entry.ips_layer = ext;
+                    break;
+                }
+            }
+        }
+        out.push_back(std::move(entry));
+    }
+    return out;
+}
+
+class CacheReader {
+public:
+    explicit CacheReader(std::vector<u8> data_) : data{std::move(data_)} {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Data type must be trivially copyable.");
+        if (data.size() - offset < sizeof(T))
+            return false;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool Read(std::string& value) {
+        u32 size{};
+        if (!Read(size) || data.size() - offset < size)
+            return false;
+        value.assign(reinterpret_cast<const char*>(data.data() + offset), size);
+        offset += size;
+        return true;
+    }
+
+    bool Read(std::vector<u8>& value) {
+        u64 size{};
+        if (!Read(size) || data.size() - offset < size)
+            return false;
+        value.assign(data.begin() + offset, data.begin() + offset + size);
+        offset += size;
+        return true;
+    }
+
+    bool Read(ResolvedEntry& entry) {
+        u8 is_directory{};
+        if (!Read(entry.path) || !Read(entry.layer) || !Read(entry.ips_layer) ||
+            !Read(is_directory)) {
+            return false;
+        }
+        entry.is_directory = is_directory != 0;
+        return true;
+    }
+
+private:
+    std::vector<u8> data;
+    std::size_t offset = 0;
+};
+
+class CacheWriter {
+public:
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Data type must be trivially copyable.");
+        const auto* bytes = reinterpret_cast<const u8*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void Write(const std::string& value) {
+        Write(static_cast<u32>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    void Write(const std::vector<u8>& value) {
+        Write(static_cast<u64>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    void Write(const ResolvedEntry& entry) {
+        Write(entry.path);
+        Write(entry.layer);
+        Write(entry.ips_layer);
+        Write(static_cast<u8>(entry.is_directory ? 1 : 0));
+    }
+
+    const std::vector<u8>& GetData() const {
+        return data;
+    }
+
+private:
+    std::vector<u8> data;
+};
+
+Cache LoadCache(const std::string& cache_path, u64 key) {
+    FileUtil::IOFile file{cache_path, "rb"};
+    if (!file.IsOpen())
+        return {};
+
+    std::vector<u8> data(file.GetSize());
+    if (file.ReadBytes(data.data(), data.size()) != data.size())
+        return {};
+
+    CacheReader reader{std::move(data)};
+    u32 magic{};
+    u32 version{};
+    u64 cached_key{};
+    u64 num_subtrees{};
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(cached_key) ||
+        !reader.Read(num_subtrees) || magic != CACHE_MAGIC || version != CACHE_VERSION ||
+        cached_key != key) {
+        return {};
+    }
+
+    Cache out;
+    for (u64 i = 0; i < num_subtrees; ++i) {
+        std::string name;
+        Subtree subtree;
+        u64 num_entries{};
+        if (!reader.Read(name) || !reader.Read(subtree.fingerprint) || !reader.Read(num_entries))
+            return {};
+
+        for (u64 j = 0; j < num_entries; ++j) {
+            ResolvedEntry entry{};
+            if (!reader.Read(entry))
+                return {};
+            subtree.entries.push_back(std::move(entry));
+        }
+        out.subtrees.emplace(std::move(name), std::move(subtree));
+    }
+
+    // The layout is only of use when complete, the subtrees are kept without it.
+    Layout layout;
+    u64 num_parts{};
+    if (!reader.Read(layout.hash) || !reader.Read(num_parts))
+        return out;
+    for (u64 i = 0; i < num_parts; ++i) {
+        LayoutPart part{};
+        u8 is_file{};
+        if (!reader.Read(part.offset) || !reader.Read(is_file))
+            return out;
+        part.is_file = is_file != 0;
+        if (part.is_file ? !reader.Read(part.entry) : !reader.Read(part.data))
+            return out;
+        layout.parts.push_back(std::move(part));
+    }
+    out.layout = std::move(layout);
+    return out;
+}
+
+void SaveCache(const std::string& cache_path, u64 key, const SubtreeMap& subtrees,
+               const Layout& layout) {
+    CacheWriter writer;
+    writer.Write(CACHE_MAGIC);
+    writer.Write(CACHE_VERSION);
+    writer.Write(key);
+    writer.Write(static_cast<u64>(subtrees.size()));
+    for (const auto& [name, subtree] : subtrees) {
+        writer.Write(name);
+        writer.Write(subtree.fingerprint);
+        writer.Write(static_cast<u64>(subtree.entries.size()));
+        for (const auto& entry : subtree.entries)
+            writer.Write(entry);
+    }
+
+    writer.Write(layout.hash);
+    writer.Write(static_cast<u64>(layout.parts.size()));
+    for (const auto& part : layout.parts) {
+        writer.Write(part.offset);
+        writer.Write(static_cast<u8>(part.is_file ? 1 : 0));
+        if (part.is_file) {
+            writer.Write(part.entry);
+        } else {
+            writer.Write(part.data);
+        }
+    }
+
+    FileUtil::CreateFullPath(cache_path);
+    FileUtil::IOFile file{cache_path, "wb"};
+    const auto& data = writer.GetData();
+    if (!file.IsOpen() || file.WriteBytes(data.data(), data.size()) != data.size()) {
+        LOG_WARNING(Loader, "Failed to write the LayeredFS cache to {}", cache_path);
+    }
+}
+
+/// Opens the parts of a cached layout, nullopt if a file can no longer be opened.
+std::optional<std::map<u64, VirtualFile>> OpenLayout(Layout& layout, const VirtualDir& base,
+                                                     const std::vector<VirtualDir>& layers,
+                                                     const std::vector<VirtualDir>& ext_layers) {
+    std::map<u64, VirtualFile> out;
+    for (auto& part : layout.parts) {
+        VirtualFile file;
+        if (part.is_file) {
+            file = OpenSource(part.entry, base, layers, ext_layers);
+            if (file == nullptr)
+                return std::nullopt;
+        } else {
+            file = std::make_shared<VectorVfsFile>(std::move(part.data));
+        }
+        out.emplace(part.offset, std::move(file));
+    }
+    return out;
+}
+
+VirtualFile BuildUncached(VirtualDir base, std::vector<VirtualDir> layers,
+                          std::vector<VirtualDir> ext_layers) {
+    layers.push_back(std::move(base));
+    auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
+    if (layered == nullptr)
+        return nullptr;
+
+    auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(ext_layers));
+    return CreateRomFS(std::move(layered), std::move(layered_ext));
+}
+
+bool IsHostDirectory(const VirtualDir& dir) {
+    return dynamic_cast<const RealVfsDirectory*>(dir.get()) != nullptr;
+}
+
+} // Anonymous namespace
+
+VirtualFile BuildLayeredRomFS(VirtualFile romfs, std::vector<VirtualDir> layers,
+                              std::vector<VirtualDir> ext_layers, const std::string& cache_path) {
+    auto base = ExtractRomFS(romfs);
+    if (base == nullptr)
+        return nullptr;
+
+    if (!std::all_of(layers.begin(), layers.end(), IsHostDirectory) ||
+        !std::all_of(ext_layers.begin(), ext_layers.end(), IsHostDirectory)) {
+        return BuildUncached(std::move(base), std::move(layers), std::move(ext_layers));
+    }
+
+    // The metadata of the base RomFS is hashed while the mod directories are scanned.
+    std::vector<std::string> host_paths;
+    for (const auto& layer : layers)
+        host_paths.push_back(layer->GetFullPath());
+    for (const auto& layer : ext_layers)
+        host_paths.push_back(layer->GetFullPath());
+
+    std::vector<std::map<std::string, ScannedTree>> scans(host_paths.size());
+    std::optional<u64> base_hash;
+    {
+        Common::ThreadWorker worker(0, "yuzu:LayeredFSScan");
+        worker.QueueWork([&base_hash, &romfs] { base_hash = HashRomFSMetadata(romfs); });
+        for (std::size_t layer = 0; layer < host_paths.size(); ++layer) {
+            scans[layer] = ListLayer(host_paths[layer]);
+            for (auto& [name, tree] : scans[layer]) {
+                worker.QueueWork([&tree = tree] { ScanTree(tree); });
+            }
+        }
+        worker.WaitForRequests();
+    }
+    if (!base_hash)
+        return nullptr;
+
+    // Entries refer to layers by index, so the cache only holds for the same set of mods.
+    const u64 num_layers = layers.size();
+    u64 key = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&num_layers),
+                                         sizeof(num_layers), *base_hash);
+    for (const auto& path : host_paths)
+        key = Common::CityHash64WithSeed(path.c_str(), path.size() + 1, key);
+
+    std::map<std::string, u64, std::less<>> fingerprints;
+    for (const auto& dir : base->GetSubdirectories())
+        fingerprints.emplace(dir->GetName(), key);
+    for (const auto& file : base->GetFiles())
+        fingerprints.emplace(file->GetName(), key);
+    for (std::size_t layer = 0; layer < scans.size(); ++layer) {
+        const bool is_ext = layer >= layers.size();
+        for (const auto& [top_level_name, tree] : scans[layer]) {
+            const std::string name(GetSubtreeName(top_level_name, is_ext));
+            auto& fingerprint = fingerprints.try_emplace(name, key).first->second;
+            const u64 layer_hash[] = {layer, tree.hash};
+            fingerprint = Common::CityHash64WithSeed(reinterpret_cast<const char*>(layer_hash),
+                                                     sizeof(layer_hash), fingerprint);
+        }
+    }
+
+    // The built RomFS only depends on the subtrees, a layout built from the same ones is reused.
+    u64 layout_hash = key;
+    for (const auto& [name, fingerprint] : fingerprints) {
+        layout_hash = Common::CityHash64WithSeed(name.c_str(), name.size() + 1, layout_hash);
+        layout_hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&fingerprint),
+                                                 sizeof(fingerprint), layout_hash);
+    }
+
+    Cache cached = LoadCache(cache_path, key);
+    if (cached.layout.hash == layout_hash && !cached.layout.parts.empty()) {
+        auto parts = OpenLayout(cached.layout, base, layers, ext_layers);
+        if (parts) {
+            LOG_INFO(Loader, "    RomFS: Reused the cached LayeredFS RomFS of {} entries",
+                     fingerprints.size());
+            return ConcatenatedVfsFile::MakeConcatenatedFile(0, std::move(*parts),
+                                                             romfs->GetName());
+        }
+    }
+
+    SubtreeMap subtrees;
+    std::size_t num_reused = 0;
+    for (const auto& [name, fingerprint] : fingerprints) {
+        const auto iter = cached.subtrees.find(name);
+        if (iter != cached.subtrees.end() && iter->second.fingerprint == fingerprint) {
+            subtrees.emplace(name, std::move(iter->second));
+            ++num_reused;
+            continue;
+        }
+
+        auto entries = ResolveSubtree(name, base, layers, ext_layers, scans);
+        subtrees.emplace(name, Subtree{fingerprint, std::move(entries)});
+    }
+    LOG_INFO(Loader, "    RomFS: Reused the cached LayeredFS layout of {} of {} entries",
+             num_reused, fingerprints.size());
+
+    std::vector<std::string> directory_paths;
+    std::vector<std::pair<std::string, VirtualFile>> file_sources;
+    std::unordered_map<const VfsFile*, const ResolvedEntry*> file_entries;
+    for (const auto& [name, subtree] : subtrees) {
+        for (const auto& entry : subtree.entries) {
+            if (entry.is_directory) {
+                directory_paths.push_back(entry.path);
+                continue;
+            }
+            auto source = OpenSource(entry, base, layers, ext_layers);
+            if (source != nullptr)
+                file_entries.emplace(source.get(), &entry);
+            file_sources.emplace_back(entry.path, std::move(source));
+        }
+    }
+
+    RomFSBuildContext ctx{std::move(directory_paths), std::move(file_sources)};
+    auto parts = ctx.Build();
+
+    // Files are cached by their source, the metadata generated by the builder by its contents.
+    Layout layout;
+    layout.hash = layout_hash;
+    for (const auto& [offset, file] : parts) {
+        const auto iter = file_entries.find(file.get());
+        if (iter != file_entries.end()) {
+            layout.parts.push_back({offset, true, *iter->second, {}});
+        } else {
+            layout.parts.push_back({offset, false, {}, file->ReadAllBytes()});
+        }
+    }
+    SaveCache(cache_path, key, subtrees, layout);
+
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, std::move(parts), romfs->GetName());
+}
+
+} // namespace FileSys
@@ -0,0 +1,30 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "core/file_sys/vfs_types.h"
+
+namespace FileSys {
+
+/**
+ * Merges a RomFS with the romfs and romfs_ext directories of LayeredFS mods into a new RomFS.
+ *
+ * The host directories of the mods are scanned on a pool of host threads, and every top-level entry
+ * of the merged RomFS is fingerprinted from the metadata of the base RomFS and the sizes and
+ * modification times of the mod files under it. The merged layout of each top-level entry is
+ * cached in cache_path, so only the entries whose fingerprint changed are merged again. Mods that
+ * are not host directories are merged without the cache.
+ * @param romfs      The RomFS of the title.
+ * @param layers     The romfs directories of the enabled mods, highest priority first.
+ * @param ext_layers The romfs_ext directories of the enabled mods, highest priority first.
+ * @param cache_path Host file the merged layout is cached in.
+ * @returns The merged RomFS, or nullptr on failure.
+ */
+VirtualFile BuildLayeredRomFS(VirtualFile romfs, std::vector<VirtualDir> layers,
+                              std::vector<VirtualDir> ext_layers, const std::string& cache_path);
+
+} // namespace FileSys
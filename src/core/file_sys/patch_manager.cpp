@@ -7,6 +7,8 @@
 #include <cstddef>
 #include <cstring>
 
+#include "common/cityhash.h"
+#include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
@@ -14,10 +16,12 @@
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
 #include "core/file_sys/ips_layer.h"
+#include "core/file_sys/layered_romfs_cache.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs.h"
 #include "core/file_sys/vfs_layered.h"
+#include "core/file_sys/vfs_real.h"
 #include "core/file_sys/vfs_vector.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
@@ -321,11 +325,6 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         return;
     }
 
-    auto extracted = ExtractRomFS(romfs);
-    if (extracted == nullptr) {
-        return;
-    }
-
     const auto& disabled = Settings::values.disabled_addons[title_id];
     auto patch_dirs = load_dir->GetSubdirectories();
     std::sort(patch_dirs.begin(), patch_dirs.end(),
@@ -348,16 +347,11 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         if (ext_dir != nullptr)
             layers_ext.push_back(std::move(ext_dir));
     }
-    layers.push_back(std::move(extracted));
-
-    auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
-    if (layered == nullptr) {
-        return;
-    }
 
-    auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
-
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    const auto cache_path = FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) +
+                            "layeredfs" DIR_SEP +
+                            fmt::format("{:016X}_{:02X}.bin", title_id, static_cast<u8>(type));
+    auto packed = BuildLayeredRomFS(romfs, std::move(layers), std::move(layers_ext), cache_path);
     if (packed == nullptr) {
         return;
     }
@@ -412,6 +406,87 @@ VirtualFile PatchManager::PatchRomFS(VirtualFile romfs, u64 ivfc_offset, Content
     return romfs;
 }
 
+static void AppendDirectoryListing(std::string& out, const VirtualDir& dir,
+                                   const std::string& prefix) {
+    // Edits that keep the size of a file, like IPS patches or replaced assets, must change the key
+    // as well. Host files are identified by their modification time, others by their contents.
+    const bool is_host_dir = dynamic_cast<const RealVfsDirectory*>(dir.get()) != nullptr;
+    for (const auto& file : dir->GetFiles()) {
+        u64 version = 0;
+        if (is_host_dir) {
+            const auto status = FileUtil::GetFileStatus(dir->GetFullPath() + '/' + file->GetName());
+            version = status ? static_cast<u64>(status->modification_time) : 0;
+        } else {
+            const auto data = file->ReadAllBytes();
+            version = Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+        }
+        out += fmt::format("{}/{}:{:X}:{:X};", prefix, file->GetName(), file->GetSize(), version);
+    }
+    for (const auto& subdir : dir->GetSubdirectories()) {
+        AppendDirectoryListing(out, subdir, prefix + '/' + subdir->GetName());
+    }
+}
+
+u64 PatchManager::GetRomFSPatchHash(VirtualFile romfs, u64 ivfc_offset, ContentRecordType type,
+                                    VirtualFile update_raw) const {
+    if (romfs == nullptr)
+        return 0;
+
+    // Hashing the whole base RomFS would cost as much as extracting it, so only its layout and its
+    // first and last sectors are hashed. They differ between builds of a title.
+    constexpr std::size_t SAMPLE_SIZE = 0x4000;
+    const auto size = romfs->GetSize();
+    std::string fingerprint = fmt::format("{:016X}:{:02X}:{:X}:{:X};", title_id,
+                                          static_cast<u8>(type), ivfc_offset, size);
+    const auto head = romfs->ReadBytes(SAMPLE_SIZE);
+    const auto tail = romfs->ReadBytes(SAMPLE_SIZE, size > SAMPLE_SIZE ? size - SAMPLE_SIZE : 0);
+    fingerprint += fmt::format("{:016X}{:016X}{:016X};",
+                               Common::CityHash64(reinterpret_cast<const char*>(head.data()),
+                                                  head.size()),
+                               Common::CityHash64(reinterpret_cast<const char*>(tail.data()),
+                                                  tail.size()),
+                               HashRomFSMetadata(romfs).value_or(0));
+
+    const auto& installed = Core::System::GetInstance().GetContentProvider();
+    const auto& disabled = Settings::values.disabled_addons[title_id];
+    const auto update_disabled =
+        std::find(disabled.cbegin(), disabled.cend(), "Update") != disabled.cend();
+
+    // Game Updates, installed NCAs are named after their content ID
+    const auto update = installed.GetEntryRaw(GetUpdateTitleID(title_id), type);
+    if (!update_disabled && update != nullptr) {
+        fingerprint += fmt::format("update:{}:{:X};", update->GetName(), update->GetSize());
+    } else if (!update_disabled && update_raw != nullptr) {
+        fingerprint += fmt::format("packed:{}:{:X};", update_raw->GetName(), update_raw->GetSize());
+    }
+
+    // LayeredFS
+    const auto load_dir =
+        Core::System::GetInstance().GetFileSystemController().GetModificationLoadRoot(title_id);
+    if ((type == ContentRecordType::Program || type == ContentRecordType::Data) &&
+        load_dir != nullptr && load_dir->GetSize() > 0) {
+        auto patch_dirs = load_dir->GetSubdirectories();
+        std::sort(
+            patch_dirs.begin(), patch_dirs.end(),
+            [](const VirtualDir& l, const VirtualDir& r) { return l->GetName() < r->GetName(); });
+
+        for (const auto& subdir : patch_dirs) {
+            if (std::find(disabled.cbegin(), disabled.cend(), subdir->GetName()) !=
+                disabled.cend()) {
+                continue;
+            }
+
+            for (const char* name : {"romfs", "romfs_ext"}) {
+                const auto dir = subdir->GetSubdirectory(name);
+                if (dir != nullptr)
+                    AppendDirectoryListing(fingerprint, dir, subdir->GetName() + '/' + name);
+            }
+        }
+    }
+
+    return Common::CityHash64(fingerprint.data(), fingerprint.size());
+}
+
 static void AppendCommaIfNotEmpty(std::string& to, const std::string& with) {
     if (to.empty())
         to += with;
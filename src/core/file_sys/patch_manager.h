@@ -61,6 +61,13 @@ public:
                            ContentRecordType type = ContentRecordType::Program,
                            VirtualFile update_raw = nullptr) const;
 
+    // Returns a hash identifying the output of PatchRomFS for the same arguments without applying
+    // any patch. It covers the base RomFS (size and sampled contents), the update NCA and the names
+    // and sizes of the files of every enabled LayeredFS mod.
+    u64 GetRomFSPatchHash(VirtualFile base, u64 ivfc_offset,
+                          ContentRecordType type = ContentRecordType::Program,
+                          VirtualFile update_raw = nullptr) const;
+
     // Returns a vector of pairs between patch names and patch versions.
     // i.e. Update 3.2.2 will return {"Update", "3.2.2"}
     std::map<std::string, std::string, std::less<>> GetPatchVersionNames(
@@ -2,8 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
+#include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/string_util.h"
 #include "common/swap.h"
@@ -12,7 +18,6 @@
 #include "core/file_sys/vfs.h"
 #include "core/file_sys/vfs_concat.h"
 #include "core/file_sys/vfs_offset.h"
-#include "core/file_sys/vfs_vector.h"
 
 namespace FileSys {
 namespace {
@@ -35,13 +40,14 @@ struct RomFSHeader {
 static_assert(sizeof(RomFSHeader) == 0x50, "RomFSHeader has incorrect size.");
 
 struct DirectoryEntry {
+    u32_le parent;
     u32_le sibling;
     u32_le child_dir;
     u32_le child_file;
     u32_le hash;
     u32_le name_length;
 };
-static_assert(sizeof(DirectoryEntry) == 0x14, "DirectoryEntry has incorrect size.");
+static_assert(sizeof(DirectoryEntry) == 0x18, "DirectoryEntry has incorrect size.");
 
 struct FileEntry {
     u32_le parent;
@@ -53,87 +59,268 @@ struct FileEntry {
 };
 static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
 
-template <typename Entry>
-std::pair<Entry, std::string> GetEntry(const VirtualFile& file, std::size_t offset) {
-    Entry entry{};
-    if (file->ReadObject(&entry, offset) != sizeof(Entry))
-        return {};
-    std::string string(entry.name_length, '\0');
-    if (file->ReadArray(&string[0], string.size(), offset + sizeof(Entry)) != string.size())
-        return {};
-    return {entry, string};
+// Same hash as the one the tables are built with in fsmitm_romfsbuild.cpp. Bytes of the name are
+// hashed as unsigned values, so names that are not ASCII hash the same whatever the signedness of
+// char is.
+u32 CalculatePathHash(u32 parent, std::string_view name) {
+    u32 hash = parent ^ 123456789;
+    for (const char c : name) {
+        hash = (hash >> 5) | (hash << 27);
+        hash ^= static_cast<u8>(c);
+    }
+    return hash;
 }
 
-void ProcessFile(VirtualFile file, std::size_t file_offset, std::size_t data_offset,
-                 u32 this_file_offset, std::shared_ptr<VectorVfsDirectory> parent) {
-    while (true) {
-        auto entry = GetEntry<FileEntry>(file, file_offset + this_file_offset);
+/// An entry of one of the meta tables, along with its offset in the table and its name.
+template <typename Entry>
+struct EntryView {
+    u32 offset;
+    Entry entry;
+    std::string_view name;
+};
+
+/**
+ * The hash and meta tables of a RomFS image, read once when it is extracted and shared by all of
+ * its directories. Directories and files are looked up by probing the hash tables with the offset
+ * of their parent directory and their name, so no tree is built up front.
+ */
+class RomFSImage {
+public:
+    static std::shared_ptr<const RomFSImage> Open(VirtualFile file) {
+        RomFSHeader header{};
+        if (file->ReadObject(&header) != sizeof(RomFSHeader))
+            return nullptr;
 
-        parent->AddFile(std::make_shared<OffsetVfsFile>(
-            file, entry.first.size, entry.first.offset + data_offset, entry.second));
+        if (header.header_size != sizeof(RomFSHeader))
+            return nullptr;
 
-        if (entry.first.sibling == ROMFS_ENTRY_EMPTY)
-            break;
+        auto image = std::make_shared<RomFSImage>();
+        if (!ReadTable(file, header.directory_hash, image->directory_hash) ||
+            !ReadTable(file, header.directory_meta, image->directory_meta) ||
+            !ReadTable(file, header.file_hash, image->file_hash) ||
+            !ReadTable(file, header.file_meta, image->file_meta)) {
+            return nullptr;
+        }
 
-        this_file_offset = entry.first.sibling;
+        image->file = std::move(file);
+        image->data_offset = header.data_offset;
+        return image;
     }
-}
 
-void ProcessDirectory(VirtualFile file, std::size_t dir_offset, std::size_t file_offset,
-                      std::size_t data_offset, u32 this_dir_offset,
-                      std::shared_ptr<VectorVfsDirectory> parent) {
-    while (true) {
-        auto entry = GetEntry<DirectoryEntry>(file, dir_offset + this_dir_offset);
-        auto current = std::make_shared<VectorVfsDirectory>(
-            std::vector<VirtualFile>{}, std::vector<VirtualDir>{}, entry.second);
+    std::optional<EntryView<DirectoryEntry>> GetDirectory(u32 offset) const {
+        return GetEntry<DirectoryEntry>(directory_meta, offset);
+    }
+
+    std::optional<EntryView<DirectoryEntry>> FindDirectory(const EntryView<DirectoryEntry>& parent,
+                                                           std::string_view name) const {
+        return FindEntry<DirectoryEntry>(directory_hash, directory_meta, parent.offset,
+                                         parent.entry.child_dir, name);
+    }
 
-        if (entry.first.child_file != ROMFS_ENTRY_EMPTY) {
-            ProcessFile(file, file_offset, data_offset, entry.first.child_file, current);
+    std::optional<EntryView<FileEntry>> FindFile(const EntryView<DirectoryEntry>& parent,
+                                                 std::string_view name) const {
+        return FindEntry<FileEntry>(file_hash, file_meta, parent.offset, parent.entry.child_file,
+                                    name);
+    }
+
+    /// Calls func on every entry of a sibling chain, starting at first.
+    template <typename Entry, typename Func>
+    void ForEachSibling(u32 first, Func&& func) const {
+        const auto& meta = std::is_same_v<Entry, FileEntry> ? file_meta : directory_meta;
+        // Bounded by the number of entries that fit in the table, in case the chain loops.
+        std::size_t remaining = meta.size() / sizeof(Entry);
+        for (auto view = GetEntry<Entry>(meta, first); view && remaining != 0; --remaining) {
+            func(*view);
+            view = GetEntry<Entry>(meta, view->entry.sibling);
         }
+    }
 
-        if (entry.first.child_dir != ROMFS_ENTRY_EMPTY) {
-            ProcessDirectory(file, dir_offset, file_offset, data_offset, entry.first.child_dir,
-                             current);
+    VirtualFile OpenFile(const EntryView<FileEntry>& view, VirtualDir parent) const {
+        return std::make_shared<OffsetVfsFile>(file, view.entry.size,
+                                               data_offset + view.entry.offset,
+                                               std::string(view.name), std::move(parent));
+    }
+
+private:
+    template <typename T>
+    static bool ReadTable(const VirtualFile& file, const TableLocation& location,
+                          std::vector<T>& out) {
+        const u64 file_size = file->GetSize();
+        if (location.offset > file_size || location.size > file_size - location.offset)
+            return false;
+        out.resize(location.size / sizeof(T));
+        return file->ReadArray(out.data(), out.size(), location.offset) ==
+               out.size() * sizeof(T);
+    }
+
+    template <typename Entry>
+    static std::optional<EntryView<Entry>> GetEntry(const std::vector<u8>& meta, u32 offset) {
+        if (offset == ROMFS_ENTRY_EMPTY || offset > meta.size() ||
+            meta.size() - offset < sizeof(Entry)) {
+            return std::nullopt;
         }
 
-        parent->AddDirectory(current);
-        if (entry.first.sibling == ROMFS_ENTRY_EMPTY)
-            break;
-        this_dir_offset = entry.first.sibling;
+        Entry entry{};
+        std::memcpy(&entry, meta.data() + offset, sizeof(Entry));
+        if (entry.name_length > meta.size() - offset - sizeof(Entry))
+            return std::nullopt;
+
+        const auto* name = reinterpret_cast<const char*>(meta.data() + offset + sizeof(Entry));
+        return EntryView<Entry>{offset, entry, std::string_view(name, entry.name_length)};
     }
-}
+
+    template <typename Entry>
+    std::optional<EntryView<Entry>> FindEntry(const std::vector<u32_le>& hash_table,
+                                              const std::vector<u8>& meta, u32 parent,
+                                              u32 first_child, std::string_view name) const {
+        std::optional<EntryView<Entry>> result;
+        if (hash_table.empty()) {
+            // Not every tool emits hash tables, fall back to scanning the parent's children.
+            ForEachSibling<Entry>(first_child, [&](const EntryView<Entry>& view) {
+                if (!result && view.name == name)
+                    result = view;
+            });
+            return result;
+        }
+
+        const u32 bucket = CalculatePathHash(parent, name) % hash_table.size();
+        std::size_t remaining = meta.size() / sizeof(Entry);
+        for (auto view = GetEntry<Entry>(meta, hash_table[bucket]); view && remaining != 0;
+             --remaining) {
+            if (view->entry.parent == parent && view->name == name)
+                return view;
+            view = GetEntry<Entry>(meta, view->entry.hash);
+        }
+        return std::nullopt;
+    }
+
+    VirtualFile file;
+    u64 data_offset = 0;
+    std::vector<u32_le> directory_hash;
+    std::vector<u8> directory_meta;
+    std::vector<u32_le> file_hash;
+    std::vector<u8> file_meta;
+};
+
+/**
+ * A directory of a RomFS image. Its subdirectories and files are only created when they are
+ * requested, which keeps mounting a RomFS with tens of thousands of files cheap and makes path
+ * lookups a hash probe per component.
+ */
+class RomFSDirectory final : public ReadOnlyVfsDirectory {
+public:
+    RomFSDirectory(std::shared_ptr<const RomFSImage> image_, EntryView<DirectoryEntry> view_,
+                   u32 root_offset_)
+        : image{std::move(image_)}, view{view_}, root_offset{root_offset_} {}
+
+    std::vector<VirtualFile> GetFiles() const override {
+        std::vector<VirtualFile> out;
+        const auto self = Clone();
+        image->ForEachSibling<FileEntry>(view.entry.child_file, [&](const auto& file_view) {
+            out.push_back(image->OpenFile(file_view, self));
+        });
+        return out;
+    }
+
+    VirtualFile GetFile(std::string_view name) const override {
+        const auto file_view = image->FindFile(view, name);
+        if (!file_view)
+            return nullptr;
+        return image->OpenFile(*file_view, Clone());
+    }
+
+    std::vector<VirtualDir> GetSubdirectories() const override {
+        std::vector<VirtualDir> out;
+        image->ForEachSibling<DirectoryEntry>(view.entry.child_dir, [&](const auto& dir_view) {
+            out.push_back(MakeDirectory(dir_view));
+        });
+        return out;
+    }
+
+    VirtualDir GetSubdirectory(std::string_view name) const override {
+        const auto dir_view = image->FindDirectory(view, name);
+        if (!dir_view)
+            return nullptr;
+        return MakeDirectory(*dir_view);
+    }
+
+    std::string GetName() const override {
+        return std::string(view.name);
+    }
+
+    VirtualDir GetParentDirectory() const override {
+        // The directory returned by ExtractRomFS is the root of the tree.
+        if (view.offset == root_offset)
+            return nullptr;
+
+        const auto parent_view = image->GetDirectory(view.entry.parent);
+        if (!parent_view)
+            return nullptr;
+        return MakeDirectory(*parent_view);
+    }
+
+private:
+    VirtualDir MakeDirectory(const EntryView<DirectoryEntry>& dir_view) const {
+        return std::make_shared<RomFSDirectory>(image, dir_view, root_offset);
+    }
+
+    VirtualDir Clone() const {
+        return MakeDirectory(view);
+    }
+
+    std::shared_ptr<const RomFSImage> image;
+    EntryView<DirectoryEntry> view;
+    u32 root_offset; ///< Offset of the directory returned by ExtractRomFS
+};
 } // Anonymous namespace
 
 VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
-    RomFSHeader header{};
-    if (file->ReadObject(&header) != sizeof(RomFSHeader))
+    const auto image = RomFSImage::Open(std::move(file));
+    if (image == nullptr)
         return nullptr;
 
-    if (header.header_size != sizeof(RomFSHeader))
+    auto root = image->GetDirectory(0);
+    if (!root)
         return nullptr;
 
-    const u64 file_offset = header.file_meta.offset;
-    const u64 dir_offset = header.directory_meta.offset + 4;
+    if (type != RomFSExtractionType::SingleDiscard) {
+        // Descend through directories whose only entry is a single subdirectory.
+        while (root->entry.child_file == ROMFS_ENTRY_EMPTY) {
+            const auto child = image->GetDirectory(root->entry.child_dir);
+            if (!child || child->entry.sibling != ROMFS_ENTRY_EMPTY)
+                break;
+            if (Common::ToLower(std::string(child->name)) == "data" &&
+                type == RomFSExtractionType::Truncated)
+                break;
+            root = child;
+        }
+    }
 
-    auto root =
-        std::make_shared<VectorVfsDirectory>(std::vector<VirtualFile>{}, std::vector<VirtualDir>{},
-                                             file->GetName(), file->GetContainingDirectory());
+    return std::make_shared<RomFSDirectory>(image, *root, root->offset);
+}
 
-    ProcessDirectory(file, dir_offset, file_offset, header.data_offset, 0, root);
+std::optional<u64> HashRomFSMetadata(const VirtualFile& file) {
+    RomFSHeader header{};
+    if (file->ReadObject(&header) != sizeof(RomFSHeader))
+        return std::nullopt;
 
-    VirtualDir out = std::move(root);
+    if (header.header_size != sizeof(RomFSHeader))
+        return std::nullopt;
 
-    if (type == RomFSExtractionType::SingleDiscard)
-        return out->GetSubdirectories().front();
+    const u64 file_size = file->GetSize();
+    u64 hash = Common::CityHash64(reinterpret_cast<const char*>(&header), sizeof(RomFSHeader));
+    for (const auto& location : {header.directory_hash, header.directory_meta, header.file_hash,
+                                 header.file_meta}) {
+        if (location.offset > file_size || location.size > file_size - location.offset)
+            return std::nullopt;
 
-    while (out->GetSubdirectories().size() == 1 && out->GetFiles().empty()) {
-        if (Common::ToLower(out->GetSubdirectories().front()->GetName()) == "data" &&
-            type == RomFSExtractionType::Truncated)
-            break;
-        out = out->GetSubdirectories().front();
+        std::vector<u8> table(location.size);
+        if (file->Read(table.data(), table.size(), location.offset) != table.size())
+            return std::nullopt;
+        hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(table.data()),
+                                          table.size(), hash);
     }
-
-    return out;
+    return hash;
 }
 
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
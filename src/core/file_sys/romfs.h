@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <optional>
+#include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -20,6 +22,11 @@ enum class RomFSExtractionType {
 VirtualDir ExtractRomFS(VirtualFile file,
                         RomFSExtractionType type = RomFSExtractionType::Truncated);
 
+// Hashes the header and the hash and meta tables of a RomFS binary, which describe its layout
+// without its file data
+// Returns std::nullopt on failure
+std::optional<u64> HashRomFSMetadata(const VirtualFile& file);
+
 // Converts a VFS filesystem into a RomFS binary
 // Returns nullptr on failure
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr);
@@ -5,10 +5,12 @@
 #include <memory>
 #include "common/assert.h"
 #include "common/common_types.h"
+#include "common/file_util.h"
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/content_archive.h"
+#include "core/file_sys/extracted_content_cache.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
@@ -16,6 +18,7 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
+#include "core/settings.h"
 
 namespace FileSys {
 
@@ -40,8 +43,35 @@ ResultVal<VirtualFile> RomFSFactory::OpenCurrentProcess(u64 current_process_titl
         return MakeResult<VirtualFile>(file);
 
     const PatchManager patch_manager(current_process_title_id);
-    return MakeResult<VirtualFile>(
-        patch_manager.PatchRomFS(file, ivfc_offset, ContentRecordType::Program, update_raw));
+    if (!Settings::values.use_extracted_content_cache) {
+        return MakeResult<VirtualFile>(
+            patch_manager.PatchRomFS(file, ivfc_offset, ContentRecordType::Program, update_raw));
+    }
+
+    if (extracted_romfs != nullptr && extracted_romfs_title_id == current_process_title_id)
+        return MakeResult<VirtualFile>(extracted_romfs);
+
+    const ExtractedContentCache cache(
+        Core::System::GetInstance().GetFilesystem(),
+        FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) + "extracted_content");
+    const auto hash =
+        patch_manager.GetRomFSPatchHash(file, ivfc_offset, ContentRecordType::Program, update_raw);
+
+    auto romfs = cache.Open(current_process_title_id, ContentRecordType::Program, hash);
+    if (romfs != nullptr) {
+        LOG_INFO(Loader, "    RomFS: Using extracted image {:016X}", hash);
+    } else {
+        auto patched =
+            patch_manager.PatchRomFS(file, ivfc_offset, ContentRecordType::Program, update_raw);
+        LOG_INFO(Loader, "    RomFS: Extracting image {:016X}, this may take a while", hash);
+        romfs = cache.Store(current_process_title_id, ContentRecordType::Program, hash, patched);
+        if (romfs == nullptr)
+            return MakeResult<VirtualFile>(std::move(patched));
+    }
+
+    extracted_romfs = romfs;
+    extracted_romfs_title_id = current_process_title_id;
+    return MakeResult<VirtualFile>(std::move(romfs));
 }
 
 ResultVal<VirtualFile> RomFSFactory::Open(u64 title_id, StorageId storage,
@@ -41,6 +41,10 @@ private:
     VirtualFile update_raw;
     bool updatable;
     u64 ivfc_offset;
+
+    // Image opened from the extracted content cache, reused across OpenCurrentProcess calls.
+    mutable VirtualFile extracted_romfs;
+    mutable u64 extracted_romfs_title_id{};
 };
 
 } // namespace FileSys
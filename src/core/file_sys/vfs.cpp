@@ -167,6 +167,10 @@ std::string VfsFile::GetExtension() const {
 
 VfsDirectory::~VfsDirectory() = default;
 
+Common::Span<const u8> VfsFile::BorrowBytes(std::size_t length, std::size_t offset) const {
+    return {};
+}
+
 std::optional<u8> VfsFile::ReadByte(std::size_t offset) const {
     u8 out{};
     std::size_t size = Read(&out, 1, offset);
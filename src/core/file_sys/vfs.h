@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/span.h"
 #include "core/file_sys/vfs_types.h"
 
 namespace FileSys {
@@ -105,6 +106,12 @@ public:
     // into file. Returns number of bytes successfully written.
     virtual std::size_t Write(const u8* data, std::size_t length, std::size_t offset = 0) = 0;
 
+    // Returns a read-only view of up to length bytes starting at offset into the file, without
+    // copying them. The view is truncated at the end of the file and stays valid while the file is
+    // alive and not written to or resized. Returns an empty view if the file cannot lend its
+    // contents, in which case Read must be used instead.
+    virtual Common::Span<const u8> BorrowBytes(std::size_t length, std::size_t offset = 0) const;
+
     // Reads exactly one byte at the offset provided, returning std::nullopt on error.
     virtual std::optional<u8> ReadByte(std::size_t offset = 0) const;
     // Reads size bytes starting at offset in file into a vector.
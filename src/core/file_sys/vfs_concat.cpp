@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "common/assert.h"
@@ -128,6 +129,25 @@ std::size_t ConcatenatedVfsFile::Read(u8* data, std::size_t length, std::size_t
     return entry->second->Read(data, std::min<u64>(read_in, length), offset - entry->first);
 }
 
+Common::Span<const u8> ConcatenatedVfsFile::BorrowBytes(std::size_t length,
+                                                        std::size_t offset) const {
+    auto entry = files.upper_bound(offset);
+    if (entry == files.begin())
+        return {};
+    --entry;
+
+    const std::size_t entry_offset = offset - entry->first;
+    const std::size_t entry_size = entry->second->GetSize();
+    if (entry_offset >= entry_size)
+        return {};
+
+    // Only ranges within a single file can be lent, except at the end of the last file.
+    if (length > entry_size - entry_offset && std::next(entry) != files.end())
+        return {};
+
+    return entry->second->BorrowBytes(length, entry_offset);
+}
+
 std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
     return 0;
 }
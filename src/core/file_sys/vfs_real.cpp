@@ -4,8 +4,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 #include "common/assert.h"
 #include "common/common_paths.h"
 #include "common/file_util.h"
@@ -14,6 +19,192 @@
 
 namespace FileSys {
 
+namespace {
+
+/**
+ * Bounded LRU cache of pages of the host files that are not memory mapped, shared by all of them.
+ * Guest reads are usually much smaller than a page and keep hitting the same few files, so most of
+ * them are served without seeking and reading the host file. Read must be called with the mutex of
+ * the file being read held, the cache itself is guarded by its own mutex.
+ */
+class HostPageCache {
+public:
+    static constexpr std::size_t PAGE_SIZE = 0x4000;
+    static constexpr std::size_t MAX_CACHED_BYTES = 16 * 1024 * 1024;
+
+    /// Reads larger than this bypass the cache, they would only evict the pages of other reads.
+    static constexpr std::size_t MAX_CACHED_READ_SIZE = PAGE_SIZE * 4;
+
+    /// Reads from the file through the cache, loading the pages that are not cached.
+    std::size_t Read(FileUtil::IOFile& file, u8* data, std::size_t length, std::size_t offset) {
+        std::size_t total = 0;
+        while (total < length) {
+            const std::size_t position = offset + total;
+            const std::size_t page_offset = position % PAGE_SIZE;
+            const std::size_t page_size =
+                CopyFromPage(file, position / PAGE_SIZE, page_offset, data + total, length - total);
+            if (page_offset >= page_size) {
+                break;
+            }
+
+            total += std::min(length - total, page_size - page_offset);
+            if (page_size < PAGE_SIZE) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    /**
+     * Drops the pages of a file overlapping a written range. Partial pages are dropped as well, as
+     * writes past the end of the file change them.
+     */
+    void Invalidate(const FileUtil::IOFile& file, std::size_t length, std::size_t offset) {
+        const u64 first_page = offset / PAGE_SIZE;
+        const u64 end_page = (offset + length + PAGE_SIZE - 1) / PAGE_SIZE;
+        std::lock_guard lock{mutex};
+        EraseIf([&](const Entry& entry) {
+            return entry.key.file == &file &&
+                   ((entry.key.page >= first_page && entry.key.page < end_page) ||
+                    entry.data.size() < PAGE_SIZE);
+        });
+    }
+
+    /// Drops every page of a file, used when it is resized, closed or destroyed.
+    void Erase(const FileUtil::IOFile& file) {
+        std::lock_guard lock{mutex};
+        EraseIf([&file](const Entry& entry) { return entry.key.file == &file; });
+    }
+
+private:
+    struct Key {
+        const FileUtil::IOFile* file;
+        u64 page;
+
+        bool operator==(const Key& rhs) const {
+            return file == rhs.file && page == rhs.page;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<const void*>{}(key.file) ^
+                   static_cast<std::size_t>(key.page * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<u8> data;
+    };
+
+    /**
+     * Copies up to length bytes at page_offset of a page into data, loading the page from the file
+     * if it is not cached. The host file is read without holding the cache mutex, so reads of
+     * other files are not serialized behind it.
+     * @return The size of the page.
+     */
+    std::size_t CopyFromPage(FileUtil::IOFile& file, u64 page, std::size_t page_offset, u8* data,
+                             std::size_t length) {
+        const Key key{&file, page};
+        {
+            std::lock_guard lock{mutex};
+            const auto iter = lookup.find(key);
+            if (iter != lookup.end()) {
+                entries.splice(entries.begin(), entries, iter->second);
+                return CopyOut(iter->second->data, page_offset, data, length);
+            }
+        }
+
+        std::vector<u8> page_data(PAGE_SIZE);
+        if (file.Seek(static_cast<s64>(page * PAGE_SIZE), SEEK_SET)) {
+            page_data.resize(file.ReadBytes(page_data.data(), page_data.size()));
+        } else {
+            page_data.clear();
+        }
+        const std::size_t page_size = CopyOut(page_data, page_offset, data, length);
+
+        std::lock_guard lock{mutex};
+        while (!entries.empty() && (entries.size() + 1) * PAGE_SIZE > MAX_CACHED_BYTES) {
+            lookup.erase(entries.back().key);
+            entries.pop_back();
+        }
+        // The caller holds the file mutex, so nobody else could have loaded this page meanwhile
+        entries.push_front({key, std::move(page_data)});
+        lookup.emplace(key, entries.begin());
+        return page_size;
+    }
+
+    static std::size_t CopyOut(const std::vector<u8>& page, std::size_t page_offset, u8* data,
+                               std::size_t length) {
+        if (page_offset < page.size()) {
+            std::memcpy(data, page.data() + page_offset,
+                        std::min(length, page.size() - page_offset));
+        }
+        return page.size();
+    }
+
+    template <typename Predicate>
+    void EraseIf(Predicate&& predicate) {
+        for (auto iter = entries.begin(); iter != entries.end();) {
+            if (predicate(*iter)) {
+                lookup.erase(iter->key);
+                iter = entries.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    // Most recently used entries are at the front.
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+    std::mutex mutex;
+};
+
+HostPageCache page_cache;
+
+} // Anonymous namespace
+
+/// Host file shared by every RealVfsFile opened on the same path.
+struct RealVfsBacking {
+    RealVfsBacking(const std::string& path, const char openmode[], bool is_writable_)
+        : file{path, openmode}, is_writable{is_writable_} {}
+
+    // Cached pages are keyed by the host file, so they must not outlive it.
+    ~RealVfsBacking() {
+        page_cache.Erase(file);
+    }
+
+    void Close() {
+        std::lock_guard lock{mutex};
+        page_cache.Erase(file);
+        file.Close();
+        mapping.reset();
+    }
+
+    /// Returns the mapping shared by the files reading this host file, mapping it if there is none.
+    std::shared_ptr<const FileUtil::MappedFile> GetMapping(const std::string& path) {
+        std::lock_guard lock{mutex};
+        auto shared_mapping = mapping.lock();
+        if (shared_mapping == nullptr && file.IsOpen()) {
+            shared_mapping = FileUtil::MappedFile::Open(path);
+            mapping = shared_mapping;
+        }
+        return shared_mapping;
+    }
+
+    FileUtil::IOFile file;
+    // Opened for a writable RealVfsFile, the files sharing it are never read from a mapping.
+    const bool is_writable;
+    // Reads and writes are a seek followed by a transfer, which must not be interleaved with other
+    // threads. Each host file has its own mutex so that reads of different files run in parallel.
+    std::mutex mutex;
+    // Owned by the RealVfsFiles reading from it, so that closing or deleting the host file does not
+    // unmap it under a concurrent read or a borrowed view.
+    std::weak_ptr<const FileUtil::MappedFile> mapping;
+};
+
 static std::string ModeFlagsToString(Mode mode) {
     std::string mode_str;
 
@@ -76,7 +267,8 @@ VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
     if (!FileUtil::Exists(path) && (perms & Mode::WriteAppend) != 0)
         FileUtil::CreateEmptyFile(path);
 
-    auto backing = std::make_shared<FileUtil::IOFile>(path, ModeFlagsToString(perms).c_str());
+    auto backing = std::make_shared<RealVfsBacking>(path, ModeFlagsToString(perms).c_str(),
+                                                    (perms & Mode::WriteAppend) != 0);
     cache[path] = backing;
 
     // Cannot use make_shared as RealVfsFile constructor is private
@@ -120,7 +312,10 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
         auto cached = cache[old_path];
         if (!cached.expired()) {
             auto file = cached.lock();
-            file->Open(new_path, "r+b");
+            {
+                std::lock_guard lock{file->mutex};
+                file->file.Open(new_path, "r+b");
+            }
             cache.erase(old_path);
             cache[new_path] = file;
         }
@@ -190,7 +385,10 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
             auto cached = cache[file_old_path];
             if (!cached.expired()) {
                 auto file = cached.lock();
-                file->Open(file_new_path, "r+b");
+                {
+                    std::lock_guard lock{file->mutex};
+                    file->file.Open(file_new_path, "r+b");
+                }
                 cache.erase(file_old_path);
                 cache[file_new_path] = file;
             }
@@ -213,13 +411,19 @@ bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
     return FileUtil::DeleteDirRecursively(path);
 }
 
-RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<FileUtil::IOFile> backing_,
+RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<RealVfsBacking> backing_,
                          const std::string& path_, Mode perms_)
     : base(base_), backing(std::move(backing_)), path(path_),
       parent_path(FileUtil::GetParentPath(path_)),
       path_components(FileUtil::SplitPathComponents(path_)),
       parent_components(FileUtil::SliceVector(path_components, 0, path_components.size() - 1)),
-      perms(perms_) {}
+      perms(perms_) {
+    // Files opened only for reading, such as game content, are read straight from a mapping. The
+    // host file may be written through the backing of a writable file opened on the same path.
+    if ((perms & Mode::WriteAppend) == 0 && !backing->is_writable) {
+        mapping = backing->GetMapping(path);
+    }
+}
 
 RealVfsFile::~RealVfsFile() = default;
 
@@ -228,11 +432,14 @@ std::string RealVfsFile::GetName() const {
 }
 
 std::size_t RealVfsFile::GetSize() const {
-    return backing->GetSize();
+    std::lock_guard lock{backing->mutex};
+    return backing->file.GetSize();
 }
 
 bool RealVfsFile::Resize(std::size_t new_size) {
-    return backing->Resize(new_size);
+    std::lock_guard lock{backing->mutex};
+    page_cache.Erase(backing->file);
+    return backing->file.Resize(new_size);
 }
 
 std::shared_ptr<VfsDirectory> RealVfsFile::GetContainingDirectory() const {
@@ -248,15 +455,35 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    if (!backing->Seek(offset, SEEK_SET))
+    if (mapping != nullptr) {
+        const auto source = mapping->GetContents().subspan(offset, length);
+        std::memcpy(data, source.data(), source.size());
+        return source.size();
+    }
+
+    std::lock_guard lock{backing->mutex};
+    if (!backing->file.IsOpen())
+        return 0;
+    if (length < HostPageCache::MAX_CACHED_READ_SIZE)
+        return page_cache.Read(backing->file, data, length, offset);
+    if (!backing->file.Seek(offset, SEEK_SET))
         return 0;
-    return backing->ReadBytes(data, length);
+    return backing->file.ReadBytes(data, length);
 }
 
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
-    if (!backing->Seek(offset, SEEK_SET))
+    std::lock_guard lock{backing->mutex};
+    page_cache.Invalidate(backing->file, length, offset);
+    if (!backing->file.Seek(offset, SEEK_SET))
         return 0;
-    return backing->WriteBytes(data, length);
+    return backing->file.WriteBytes(data, length);
+}
+
+Common::Span<const u8> RealVfsFile::BorrowBytes(std::size_t length, std::size_t offset) const {
+    if (mapping == nullptr) {
+        return {};
+    }
+    return mapping->GetContents().subspan(offset, length);
 }
 
 bool RealVfsFile::Rename(std::string_view name) {
@@ -264,7 +491,9 @@ bool RealVfsFile::Rename(std::string_view name) {
 }
 
 bool RealVfsFile::Close() {
-    return backing->Close();
+    std::lock_guard lock{backing->mutex};
+    page_cache.Erase(backing->file);
+    return backing->file.Close();
 }
 
 // TODO(DarkLordZach): MSVC would not let me combine the following two functions using 'if
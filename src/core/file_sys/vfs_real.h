@@ -10,11 +10,13 @@
 #include "core/file_sys/vfs.h"
 
 namespace FileUtil {
-class IOFile;
+class MappedFile;
 }
 
 namespace FileSys {
 
+struct RealVfsBacking;
+
 class RealVfsFilesystem : public VfsFilesystem {
 public:
     RealVfsFilesystem();
@@ -36,7 +38,7 @@ public:
     bool DeleteDirectory(std::string_view path) override;
 
 private:
-    boost::container::flat_map<std::string, std::weak_ptr<FileUtil::IOFile>> cache;
+    boost::container::flat_map<std::string, std::weak_ptr<RealVfsBacking>> cache;
 };
 
 // An implmentation of VfsFile that represents a file on the user's computer.
@@ -55,16 +57,18 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    Common::Span<const u8> BorrowBytes(std::size_t length, std::size_t offset) const override;
     bool Rename(std::string_view name) override;
 
 private:
-    RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<FileUtil::IOFile> backing,
+    RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<RealVfsBacking> backing,
                 const std::string& path, Mode perms = Mode::Read);
 
     bool Close();
 
     RealVfsFilesystem& base;
-    std::shared_ptr<FileUtil::IOFile> backing;
+    std::shared_ptr<RealVfsBacking> backing;
+    std::shared_ptr<const FileUtil::MappedFile> mapping;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
@@ -51,6 +51,10 @@ std::size_t VectorVfsFile::Write(const u8* data_, std::size_t length, std::size_
     return write;
 }
 
+Common::Span<const u8> VectorVfsFile::BorrowBytes(std::size_t length, std::size_t offset) const {
+    return Common::Span<const u8>{data}.subspan(offset, length);
+}
+
 bool VectorVfsFile::Rename(std::string_view name_) {
     name = name_;
     return true;
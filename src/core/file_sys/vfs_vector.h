@@ -50,6 +50,10 @@ public:
         return 0;
     }
 
+    Common::Span<const u8> BorrowBytes(std::size_t length, std::size_t offset) const override {
+        return Common::Span<const u8>{data}.subspan(offset, length);
+    }
+
     bool Rename(std::string_view name) override {
         this->name = name;
         return true;
@@ -76,6 +80,7 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    Common::Span<const u8> BorrowBytes(std::size_t length, std::size_t offset) const override;
     bool Rename(std::string_view name) override;
 
     virtual void Assign(std::vector<u8> new_data);
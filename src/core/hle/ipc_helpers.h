@@ -136,6 +136,14 @@ public:
 
     template <class T>
     void PushIpcInterface(std::shared_ptr<T> iface) {
+        // Interfaces handed out by a service are completed on the same thread as the service
+        // itself, so that requests made through them stay ordered with the parent's.
+        if (iface->GetServiceThread().expired()) {
+            if (const auto& handler = context->Session()->GetHleHandler()) {
+                iface->SetServiceThread(handler->GetServiceThread());
+            }
+        }
+
         if (context->Session()->IsDomain()) {
             context->AddDomainObject(std::move(iface));
         } else {
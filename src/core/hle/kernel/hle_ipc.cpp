@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <sstream>
 #include <utility>
 
@@ -282,25 +283,58 @@ ResultCode HLERequestContext::WriteToOutgoingCommandBuffer(Thread& thread) {
     return RESULT_SUCCESS;
 }
 
-std::vector<u8> HLERequestContext::ReadBuffer(int buffer_index) const {
-    std::vector<u8> buffer;
+VAddr HLERequestContext::GetReadBufferAddress(int buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
-    auto& memory = Core::System::GetInstance().Memory();
-
     if (is_buffer_a) {
-        ASSERT_MSG(BufferDescriptorA().size() > buffer_index,
-                   "BufferDescriptorA invalid buffer_index {}", buffer_index);
-        buffer.resize(BufferDescriptorA()[buffer_index].Size());
-        memory.ReadBlock(BufferDescriptorA()[buffer_index].Address(), buffer.data(), buffer.size());
+        return BufferDescriptorA()[buffer_index].Address();
     } else {
         ASSERT_MSG(BufferDescriptorX().size() > buffer_index,
                    "BufferDescriptorX invalid buffer_index {}", buffer_index);
-        buffer.resize(BufferDescriptorX()[buffer_index].Size());
-        memory.ReadBlock(BufferDescriptorX()[buffer_index].Address(), buffer.data(), buffer.size());
+        return BufferDescriptorX()[buffer_index].Address();
     }
+}
 
-    return buffer;
+VAddr HLERequestContext::GetWriteBufferAddress(int buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return BufferDescriptorB()[buffer_index].Address();
+    } else {
+        ASSERT_MSG(BufferDescriptorC().size() > buffer_index,
+                   "BufferDescriptorC invalid buffer_index {}", buffer_index);
+        return BufferDescriptorC()[buffer_index].Address();
+    }
+}
+
+std::vector<u8> HLERequestContext::ReadBuffer(int buffer_index) const {
+    const Common::Span<const u8> buffer = ReadBufferSpan(buffer_index);
+    return std::vector<u8>(buffer.begin(), buffer.end());
+}
+
+Common::Span<const u8> HLERequestContext::ReadBufferSpan(int buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+    const VAddr address{GetReadBufferAddress(buffer_index)};
+    const std::size_t size{is_buffer_a ? BufferDescriptorA()[buffer_index].Size()
+                                       : BufferDescriptorX()[buffer_index].Size()};
+    if (size == 0) {
+        return {};
+    }
+    auto& memory = Core::System::GetInstance().Memory();
+
+    if (const u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+
+    // The buffer crosses memory regions, gather it into scratch memory
+    if (read_buffer_scratch.size() <= static_cast<std::size_t>(buffer_index)) {
+        read_buffer_scratch.resize(buffer_index + 1);
+    }
+    auto& scratch = read_buffer_scratch[buffer_index];
+    scratch.resize(size);
+    memory.ReadBlock(address, scratch.data(), size);
+    return scratch;
 }
 
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
@@ -310,8 +344,6 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
         return 0;
     }
 
-    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
-                           BufferDescriptorB()[buffer_index].Size()};
     const std::size_t buffer_size{GetWriteBufferSize(buffer_index)};
     if (size > buffer_size) {
         LOG_CRITICAL(Core, "size ({:016X}) is greater than buffer_size ({:016X})", size,
@@ -319,21 +351,57 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
         size = buffer_size; // TODO(bunnei): This needs to be HW tested
     }
 
+    const VAddr address{GetWriteBufferAddress(buffer_index)};
     auto& memory = Core::System::GetInstance().Memory();
-    if (is_buffer_b) {
-        ASSERT_MSG(BufferDescriptorB().size() > buffer_index,
-                   "BufferDescriptorB invalid buffer_index {}", buffer_index);
-        ASSERT_MSG(BufferDescriptorB()[buffer_index].Size() >= size,
-                   "BufferDescriptorB buffer_index {} is not large enough", buffer_index);
-        memory.WriteBlock(BufferDescriptorB()[buffer_index].Address(), buffer, size);
+    if (u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        std::memcpy(pointer, buffer, size);
     } else {
-        ASSERT_MSG(BufferDescriptorC().size() > buffer_index,
-                   "BufferDescriptorC invalid buffer_index {}", buffer_index);
-        ASSERT_MSG(BufferDescriptorC()[buffer_index].Size() >= size,
-                   "BufferDescriptorC buffer_index {} is not large enough", buffer_index);
-        memory.WriteBlock(BufferDescriptorC()[buffer_index].Address(), buffer, size);
+        memory.WriteBlock(address, buffer, size);
+    }
+
+    return size;
+}
+
+Common::Span<u8> HLERequestContext::AcquireWriteBuffer(int buffer_index) {
+    const VAddr address{GetWriteBufferAddress(buffer_index)};
+    const std::size_t size{GetWriteBufferSize(buffer_index)};
+    auto& memory = Core::System::GetInstance().Memory();
+
+    if (u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+
+    // The buffer crosses memory regions, let the caller write into scratch memory instead
+    if (write_buffer_scratch.size() <= static_cast<std::size_t>(buffer_index)) {
+        write_buffer_scratch.resize(buffer_index + 1);
+    }
+    auto& scratch = write_buffer_scratch[buffer_index];
+    scratch.resize(size);
+    return scratch;
+}
+
+std::size_t HLERequestContext::CommitWriteBuffer(std::size_t size, int buffer_index) {
+    if (size == 0) {
+        return 0;
+    }
+
+    const std::size_t buffer_size{GetWriteBufferSize(buffer_index)};
+    if (size > buffer_size) {
+        LOG_CRITICAL(Core, "size ({:016X}) is greater than buffer_size ({:016X})", size,
+                     buffer_size);
+        size = buffer_size;
+    }
+
+    const VAddr address{GetWriteBufferAddress(buffer_index)};
+    auto& memory = Core::System::GetInstance().Memory();
+    if (memory.GetContiguousPointer(address, buffer_size) != nullptr) {
+        // The data was written in place
+        return size;
     }
 
+    ASSERT_MSG(write_buffer_scratch.size() > static_cast<std::size_t>(buffer_index),
+               "CommitWriteBuffer buffer_index {} was not acquired", buffer_index);
+    memory.WriteBlock(address, write_buffer_scratch[buffer_index].data(), size);
     return size;
 }
 
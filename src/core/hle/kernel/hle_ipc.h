@@ -13,6 +13,7 @@
 #include <vector>
 #include <boost/container/small_vector.hpp>
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/object.h"
@@ -30,6 +31,7 @@ class HandleTable;
 class HLERequestContext;
 class Process;
 class ServerSession;
+class ServiceThread;
 class Thread;
 class ReadableEvent;
 class WritableEvent;
@@ -70,11 +72,27 @@ public:
      */
     void ClientDisconnected(const std::shared_ptr<ServerSession>& server_session);
 
+    /**
+     * Returns the host thread that completes requests made to this handler. If it has expired
+     * (or was never set), requests are completed synchronously on the emulated CPU thread.
+     */
+    std::weak_ptr<ServiceThread> GetServiceThread() const {
+        return service_thread;
+    }
+
+    /// Sets the host thread that completes requests made to this handler.
+    void SetServiceThread(std::weak_ptr<ServiceThread> service_thread_) {
+        service_thread = std::move(service_thread_);
+    }
+
 protected:
     /// List of sessions that are connected to this handler.
     /// A ServerSession whose server endpoint is an HLE implementation is kept alive by this list
     /// for the duration of the connection.
     std::vector<std::shared_ptr<ServerSession>> connected_sessions;
+
+    /// Host thread that completes the requests made to this handler, owned by the kernel.
+    std::weak_ptr<ServiceThread> service_thread;
 };
 
 /**
@@ -181,9 +199,33 @@ public:
     /// Helper function to read a buffer using the appropriate buffer descriptor
     std::vector<u8> ReadBuffer(int buffer_index = 0) const;
 
+    /**
+     * Helper function to get a view of a buffer using the appropriate buffer descriptor. When the
+     * buffer is backed by contiguous host memory the view points straight into guest memory,
+     * otherwise the buffer is gathered into scratch memory owned by this context. The view is
+     * valid until the next call with the same buffer index or the destruction of the context.
+     */
+    Common::Span<const u8> ReadBufferSpan(int buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size, int buffer_index = 0) const;
 
+    /**
+     * Helper function to get a writable view of a buffer using the appropriate buffer descriptor,
+     * so that services can produce their output in place. When the buffer is backed by contiguous
+     * host memory the view points straight into guest memory, otherwise it points to scratch
+     * memory owned by this context. Either way, CommitWriteBuffer must be called once the data has
+     * been written.
+     */
+    Common::Span<u8> AcquireWriteBuffer(int buffer_index = 0);
+
+    /**
+     * Finishes a write started with AcquireWriteBuffer, scattering the first `size` bytes of the
+     * scratch memory back to guest memory if the buffer was not contiguous.
+     * @returns The number of bytes written, clamped to the size of the buffer.
+     */
+    std::size_t CommitWriteBuffer(std::size_t size, int buffer_index = 0);
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam ContiguousContainer an arbitrary container that satisfies the
@@ -279,6 +321,12 @@ public:
 private:
     void ParseCommandBuffer(const HandleTable& handle_table, u32_le* src_cmdbuf, bool incoming);
 
+    /// Returns the address of the input buffer with the given index
+    VAddr GetReadBufferAddress(int buffer_index) const;
+
+    /// Returns the address of the output buffer with the given index
+    VAddr GetWriteBufferAddress(int buffer_index) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     std::shared_ptr<Kernel::ServerSession> server_session;
     std::shared_ptr<Thread> thread;
@@ -303,6 +351,10 @@ private:
 
     std::vector<std::shared_ptr<SessionRequestHandler>> domain_request_handlers;
     bool is_thread_waiting{};
+
+    /// Scratch memory used for buffers that are not contiguous in host memory, per buffer index
+    mutable std::vector<std::vector<u8>> read_buffer_scratch;
+    std::vector<std::vector<u8>> write_buffer_scratch;
 };
 
 } // namespace Kernel
@@ -9,7 +9,9 @@
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -27,6 +29,7 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/resource_limit.h"
 #include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/synchronization.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/kernel/time_manager.h"
@@ -115,6 +118,20 @@ struct KernelCore::Impl {
     }
 
     void Shutdown() {
+        // Service threads may still be completing requests that touch kernel state, so they must
+        // be joined before anything else is torn down.
+        std::unordered_set<std::shared_ptr<Kernel::ServiceThread>> threads_to_join;
+        std::vector<std::shared_ptr<Kernel::ServiceThread>> released_threads_to_join;
+        {
+            std::lock_guard lk{service_threads_mutex};
+            threads_to_join = std::move(service_threads);
+            released_threads_to_join = std::move(released_service_threads);
+            service_threads.clear();
+            released_service_threads.clear();
+        }
+        threads_to_join.clear();
+        released_threads_to_join.clear();
+
         next_object_id = 0;
         next_kernel_process_id = Process::InitialKIPIDMin;
         next_user_process_id = Process::ProcessIDMin;
@@ -271,6 +288,12 @@ struct KernelCore::Impl {
     std::bitset<Core::Hardware::NUM_CPU_CORES> registered_core_threads;
     std::mutex register_thread_mutex;
 
+    // Threads used for services
+    std::unordered_set<std::shared_ptr<Kernel::ServiceThread>> service_threads;
+    // Service threads released from one of their own requests, which can't be joined there
+    std::vector<std::shared_ptr<Kernel::ServiceThread>> released_service_threads;
+    std::mutex service_threads_mutex;
+
     // System context
     Core::System& system;
 };
@@ -437,4 +460,27 @@ Core::EmuThreadHandle KernelCore::GetCurrentEmuThreadID() const {
     return impl->GetCurrentEmuThreadID();
 }
 
+std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateServiceThread(const std::string& name) {
+    auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, 1, name);
+    std::lock_guard lk{impl->service_threads_mutex};
+    impl->service_threads.emplace(service_thread);
+    return service_thread;
+}
+
+void KernelCore::ReleaseServiceThread(std::weak_ptr<Kernel::ServiceThread> service_thread) {
+    auto strong_ptr = service_thread.lock();
+    if (!strong_ptr) {
+        return;
+    }
+    {
+        std::lock_guard lk{impl->service_threads_mutex};
+        impl->service_threads.erase(strong_ptr);
+        if (strong_ptr->IsCurrentThread()) {
+            // Joining the thread from itself would deadlock, keep it alive until shutdown
+            impl->released_service_threads.push_back(std::move(strong_ptr));
+        }
+    }
+    // Dropping the last reference joins the thread, which must happen outside of the lock
+}
+
 } // namespace Kernel
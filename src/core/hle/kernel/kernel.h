@@ -31,6 +31,7 @@ class PhysicalCore;
 class Process;
 class ResourceLimit;
 class Scheduler;
+class ServiceThread;
 class Synchronization;
 class Thread;
 class TimeManager;
@@ -147,6 +148,25 @@ public:
     /// Register the current thread as a non CPU core thread.
     void RegisterHostThread();
 
+    /**
+     * Creates a host service thread, which is used to complete HLE requests outside of the
+     * emulated CPU threads. The kernel owns the thread until it is released or the kernel is shut
+     * down.
+     *
+     * @param name The name of the service thread, used for debugging purposes.
+     *
+     * @returns A weak pointer to the newly created service thread.
+     */
+    std::weak_ptr<Kernel::ServiceThread> CreateServiceThread(const std::string& name);
+
+    /**
+     * Releases a service thread previously created with CreateServiceThread, joining its host
+     * threads once there are no more requests in flight.
+     *
+     * @param service_thread The service thread to release.
+     */
+    void ReleaseServiceThread(std::weak_ptr<Kernel::ServiceThread> service_thread);
+
 private:
     friend class Object;
     friend class Process;
@@ -18,6 +18,7 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/session.h"
 #include "core/hle/kernel/thread.h"
 #include "core/memory.h"
@@ -33,7 +34,7 @@ ResultVal<std::shared_ptr<ServerSession>> ServerSession::Create(KernelCore& kern
     std::shared_ptr<ServerSession> session{std::make_shared<ServerSession>(kernel)};
 
     session->request_event = Core::Timing::CreateEvent(
-        name, [session](u64 userdata, s64 cycles_late) { session->CompleteSyncRequest(); });
+        name, [session](u64 userdata, s64 cycles_late) { session->CompleteQueuedSyncRequest(); });
     session->name = std::move(name);
     session->parent = std::move(parent);
 
@@ -140,16 +141,23 @@ ResultCode ServerSession::QueueSyncRequest(std::shared_ptr<Thread> thread, Memor
         std::make_shared<Kernel::HLERequestContext>(SharedFrom(this), std::move(thread))};
 
     context->PopulateFromIncomingCommandBuffer(kernel.CurrentProcess()->GetHandleTable(), cmd_buf);
+
+    // Requests to services that own a host service thread are completed there, leaving the
+    // requesting guest thread asleep in the meantime.
+    if (hle_handler != nullptr) {
+        if (const auto service_thread = hle_handler->GetServiceThread().lock()) {
+            service_thread->QueueSyncRequest(SharedFrom(this), std::move(context));
+            return RESULT_SUCCESS;
+        }
+    }
+
     request_queue.Push(std::move(context));
+    Core::System::GetInstance().CoreTiming().ScheduleEvent(20000, request_event, {});
 
     return RESULT_SUCCESS;
 }
 
-ResultCode ServerSession::CompleteSyncRequest() {
-    ASSERT(!request_queue.Empty());
-
-    auto& context = *request_queue.Front();
-
+ResultCode ServerSession::CompleteSyncRequest(HLERequestContext& context) {
     ResultCode result = RESULT_SUCCESS;
     // If the session has been converted to a domain, handle the domain request
     if (IsDomain() && context.HasDomainMessageHeader()) {
@@ -168,10 +176,19 @@ ResultCode ServerSession::CompleteSyncRequest() {
 
     // Some service requests require the thread to block
     if (!context.IsThreadWaiting()) {
-        context.GetThread().ResumeFromWait();
-        context.GetThread().SetWaitSynchronizationResult(result);
+        auto& thread = context.GetThread();
+        thread.ResumeFromWait();
+        thread.SetWaitSynchronizationResult(result);
+        kernel.PrepareReschedule(thread.GetProcessorID());
     }
 
+    return result;
+}
+
+ResultCode ServerSession::CompleteQueuedSyncRequest() {
+    ASSERT(!request_queue.Empty());
+
+    const ResultCode result = CompleteSyncRequest(*request_queue.Front());
     request_queue.Pop();
 
     return result;
@@ -179,7 +196,6 @@ ResultCode ServerSession::CompleteSyncRequest() {
 
 ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread,
                                             Memory::Memory& memory) {
-    Core::System::GetInstance().CoreTiming().ScheduleEvent(20000, request_event, {});
     return QueueSyncRequest(std::move(thread), memory);
 }
 
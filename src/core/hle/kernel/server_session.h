@@ -25,6 +25,7 @@ namespace Kernel {
 
 class HLERequestContext;
 class KernelCore;
+class ServiceThread;
 class Session;
 class SessionRequestHandler;
 class Thread;
@@ -84,6 +85,11 @@ public:
         hle_handler = std::move(hle_handler_);
     }
 
+    /// Returns the HLE handler for the session, if any.
+    const std::shared_ptr<SessionRequestHandler>& GetHleHandler() const {
+        return hle_handler;
+    }
+
     /**
      * Handle a sync request from the emulated application.
      *
@@ -94,6 +100,16 @@ public:
      */
     ResultCode HandleSyncRequest(std::shared_ptr<Thread> thread, Memory::Memory& memory);
 
+    /**
+     * Completes a sync request from the emulated application, dispatching it to the HLE handler
+     * and waking up the requesting thread unless the handler put it to sleep.
+     *
+     * @param context Request context that was populated from the requesting thread.
+     *
+     * @returns ResultCode from the operation.
+     */
+    ResultCode CompleteSyncRequest(HLERequestContext& context);
+
     bool ShouldWait(const Thread* thread) const override;
 
     void Acquire(Thread* thread) override;
@@ -128,8 +144,8 @@ private:
     /// Queues a sync request from the emulated application.
     ResultCode QueueSyncRequest(std::shared_ptr<Thread> thread, Memory::Memory& memory);
 
-    /// Completes a sync request from the emulated application.
-    ResultCode CompleteSyncRequest();
+    /// Completes the oldest sync request queued through core timing.
+    ResultCode CompleteQueuedSyncRequest();
 
     /// Handles a SyncRequest to a domain, forwarding the request to the proper object or closing an
     /// object handle.
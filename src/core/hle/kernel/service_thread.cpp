@@ -0,0 +1,135 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread.h"
+#include "core/hle/lock.h"
+
+MICROPROFILE_DEFINE(Kernel_ServiceThread, "Kernel", "Service Thread", MP_RGB(160, 96, 224));
+
+namespace Kernel {
+
+class ServiceThread::Impl final {
+public:
+    explicit Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    ~Impl();
+
+    void QueueSyncRequest(std::shared_ptr<ServerSession> session,
+                          std::shared_ptr<HLERequestContext>&& context);
+
+    const std::string& GetName() const {
+        return service_name;
+    }
+
+    bool IsCurrentThread() const;
+
+private:
+    void WorkerLoop(KernelCore& kernel, const std::string& thread_name);
+
+    std::string service_name;
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> requests;
+    std::mutex queue_mutex;
+    std::condition_variable condition;
+    bool stop{};
+};
+
+ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name)
+    : service_name{name} {
+    ASSERT(num_threads > 0);
+    threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(&Impl::WorkerLoop, this, std::ref(kernel), "yuzu:" + name);
+    }
+}
+
+ServiceThread::Impl::~Impl() {
+    {
+        std::unique_lock lock{queue_mutex};
+        stop = true;
+    }
+    condition.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ServiceThread::Impl::WorkerLoop(KernelCore& kernel, const std::string& thread_name) {
+    Common::SetCurrentThreadName(thread_name.c_str());
+    MicroProfileOnThreadCreate(thread_name.c_str());
+    kernel.RegisterHostThread();
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{queue_mutex};
+            condition.wait(lock, [this] { return stop || !requests.empty(); });
+            if (stop && requests.empty()) {
+                break;
+            }
+            task = std::move(requests.front());
+            requests.pop();
+        }
+        task();
+    }
+
+    MicroProfileOnThreadExit();
+}
+
+bool ServiceThread::Impl::IsCurrentThread() const {
+    const auto current_id = std::this_thread::get_id();
+    return std::any_of(threads.begin(), threads.end(), [current_id](const std::thread& thread) {
+        return thread.get_id() == current_id;
+    });
+}
+
+void ServiceThread::Impl::QueueSyncRequest(std::shared_ptr<ServerSession> session,
+                                           std::shared_ptr<HLERequestContext>&& context) {
+    {
+        std::unique_lock lock{queue_mutex};
+        requests.emplace([session = std::move(session), context = std::move(context)] {
+            MICROPROFILE_SCOPE(Kernel_ServiceThread);
+
+            // The service implementations and the kernel objects they touch are not thread-safe,
+            // so the request is completed under the HLE lock. Guest threads that are not in a
+            // syscall keep running while this happens.
+            std::lock_guard hle_lock{HLE::g_hle_lock};
+            session->CompleteSyncRequest(*context);
+        });
+    }
+    condition.notify_one();
+}
+
+ServiceThread::ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name)
+    : impl{std::make_unique<Impl>(kernel, num_threads, name)} {}
+
+ServiceThread::~ServiceThread() = default;
+
+void ServiceThread::QueueSyncRequest(std::shared_ptr<ServerSession> session,
+                                     std::shared_ptr<HLERequestContext>&& context) {
+    impl->QueueSyncRequest(std::move(session), std::move(context));
+}
+
+const std::string& ServiceThread::GetName() const {
+    return impl->GetName();
+}
+
+bool ServiceThread::IsCurrentThread() const {
+    return impl->IsCurrentThread();
+}
+
+} // namespace Kernel
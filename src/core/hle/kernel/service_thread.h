@@ -0,0 +1,42 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace Kernel {
+
+class HLERequestContext;
+class KernelCore;
+class ServerSession;
+
+/**
+ * Host thread (or pool of host threads) that services HLE IPC requests outside of the emulated CPU
+ * thread. The requesting guest thread stays in WaitIPC until the request has been completed on
+ * this thread, at which point it is woken through the scheduler. Requests queued to the same
+ * ServiceThread are completed in the order they were received when it has a single worker.
+ */
+class ServiceThread final {
+public:
+    explicit ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    ~ServiceThread();
+
+    /// Queues a request to be completed on this service thread.
+    void QueueSyncRequest(std::shared_ptr<ServerSession> session,
+                          std::shared_ptr<HLERequestContext>&& context);
+
+    /// Returns the name of this service thread, used for debugging purposes.
+    const std::string& GetName() const;
+
+    /// Returns true if the calling host thread is one of the threads of this service thread.
+    bool IsCurrentThread() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace Kernel
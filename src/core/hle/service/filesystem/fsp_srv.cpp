@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
@@ -13,6 +14,7 @@
 #include "common/common_types.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
+#include "common/span.h"
 #include "common/string_util.h"
 #include "core/file_sys/directory.h"
 #include "core/file_sys/errors.h"
@@ -27,6 +29,7 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/filesystem/fsp_srv.h"
+#include "core/hle/service/filesystem/read_ahead_cache.h"
 #include "core/reporter.h"
 
 namespace Service::FileSystem {
@@ -56,8 +59,10 @@ enum class FileSystemType : u8 {
 
 class IStorage final : public ServiceFramework<IStorage> {
 public:
-    explicit IStorage(FileSys::VirtualFile backend_)
-        : ServiceFramework("IStorage"), backend(std::move(backend_)) {
+    explicit IStorage(std::shared_ptr<ReadAheadCache> read_ahead_cache,
+                      FileSys::VirtualFile backend_)
+        : ServiceFramework("IStorage"), backend(std::move(backend_)),
+          stream(std::move(read_ahead_cache), backend) {
         static const FunctionInfo functions[] = {
             {0, &IStorage::Read, "Read"},
             {1, nullptr, "Write"},
@@ -71,6 +76,7 @@ public:
 
 private:
     FileSys::VirtualFile backend;
+    ReadAheadStream stream;
 
     void Read(Kernel::HLERequestContext& ctx) {
         IPC::RequestParser rp{ctx};
@@ -93,10 +99,10 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const Common::Span<u8> output = ctx.AcquireWriteBuffer();
+        const std::size_t read_size = std::min<std::size_t>(length, output.size());
+        ctx.CommitWriteBuffer(stream.Read(output.data(), read_size, offset));
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(RESULT_SUCCESS);
@@ -114,8 +120,10 @@ private:
 
 class IFile final : public ServiceFramework<IFile> {
 public:
-    explicit IFile(FileSys::VirtualFile backend_)
-        : ServiceFramework("IFile"), backend(std::move(backend_)) {
+    explicit IFile(std::shared_ptr<ReadAheadCache> read_ahead_cache_,
+                   FileSys::VirtualFile backend_)
+        : ServiceFramework("IFile"), backend(std::move(backend_)),
+          read_ahead_cache(std::move(read_ahead_cache_)), stream(read_ahead_cache, backend) {
         static const FunctionInfo functions[] = {
             {0, &IFile::Read, "Read"},       {1, &IFile::Write, "Write"},
             {2, &IFile::Flush, "Flush"},     {3, &IFile::SetSize, "SetSize"},
@@ -126,6 +134,8 @@ public:
 
 private:
     FileSys::VirtualFile backend;
+    std::shared_ptr<ReadAheadCache> read_ahead_cache;
+    ReadAheadStream stream;
 
     void Read(Kernel::HLERequestContext& ctx) {
         IPC::RequestParser rp{ctx};
@@ -150,15 +160,15 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const Common::Span<u8> output = ctx.AcquireWriteBuffer();
+        const std::size_t read_size = std::min<std::size_t>(length, output.size());
+        const std::size_t bytes_read =
+            ctx.CommitWriteBuffer(stream.Read(output.data(), read_size, offset));
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(RESULT_SUCCESS);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(bytes_read));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -184,16 +194,16 @@ private:
             return;
         }
 
-        const std::vector<u8> data = ctx.ReadBuffer();
+        const Common::Span<const u8> data = ctx.ReadBufferSpan();
 
         ASSERT_MSG(
             static_cast<s64>(data.size()) <= length,
             "Attempting to write more data than requested (requested={:016X}, actual={:016X}).",
             length, data.size());
 
-        // Write the data to the Storage backend
-        const auto write_size =
-            static_cast<std::size_t>(std::distance(data.begin(), data.begin() + length));
+        // Write the data to the Storage backend, the file may be read ahead by other interfaces
+        read_ahead_cache->Invalidate();
+        const auto write_size = std::min<std::size_t>(length, data.size());
         const std::size_t written = backend->Write(data.data(), write_size, offset);
 
         ASSERT_MSG(static_cast<s64>(written) == length,
@@ -218,6 +228,7 @@ private:
         const u64 size = rp.Pop<u64>();
         LOG_DEBUG(Service_FS, "called, size={}", size);
 
+        read_ahead_cache->Invalidate();
         backend->Resize(size);
 
         IPC::ResponseBuilder rb{ctx, 2};
@@ -302,8 +313,10 @@ private:
 
 class IFileSystem final : public ServiceFramework<IFileSystem> {
 public:
-    explicit IFileSystem(FileSys::VirtualDir backend, SizeGetter size)
-        : ServiceFramework("IFileSystem"), backend(std::move(backend)), size(std::move(size)) {
+    explicit IFileSystem(FileSys::VirtualDir backend, SizeGetter size,
+                         std::shared_ptr<ReadAheadCache> read_ahead_cache)
+        : ServiceFramework("IFileSystem"), backend(std::move(backend)), size(std::move(size)),
+          read_ahead_cache(std::move(read_ahead_cache)) {
         static const FunctionInfo functions[] = {
             {0, &IFileSystem::CreateFile, "CreateFile"},
             {1, &IFileSystem::DeleteFile, "DeleteFile"},
@@ -420,7 +433,7 @@ public:
             return;
         }
 
-        auto file = std::make_shared<IFile>(result.Unwrap());
+        auto file = std::make_shared<IFile>(read_ahead_cache, result.Unwrap());
 
         IPC::ResponseBuilder rb{ctx, 2, 0, 1};
         rb.Push(RESULT_SUCCESS);
@@ -496,6 +509,7 @@ public:
 private:
     VfsDirectoryServiceWrapper backend;
     SizeGetter size;
+    std::shared_ptr<ReadAheadCache> read_ahead_cache;
 };
 
 class ISaveDataInfoReader final : public ServiceFramework<ISaveDataInfoReader> {
@@ -648,7 +662,8 @@ private:
 };
 
 FSP_SRV::FSP_SRV(FileSystemController& fsc, const Core::Reporter& reporter)
-    : ServiceFramework("fsp-srv"), fsc(fsc), reporter(reporter) {
+    : ServiceFramework("fsp-srv", DefaultMaxSessions, ServiceThreadType::Dedicated), fsc(fsc),
+      read_ahead_cache(std::make_shared<ReadAheadCache>()), reporter(reporter) {
     // clang-format off
     static const FunctionInfo functions[] = {
         {0, nullptr, "OpenFileSystem"},
@@ -795,7 +810,8 @@ void FSP_SRV::OpenSdCardFileSystem(Kernel::HLERequestContext& ctx) {
     LOG_DEBUG(Service_FS, "called");
 
     auto filesystem = std::make_shared<IFileSystem>(
-        fsc.OpenSDMC().Unwrap(), SizeGetter::FromStorageId(fsc, FileSys::StorageId::SdCard));
+        fsc.OpenSDMC().Unwrap(), SizeGetter::FromStorageId(fsc, FileSys::StorageId::SdCard),
+        read_ahead_cache);
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
@@ -846,8 +862,8 @@ void FSP_SRV::OpenSaveDataFileSystem(Kernel::HLERequestContext& ctx) {
         id = FileSys::StorageId::NandSystem;
     }
 
-    auto filesystem =
-        std::make_shared<IFileSystem>(std::move(dir.Unwrap()), SizeGetter::FromStorageId(fsc, id));
+    auto filesystem = std::make_shared<IFileSystem>(
+        std::move(dir.Unwrap()), SizeGetter::FromStorageId(fsc, id), read_ahead_cache);
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
@@ -899,7 +915,7 @@ void FSP_SRV::OpenDataStorageByCurrentProcess(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    auto storage = std::make_shared<IStorage>(std::move(romfs.Unwrap()));
+    auto storage = std::make_shared<IStorage>(read_ahead_cache, std::move(romfs.Unwrap()));
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
@@ -923,7 +939,7 @@ void FSP_SRV::OpenDataStorageByDataId(Kernel::HLERequestContext& ctx) {
         if (archive != nullptr) {
             IPC::ResponseBuilder rb{ctx, 2, 0, 1};
             rb.Push(RESULT_SUCCESS);
-            rb.PushIpcInterface(std::make_shared<IStorage>(archive));
+            rb.PushIpcInterface(std::make_shared<IStorage>(read_ahead_cache, archive));
             return;
         }
 
@@ -939,6 +955,7 @@ void FSP_SRV::OpenDataStorageByDataId(Kernel::HLERequestContext& ctx) {
     FileSys::PatchManager pm{title_id};
 
     auto storage = std::make_shared<IStorage>(
+        read_ahead_cache,
         pm.PatchRomFS(std::move(data.Unwrap()), 0, FileSys::ContentRecordType::Data));
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
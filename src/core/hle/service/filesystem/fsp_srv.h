@@ -17,6 +17,8 @@ class FileSystemBackend;
 
 namespace Service::FileSystem {
 
+class ReadAheadCache;
+
 enum class AccessLogVersion : u32 {
     V7_0_0 = 2,
 
@@ -52,6 +54,7 @@ private:
     void GetAccessLogVersionInfo(Kernel::HLERequestContext& ctx);
 
     FileSystemController& fsc;
+    std::shared_ptr<ReadAheadCache> read_ahead_cache;
 
     FileSys::VirtualFile romfs;
     u64 current_process_id = 0;
@@ -0,0 +1,180 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "common/microprofile.h"
+#include "core/file_sys/vfs.h"
+#include "core/hle/service/filesystem/read_ahead_cache.h"
+
+MICROPROFILE_DEFINE(Service_FS_ReadAhead, "Service", "FS Read Ahead", MP_RGB(96, 160, 224));
+
+namespace Service::FileSystem {
+
+namespace {
+/// Number of host threads reading ahead, host file reads are serialized but decryption is not.
+constexpr std::size_t NUM_READ_AHEAD_THREADS = 2;
+
+/// Number of consecutive sequential reads after which a file is read ahead.
+constexpr u32 SEQUENTIAL_READ_THRESHOLD = 2;
+
+/// The read ahead window starts small and doubles with every sequential read, up to 4 MiB.
+constexpr std::size_t MIN_WINDOW_BLOCKS = 2;
+constexpr std::size_t MAX_WINDOW_BLOCKS = 16;
+} // Anonymous namespace
+
+ReadAheadCache::ReadAheadCache() : worker(NUM_READ_AHEAD_THREADS, "yuzu:FSReadAhead") {}
+
+ReadAheadCache::~ReadAheadCache() = default;
+
+void ReadAheadCache::Invalidate() {
+    std::lock_guard lock{mutex};
+    entries.clear();
+    lookup.clear();
+}
+
+std::size_t ReadAheadCache::ReadCached(u64 stream_id, u8* data, std::size_t length,
+                                       std::size_t offset) {
+    std::size_t copied = 0;
+    std::unique_lock lock{mutex};
+    while (copied < length) {
+        const std::size_t position = offset + copied;
+        const Key key{stream_id, position / BLOCK_SIZE};
+        const auto iter = lookup.find(key);
+        if (iter == lookup.end()) {
+            break;
+        }
+
+        // Hold a reference, the block could be evicted while it is being waited on or copied.
+        const std::shared_ptr<Block> block = iter->second->block;
+        block_ready.wait(lock, [&block] { return block->ready; });
+
+        const std::size_t block_offset = position % BLOCK_SIZE;
+        const std::size_t block_size = block->data.size();
+        if (block_offset >= block_size) {
+            break;
+        }
+        const std::size_t copy_size = std::min(length - copied, block_size - block_offset);
+
+        // Ready blocks are never modified again, so they can be copied without the lock.
+        lock.unlock();
+        std::memcpy(data + copied, block->data.data() + block_offset, copy_size);
+        lock.lock();
+        copied += copy_size;
+
+        const auto current = lookup.find(key);
+        if (current != lookup.end() && current->second->block == block) {
+            if (block_offset + copy_size == block_size) {
+                entries.erase(current->second);
+                lookup.erase(current);
+            } else {
+                entries.splice(entries.begin(), entries, current->second);
+            }
+        }
+
+        // A short block ends at the end of the file or where reading it failed.
+        if (block_size < BLOCK_SIZE) {
+            break;
+        }
+    }
+    return copied;
+}
+
+void ReadAheadCache::QueueBlock(u64 stream_id, u64 block_index, FileSys::VirtualFile file) {
+    const Key key{stream_id, block_index};
+    std::shared_ptr<Block> block;
+    {
+        std::lock_guard lock{mutex};
+        if (lookup.find(key) != lookup.end()) {
+            return;
+        }
+        block = std::make_shared<Block>();
+        while (!entries.empty() && (entries.size() + 1) * BLOCK_SIZE > MAX_CACHED_BYTES) {
+            lookup.erase(entries.back().key);
+            entries.pop_back();
+        }
+        entries.push_front({key, block});
+        lookup.emplace(key, entries.begin());
+    }
+
+    worker.QueueWork([this, block = std::move(block), file = std::move(file), block_index] {
+        MICROPROFILE_SCOPE(Service_FS_ReadAhead);
+
+        std::vector<u8> data(BLOCK_SIZE);
+        data.resize(file->Read(data.data(), data.size(), block_index * BLOCK_SIZE));
+        {
+            std::lock_guard lock{mutex};
+            block->data = std::move(data);
+            block->ready = true;
+        }
+        block_ready.notify_all();
+    });
+}
+
+void ReadAheadCache::EraseStream(u64 stream_id) {
+    std::lock_guard lock{mutex};
+    for (auto iter = entries.begin(); iter != entries.end();) {
+        if (iter->key.stream_id == stream_id) {
+            lookup.erase(iter->key);
+            iter = entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+ReadAheadStream::ReadAheadStream(std::shared_ptr<ReadAheadCache> cache_, FileSys::VirtualFile file_)
+    : cache{std::move(cache_)}, file{std::move(file_)}, is_enabled{!file->IsWritable()},
+      window_blocks{MIN_WINDOW_BLOCKS} {
+    std::lock_guard lock{cache->mutex};
+    stream_id = cache->next_stream_id++;
+}
+
+ReadAheadStream::~ReadAheadStream() {
+    cache->EraseStream(stream_id);
+}
+
+std::size_t ReadAheadStream::Read(u8* data, std::size_t length, std::size_t offset) {
+    if (!is_enabled) {
+        return file->Read(data, length, offset);
+    }
+
+    const std::size_t file_size = file->GetSize();
+    if (offset >= file_size) {
+        return 0;
+    }
+    length = std::min(length, file_size - offset);
+
+    if (offset == next_offset) {
+        ++sequential_reads;
+    } else {
+        sequential_reads = 0;
+        window_blocks = MIN_WINDOW_BLOCKS;
+    }
+    next_offset = offset + length;
+
+    std::size_t read = cache->ReadCached(stream_id, data, length, offset);
+    if (read < length) {
+        read += file->Read(data + read, length - read, offset + read);
+    }
+
+    if (sequential_reads >= SEQUENTIAL_READ_THRESHOLD) {
+        ReadAhead(offset + length, file_size);
+    }
+    return read;
+}
+
+void ReadAheadStream::ReadAhead(std::size_t end_offset, std::size_t file_size) {
+    constexpr std::size_t block_size = ReadAheadCache::BLOCK_SIZE;
+    const u64 first_block = end_offset / block_size;
+    const u64 end_block =
+        std::min<u64>(first_block + window_blocks, (file_size + block_size - 1) / block_size);
+    for (u64 block = first_block; block < end_block; ++block) {
+        cache->QueueBlock(stream_id, block, file);
+    }
+    window_blocks = std::min(window_blocks * 2, MAX_WINDOW_BLOCKS);
+}
+
+} // namespace Service::FileSystem
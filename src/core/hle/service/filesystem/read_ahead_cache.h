@@ -0,0 +1,119 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/vfs_types.h"
+
+namespace Service::FileSystem {
+
+/**
+ * Bounded cache of file blocks read ahead of the guest on a pool of host threads. There is one per
+ * FSP_SRV instance, shared by every IStorage and IFile it opens, each of which reads through a
+ * ReadAheadStream that detects when its file is being read sequentially.
+ */
+class ReadAheadCache final {
+public:
+    static constexpr std::size_t BLOCK_SIZE = 0x40000;
+    static constexpr std::size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;
+
+    ReadAheadCache();
+    ~ReadAheadCache();
+
+    /// Drops every cached block, called whenever a file is modified through fsp-srv.
+    void Invalidate();
+
+private:
+    friend class ReadAheadStream;
+
+    struct Block {
+        std::vector<u8> data;
+        bool ready = false;
+    };
+
+    struct Key {
+        u64 stream_id;
+        u64 block;
+
+        bool operator==(const Key& rhs) const {
+            return stream_id == rhs.stream_id && block == rhs.block;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return static_cast<std::size_t>(key.stream_id ^ (key.block * 0x9E3779B97F4A7C15ULL));
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<Block> block;
+    };
+
+    /**
+     * Copies the leading part of [offset, offset + length) that is held by the cache, waiting for
+     * blocks that are still being read. Blocks copied up to their end are dropped, as a guest
+     * streaming a file does not read them again.
+     * @returns The number of bytes copied.
+     */
+    std::size_t ReadCached(u64 stream_id, u8* data, std::size_t length, std::size_t offset);
+
+    /// Queues a block to be read ahead, unless it is already cached or being read.
+    void QueueBlock(u64 stream_id, u64 block_index, FileSys::VirtualFile file);
+
+    /// Drops the cached blocks of a stream, called when it is closed.
+    void EraseStream(u64 stream_id);
+
+    std::mutex mutex;
+    std::condition_variable block_ready;
+    // Most recently used entries are at the front.
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+    u64 next_stream_id = 0;
+
+    // Declared last so queued reads are completed before the rest of the cache is destroyed.
+    Common::ThreadWorker worker;
+};
+
+/// Reads a file opened through fsp-srv, reading ahead of the guest while it reads sequentially.
+class ReadAheadStream final {
+public:
+    explicit ReadAheadStream(std::shared_ptr<ReadAheadCache> cache, FileSys::VirtualFile file);
+    ~ReadAheadStream();
+
+    ReadAheadStream(const ReadAheadStream&) = delete;
+    ReadAheadStream& operator=(const ReadAheadStream&) = delete;
+
+    /**
+     * Reads from the file straight into data, which is usually guest memory. Cached blocks are
+     * copied, the rest is read from the file on the calling thread. Writable files are always
+     * read directly.
+     * @returns The number of bytes read.
+     */
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset);
+
+private:
+    /// Queues the blocks following a sequential read, growing the window with every such read.
+    void ReadAhead(std::size_t end_offset, std::size_t file_size);
+
+    std::shared_ptr<ReadAheadCache> cache;
+    FileSys::VirtualFile file;
+    u64 stream_id;
+    bool is_enabled;
+
+    std::size_t next_offset = 0;   ///< Offset a sequential read would start at
+    u32 sequential_reads = 0;      ///< Number of consecutive sequential reads
+    std::size_t window_blocks = 0; ///< Number of blocks kept read ahead of the guest
+};
+
+} // namespace Service::FileSystem
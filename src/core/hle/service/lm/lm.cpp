@@ -81,7 +81,8 @@ private:
 class LM final : public ServiceFramework<LM> {
 public:
     explicit LM(Manager& manager_, Memory::Memory& memory_)
-        : ServiceFramework{"lm"}, manager{manager_}, memory{memory_} {
+        : ServiceFramework{"lm", DefaultMaxSessions, ServiceThreadType::Dedicated},
+          manager{manager_}, memory{memory_} {
         // clang-format off
         static const FunctionInfo functions[] = {
             {0, &LM::OpenLogger, "OpenLogger"},
@@ -14,6 +14,7 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_port.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/service/acc/acc.h"
 #include "core/hle/service/am/am.h"
@@ -92,13 +93,29 @@ namespace Service {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ServiceFrameworkBase::ServiceFrameworkBase(const char* service_name, u32 max_sessions,
+                                           ServiceThreadType thread_type,
                                            InvokerFn* handler_invoker)
-    : service_name(service_name), max_sessions(max_sessions), handler_invoker(handler_invoker) {}
+    : service_name(service_name), max_sessions(max_sessions), thread_type(thread_type),
+      handler_invoker(handler_invoker) {}
 
-ServiceFrameworkBase::~ServiceFrameworkBase() = default;
+ServiceFrameworkBase::~ServiceFrameworkBase() {
+    if (owns_service_thread) {
+        Core::System::GetInstance().Kernel().ReleaseServiceThread(service_thread);
+    }
+}
+
+void ServiceFrameworkBase::CreateServiceThread() {
+    if (thread_type != ServiceThreadType::Dedicated) {
+        return;
+    }
+
+    service_thread = Core::System::GetInstance().Kernel().CreateServiceThread(service_name);
+    owns_service_thread = true;
+}
 
 void ServiceFrameworkBase::InstallAsService(SM::ServiceManager& service_manager) {
     ASSERT(!port_installed);
+    CreateServiceThread();
 
     auto port = service_manager.RegisterService(service_name, max_sessions).Unwrap();
     port->SetHleHandler(shared_from_this());
@@ -107,6 +124,7 @@ void ServiceFrameworkBase::InstallAsService(SM::ServiceManager& service_manager)
 
 void ServiceFrameworkBase::InstallAsNamedPort() {
     ASSERT(!port_installed);
+    CreateServiceThread();
 
     auto& kernel = Core::System::GetInstance().Kernel();
     auto [server_port, client_port] =
@@ -118,6 +136,7 @@ void ServiceFrameworkBase::InstallAsNamedPort() {
 
 std::shared_ptr<Kernel::ClientPort> ServiceFrameworkBase::CreatePort() {
     ASSERT(!port_installed);
+    CreateServiceThread();
 
     auto& kernel = Core::System::GetInstance().Kernel();
     auto [server_port, client_port] =
@@ -39,6 +39,14 @@ static const int kMaxPortSize = 8; ///< Maximum size of a port name (8 character
 /// Arbitrary default number of maximum connections to an HLE service.
 static const u32 DefaultMaxSessions = 10;
 
+/// Specifies where the requests made to an HLE service are completed.
+enum class ServiceThreadType {
+    /// Requests are completed synchronously on the emulated CPU thread.
+    Synchronous,
+    /// Requests are completed on a host thread dedicated to the service.
+    Dedicated,
+};
+
 /**
  * This is an non-templated base of ServiceFramework to reduce code bloat and compilation times, it
  * is not meant to be used directly.
@@ -89,9 +97,13 @@ private:
     using InvokerFn = void(ServiceFrameworkBase* object, HandlerFnP<ServiceFrameworkBase> member,
                            Kernel::HLERequestContext& ctx);
 
-    ServiceFrameworkBase(const char* service_name, u32 max_sessions, InvokerFn* handler_invoker);
+    ServiceFrameworkBase(const char* service_name, u32 max_sessions, ServiceThreadType thread_type,
+                         InvokerFn* handler_invoker);
     ~ServiceFrameworkBase() override;
 
+    /// Creates the service thread for this service, unless it runs synchronously.
+    void CreateServiceThread();
+
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(Kernel::HLERequestContext& ctx, const FunctionInfoBase* info);
 
@@ -99,10 +111,14 @@ private:
     std::string service_name;
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
+    /// Where requests made to this service are completed.
+    ServiceThreadType thread_type;
 
     /// Flag to store if a port was already create/installed to detect multiple install attempts,
     /// which is not supported.
     bool port_installed = false;
+    /// Flag to store if this service created (and thus must release) its service thread.
+    bool owns_service_thread = false;
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
@@ -149,9 +165,13 @@ protected:
      * Initializes the handler with no functions installed.
      * @param max_sessions Maximum number of sessions that can be
      * connected to this service at the same time.
+     * @param thread_type Where requests made to this service are completed. Only services that
+     * have been audited to not share state with core timing callbacks or the GPU should use
+     * ServiceThreadType::Dedicated.
      */
-    explicit ServiceFramework(const char* service_name, u32 max_sessions = DefaultMaxSessions)
-        : ServiceFrameworkBase(service_name, max_sessions, Invoker) {}
+    explicit ServiceFramework(const char* service_name, u32 max_sessions = DefaultMaxSessions,
+                              ServiceThreadType thread_type = ServiceThreadType::Synchronous)
+        : ServiceFrameworkBase(service_name, max_sessions, thread_type, Invoker) {}
 
     /// Registers handlers in the service.
     template <std::size_t N>
@@ -2,11 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cinttypes>
 #include <cstring>
 #include "common/common_funcs.h"
 #include "common/file_util.h"
 #include "common/logging/log.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
@@ -135,21 +137,45 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
 
     const FileSys::PatchManager pm(metadata.GetTitleID());
 
+    // Read all NSO modules up front, decompressing and verifying their segments in parallel while
+    // the remaining modules are still being read.
+    static constexpr std::array<const char*, 11> module_names{
+        "rtld",    "main",    "subsdk0", "subsdk1", "subsdk2", "subsdk3",
+        "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk",
+    };
+    std::array<FileSys::VirtualFile, module_names.size()> module_files;
+    std::array<std::unique_ptr<AppLoader_NSO::PendingModule>, module_names.size()> pending_modules;
+    {
+        Common::ThreadWorker worker(0, "yuzu:NSODecoder");
+        for (std::size_t i = 0; i < module_names.size(); ++i) {
+            module_files[i] = dir->GetFile(module_names[i]);
+            if (module_files[i] == nullptr) {
+                continue;
+            }
+
+            pending_modules[i] = AppLoader_NSO::ReadModule(*module_files[i], worker);
+            if (!pending_modules[i]) {
+                return {ResultStatus::ErrorLoadingNSO, {}};
+            }
+        }
+        worker.WaitForRequests();
+    }
+
     // Load NSO modules
     modules.clear();
     const VAddr base_address = process.VMManager().GetCodeRegionBaseAddress();
     VAddr next_load_addr = base_address;
-    for (const auto& module : {"rtld", "main", "subsdk0", "subsdk1", "subsdk2", "subsdk3",
-                               "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"}) {
-        const FileSys::VirtualFile module_file = dir->GetFile(module);
-        if (module_file == nullptr) {
+    for (std::size_t i = 0; i < module_names.size(); ++i) {
+        if (!pending_modules[i]) {
             continue;
         }
 
+        const char* const module = module_names[i];
         const VAddr load_addr = next_load_addr;
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr =
-            AppLoader_NSO::LoadModule(process, *module_file, load_addr, should_pass_arguments, pm);
+            AppLoader_NSO::LoadModule(process, *module_files[i], *pending_modules[i], load_addr,
+                                      should_pass_arguments, pm);
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
@@ -5,6 +5,7 @@
 #include <cinttypes>
 #include <cstring>
 #include <vector>
+#include <mbedtls/sha256.h>
 
 #include "common/common_funcs.h"
 #include "common/file_util.h"
@@ -12,6 +13,7 @@
 #include "common/logging/log.h"
 #include "common/lz4_compression.h"
 #include "common/swap.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/gdbstub/gdbstub.h"
@@ -56,6 +58,11 @@ bool NSOHeader::IsSegmentCompressed(size_t segment_num) const {
     return ((flags >> segment_num) & 1) != 0;
 }
 
+bool NSOHeader::IsSegmentHashChecked(size_t segment_num) const {
+    ASSERT_MSG(segment_num < 3, "Invalid segment {}", segment_num);
+    return ((flags >> (segment_num + 3)) & 1) != 0;
+}
+
 AppLoader_NSO::AppLoader_NSO(FileSys::VirtualFile file) : AppLoader(std::move(file)) {}
 
 FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& file) {
@@ -71,32 +78,74 @@ FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& file) {
     return FileType::NSO;
 }
 
-std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process,
-                                               const FileSys::VfsFile& file, VAddr load_base,
-                                               bool should_pass_arguments,
-                                               std::optional<FileSys::PatchManager> pm) {
+std::unique_ptr<AppLoader_NSO::PendingModule> AppLoader_NSO::ReadModule(
+    const FileSys::VfsFile& file, Common::ThreadWorker& worker) {
     if (file.GetSize() < sizeof(NSOHeader)) {
-        return {};
+        return nullptr;
     }
 
-    NSOHeader nso_header{};
+    auto module = std::make_unique<PendingModule>();
+    NSOHeader& nso_header = module->header;
     if (sizeof(NSOHeader) != file.ReadObject(&nso_header)) {
-        return {};
+        return nullptr;
     }
 
     if (nso_header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
+        return nullptr;
+    }
+
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        std::vector<u8> data =
+            file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
+
+        // The module is heap allocated, so pointers into it stay valid while the work is pending
+        worker.QueueWork([module = module.get(), i, data = std::move(data)]() mutable {
+            const NSOHeader& header = module->header;
+            if (header.IsSegmentCompressed(i)) {
+                data = DecompressSegment(data, header.segments[i]);
+            }
+            if (header.IsSegmentHashChecked(i)) {
+                NSOHeader::SHA256Hash hash{};
+                mbedtls_sha256_ret(data.data(), data.size(), hash.data(), 0);
+                module->hash_matches[i] = hash == header.segment_hashes[i];
+            }
+            module->segments[i] = std::move(data);
+        });
+    }
+
+    return module;
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process,
+                                               const FileSys::VfsFile& file, VAddr load_base,
+                                               bool should_pass_arguments,
+                                               std::optional<FileSys::PatchManager> pm) {
+    Common::ThreadWorker worker(3, "yuzu:NSODecoder");
+    const auto module = ReadModule(file, worker);
+    worker.WaitForRequests();
+    if (!module) {
         return {};
     }
 
+    return LoadModule(process, file, *module, load_base, should_pass_arguments, std::move(pm));
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process,
+                                               const FileSys::VfsFile& file,
+                                               PendingModule& module, VAddr load_base,
+                                               bool should_pass_arguments,
+                                               std::optional<FileSys::PatchManager> pm) {
+    NSOHeader& nso_header = module.header;
+
     // Build program image
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data =
-            file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+        if (!module.hash_matches[i]) {
+            LOG_ERROR(Loader, "Hash mismatch in segment {} of module {}", i, file.GetName());
         }
+
+        const std::vector<u8>& data = module.segments[i];
         program_image.resize(nso_header.segments[i].location +
                              PageAlignSize(static_cast<u32>(data.size())));
         std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
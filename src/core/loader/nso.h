@@ -5,13 +5,19 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <type_traits>
+#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/loader/loader.h"
 
+namespace Common {
+class ThreadWorker;
+}
+
 namespace Kernel {
 class Process;
 }
@@ -51,6 +57,7 @@ struct NSOHeader {
     std::array<SHA256Hash, 3> segment_hashes;
 
     bool IsSegmentCompressed(size_t segment_num) const;
+    bool IsSegmentHashChecked(size_t segment_num) const;
 };
 static_assert(sizeof(NSOHeader) == 0x100, "NSOHeader has incorrect size.");
 static_assert(std::is_trivially_copyable_v<NSOHeader>, "NSOHeader must be trivially copyable.");
@@ -82,10 +89,38 @@ public:
         return IdentifyType(file);
     }
 
+    /// NSO module whose segments have been read and are being decoded on a ThreadWorker.
+    struct PendingModule {
+        NSOHeader header{};
+        /// Decompressed segments, only valid once the worker has finished its requests.
+        std::array<std::vector<u8>, 3> segments;
+        /// Whether the hash of each segment matched its header, when hash checking is enabled.
+        std::array<bool, 3> hash_matches{true, true, true};
+    };
+
+    /**
+     * Reads the segments of an NSO module and queues their decompression and hash verification on
+     * the given worker. The worker must have finished its requests before the returned module is
+     * passed to LoadModule.
+     *
+     * Reads are done on the calling thread, as the VFS stack is not safe to read from several
+     * threads at once.
+     *
+     * @returns The pending module, or nullptr if the file is not a valid NSO.
+     */
+    static std::unique_ptr<PendingModule> ReadModule(const FileSys::VfsFile& file,
+                                                     Common::ThreadWorker& worker);
+
     static std::optional<VAddr> LoadModule(Kernel::Process& process, const FileSys::VfsFile& file,
                                            VAddr load_base, bool should_pass_arguments,
                                            std::optional<FileSys::PatchManager> pm = {});
 
+    /// Lays out a decoded module in the given process, applying patches and cheats.
+    static std::optional<VAddr> LoadModule(Kernel::Process& process, const FileSys::VfsFile& file,
+                                           PendingModule& module, VAddr load_base,
+                                           bool should_pass_arguments,
+                                           std::optional<FileSys::PatchManager> pm = {});
+
     LoadResult Load(Kernel::Process& process) override;
 
     ResultStatus ReadNSOModules(Modules& modules) override;
@@ -164,6 +164,24 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    u8* GetContiguousPointer(const VAddr vaddr, const std::size_t size) {
+        // Pages that are mapped to the same host allocation share the same pointer entry, as
+        // entries are stored relative to the virtual address of the page.
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + std::max<std::size_t>(size, 1) - 1) >> PAGE_BITS;
+        u8* const page_pointer = current_page_table->pointers[first_page];
+        if (page_pointer == nullptr) {
+            return nullptr;
+        }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            if (current_page_table->pointers[page] != page_pointer) {
+                return nullptr;
+            }
+        }
+
+        return page_pointer + vaddr;
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -651,6 +669,14 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+u8* Memory::GetContiguousPointer(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer(vaddr, size);
+}
+
+const u8* Memory::GetContiguousPointer(VAddr vaddr, std::size_t size) const {
+    return impl->GetContiguousPointer(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
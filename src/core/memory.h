@@ -173,6 +173,32 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a pointer to the given address range, if the whole range is backed by contiguous host
+     * memory that can be accessed directly.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The pointer to the given address, if the range is contiguous in host memory.
+     *          If the range crosses unmapped, special or rasterizer cached pages, or pages that
+     *          belong to different host allocations, nullptr will be returned.
+     */
+    u8* GetContiguousPointer(VAddr vaddr, std::size_t size);
+
+    /**
+     * Gets a pointer to the given address range, if the whole range is backed by contiguous host
+     * memory that can be accessed directly.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The pointer to the given address, if the range is contiguous in host memory.
+     *          If the range crosses unmapped, special or rasterizer cached pages, or pages that
+     *          belong to different host allocations, nullptr will be returned.
+     */
+    const u8* GetContiguousPointer(VAddr vaddr, std::size_t size) const;
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
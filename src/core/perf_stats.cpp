@@ -100,6 +100,10 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     results.frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                         static_cast<double>(system_frames);
     results.emulation_speed = system_us_per_second.count() / 1'000'000.0;
+    if (audio_latency_samples != 0) {
+        results.audio_latency = duration_cast<DoubleSecs>(accumulated_audio_latency).count() /
+                                static_cast<double>(audio_latency_samples);
+    }
 
     // Reset counters
     reset_point = now;
@@ -107,6 +111,8 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     game_frames = 0;
+    accumulated_audio_latency = microseconds::zero();
+    audio_latency_samples = 0;
 
     target_fps = static_cast<u32>(results.game_fps / results.emulation_speed);
 
@@ -120,6 +126,13 @@ double PerfStats::GetLastFrameTimeScale() {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
+void PerfStats::AddAudioLatency(microseconds latency) {
+    std::lock_guard lock{object_mutex};
+
+    accumulated_audio_latency += latency;
+    audio_latency_samples += 1;
+}
+
 void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
     if (!Settings::values.use_frame_limit) {
         return;
@@ -21,6 +21,8 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Mean time between audio being rendered and heard, in seconds, zero if not measured
+    double audio_latency;
 };
 
 /**
@@ -52,6 +54,9 @@ public:
      */
     double GetLastFrameTimeScale();
 
+    /// Records the measured latency of the audio output
+    void AddAudioLatency(std::chrono::microseconds latency);
+
 private:
     std::mutex object_mutex{};
 
@@ -74,6 +79,10 @@ private:
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     u32 game_frames = 0;
+    /// Cumulative audio latency measurements since last reset
+    std::chrono::microseconds accumulated_audio_latency{0};
+    /// Number of audio latency measurements since last reset
+    u32 audio_latency_samples = 0;
 
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
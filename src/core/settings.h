@@ -374,6 +374,7 @@ enum class SDMCSize : u64 {
 enum class RendererBackend {
     OpenGL = 0,
     Vulkan = 1,
+    Null = 2,
 };
 
 struct Values {
@@ -417,6 +418,7 @@ struct Values {
 
     // Data Storage
     bool use_virtual_sd;
+    bool use_extracted_content_cache;
     bool gamecard_inserted;
     bool gamecard_current_game;
     std::string gamecard_path;
@@ -436,6 +438,7 @@ struct Values {
     bool use_frame_limit;
     u16 frame_limit;
     bool use_disk_shader_cache;
+    bool use_shader_optimizations;
     bool use_accurate_gpu_emulation;
     bool use_asynchronous_gpu_emulation;
     bool use_vsync;
@@ -453,6 +456,8 @@ struct Values {
     std::string sink_id;
     bool enable_audio_stretching;
     bool enable_realtime_audio;
+    bool enable_low_latency_audio;
+    u16 audio_stretch_threshold;
     std::string audio_device_id;
     float volume;
 
@@ -463,6 +468,8 @@ struct Values {
     std::string program_args;
     bool dump_exefs;
     bool dump_nso;
+    bool dump_audio_renderer;
+    bool dump_gpu_commands;
     bool reporting_services;
     bool quest_flag;
 
@@ -52,6 +52,8 @@ static const char* TranslateRenderer(Settings::RendererBackend backend) {
         return "OpenGL";
     case Settings::RendererBackend::Vulkan:
         return "Vulkan";
+    case Settings::RendererBackend::Null:
+        return "Null";
     }
     return "Unknown";
 }
@@ -179,6 +181,7 @@ void TelemetrySession::AddInitialInfo(Loader::AppLoader& app_loader) {
     AddField(field_type, "Audio_SinkId", Settings::values.sink_id);
     AddField(field_type, "Audio_EnableAudioStretching", Settings::values.enable_audio_stretching);
     AddField(field_type, "Audio_EnableRealTime", Settings::values.enable_realtime_audio);
+    AddField(field_type, "Audio_EnableLowLatency", Settings::values.enable_low_latency_audio);
     AddField(field_type, "Core_UseMultiCore", Settings::values.use_multi_core);
     AddField(field_type, "Renderer_Backend", TranslateRenderer(Settings::values.renderer_backend));
     AddField(field_type, "Renderer_ResolutionFactor", Settings::values.resolution_factor);
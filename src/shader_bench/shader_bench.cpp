@@ -0,0 +1,223 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+// Decodes and decompiles the guest shaders stored in transferable OpenGL shader caches, without a
+// game or a GL context, and reports how long each stage of the shader pipeline takes. Passing the
+// caches of a few games gives a reproducible corpus to measure shader compiler changes against.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/guest_driver.h"
+#include "video_core/renderer_opengl/gl_device.h"
+#include "video_core/renderer_opengl/gl_shader_decompiler.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/shader/compiler_settings.h"
+#include "video_core/shader/memory_util.h"
+#include "video_core/shader/registry.h"
+#include "video_core/shader/shader_ir.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Tegra::Engines::ShaderType;
+using VideoCommon::Shader::CompilerSettings;
+using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
+using VideoCommon::Shader::Registry;
+using VideoCommon::Shader::ShaderIR;
+using VideoCommon::Shader::STAGE_MAIN_OFFSET;
+
+struct Timings {
+    Clock::duration decode{};
+    Clock::duration decompile{};
+    std::size_t shaders{};
+    std::size_t glsl_size{};
+};
+
+/// Loads every entry of a transferable cache, returns false if the file can't be parsed
+bool LoadCorpus(const std::string& path, std::vector<OpenGL::ShaderDiskCacheEntry>& entries) {
+    FileUtil::IOFile file{path, "rb"};
+    if (!file.IsOpen()) {
+        LOG_CRITICAL(Render_OpenGL, "Failed to open shader cache {}", path);
+        return false;
+    }
+    u32 version{};
+    if (file.ReadBytes(&version, sizeof(version)) != sizeof(version)) {
+        LOG_CRITICAL(Render_OpenGL, "Failed to read the version of shader cache {}", path);
+        return false;
+    }
+    const std::size_t first_entry = entries.size();
+    while (file.Tell() < file.GetSize()) {
+        if (!entries.emplace_back().Load(file)) {
+            LOG_CRITICAL(Render_OpenGL,
+                         "Failed to load entry {} of shader cache {} with version {}, it may "
+                         "have been written by a different version of the emulator",
+                         entries.size() - first_entry - 1, path, version);
+            return false;
+        }
+    }
+    LOG_INFO(Render_OpenGL, "Loaded {} shaders from {}", entries.size() - first_entry, path);
+    return true;
+}
+
+std::unique_ptr<Registry> MakeRegistry(const OpenGL::ShaderDiskCacheEntry& entry) {
+    const VideoCore::GuestDriverProfile guest_profile{entry.texture_handler_size};
+    const VideoCommon::Shader::SerializedRegistryInfo info{guest_profile, entry.bound_buffer,
+                                                           entry.graphics_info, entry.compute_info};
+    auto registry = std::make_unique<Registry>(entry.type, info);
+    for (const auto& [address, value] : entry.keys) {
+        const auto [buffer, offset] = address;
+        registry->InsertKey(buffer, offset, value);
+    }
+    for (const auto& [offset, sampler] : entry.bound_samplers) {
+        registry->InsertBoundSampler(offset, sampler);
+    }
+    for (const auto& [key, sampler] : entry.bindless_samplers) {
+        const auto [buffer, offset] = key;
+        registry->InsertBindlessSampler(buffer, offset, sampler);
+    }
+    return registry;
+}
+
+void RunPass(const OpenGL::Device& device, const CompilerSettings& settings,
+             const std::vector<OpenGL::ShaderDiskCacheEntry>& entries, Timings& timings) {
+    for (const auto& entry : entries) {
+        const auto registry = MakeRegistry(entry);
+        const u32 main_offset =
+            entry.type == ShaderType::Compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+
+        const auto decode_start = Clock::now();
+        const ShaderIR ir(entry.code, main_offset, settings, *registry);
+        const auto decompile_start = Clock::now();
+        const std::string glsl = OpenGL::DecompileShader(device, ir, *registry, entry.type,
+                                                         "bench");
+        const auto end = Clock::now();
+
+        timings.decode += decompile_start - decode_start;
+        timings.decompile += end - decompile_start;
+        timings.glsl_size += glsl.size();
+        ++timings.shaders;
+    }
+}
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <transferable cache>...\n"
+                 "-i, --iterations=N    Decode and decompile the corpus N times\n"
+                 "-o, --optimize        Run the IR optimization passes\n"
+                 "-f, --full-decompile  Decompile the control flow to structured code\n"
+                 "-h, --help            Display this help and exit\n";
+}
+
+void InitializeLogging() {
+    Log::Filter log_filter(Log::Level::Info);
+    Log::SetGlobalFilter(log_filter);
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    InitializeLogging();
+
+    std::vector<std::string> cache_paths;
+    u32 iterations{1};
+    CompilerSettings settings;
+
+    int option_index = 0;
+    static struct option long_options[] = {
+        {"iterations", required_argument, 0, 'i'},
+        {"optimize", no_argument, 0, 'o'},
+        {"full-decompile", no_argument, 0, 'f'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "i:ofh", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'i':
+                iterations = static_cast<u32>(std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'o':
+                settings.optimize = true;
+                break;
+            case 'f':
+                settings.depth = VideoCommon::Shader::CompileDepth::FullDecompile;
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            default:
+                PrintHelp(argv[0]);
+                return -1;
+            }
+        } else {
+            cache_paths.emplace_back(argv[optind]);
+            optind++;
+        }
+    }
+
+    if (cache_paths.empty() || iterations == 0) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    std::vector<OpenGL::ShaderDiskCacheEntry> entries;
+    for (const auto& path : cache_paths) {
+        if (!LoadCorpus(path, entries)) {
+            return -1;
+        }
+    }
+
+    // Decompile for a device with every optional feature, no GL calls are made
+    const OpenGL::Device device{nullptr};
+
+    // The first pass warms up the allocator and the reusable buffers, it isn't measured
+    Timings warmup;
+    RunPass(device, settings, entries, warmup);
+
+    Timings timings;
+    for (u32 i = 0; i < iterations; ++i) {
+        RunPass(device, settings, entries, timings);
+    }
+
+    const auto to_ms = [](Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    const double decode_ms = to_ms(timings.decode);
+    const double decompile_ms = to_ms(timings.decompile);
+    const double total_ms = decode_ms + decompile_ms;
+    std::cout << fmt::format("Processed {} shaders in {} iterations, {} bytes of GLSL per pass\n",
+                             entries.size(), iterations, timings.glsl_size / iterations);
+    std::cout << fmt::format("Decode:     {:10.3f} ms total, {:8.3f} us per shader\n", decode_ms,
+                             decode_ms * 1000.0 / timings.shaders);
+    std::cout << fmt::format("Decompile:  {:10.3f} ms total, {:8.3f} us per shader\n",
+                             decompile_ms, decompile_ms * 1000.0 / timings.shaders);
+    if (total_ms > 0.0) {
+        std::cout << fmt::format("Throughput: {:.1f} shaders/s, {:.1f} MiB/s of GLSL\n",
+                                 timings.shaders * 1000.0 / total_ms,
+                                 timings.glsl_size / (1024.0 * 1024.0) / (total_ms / 1000.0));
+    }
+    return 0;
+}
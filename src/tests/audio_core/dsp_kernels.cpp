@@ -0,0 +1,214 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/algorithm/dsp_kernels.h"
+#include "common/common_types.h"
+
+namespace AudioCore::DSP {
+
+namespace {
+
+// Covers every vector width used by the kernels along with their scalar tails.
+constexpr std::size_t MAX_TEST_LENGTH = 67;
+
+s16 SaturateToS16(float value) {
+    return static_cast<s16>(std::clamp(value, -32768.0f, 32767.0f));
+}
+
+std::vector<s16> RandomS16(std::mt19937& rng, std::size_t count) {
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+    std::vector<s16> values(count);
+    std::generate(values.begin(), values.end(), [&] { return static_cast<s16>(dist(rng)); });
+    return values;
+}
+
+std::vector<float> RandomFloat(std::mt19937& rng, std::size_t count, float range) {
+    std::uniform_real_distribution<float> dist(-range, range);
+    std::vector<float> values(count);
+    std::generate(values.begin(), values.end(), [&] { return dist(rng); });
+    return values;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DSP: MixAccumulate", "[audio_core]") {
+    std::mt19937 rng(1);
+    for (std::size_t count = 0; count <= MAX_TEST_LENGTH; ++count) {
+        const auto src = RandomFloat(rng, count, 32768.0f);
+        auto dst = RandomFloat(rng, count, 32768.0f);
+        auto expected = dst;
+        for (std::size_t i = 0; i < count; ++i) {
+            expected[i] += src[i] * 0.75f;
+        }
+        MixAccumulate(dst.data(), src.data(), 0.75f, count);
+        REQUIRE(dst == expected);
+    }
+}
+
+TEST_CASE("DSP: MixAccumulateRamp", "[audio_core]") {
+    std::mt19937 rng(2);
+    for (std::size_t count = 0; count <= MAX_TEST_LENGTH; ++count) {
+        const auto src = RandomFloat(rng, count, 32768.0f);
+        auto dst = RandomFloat(rng, count, 32768.0f);
+        auto expected = dst;
+        for (std::size_t i = 0; i < count; ++i) {
+            expected[i] += src[i] * (0.25f + 0.01f * static_cast<float>(i));
+        }
+        MixAccumulateRamp(dst.data(), src.data(), 0.25f, 0.01f, count);
+        REQUIRE(dst == expected);
+    }
+}
+
+TEST_CASE("DSP: MixStereoS16", "[audio_core]") {
+    std::mt19937 rng(3);
+    for (std::size_t frames = 0; frames <= MAX_TEST_LENGTH; ++frames) {
+        const auto samples = RandomS16(rng, frames * 2);
+        auto left = RandomFloat(rng, frames, 1000.0f);
+        auto right = RandomFloat(rng, frames, 1000.0f);
+        auto expected_left = left;
+        auto expected_right = right;
+        for (std::size_t i = 0; i < frames; ++i) {
+            const float gain = 1.0f - 0.005f * static_cast<float>(i);
+            expected_left[i] += static_cast<float>(samples[i * 2]) * gain;
+            expected_right[i] += static_cast<float>(samples[i * 2 + 1]) * gain;
+        }
+        MixStereoS16(left.data(), right.data(), samples.data(), 1.0f, -0.005f, frames);
+        REQUIRE(left == expected_left);
+        REQUIRE(right == expected_right);
+    }
+}
+
+TEST_CASE("DSP: InterleaveS16 saturates", "[audio_core]") {
+    std::mt19937 rng(4);
+    for (std::size_t frames = 0; frames <= MAX_TEST_LENGTH; ++frames) {
+        const auto left = RandomFloat(rng, frames, 50000.0f);
+        const auto right = RandomFloat(rng, frames, 50000.0f);
+        std::vector<s16> expected(frames * 2);
+        for (std::size_t i = 0; i < frames; ++i) {
+            expected[i * 2] = SaturateToS16(left[i]);
+            expected[i * 2 + 1] = SaturateToS16(right[i]);
+        }
+        std::vector<s16> output(frames * 2);
+        InterleaveS16(output.data(), left.data(), right.data(), frames);
+        REQUIRE(output == expected);
+    }
+}
+
+TEST_CASE("DSP: ApplyVolumeS16", "[audio_core]") {
+    std::mt19937 rng(5);
+    for (std::size_t count = 0; count <= MAX_TEST_LENGTH; ++count) {
+        for (const float volume : {0.0f, 0.3f, 1.5f}) {
+            auto samples = RandomS16(rng, count);
+            auto expected = samples;
+            for (auto& sample : expected) {
+                sample = SaturateToS16(static_cast<float>(sample) * volume);
+            }
+            ApplyVolumeS16(samples.data(), volume, count);
+            REQUIRE(samples == expected);
+        }
+    }
+}
+
+TEST_CASE("DSP: UpmixMonoToStereo", "[audio_core]") {
+    std::mt19937 rng(6);
+    for (std::size_t frames = 0; frames <= MAX_TEST_LENGTH; ++frames) {
+        const auto mono = RandomS16(rng, frames);
+        std::vector<s16> expected(frames * 2);
+        for (std::size_t i = 0; i < frames; ++i) {
+            expected[i * 2] = mono[i];
+            expected[i * 2 + 1] = mono[i];
+        }
+        std::vector<s16> stereo(frames * 2);
+        UpmixMonoToStereo(stereo.data(), mono.data(), frames);
+        REQUIRE(stereo == expected);
+    }
+}
+
+TEST_CASE("DSP: Filter4TapStereo", "[audio_core]") {
+    std::mt19937 rng(7);
+    for (int iteration = 0; iteration < 256; ++iteration) {
+        const auto history = RandomS16(rng, 8);
+        const auto taps = RandomS16(rng, 4);
+        s32 left = 0;
+        s32 right = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            left += history[i * 2] * taps[i];
+            right += history[i * 2 + 1] * taps[i];
+        }
+        const auto result = Filter4TapStereo(history.data(), taps.data());
+        REQUIRE(result[0] == left);
+        REQUIRE(result[1] == right);
+    }
+}
+
+// Hidden by default, run with `tests [benchmark]` to compare against the scalar loops.
+TEST_CASE("DSP: BiquadFilterStereo matches BiquadFilter", "[audio_core]") {
+    std::mt19937 rng(8);
+    // Lowpass with the feedback coefficients negated as stored by the guest
+    const auto coeffs = BiquadCoefficientsFromQ14({1018, 2036, 1018}, {26555, -10247});
+    for (std::size_t count = 0; count <= MAX_TEST_LENGTH; ++count) {
+        auto left = RandomFloat(rng, count, 32768.0f);
+        auto right = RandomFloat(rng, count, 32768.0f);
+        auto expected_left = left;
+        auto expected_right = right;
+
+        BiquadState left_state{}, right_state{};
+        BiquadState expected_left_state{}, expected_right_state{};
+        // Run twice to cover the state carried between blocks
+        for (int pass = 0; pass < 2; ++pass) {
+            BiquadFilterStereo(left.data(), right.data(), count, coeffs, left_state, right_state);
+            BiquadFilter(expected_left.data(), count, coeffs, expected_left_state);
+            BiquadFilter(expected_right.data(), count, coeffs, expected_right_state);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(left[i] == Approx(expected_left[i]).margin(0.01));
+            REQUIRE(right[i] == Approx(expected_right[i]).margin(0.01));
+        }
+    }
+}
+
+TEST_CASE("DSP: Mixing throughput", "[.][benchmark]") {
+    constexpr std::size_t FRAMES = 512;
+    constexpr std::size_t VOICES = 96;
+    constexpr int ITERATIONS = 2000;
+
+    std::mt19937 rng(8);
+    const auto samples = RandomS16(rng, FRAMES * 2);
+    std::vector<float> left(FRAMES);
+    std::vector<float> right(FRAMES);
+
+    const auto measure = [&](const auto& mix) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+            for (std::size_t voice = 0; voice < VOICES; ++voice) {
+                mix();
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
+
+    const double scalar_ms = measure([&] {
+        for (std::size_t i = 0; i < FRAMES; ++i) {
+            const float gain = 0.5f + 0.0001f * static_cast<float>(i);
+            left[i] += static_cast<float>(samples[i * 2]) * gain;
+            right[i] += static_cast<float>(samples[i * 2 + 1]) * gain;
+        }
+    });
+    const double kernel_ms = measure([&] {
+        MixStereoS16(left.data(), right.data(), samples.data(), 0.5f, 0.0001f, FRAMES);
+    });
+
+    WARN("Mixing " << VOICES << " voices x " << ITERATIONS << " buffers: scalar " << scalar_ms
+                   << " ms, kernel " << kernel_ms << " ms");
+    REQUIRE(kernel_ms > 0.0);
+}
+
+} // namespace AudioCore::DSP
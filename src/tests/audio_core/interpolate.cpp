@@ -0,0 +1,119 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/algorithm/interpolate.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+namespace {
+
+// Output of the interpolator before it was made incremental, for 24 frames of MakeInput()
+constexpr std::array<s16, 34> downsample_3_2_reference{
+    -6600, -5005, -15695, -11760, -16979, -9065, 6758, 12227, 17306, -13631, -8714, -3335,
+    12493, 7208, 3651, -18808, -5514, 2395, 15775, -6442, -10082, -15611, 212, 8124, 10757,
+    18672, -15260, -7349, 5945, 13859, -2894, 5017, -12062, -4147
+};
+
+constexpr std::array<s16, 26> downsample_2_reference{
+    -6600, -5005, -22836, -16547, -1154, 6761, 17306, -13631, -3331, 4578, 15123, -15814, -5514,
+    2395, 12940, -17997, -7696, 212, 10757, 18672, -9879, -1964, 8574, 16489, -12062, -4147
+};
+
+constexpr std::array<s16, 98> upsample_2_reference{
+    68, 51, 68, 51, 68, 51, -17034, -13088, -17034, -13088, -27293, -18960, -27293, -18960,
+    -9133, -1162, -9133, -1162, 6810, 17699, 6810, 17699, 25670, -1933, 25670, -1933, 6038,
+    -22292, 6038, -22292, -14321, -3360, -14321, -3360, 4611, 15500, 4611, 15500, 23472, -4131,
+    23472, -4131, 3840, -24491, 3840, -24491, -16520, -5558, -16520, -5558, 2413, 13302, 2413,
+    13302, 21273, -6330, 21273, -6330, 1642, -26689, 1642, -26689, -18718, -7757, -18718, -7757,
+    214, 8186, 214, 8186, 19075, 27046, 19075, 27046, -557, 7414, -557, 7414, -20916, -12945,
+    -20916, -12945, -1984, 5987, -1984, 5987, 16876, 24848, 16876, 24848, -2755, 5216, -2755,
+    5216, -23115, -15144, -23115, -15144
+};
+
+std::vector<s16> MakeInput(std::size_t num_frames) {
+    std::vector<s16> input(num_frames * 2);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<s16>(static_cast<int>((i * 7919) % 65536) - 32768);
+    }
+    return input;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Interpolate: Downsampling matches the previous implementation", "[audio_core]") {
+    InterpolationState state_3_2;
+    const std::vector<s16> output_3_2 = Interpolate(state_3_2, MakeInput(24), 1.5);
+    REQUIRE(output_3_2 == std::vector<s16>(downsample_3_2_reference.begin(),
+                                           downsample_3_2_reference.end()));
+
+    InterpolationState state_2;
+    const std::vector<s16> output_2 = Interpolate(state_2, MakeInput(24), 2.0);
+    REQUIRE(output_2 ==
+            std::vector<s16>(downsample_2_reference.begin(), downsample_2_reference.end()));
+}
+
+TEST_CASE("Interpolate: Upsampling keeps the first frame of the previous implementation",
+          "[audio_core]") {
+    InterpolationState state;
+    const std::vector<s16> output = Interpolate(state, MakeInput(24), 0.5);
+    REQUIRE(output.size() == upsample_2_reference.size());
+
+    // The previous implementation picked the filter phase once per input frame and repeated the
+    // same output for every frame it produced from it. The phase now advances with every output
+    // frame, so only the first output of each input frame is expected to match.
+    for (std::size_t frame = 0; frame < output.size() / 2; ++frame) {
+        const s16* const reference = upsample_2_reference.data() + frame * 2;
+        if (frame > 0 && reference[0] == reference[-2] && reference[1] == reference[-1]) {
+            continue;
+        }
+        REQUIRE(output[frame * 2 + 0] == reference[0]);
+        REQUIRE(output[frame * 2 + 1] == reference[1]);
+    }
+}
+
+TEST_CASE("Interpolate: Streaming matches whole buffers", "[audio_core]") {
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> sample_dist(-32768, 32767);
+
+    for (const double ratio : {0.5, 22050.0 / 48000.0, 32000.0 / 48000.0, 1.5, 2.5}) {
+        InterpolationState whole_state;
+        InterpolationState stream_state;
+
+        for (int buffer = 0; buffer < 8; ++buffer) {
+            std::vector<s16> input(std::uniform_int_distribution<std::size_t>(1, 600)(rng) * 2);
+            std::generate(input.begin(), input.end(),
+                          [&] { return static_cast<s16>(sample_dist(rng)); });
+            const std::size_t num_frames = input.size() / 2;
+
+            const std::vector<s16> expected = Interpolate(whole_state, input, ratio);
+
+            // Feed and drain the streaming interpolator in small, uneven chunks.
+            std::vector<s16> streamed;
+            std::array<s16, 64> output;
+            std::size_t consumed = 0;
+            while (true) {
+                const std::size_t input_frames = std::min<std::size_t>(num_frames - consumed, 7);
+                const auto result = Interpolate(stream_state, input.data() + consumed * 2,
+                                                input_frames, output.data(), 13, ratio);
+                consumed += result.consumed_frames;
+                streamed.insert(streamed.end(), output.begin(),
+                                output.begin() + result.produced_frames * 2);
+                if (consumed == num_frames && result.produced_frames == 0) {
+                    break;
+                }
+            }
+
+            REQUIRE(streamed == expected);
+        }
+    }
+}
+
+} // namespace AudioCore
@@ -0,0 +1,53 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+
+VirtualFile MakeFile(const std::string& name, u8 value) {
+    return std::make_shared<VectorVfsFile>(std::vector<u8>(0x10, value), name);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RomFS: Built images look up non-ASCII names", "[core]") {
+    // Names with bytes above 0x7F hash differently if the bytes are sign extended, some of these
+    // land in different buckets of the hash table when they do.
+    const std::vector<std::string> names{"ascii.bin", u8"été.bin", u8"données.bin", u8"音楽.bin"};
+
+    std::vector<VirtualFile> files;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        files.push_back(MakeFile(names[i], static_cast<u8>(i + 1)));
+    }
+    const auto subdir = std::make_shared<VectorVfsDirectory>(
+        std::vector<VirtualFile>{MakeFile("inner.bin", 0xFF)}, std::vector<VirtualDir>{},
+        u8"répertoire");
+    const auto root = std::make_shared<VectorVfsDirectory>(std::move(files),
+                                                           std::vector<VirtualDir>{subdir}, "root");
+
+    const auto romfs = ExtractRomFS(CreateRomFS(root), RomFSExtractionType::Full);
+    REQUIRE(romfs != nullptr);
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        const auto file = romfs->GetFile(names[i]);
+        REQUIRE(file != nullptr);
+        REQUIRE(file->ReadAllBytes() == std::vector<u8>(0x10, static_cast<u8>(i + 1)));
+    }
+
+    const auto extracted_subdir = romfs->GetSubdirectory(u8"répertoire");
+    REQUIRE(extracted_subdir != nullptr);
+    REQUIRE(extracted_subdir->GetFile("inner.bin") != nullptr);
+    REQUIRE(romfs->GetFileRelative(u8"répertoire/inner.bin") != nullptr);
+}
+
+} // namespace FileSys
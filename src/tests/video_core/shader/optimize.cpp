@@ -0,0 +1,275 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <functional>
+#include <variant>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "video_core/shader/node.h"
+#include "video_core/shader/node_arena.h"
+#include "video_core/shader/node_helper.h"
+#include "video_core/shader/optimize.h"
+
+namespace VideoCommon::Shader {
+
+namespace {
+
+using Tegra::Shader::Pred;
+using Tegra::Shader::Register;
+
+Node Gpr(u32 index) {
+    return MakeNode<GprNode>(Register{index});
+}
+
+Node Cbuf(u32 index, u32 offset) {
+    return MakeNode<CbufNode>(index, Immediate(offset));
+}
+
+Node Predicate(Pred index, bool negated = false) {
+    return MakeNode<PredicateNode>(index, negated);
+}
+
+Node Assign(Node dest, Node value) {
+    return Operation(OperationCode::Assign, dest, value);
+}
+
+const OperationNode& AsOperation(const Node& node) {
+    const auto operation = std::get_if<OperationNode>(&*node);
+    REQUIRE(operation != nullptr);
+    return *operation;
+}
+
+bool IsImmediate(const Node& node, u32 value) {
+    const auto immediate = std::get_if<ImmediateNode>(&*node);
+    return immediate && immediate->GetValue() == value;
+}
+
+bool IsGpr(const Node& node, u32 index) {
+    const auto gpr = std::get_if<GprNode>(&*node);
+    return gpr && gpr->GetIndex() == index;
+}
+
+bool IsCustomVar(const Node& node, u32 index) {
+    const auto variable = std::get_if<CustomVarNode>(&*node);
+    return variable && variable->GetIndex() == index;
+}
+
+bool IsConstantPredicate(const Node& node, bool value) {
+    const auto predicate = std::get_if<PredicateNode>(&*node);
+    return predicate && !predicate->IsNegated() &&
+           predicate->GetIndex() == (value ? Pred::UnusedIndex : Pred::NeverExecute);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ShaderOptimize[FoldOperation]", "[video_core]") {
+    NodeArena arena;
+    const NodeArena::Scope scope{arena};
+
+    const auto fold = [](const Node& node) { return FoldOperation(AsOperation(node)); };
+
+    SECTION("Operations on immediates are evaluated") {
+        REQUIRE(IsImmediate(fold(Operation(OperationCode::IAdd, Immediate(2U), Immediate(3U))), 5));
+        REQUIRE(IsImmediate(
+            fold(Operation(OperationCode::IArithmeticShiftRight, Immediate(-8), Immediate(1U))),
+            static_cast<u32>(-4)));
+        REQUIRE(IsImmediate(fold(Operation(OperationCode::FNegate, Immediate(1.0f))), 0xBF800000));
+        REQUIRE(IsConstantPredicate(
+            fold(Operation(OperationCode::LogicalILessThan, Immediate(-1), Immediate(0))), true));
+        REQUIRE(IsConstantPredicate(
+            fold(Operation(OperationCode::LogicalULessThan, Immediate(-1), Immediate(0))), false));
+    }
+
+    SECTION("Identities return the other operand") {
+        const Node reg = Gpr(4);
+        REQUIRE(fold(Operation(OperationCode::IAdd, reg, Immediate(0U))) == reg);
+        REQUIRE(fold(Operation(OperationCode::UMul, Immediate(1U), reg)) == reg);
+        REQUIRE(IsImmediate(fold(Operation(OperationCode::IBitwiseAnd, reg, Immediate(0U))), 0));
+
+        const Node pred = Predicate(static_cast<Pred>(2));
+        const Node always = Predicate(Pred::UnusedIndex);
+        REQUIRE(fold(Operation(OperationCode::LogicalAnd, always, pred)) == pred);
+        REQUIRE(IsConstantPredicate(fold(Operation(OperationCode::LogicalOr, pred, always)), true));
+
+        const Node negated = Operation(OperationCode::FNegate, reg);
+        REQUIRE(fold(Operation(OperationCode::FNegate, negated)) == reg);
+    }
+
+    SECTION("Operations that can't be simplified are kept") {
+        REQUIRE(fold(Operation(OperationCode::IAdd, Gpr(1), Gpr(2))) == nullptr);
+        REQUIRE(fold(Operation(OperationCode::ULogicalShiftLeft, Immediate(1U), Immediate(32U))) ==
+                nullptr);
+
+        // Atomics can't be dropped even when their result is multiplied by zero
+        const Node atomic = Operation(OperationCode::AtomicIAdd, Gpr(1), Immediate(1U));
+        REQUIRE(fold(Operation(OperationCode::IMul, atomic, Immediate(0U))) == nullptr);
+
+        // Operations with an amend are evaluated for its side effects
+        const Node amended = Operation(OperationCode::IAdd, Immediate(1U), Immediate(1U));
+        std::get_if<OperationNode>(&*amended)->SetAmendIndex(0);
+        REQUIRE(fold(amended) == nullptr);
+    }
+}
+
+TEST_CASE("ShaderOptimize[PropagateCopies]", "[video_core]") {
+    NodeArena arena;
+    const NodeArena::Scope scope{arena};
+
+    SECTION("Immediates and copies are forwarded to later reads") {
+        NodeBlock block{
+            Assign(Gpr(1), Immediate(7U)),
+            Assign(Gpr(2), Gpr(3)),
+            Assign(Gpr(4), Operation(OperationCode::IAdd, Gpr(1), Gpr(2))),
+        };
+        REQUIRE(PropagateCopies(block) == 2);
+        REQUIRE(block.size() == 3);
+
+        const auto& sum = AsOperation(AsOperation(block[2])[1]);
+        REQUIRE(IsImmediate(sum[0], 7));
+        REQUIRE(IsGpr(sum[1], 3));
+        REQUIRE(IsGpr(AsOperation(block[2])[0], 4));
+    }
+
+    SECTION("Writes invalidate the copies made from a register") {
+        NodeBlock block{
+            Assign(Gpr(2), Gpr(3)),
+            Assign(Gpr(3), Immediate(1U)),
+            Assign(Gpr(4), Gpr(2)),
+        };
+        REQUIRE(PropagateCopies(block) == 0);
+        REQUIRE(IsGpr(AsOperation(block[2])[1], 2));
+    }
+
+    SECTION("Registers written in conditional code are not forwarded past it") {
+        const Node condition = Predicate(static_cast<Pred>(0));
+        NodeBlock block{
+            Assign(Gpr(1), Immediate(7U)),
+            Conditional(condition, {Assign(Gpr(5), Gpr(1)), Assign(Gpr(1), Immediate(8U))}),
+            Assign(Gpr(6), Gpr(1)),
+        };
+        REQUIRE(PropagateCopies(block) == 1);
+
+        const auto& conditional = *std::get_if<ConditionalNode>(&*block[1]);
+        REQUIRE(IsImmediate(AsOperation(conditional.GetCode()[0])[1], 7));
+        REQUIRE(IsGpr(AsOperation(block[2])[1], 1));
+    }
+}
+
+TEST_CASE("ShaderOptimize[FoldConstants]", "[video_core]") {
+    NodeArena arena;
+    const NodeArena::Scope scope{arena};
+
+    SECTION("Nested constant expressions are folded") {
+        NodeBlock block{Assign(Gpr(1), Operation(OperationCode::IMul, Immediate(3U),
+                                                 Operation(OperationCode::IAdd, Immediate(1U),
+                                                           Immediate(1U))))};
+        REQUIRE(FoldConstants(block) == 2);
+        REQUIRE(IsImmediate(AsOperation(block[0])[1], 6));
+    }
+
+    SECTION("Conditionals with constant conditions are resolved") {
+        const Node store = Assign(Gpr(1), Immediate(1U));
+        const Node skipped = Assign(Gpr(2), Immediate(2U));
+        NodeBlock block{
+            Conditional(Predicate(Pred::UnusedIndex), {store}),
+            Conditional(Predicate(Pred::UnusedIndex, true), {skipped}),
+        };
+        REQUIRE(FoldConstants(block) == 2);
+        REQUIRE(block == NodeBlock{store});
+    }
+
+    SECTION("Conditionals on runtime predicates are kept") {
+        const Node condition = Predicate(static_cast<Pred>(1));
+        NodeBlock block{Conditional(condition, {Assign(Gpr(1), Immediate(1U))})};
+        const NodeBlock original = block;
+        REQUIRE(FoldConstants(block) == 0);
+        REQUIRE(block == original);
+    }
+}
+
+TEST_CASE("ShaderOptimize[DeduplicateCbufLoads]", "[video_core]") {
+    NodeArena arena;
+    const NodeArena::Scope scope{arena};
+
+    u32 num_variables = 0;
+    const std::function<u32()> new_variable = [&num_variables] { return num_variables++; };
+    CbufVariables variables;
+
+    NodeBlock first{
+        Assign(Gpr(1), Operation(OperationCode::FMul, Cbuf(0, 0x10), Cbuf(0, 0x10))),
+        Assign(Gpr(2), Cbuf(0, 0x14)),
+        Conditional(Predicate(static_cast<Pred>(0)), {Assign(Gpr(3), Cbuf(0, 0x10))}),
+    };
+    REQUIRE(DeduplicateCbufLoads(first, variables, new_variable) == 2);
+    REQUIRE(num_variables == 1);
+    REQUIRE(first.size() == 4);
+
+    // The slot is loaded once at the start of the block
+    const auto& load = AsOperation(first[0]);
+    REQUIRE(IsCustomVar(load[0], 0));
+    const auto cbuf = std::get_if<CbufNode>(&*load[1]);
+    REQUIRE(cbuf != nullptr);
+    REQUIRE(cbuf->GetIndex() == 0);
+    REQUIRE(IsImmediate(cbuf->GetOffset(), 0x10));
+
+    const auto& product = AsOperation(AsOperation(first[1])[1]);
+    REQUIRE(IsCustomVar(product[0], 0));
+    REQUIRE(IsCustomVar(product[1], 0));
+    REQUIRE(std::holds_alternative<CbufNode>(*AsOperation(first[2])[1]));
+    const auto& conditional = *std::get_if<ConditionalNode>(&*first[3]);
+    REQUIRE(IsCustomVar(AsOperation(conditional.GetCode()[0])[1], 0));
+
+    // Other blocks reading the same slot reuse its variable
+    NodeBlock second{Assign(Gpr(4), Operation(OperationCode::FAdd, Cbuf(0, 0x10), Cbuf(0, 0x10)))};
+    REQUIRE(DeduplicateCbufLoads(second, variables, new_variable) == 1);
+    REQUIRE(num_variables == 1);
+    REQUIRE(IsCustomVar(AsOperation(second[0])[0], 0));
+}
+
+TEST_CASE("ShaderOptimize[EliminateDeadStores]", "[video_core]") {
+    NodeArena arena;
+    const NodeArena::Scope scope{arena};
+    const std::vector<Node> amend_code;
+
+    SECTION("Stores overwritten before being read are removed") {
+        const Node last = Assign(Gpr(1), Immediate(2U));
+        NodeBlock block{Assign(Gpr(1), Immediate(1U)), last};
+        REQUIRE(EliminateDeadStores(block, amend_code) == 1);
+        REQUIRE(block == NodeBlock{last});
+    }
+
+    SECTION("Stores read before being overwritten are kept") {
+        NodeBlock block{
+            Assign(Gpr(1), Immediate(1U)),
+            Assign(Gpr(2), Gpr(1)),
+            Assign(Gpr(1), Immediate(2U)),
+        };
+        const NodeBlock original = block;
+        REQUIRE(EliminateDeadStores(block, amend_code) == 0);
+        REQUIRE(block == original);
+    }
+
+    SECTION("Stores before control flow are kept") {
+        NodeBlock block{
+            Assign(Gpr(1), Immediate(1U)),
+            Conditional(Predicate(static_cast<Pred>(0)), {Operation(OperationCode::Exit)}),
+            Assign(Gpr(1), Immediate(2U)),
+        };
+        const NodeBlock original = block;
+        REQUIRE(EliminateDeadStores(block, amend_code) == 0);
+        REQUIRE(block == original);
+    }
+
+    SECTION("Stores with side effects are kept") {
+        NodeBlock block{
+            Assign(Gpr(1), Operation(OperationCode::AtomicIAdd, Gpr(2), Immediate(1U))),
+            Assign(Gpr(1), Immediate(2U)),
+        };
+        REQUIRE(EliminateDeadStores(block, amend_code) == 0);
+        REQUIRE(block.size() == 2);
+    }
+}
+
+} // namespace VideoCommon::Shader
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -17,6 +18,7 @@
 #include <boost/range/iterator_range.hpp>
 
 #include "common/alignment.h"
+#include "common/cityhash.h"
 #include "common/common_types.h"
 #include "core/core.h"
 #include "video_core/buffer_cache/buffer_block.h"
@@ -46,7 +48,6 @@ public:
 
         // Cache management is a big overhead, so only cache entries with a given size.
         // TODO: Figure out which size is the best for given games.
-        constexpr std::size_t max_stream_size = 0x800;
         if (use_fast_cbuf || size < max_stream_size) {
             if (!is_written && !IsRegionWritten(cache_addr, cache_addr + size - 1)) {
                 if (use_fast_cbuf) {
@@ -86,8 +87,14 @@ public:
     void Map(std::size_t max_size) {
         std::lock_guard lock{mutex};
 
-        std::tie(buffer_ptr, buffer_offset_base, invalidated) = stream_buffer->Map(max_size, 4);
+        bool is_wrapped;
+        std::tie(buffer_ptr, buffer_offset_base, is_wrapped) = stream_buffer->Map(max_size, 4);
         buffer_offset = buffer_offset_base;
+        if (is_wrapped) {
+            // Previous uploads are going to be overwritten
+            ClearStreamUploads();
+            invalidated = true;
+        }
     }
 
     /// Finishes the upload stream, returns true on bindings invalidation.
@@ -100,6 +107,7 @@ public:
 
     void TickFrame() {
         ++epoch;
+        ClearStreamUploads();
         while (!pending_destruction.empty()) {
             // Delay at least 4 frames before destruction.
             // This is due to triple buffering happening on some drivers.
@@ -163,6 +171,12 @@ protected:
     virtual void CopyBlock(const TBuffer& src, const TBuffer& dst, std::size_t src_offset,
                            std::size_t dst_offset, std::size_t size) = 0;
 
+    /// Returns the command buffer being recorded, stream uploads are only reused within one.
+    /// Backends without command buffers reuse them until the stream buffer wraps.
+    virtual u64 GetCommandBufferTick() const {
+        return 0;
+    }
+
     virtual BufferInfo ConstBufferUpload(const void* raw_pointer, std::size_t size) {
         return {};
     }
@@ -297,13 +311,43 @@ private:
 
     BufferInfo StreamBufferUpload(const void* raw_pointer, std::size_t size,
                                   std::size_t alignment) {
+        if (size >= max_stream_size) {
+            return {&stream_buffer_handle, StreamBufferCopy(raw_pointer, size, alignment)};
+        }
+        const u64 tick = GetCommandBufferTick();
+        if (tick != stream_uploads_tick) {
+            ClearStreamUploads();
+            stream_uploads_tick = tick;
+        }
+        // Games rewrite small buffers (e.g. constant buffers) with the same contents every draw.
+        // Bind the previous copy while it's still in the stream buffer instead of uploading again.
+        const auto data = static_cast<const u8*>(raw_pointer);
+        const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(data), size);
+        StreamUpload& upload = stream_uploads[hash];
+        if (upload.size == size && upload.offset % alignment == 0 &&
+            std::memcmp(stream_upload_data.data() + upload.data_offset, data, size) == 0) {
+            return {&stream_buffer_handle, upload.offset};
+        }
+        upload.offset = StreamBufferCopy(raw_pointer, size, alignment);
+        upload.data_offset = stream_upload_data.size();
+        upload.size = size;
+        stream_upload_data.insert(stream_upload_data.end(), data, data + size);
+        return {&stream_buffer_handle, upload.offset};
+    }
+
+    void ClearStreamUploads() {
+        stream_uploads.clear();
+        stream_upload_data.clear();
+    }
+
+    u64 StreamBufferCopy(const void* raw_pointer, std::size_t size, std::size_t alignment) {
         AlignBuffer(alignment);
-        const std::size_t uploaded_offset = buffer_offset;
+        const u64 uploaded_offset = buffer_offset;
         std::memcpy(buffer_ptr, raw_pointer, size);
 
         buffer_ptr += size;
         buffer_offset += size;
-        return {&stream_buffer_handle, uploaded_offset};
+        return uploaded_offset;
     }
 
     void AlignBuffer(std::size_t alignment) {
@@ -436,6 +480,22 @@ private:
 
     bool invalidated = false;
 
+    /// Uploads smaller than this skip the interval cache and go through the stream buffer
+    static constexpr std::size_t max_stream_size = 0x800;
+
+    struct StreamUpload {
+        u64 offset = 0;
+        std::size_t data_offset = 0; ///< Copy of the uploaded data in stream_upload_data
+        std::size_t size = 0;
+    };
+    /// Small uploads in the stream buffer since it last wrapped, keyed by the hash of their data
+    std::unordered_map<u64, StreamUpload> stream_uploads;
+    /// Copies of the data of stream_uploads, hashes alone can collide. Cleared along with them,
+    /// keeping its capacity so copies don't allocate once it has grown
+    std::vector<u8> stream_upload_data;
+    /// Command buffer the stream uploads were made in
+    u64 stream_uploads_tick = 0;
+
     u8* buffer_ptr = nullptr;
     u64 buffer_offset = 0;
     u64 buffer_offset_base = 0;
@@ -2,19 +2,25 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
+
 #include "common/assert.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
 #include "common/microprofile.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/frontend/emu_window.h"
 #include "core/memory.h"
+#include "core/settings.h"
 #include "video_core/engines/fermi_2d.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/kepler_memory.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/video_core.h"
@@ -33,6 +39,16 @@ GPU::GPU(Core::System& system, std::unique_ptr<VideoCore::RendererBase>&& render
     kepler_compute = std::make_unique<Engines::KeplerCompute>(system, rasterizer, *memory_manager);
     maxwell_dma = std::make_unique<Engines::MaxwellDMA>(system, *memory_manager);
     kepler_memory = std::make_unique<Engines::KeplerMemory>(system, *memory_manager);
+
+    if (Settings::values.dump_gpu_commands) {
+        const auto dump_dir{FileUtil::GetUserPath(FileUtil::UserPath::DumpDir) + "gpu" + DIR_SEP};
+        const auto timestamp{std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch())};
+        const auto path{fmt::format("{}{}.bin", dump_dir, timestamp.count())};
+        if (FileUtil::CreateFullPath(path)) {
+            capture = std::make_unique<GPUCaptureWriter>(path);
+        }
+    }
 }
 
 GPU::~GPU() = default;
@@ -125,6 +141,24 @@ bool GPU::CancelSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
     return true;
 }
 
+void GPU::CaptureCommandList(const Tegra::CommandList& entries) {
+    if (capture) {
+        capture->RecordCommandList(*memory_manager, entries);
+    }
+}
+
+void GPU::CaptureSwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    if (capture) {
+        capture->RecordSwapBuffers(framebuffer);
+    }
+}
+
+void GPU::CaptureInvalidateRegion(CacheAddr addr, u64 size) {
+    if (capture) {
+        capture->InvalidateRegion(addr, size);
+    }
+}
+
 u64 GPU::GetTicks() const {
     // This values were reversed engineered by fincs from NVN
     // The gpu clock is reported in units of 385/625 nanoseconds
@@ -128,6 +128,7 @@ enum class EngineID {
     MAXWELL_DMA_COPY_A = 0xB0B5,
 };
 
+class GPUCaptureWriter;
 class MemoryManager;
 
 class GPU {
@@ -281,6 +282,15 @@ public:
 protected:
     virtual void TriggerCpuInterrupt(u32 syncpoint_id, u32 value) const = 0;
 
+    /// Records a submission when GPU commands are being dumped
+    void CaptureCommandList(const Tegra::CommandList& entries);
+
+    /// Records the end of a frame when GPU commands are being dumped
+    void CaptureSwapBuffers(const Tegra::FramebufferConfig* framebuffer);
+
+    /// Marks a region written by the CPU to be recorded again when GPU commands are being dumped
+    void CaptureInvalidateRegion(CacheAddr addr, u64 size);
+
 private:
     void ProcessBindMethod(const MethodCall& method_call);
     void ProcessSemaphoreTriggerMethod();
@@ -304,6 +314,9 @@ protected:
 private:
     std::unique_ptr<Tegra::MemoryManager> memory_manager;
 
+    /// Capture of the submitted command lists, only created when dumping GPU commands
+    std::unique_ptr<GPUCaptureWriter> capture;
+
     /// Mapping of command subchannels to their bound engine ids
     std::array<EngineID, 8> bound_engines = {};
     /// 3D engine
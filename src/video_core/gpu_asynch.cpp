@@ -23,10 +23,12 @@ void GPUAsynch::Start() {
 }
 
 void GPUAsynch::PushGPUEntries(Tegra::CommandList&& entries) {
+    CaptureCommandList(entries);
     gpu_thread.SubmitList(std::move(entries));
 }
 
 void GPUAsynch::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    CaptureSwapBuffers(framebuffer);
     gpu_thread.SwapBuffers(framebuffer);
 }
 
@@ -35,10 +37,12 @@ void GPUAsynch::FlushRegion(CacheAddr addr, u64 size) {
 }
 
 void GPUAsynch::InvalidateRegion(CacheAddr addr, u64 size) {
+    CaptureInvalidateRegion(addr, size);
     gpu_thread.InvalidateRegion(addr, size);
 }
 
 void GPUAsynch::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
+    CaptureInvalidateRegion(addr, size);
     gpu_thread.FlushAndInvalidateRegion(addr, size);
 }
 
@@ -0,0 +1,288 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/alignment.h"
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
+#include "core/memory.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra {
+
+namespace {
+
+constexpr u32 CAPTURE_MAGIC{Common::MakeMagic('Y', 'G', 'P', 'C')};
+constexpr u32 CAPTURE_VERSION{1};
+
+/// Memory is recorded in pieces of this size, so small changes to large buffers stay small
+constexpr u64 RECORDED_PIECE_SIZE{0x10000};
+
+/// Records larger than this are rejected when reading, they can only come from a corrupt capture
+constexpr u64 MAX_RECORD_SIZE{64 * 1024 * 1024};
+
+struct CaptureHeader {
+    u32_le magic;
+    u32_le version;
+};
+static_assert(sizeof(CaptureHeader) == 0x8, "CaptureHeader is an invalid size");
+
+struct CaptureRecordHeader {
+    GPUCaptureRecordType type;
+    INSERT_PADDING_WORDS(1);
+    u64_le gpu_addr;
+    u64_le cpu_addr;
+    u64_le size;
+};
+static_assert(sizeof(CaptureRecordHeader) == 0x20, "CaptureRecordHeader is an invalid size");
+
+bool IsZero(const u8* data, u64 size) {
+    return std::all_of(data, data + size, [](u8 value) { return value == 0; });
+}
+
+/// Returns true when a map or unmap record holds the size of a region instead of a payload
+bool HasRegionSize(GPUCaptureRecordType type) {
+    return type == GPUCaptureRecordType::Map || type == GPUCaptureRecordType::Unmap;
+}
+
+} // Anonymous namespace
+
+GPUCaptureWriter::GPUCaptureWriter(const std::string& path) : file{path, "wb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to create GPU capture {}", path);
+        return;
+    }
+
+    const CaptureHeader header{CAPTURE_MAGIC, CAPTURE_VERSION};
+    file.WriteObject(header);
+    LOG_INFO(HW_GPU, "Recording GPU command lists to {}", path);
+}
+
+void GPUCaptureWriter::RecordCommandList(const MemoryManager& memory_manager,
+                                         const CommandList& entries) {
+    if (!IsOpen()) {
+        return;
+    }
+    std::lock_guard lock{mutex};
+
+    RecordMappings(memory_manager);
+    if (is_frame_start) {
+        // Anything mapped to the GPU may be read by this frame, hashing all of it again on each
+        // following submission is too slow so those only record the pages written meanwhile
+        {
+            std::lock_guard dirty_lock{dirty_mutex};
+            dirty_pages.clear();
+        }
+        RecordMappedMemory(memory_manager);
+        is_frame_start = false;
+    } else {
+        RecordDirtyMemory(memory_manager);
+    }
+    for (const CommandListHeader& entry : entries) {
+        RecordGPUMemory(memory_manager, entry.addr, entry.size * sizeof(u32));
+    }
+
+    WriteRecord(GPUCaptureRecordType::CommandList, 0, 0, entries.size() * sizeof(u64),
+                entries.data(), entries.size() * sizeof(u64));
+}
+
+void GPUCaptureWriter::RecordSwapBuffers(const FramebufferConfig* framebuffer) {
+    if (!IsOpen()) {
+        return;
+    }
+    std::lock_guard lock{mutex};
+
+    const u64 size{framebuffer ? sizeof(FramebufferConfig) : 0};
+    WriteRecord(GPUCaptureRecordType::SwapBuffers, 0, 0, size, framebuffer, size);
+    is_frame_start = true;
+}
+
+void GPUCaptureWriter::InvalidateRegion(CacheAddr addr, u64 size) {
+    if (!IsOpen() || size == 0) {
+        return;
+    }
+    std::lock_guard lock{dirty_mutex};
+
+    const CacheAddr end{addr + size};
+    for (CacheAddr page = Common::AlignDown(addr, Memory::PAGE_SIZE); page < end;
+         page += Memory::PAGE_SIZE) {
+        dirty_pages.insert(page);
+    }
+}
+
+void GPUCaptureWriter::RecordMappings(const MemoryManager& memory_manager) {
+    std::map<GPUVAddr, std::pair<VAddr, u64>> mappings;
+    memory_manager.ForEachMappedRegion([&mappings](GPUVAddr gpu_addr, VAddr cpu_addr, u64 size) {
+        mappings.emplace(gpu_addr, std::make_pair(cpu_addr, size));
+    });
+    if (mappings == recorded_mappings) {
+        return;
+    }
+
+    // Unmap first, a region may have been remapped elsewhere with part of its old range
+    std::vector<std::pair<GPUVAddr, std::pair<VAddr, u64>>> changes;
+    std::set_difference(recorded_mappings.begin(), recorded_mappings.end(), mappings.begin(),
+                        mappings.end(), std::back_inserter(changes));
+    for (const auto& [gpu_addr, region] : changes) {
+        WriteRecord(GPUCaptureRecordType::Unmap, gpu_addr, region.first, region.second, nullptr,
+                    0);
+    }
+
+    changes.clear();
+    std::set_difference(mappings.begin(), mappings.end(), recorded_mappings.begin(),
+                        recorded_mappings.end(), std::back_inserter(changes));
+    for (const auto& [gpu_addr, region] : changes) {
+        WriteRecord(GPUCaptureRecordType::Map, gpu_addr, region.first, region.second, nullptr, 0);
+    }
+
+    recorded_mappings = std::move(mappings);
+}
+
+void GPUCaptureWriter::RecordMappedMemory(const MemoryManager& memory_manager) {
+    for (const auto& [gpu_addr, region] : recorded_mappings) {
+        // Mapped regions are contiguous in host memory
+        const u8* const data{memory_manager.GetPointer(gpu_addr)};
+        if (data == nullptr) {
+            continue;
+        }
+        const auto [cpu_addr, size] = region;
+        for (u64 offset = 0; offset < size; offset += RECORDED_PIECE_SIZE) {
+            const u64 piece_size{std::min(RECORDED_PIECE_SIZE, size - offset)};
+            RecordMemory(cpu_addr + offset, data + offset, piece_size, true);
+        }
+    }
+}
+
+void GPUCaptureWriter::RecordDirtyMemory(const MemoryManager& memory_manager) {
+    std::set<CacheAddr> pages;
+    {
+        std::lock_guard lock{dirty_mutex};
+        pages.swap(dirty_pages);
+    }
+    if (pages.empty()) {
+        return;
+    }
+
+    for (const auto& [gpu_addr, region] : recorded_mappings) {
+        const u8* const data{memory_manager.GetPointer(gpu_addr)};
+        if (data == nullptr) {
+            continue;
+        }
+        const auto [cpu_addr, size] = region;
+        const CacheAddr begin{ToCacheAddr(data)};
+
+        // Cut the same pieces as RecordMappedMemory, so unchanged ones are matched by their hash
+        u64 recorded_end{};
+        auto iter = pages.lower_bound(Common::AlignDown(begin, Memory::PAGE_SIZE));
+        for (; iter != pages.end() && *iter < begin + size; ++iter) {
+            const u64 page_offset{*iter > begin ? *iter - begin : 0};
+            if (page_offset < recorded_end) {
+                continue;
+            }
+            const u64 offset{Common::AlignDown(page_offset, RECORDED_PIECE_SIZE)};
+            const u64 piece_size{std::min(RECORDED_PIECE_SIZE, size - offset)};
+            RecordMemory(cpu_addr + offset, data + offset, piece_size, true);
+            recorded_end = offset + piece_size;
+        }
+    }
+}
+
+void GPUCaptureWriter::RecordGPUMemory(const MemoryManager& memory_manager, GPUVAddr gpu_addr,
+                                       u64 size) {
+    const GPUVAddr end{gpu_addr + size};
+    while (gpu_addr < end) {
+        const GPUVAddr piece_end{std::min(Common::AlignUp(gpu_addr + 1, RECORDED_PIECE_SIZE), end)};
+        const auto cpu_addr{memory_manager.GpuToCpuAddress(gpu_addr)};
+        const u8* const data{memory_manager.GetPointer(gpu_addr)};
+        if (cpu_addr && data != nullptr) {
+            RecordMemory(*cpu_addr, data, piece_end - gpu_addr, false);
+        }
+        gpu_addr = piece_end;
+    }
+}
+
+void GPUCaptureWriter::RecordMemory(VAddr cpu_addr, const u8* data, u64 size, bool skip_zeroes) {
+    const u64 hash{Common::CityHash64(reinterpret_cast<const char*>(data), size)};
+    auto& hashes = recorded_hashes[cpu_addr];
+    const auto iter = hashes.find(size);
+    if (iter != hashes.end() && iter->second == hash) {
+        return;
+    }
+    const bool is_first_record{iter == hashes.end()};
+    hashes.insert_or_assign(size, hash);
+
+    // Memory is zero when a replay maps it, most of a freshly mapped region doesn't need a record
+    if (skip_zeroes && is_first_record && IsZero(data, size)) {
+        return;
+    }
+    WriteRecord(GPUCaptureRecordType::Memory, 0, cpu_addr, size, data, size);
+}
+
+void GPUCaptureWriter::WriteRecord(GPUCaptureRecordType type, GPUVAddr gpu_addr, VAddr cpu_addr,
+                                   u64 size, const void* data, u64 data_size) {
+    CaptureRecordHeader header{};
+    header.type = type;
+    header.gpu_addr = gpu_addr;
+    header.cpu_addr = cpu_addr;
+    header.size = size;
+    file.WriteObject(header);
+    if (data_size != 0) {
+        file.WriteBytes(static_cast<const u8*>(data), data_size);
+    }
+}
+
+GPUCaptureReader::GPUCaptureReader(const std::string& path) : file{path, "rb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open GPU capture {}", path);
+        return;
+    }
+
+    CaptureHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != CAPTURE_MAGIC) {
+        LOG_ERROR(HW_GPU, "{} is not a GPU capture", path);
+        return;
+    }
+    if (header.version != CAPTURE_VERSION) {
+        LOG_ERROR(HW_GPU, "Unsupported GPU capture version {}", header.version);
+        return;
+    }
+
+    is_valid = true;
+}
+
+bool GPUCaptureReader::ReadRecord(GPUCaptureRecord& record) {
+    if (!is_valid) {
+        return false;
+    }
+
+    CaptureRecordHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    record.type = header.type;
+    record.gpu_addr = header.gpu_addr;
+    record.cpu_addr = header.cpu_addr;
+    record.size = header.size;
+    if (HasRegionSize(header.type)) {
+        record.data.clear();
+        return true;
+    }
+    if (header.size > MAX_RECORD_SIZE) {
+        LOG_ERROR(HW_GPU, "GPU capture record is too large, {} bytes", header.size);
+        return false;
+    }
+
+    record.data.resize(header.size);
+    return file.ReadBytes(record.data.data(), record.data.size()) == record.data.size();
+}
+
+} // namespace Tegra
@@ -0,0 +1,123 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/gpu.h"
+
+namespace Tegra {
+
+struct FramebufferConfig;
+class MemoryManager;
+
+/**
+ * A GPU capture is a header followed by a stream of records, replayed in order by yuzu-gpu-replay.
+ * Map and unmap records mirror the regions of the GPU address space backed by CPU memory. Memory
+ * records hold the contents of CPU memory referenced by the GPU and precede the command list that
+ * first reads them. Command list records hold the entries of a submission and swap records the
+ * framebuffer presented at the end of a frame. All mapped memory is recorded at the first
+ * submission of a frame, the later ones in the same frame record their pushbuffers and the pages of
+ * mapped memory the CPU wrote since the previous submission.
+ */
+enum class GPUCaptureRecordType : u32 {
+    Map = 0,
+    Unmap = 1,
+    Memory = 2,
+    CommandList = 3,
+    SwapBuffers = 4,
+};
+
+struct GPUCaptureRecord {
+    GPUCaptureRecordType type{};
+    GPUVAddr gpu_addr{};  ///< GPU address of a map or unmap record
+    VAddr cpu_addr{};     ///< CPU address of a map or memory record
+    u64 size{};           ///< Size of the region of a map or unmap record
+    std::vector<u8> data; ///< Contents of memory, command list and swap records
+};
+
+/// Records the command lists submitted to the GPU and the memory they use, so they can be replayed
+class GPUCaptureWriter {
+public:
+    explicit GPUCaptureWriter(const std::string& path);
+
+    bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /// Records a submission, preceded by the memory it reads that changed since it was recorded
+    void RecordCommandList(const MemoryManager& memory_manager, const CommandList& entries);
+
+    /// Records the end of a frame
+    void RecordSwapBuffers(const FramebufferConfig* framebuffer);
+
+    /// Marks a range of host memory written by the CPU, recorded again at the next submission
+    void InvalidateRegion(CacheAddr addr, u64 size);
+
+private:
+    /// Records the regions mapped or unmapped since the last call
+    void RecordMappings(const MemoryManager& memory_manager);
+
+    /// Records every region of CPU memory mapped to the GPU, a page at a time
+    void RecordMappedMemory(const MemoryManager& memory_manager);
+
+    /// Records the pieces of mapped memory holding a page written since the previous submission
+    void RecordDirtyMemory(const MemoryManager& memory_manager);
+
+    /// Records a range of GPU memory, one record per page of CPU memory backing it
+    void RecordGPUMemory(const MemoryManager& memory_manager, GPUVAddr gpu_addr, u64 size);
+
+    /// Records a range of CPU memory, unless it is unchanged since it was last recorded
+    void RecordMemory(VAddr cpu_addr, const u8* data, u64 size, bool skip_zeroes);
+
+    void WriteRecord(GPUCaptureRecordType type, GPUVAddr gpu_addr, VAddr cpu_addr, u64 size,
+                     const void* data, u64 data_size);
+
+    FileUtil::IOFile file;
+    std::mutex mutex;
+
+    /// Set at the end of a frame, all mapped memory is recorded again at the start of the next one
+    bool is_frame_start = true;
+
+    /// Host pages written by the CPU since the previous submission, guarded by dirty_mutex as they
+    /// are marked from the CPU thread while a submission may be recorded
+    std::set<CacheAddr> dirty_pages;
+    std::mutex dirty_mutex;
+
+    /// Regions recorded as mapped, keyed by GPU address and holding their CPU address and size
+    std::map<GPUVAddr, std::pair<VAddr, u64>> recorded_mappings;
+
+    /// Hash of the last recorded contents of every recorded range, keyed by address and size
+    std::unordered_map<VAddr, std::unordered_map<u64, u64>> recorded_hashes;
+};
+
+/// Reads back a capture made by GPUCaptureWriter
+class GPUCaptureReader {
+public:
+    explicit GPUCaptureReader(const std::string& path);
+
+    /// Returns true if the capture was opened and its header is valid
+    bool IsValid() const {
+        return is_valid;
+    }
+
+    /// Reads the next record, returns false at the end of the capture or if it is truncated
+    bool ReadRecord(GPUCaptureRecord& record);
+
+private:
+    FileUtil::IOFile file;
+    bool is_valid{};
+};
+
+} // namespace Tegra
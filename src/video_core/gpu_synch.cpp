@@ -18,11 +18,13 @@ void GPUSynch::Start() {
 }
 
 void GPUSynch::PushGPUEntries(Tegra::CommandList&& entries) {
+    CaptureCommandList(entries);
     dma_pusher->Push(std::move(entries));
     dma_pusher->DispatchCalls();
 }
 
 void GPUSynch::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    CaptureSwapBuffers(framebuffer);
     renderer->SwapBuffers(framebuffer);
 }
 
@@ -31,10 +33,12 @@ void GPUSynch::FlushRegion(CacheAddr addr, u64 size) {
 }
 
 void GPUSynch::InvalidateRegion(CacheAddr addr, u64 size) {
+    CaptureInvalidateRegion(addr, size);
     renderer->Rasterizer().InvalidateRegion(addr, size);
 }
 
 void GPUSynch::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
+    CaptureInvalidateRegion(addr, size);
     renderer->Rasterizer().FlushAndInvalidateRegion(addr, size);
 }
 
@@ -578,6 +578,7 @@ MemoryManager::VMAIter MemoryManager::SplitVMA(VMAIter vma_handle, u64 offset_in
         break;
     case VirtualMemoryArea::Type::Mapped:
         new_vma.backing_memory += offset_in_vma;
+        new_vma.backing_addr += offset_in_vma;
         break;
     }
 
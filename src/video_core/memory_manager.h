@@ -97,6 +97,16 @@ public:
     void WriteBlockUnsafe(GPUVAddr dest_addr, const void* src_buffer, std::size_t size);
     void CopyBlockUnsafe(GPUVAddr dest_addr, GPUVAddr src_addr, std::size_t size);
 
+    /// Calls func(gpu_addr, cpu_addr, size) for every region backed by CPU memory
+    template <typename Func>
+    void ForEachMappedRegion(Func&& func) const {
+        for (const auto& [base, vma] : vma_map) {
+            if (vma.type == VirtualMemoryArea::Type::Mapped) {
+                func(vma.base, vma.backing_addr, vma.size);
+            }
+        }
+    }
+
 private:
     using VMAMap = std::map<GPUVAddr, VirtualMemoryArea>;
     using VMAHandle = VMAMap::const_iterator;
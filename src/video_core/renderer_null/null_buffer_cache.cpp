@@ -0,0 +1,78 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <tuple>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "video_core/renderer_null/null_buffer_cache.h"
+
+namespace Null {
+
+NullStreamBuffer::NullStreamBuffer(std::size_t size) : buffer(size) {}
+
+NullStreamBuffer::~NullStreamBuffer() = default;
+
+std::tuple<u8*, u64, bool> NullStreamBuffer::Map(u64 size, u64 alignment) {
+    ASSERT_MSG(mapped_size == 0, "Stream buffer is already mapped");
+    mapped_size = size;
+    if (alignment > 0) {
+        offset = Common::AlignUp(offset, alignment);
+    }
+
+    bool invalidated = false;
+    if (offset + size > buffer.size()) {
+        // There's no host work to wait for, the buffer only has to be large enough
+        if (size > buffer.size()) {
+            buffer.resize(Common::AlignUp(size, buffer.size()));
+        }
+        offset = 0;
+        invalidated = true;
+    }
+    return {buffer.data() + offset, offset, invalidated};
+}
+
+void NullStreamBuffer::Unmap(u64 size) {
+    ASSERT_MSG(size <= mapped_size, "Reserved size is too small");
+    offset += size;
+    mapped_size = 0;
+}
+
+CachedBufferBlock::CachedBufferBlock(CacheAddr cache_addr, std::size_t size, BufferHandle handle)
+    : VideoCommon::BufferBlock{cache_addr, size}, handle{handle} {}
+
+CachedBufferBlock::~CachedBufferBlock() = default;
+
+NullBufferCache::NullBufferCache(VideoCore::RasterizerInterface& rasterizer, Core::System& system,
+                                 std::size_t stream_size)
+    : VideoCommon::BufferCache<Buffer, BufferHandle, NullStreamBuffer>{
+          rasterizer, system, std::make_unique<NullStreamBuffer>(stream_size)} {}
+
+NullBufferCache::~NullBufferCache() = default;
+
+const BufferHandle* NullBufferCache::GetEmptyBuffer(std::size_t size) {
+    return &empty_buffer;
+}
+
+Buffer NullBufferCache::CreateBlock(CacheAddr cache_addr, std::size_t size) {
+    return std::make_shared<CachedBufferBlock>(cache_addr, size, next_handle++);
+}
+
+const BufferHandle* NullBufferCache::ToHandle(const Buffer& buffer) {
+    return buffer->GetHandle();
+}
+
+void NullBufferCache::UploadBlockData(const Buffer& buffer, std::size_t offset, std::size_t size,
+                                      const u8* data) {}
+
+void NullBufferCache::DownloadBlockData(const Buffer& buffer, std::size_t offset,
+                                        std::size_t size, u8* data) {
+    // Nothing is ever written to a block, guest memory already holds its contents
+}
+
+void NullBufferCache::CopyBlock(const Buffer& src, const Buffer& dst, std::size_t src_offset,
+                                std::size_t dst_offset, std::size_t size) {}
+
+} // namespace Null
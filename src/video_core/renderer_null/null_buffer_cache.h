@@ -0,0 +1,101 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/buffer_cache/buffer_cache.h"
+
+namespace Core {
+class System;
+}
+
+namespace VideoCore {
+class RasterizerInterface;
+}
+
+namespace Null {
+
+/// Buffers have no host object, they are identified by a number that is never read
+using BufferHandle = u64;
+
+/// Stream buffer backed by host memory, uploads are copied to it and discarded
+class NullStreamBuffer final {
+public:
+    explicit NullStreamBuffer(std::size_t size);
+    ~NullStreamBuffer();
+
+    /**
+     * Reserves a region of memory from the stream buffer.
+     * @param size Size to reserve.
+     * @param alignment Alignment of the returned offset.
+     * @returns A tuple in the following order: Raw memory pointer (with offset added), buffer
+     * offset and a boolean that's true when previous uploads have been overwritten.
+     */
+    std::tuple<u8*, u64, bool> Map(u64 size, u64 alignment);
+
+    /// Commits the first "size" bytes of the reserved region.
+    void Unmap(u64 size);
+
+    BufferHandle GetHandle() const {
+        return 0;
+    }
+
+private:
+    std::vector<u8> buffer; ///< Memory uploads are copied to.
+    u64 offset{};           ///< Buffer iterator.
+    u64 mapped_size{};      ///< Size reserved for the current copy.
+};
+
+class CachedBufferBlock final : public VideoCommon::BufferBlock {
+public:
+    explicit CachedBufferBlock(CacheAddr cache_addr, std::size_t size, BufferHandle handle);
+    ~CachedBufferBlock();
+
+    const BufferHandle* GetHandle() const {
+        return &handle;
+    }
+
+private:
+    BufferHandle handle;
+};
+
+using Buffer = std::shared_ptr<CachedBufferBlock>;
+
+class NullBufferCache final
+    : public VideoCommon::BufferCache<Buffer, BufferHandle, NullStreamBuffer> {
+public:
+    explicit NullBufferCache(VideoCore::RasterizerInterface& rasterizer, Core::System& system,
+                             std::size_t stream_size);
+    ~NullBufferCache();
+
+    const BufferHandle* GetEmptyBuffer(std::size_t size) override;
+
+protected:
+    void WriteBarrier() override {}
+
+    Buffer CreateBlock(CacheAddr cache_addr, std::size_t size) override;
+
+    const BufferHandle* ToHandle(const Buffer& buffer) override;
+
+    void UploadBlockData(const Buffer& buffer, std::size_t offset, std::size_t size,
+                         const u8* data) override;
+
+    void DownloadBlockData(const Buffer& buffer, std::size_t offset, std::size_t size,
+                           u8* data) override;
+
+    void CopyBlock(const Buffer& src, const Buffer& dst, std::size_t src_offset,
+                   std::size_t dst_offset, std::size_t size) override;
+
+private:
+    BufferHandle empty_buffer{};
+    BufferHandle next_handle{1};
+};
+
+} // namespace Null
@@ -0,0 +1,414 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <bitset>
+#include <type_traits>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "core/core.h"
+#include "core/memory.h"
+#include "video_core/dirty_flags.h"
+#include "video_core/engines/kepler_compute.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Null {
+
+MICROPROFILE_DEFINE(Null_Drawing, "Null", "Drawing", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_Compute, "Null", "Compute", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_Clearing, "Null", "Clearing", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_Geometry, "Null", "Setup geometry", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_ConstBuffers, "Null", "Setup constant buffers", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_GlobalBuffers, "Null", "Setup global buffers", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_RenderTargets, "Null", "Setup render targets", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_Textures, "Null", "Setup textures", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_Images, "Null", "Setup images", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_ShaderCache, "Null", "Shader cache", MP_RGB(128, 128, 192));
+
+namespace {
+
+constexpr auto ComputeShaderIndex = static_cast<std::size_t>(Tegra::Engines::ShaderType::Compute);
+
+/// Alignment the hardware backends commonly use for uniform and storage buffers
+constexpr std::size_t BUFFER_ALIGNMENT = 256;
+
+/// Initial size of the stream buffer, it grows if a draw needs more
+constexpr std::size_t STREAM_BUFFER_SIZE = 64 * 1024 * 1024;
+
+template <typename Engine, typename Entry>
+Tegra::Texture::FullTextureInfo GetTextureInfo(const Engine& engine, const Entry& entry,
+                                               std::size_t stage, std::size_t index = 0) {
+    const auto stage_type = static_cast<Tegra::Engines::ShaderType>(stage);
+    if (entry.IsBindless()) {
+        const Tegra::Texture::TextureHandle tex_handle =
+            engine.AccessConstBuffer32(stage_type, entry.GetBuffer(), entry.GetOffset());
+        return engine.GetTextureInfo(tex_handle);
+    }
+    const auto& gpu_profile = engine.AccessGuestDriverProfile();
+    const u32 entry_offset = static_cast<u32>(index * gpu_profile.GetTextureHandlerSize());
+    const u32 offset = entry.GetOffset() + entry_offset;
+    if constexpr (std::is_same_v<Engine, Tegra::Engines::Maxwell3D>) {
+        return engine.GetStageTexture(stage_type, offset);
+    } else {
+        return engine.GetTexture(offset);
+    }
+}
+
+std::size_t CalculateConstBufferSize(const VideoCommon::Shader::ConstBuffer& entry,
+                                     const Tegra::Engines::ConstBufferInfo& buffer) {
+    if (entry.IsIndirect()) {
+        // Buffer is accessed indirectly, so upload the entire thing
+        return buffer.size;
+    } else {
+        // Buffer is accessed directly, upload just what we use
+        return entry.GetSize();
+    }
+}
+
+} // Anonymous namespace
+
+RasterizerNull::RasterizerNull(Core::System& system)
+    : RasterizerAccelerated{system.Memory()}, system{system}, texture_cache{system, *this},
+      shader_cache{system, *this}, buffer_cache{*this, system, STREAM_BUFFER_SIZE} {}
+
+RasterizerNull::~RasterizerNull() = default;
+
+void RasterizerNull::Draw(bool is_indexed, bool is_instanced) {
+    MICROPROFILE_SCOPE(Null_Drawing);
+
+    buffer_cache.Map(CalculateGraphicsStreamBufferSize(is_indexed));
+
+    SetupVertexArrays();
+    if (is_indexed) {
+        SetupIndexBuffer();
+    }
+
+    const auto shaders = shader_cache.GetShaders();
+    SetupShaderResources(shaders);
+
+    buffer_cache.Unmap();
+
+    UpdateAttachments();
+    MarkAttachmentsInUse();
+}
+
+void RasterizerNull::Clear() {
+    MICROPROFILE_SCOPE(Null_Clearing);
+
+    if (!system.GPU().Maxwell3D().ShouldExecute()) {
+        return;
+    }
+
+    const auto& regs = system.GPU().Maxwell3D().regs;
+    const bool use_color = regs.clear_buffers.R || regs.clear_buffers.G || regs.clear_buffers.B ||
+                           regs.clear_buffers.A;
+    const bool use_depth = regs.clear_buffers.Z;
+    const bool use_stencil = regs.clear_buffers.S;
+    if (!use_color && !use_depth && !use_stencil) {
+        return;
+    }
+
+    UpdateAttachments();
+    MarkAttachmentsInUse();
+}
+
+void RasterizerNull::DispatchCompute(GPUVAddr code_addr) {
+    MICROPROFILE_SCOPE(Null_Compute);
+
+    const auto kernel = shader_cache.GetComputeKernel(code_addr);
+
+    buffer_cache.Map(CalculateComputeStreamBufferSize());
+
+    const auto& ir = kernel->GetIR();
+    SetupComputeConstBuffers(ir);
+    SetupComputeGlobalBuffers(ir);
+    SetupComputeTextures(ir);
+    SetupComputeImages(ir);
+
+    buffer_cache.Unmap();
+}
+
+void RasterizerNull::ResetCounter(VideoCore::QueryType type) {}
+
+void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+                           std::optional<u64> timestamp) {
+    // Nothing is rasterized, report every sample query as visible so games relying on occlusion
+    // queries keep submitting their full workload
+    auto& memory_manager = system.GPU().MemoryManager();
+    memory_manager.Write<u64>(gpu_addr, 1);
+    if (timestamp) {
+        memory_manager.Write<u64>(gpu_addr + 8, *timestamp);
+    }
+}
+
+void RasterizerNull::FlushAll() {}
+
+void RasterizerNull::FlushRegion(CacheAddr addr, u64 size) {
+    texture_cache.FlushRegion(addr, size);
+    buffer_cache.FlushRegion(addr, size);
+}
+
+void RasterizerNull::InvalidateRegion(CacheAddr addr, u64 size) {
+    texture_cache.InvalidateRegion(addr, size);
+    shader_cache.InvalidateRegion(addr, size);
+    buffer_cache.InvalidateRegion(addr, size);
+}
+
+void RasterizerNull::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
+    FlushRegion(addr, size);
+    InvalidateRegion(addr, size);
+}
+
+void RasterizerNull::FlushCommands() {}
+
+void RasterizerNull::TickFrame() {
+    buffer_cache.TickFrame();
+}
+
+bool RasterizerNull::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
+                                           const Tegra::Engines::Fermi2D::Regs::Surface& dst,
+                                           const Tegra::Engines::Fermi2D::Config& copy_config) {
+    texture_cache.DoFermiCopy(src, dst, copy_config);
+    return true;
+}
+
+bool RasterizerNull::AccelerateDisplay(const Tegra::FramebufferConfig& config,
+                                       VAddr framebuffer_addr, u32 pixel_stride) {
+    if (!framebuffer_addr) {
+        return false;
+    }
+    const u8* host_ptr{system.Memory().GetPointer(framebuffer_addr)};
+    return texture_cache.TryFindFramebufferSurface(host_ptr) != nullptr;
+}
+
+void RasterizerNull::SetupDirtyFlags() {
+    VideoCommon::Dirty::SetupDirtyRenderTargets(system.GPU().Maxwell3D().dirty.tables);
+}
+
+void RasterizerNull::UpdateAttachments() {
+    MICROPROFILE_SCOPE(Null_RenderTargets);
+    auto& dirty = system.GPU().Maxwell3D().dirty.flags;
+    if (!dirty[VideoCommon::Dirty::RenderTargets]) {
+        return;
+    }
+    dirty[VideoCommon::Dirty::RenderTargets] = false;
+
+    texture_cache.GuardRenderTargets(true);
+    for (std::size_t rt = 0; rt < Maxwell::NumRenderTargets; ++rt) {
+        color_attachments[rt] = texture_cache.GetColorBufferSurface(rt, true);
+    }
+    zeta_attachment = texture_cache.GetDepthBufferSurface(true);
+    texture_cache.GuardRenderTargets(false);
+}
+
+void RasterizerNull::MarkAttachmentsInUse() {
+    for (std::size_t index = 0; index < std::size(color_attachments); ++index) {
+        if (color_attachments[index]) {
+            texture_cache.MarkColorBufferInUse(index);
+        }
+    }
+    if (zeta_attachment) {
+        texture_cache.MarkDepthBufferInUse();
+    }
+}
+
+void RasterizerNull::SetupVertexArrays() {
+    MICROPROFILE_SCOPE(Null_Geometry);
+    const auto& regs = system.GPU().Maxwell3D().regs;
+
+    for (u32 index = 0; index < static_cast<u32>(Maxwell::NumVertexArrays); ++index) {
+        const auto& vertex_array = regs.vertex_array[index];
+        if (!vertex_array.IsEnabled()) {
+            continue;
+        }
+
+        const GPUVAddr start{vertex_array.StartAddress()};
+        const GPUVAddr end{regs.vertex_array_limit[index].LimitAddress()};
+
+        ASSERT(end > start);
+        buffer_cache.UploadMemory(start, end - start + 1);
+    }
+}
+
+void RasterizerNull::SetupIndexBuffer() {
+    MICROPROFILE_SCOPE(Null_Geometry);
+    const auto& regs = system.GPU().Maxwell3D().regs;
+    buffer_cache.UploadMemory(regs.index_array.IndexStart(), CalculateIndexBufferSize());
+}
+
+void RasterizerNull::SetupShaderResources(
+    const std::array<Shader, Maxwell::MaxShaderProgram>& shaders) {
+    texture_cache.GuardSamplers(true);
+
+    for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+        // Skip VertexA stage
+        const auto& shader = shaders[stage + 1];
+        if (!shader) {
+            continue;
+        }
+        const auto& ir = shader->GetIR();
+        SetupGraphicsConstBuffers(ir, stage);
+        SetupGraphicsGlobalBuffers(ir, stage);
+        SetupGraphicsTextures(ir, stage);
+        SetupGraphicsImages(ir, stage);
+    }
+    texture_cache.GuardSamplers(false);
+}
+
+void RasterizerNull::SetupGraphicsConstBuffers(const VideoCommon::Shader::ShaderIR& ir,
+                                               std::size_t stage) {
+    MICROPROFILE_SCOPE(Null_ConstBuffers);
+    const auto& shader_stage = system.GPU().Maxwell3D().state.shader_stages[stage];
+    for (const auto& [index, entry] : ir.GetConstantBuffers()) {
+        SetupConstBuffer(entry, shader_stage.const_buffers[index]);
+    }
+}
+
+void RasterizerNull::SetupGraphicsGlobalBuffers(const VideoCommon::Shader::ShaderIR& ir,
+                                                std::size_t stage) {
+    MICROPROFILE_SCOPE(Null_GlobalBuffers);
+    const auto& cbufs{system.GPU().Maxwell3D().state.shader_stages[stage]};
+    for (const auto& [base, usage] : ir.GetGlobalMemory()) {
+        const auto addr{cbufs.const_buffers[base.cbuf_index].address + base.cbuf_offset};
+        SetupGlobalBuffer(usage, addr);
+    }
+}
+
+void RasterizerNull::SetupGraphicsTextures(const VideoCommon::Shader::ShaderIR& ir,
+                                           std::size_t stage) {
+    MICROPROFILE_SCOPE(Null_Textures);
+    const auto& gpu = system.GPU().Maxwell3D();
+    for (const auto& entry : ir.GetSamplers()) {
+        for (std::size_t i = 0; i < entry.Size(); ++i) {
+            const auto texture = GetTextureInfo(gpu, entry, stage, i);
+            texture_cache.GetTextureSurface(texture.tic, entry);
+        }
+    }
+}
+
+void RasterizerNull::SetupGraphicsImages(const VideoCommon::Shader::ShaderIR& ir,
+                                         std::size_t stage) {
+    MICROPROFILE_SCOPE(Null_Images);
+    const auto& gpu = system.GPU().Maxwell3D();
+    for (const auto& entry : ir.GetImages()) {
+        const auto tic = GetTextureInfo(gpu, entry, stage).tic;
+        SetupImage(tic, entry);
+    }
+}
+
+void RasterizerNull::SetupComputeConstBuffers(const VideoCommon::Shader::ShaderIR& ir) {
+    MICROPROFILE_SCOPE(Null_ConstBuffers);
+    const auto& launch_desc = system.GPU().KeplerCompute().launch_description;
+    const std::bitset<8> mask = launch_desc.const_buffer_enable_mask.Value();
+    for (const auto& [index, entry] : ir.GetConstantBuffers()) {
+        const auto& config = launch_desc.const_buffer_config[index];
+        Tegra::Engines::ConstBufferInfo buffer;
+        buffer.address = config.Address();
+        buffer.size = config.size;
+        buffer.enabled = mask[index];
+        SetupConstBuffer(entry, buffer);
+    }
+}
+
+void RasterizerNull::SetupComputeGlobalBuffers(const VideoCommon::Shader::ShaderIR& ir) {
+    MICROPROFILE_SCOPE(Null_GlobalBuffers);
+    const auto& cbufs{system.GPU().KeplerCompute().launch_description.const_buffer_config};
+    for (const auto& [base, usage] : ir.GetGlobalMemory()) {
+        const auto addr{cbufs[base.cbuf_index].Address() + base.cbuf_offset};
+        SetupGlobalBuffer(usage, addr);
+    }
+}
+
+void RasterizerNull::SetupComputeTextures(const VideoCommon::Shader::ShaderIR& ir) {
+    MICROPROFILE_SCOPE(Null_Textures);
+    const auto& gpu = system.GPU().KeplerCompute();
+    for (const auto& entry : ir.GetSamplers()) {
+        for (std::size_t i = 0; i < entry.Size(); ++i) {
+            const auto texture = GetTextureInfo(gpu, entry, ComputeShaderIndex, i);
+            texture_cache.GetTextureSurface(texture.tic, entry);
+        }
+    }
+}
+
+void RasterizerNull::SetupComputeImages(const VideoCommon::Shader::ShaderIR& ir) {
+    MICROPROFILE_SCOPE(Null_Images);
+    const auto& gpu = system.GPU().KeplerCompute();
+    for (const auto& entry : ir.GetImages()) {
+        const auto tic = GetTextureInfo(gpu, entry, ComputeShaderIndex).tic;
+        SetupImage(tic, entry);
+    }
+}
+
+void RasterizerNull::SetupConstBuffer(const VideoCommon::Shader::ConstBuffer& entry,
+                                      const Tegra::Engines::ConstBufferInfo& buffer) {
+    if (!buffer.enabled) {
+        return;
+    }
+
+    // Align the size like the hardware backends do, so the same regions end up cached
+    const std::size_t size =
+        Common::AlignUp(CalculateConstBufferSize(entry, buffer), 4 * sizeof(float));
+    ASSERT(size <= MaxConstbufferSize);
+
+    buffer_cache.UploadMemory(buffer.address, size, BUFFER_ALIGNMENT);
+}
+
+void RasterizerNull::SetupGlobalBuffer(const VideoCommon::Shader::GlobalMemoryUsage& usage,
+                                       GPUVAddr address) {
+    auto& memory_manager{system.GPU().MemoryManager()};
+    const auto actual_addr = memory_manager.Read<u64>(address);
+    const auto size = memory_manager.Read<u32>(address + 8);
+    if (size == 0) {
+        return;
+    }
+    buffer_cache.UploadMemory(actual_addr, size, BUFFER_ALIGNMENT, usage.is_written);
+}
+
+void RasterizerNull::SetupImage(const Tegra::Texture::TICEntry& tic,
+                                const VideoCommon::Shader::Image& entry) {
+    const auto view = texture_cache.GetImageSurface(tic, entry);
+    if (view && entry.IsWritten()) {
+        view->MarkAsModified(texture_cache.Tick());
+    }
+}
+
+std::size_t RasterizerNull::CalculateGraphicsStreamBufferSize(bool is_indexed) const {
+    std::size_t size = CalculateVertexArraysSize();
+    if (is_indexed) {
+        size = Common::AlignUp(size, 4) + CalculateIndexBufferSize();
+    }
+    size += Maxwell::MaxConstBuffers * (MaxConstbufferSize + BUFFER_ALIGNMENT);
+    return size;
+}
+
+std::size_t RasterizerNull::CalculateComputeStreamBufferSize() const {
+    return Tegra::Engines::KeplerCompute::NumConstBuffers *
+           (Maxwell::MaxConstBufferSize + BUFFER_ALIGNMENT);
+}
+
+std::size_t RasterizerNull::CalculateVertexArraysSize() const {
+    const auto& regs = system.GPU().Maxwell3D().regs;
+
+    std::size_t size = 0;
+    for (u32 index = 0; index < Maxwell::NumVertexArrays; ++index) {
+        // This implementation assumes that all attributes are used in the shader.
+        const GPUVAddr start{regs.vertex_array[index].StartAddress()};
+        const GPUVAddr end{regs.vertex_array_limit[index].LimitAddress()};
+        DEBUG_ASSERT(end >= start);
+
+        size += (end - start + 1) * regs.vertex_array[index].enable;
+    }
+    return size;
+}
+
+std::size_t RasterizerNull::CalculateIndexBufferSize() const {
+    const auto& regs = system.GPU().Maxwell3D().regs;
+    return static_cast<std::size_t>(regs.index_array.count) *
+           static_cast<std::size_t>(regs.index_array.FormatSizeInBytes());
+}
+
+} // namespace Null
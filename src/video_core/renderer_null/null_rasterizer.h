@@ -0,0 +1,108 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "common/common_types.h"
+#include "video_core/engines/const_buffer_info.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/rasterizer_accelerated.h"
+#include "video_core/renderer_null/null_buffer_cache.h"
+#include "video_core/renderer_null/null_shader_cache.h"
+#include "video_core/renderer_null/null_texture_cache.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace Core {
+class System;
+}
+
+namespace Null {
+
+/**
+ * Rasterizer that runs the same cache bookkeeping as the hardware backends on every draw, clear
+ * and dispatch, without recording any host work. It bounds how fast the GPU frontend can go.
+ */
+class RasterizerNull final : public VideoCore::RasterizerAccelerated {
+public:
+    explicit RasterizerNull(Core::System& system);
+    ~RasterizerNull() override;
+
+    void Draw(bool is_indexed, bool is_instanced) override;
+    void Clear() override;
+    void DispatchCompute(GPUVAddr code_addr) override;
+    void ResetCounter(VideoCore::QueryType type) override;
+    void Query(GPUVAddr gpu_addr, VideoCore::QueryType type, std::optional<u64> timestamp) override;
+    void FlushAll() override;
+    void FlushRegion(CacheAddr addr, u64 size) override;
+    void InvalidateRegion(CacheAddr addr, u64 size) override;
+    void FlushAndInvalidateRegion(CacheAddr addr, u64 size) override;
+    void FlushCommands() override;
+    void TickFrame() override;
+    bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
+                               const Tegra::Engines::Fermi2D::Regs::Surface& dst,
+                               const Tegra::Engines::Fermi2D::Config& copy_config) override;
+    bool AccelerateDisplay(const Tegra::FramebufferConfig& config, VAddr framebuffer_addr,
+                           u32 pixel_stride) override;
+    void SetupDirtyFlags() override;
+
+    /// Maximum supported size that a constbuffer can have in bytes.
+    static constexpr std::size_t MaxConstbufferSize = 0x10000;
+
+private:
+    void UpdateAttachments();
+
+    void MarkAttachmentsInUse();
+
+    void SetupVertexArrays();
+
+    void SetupIndexBuffer();
+
+    void SetupShaderResources(const std::array<Shader, Maxwell::MaxShaderProgram>& shaders);
+
+    void SetupGraphicsConstBuffers(const VideoCommon::Shader::ShaderIR& ir, std::size_t stage);
+
+    void SetupGraphicsGlobalBuffers(const VideoCommon::Shader::ShaderIR& ir, std::size_t stage);
+
+    void SetupGraphicsTextures(const VideoCommon::Shader::ShaderIR& ir, std::size_t stage);
+
+    void SetupGraphicsImages(const VideoCommon::Shader::ShaderIR& ir, std::size_t stage);
+
+    void SetupComputeConstBuffers(const VideoCommon::Shader::ShaderIR& ir);
+
+    void SetupComputeGlobalBuffers(const VideoCommon::Shader::ShaderIR& ir);
+
+    void SetupComputeTextures(const VideoCommon::Shader::ShaderIR& ir);
+
+    void SetupComputeImages(const VideoCommon::Shader::ShaderIR& ir);
+
+    void SetupConstBuffer(const VideoCommon::Shader::ConstBuffer& entry,
+                          const Tegra::Engines::ConstBufferInfo& buffer);
+
+    void SetupGlobalBuffer(const VideoCommon::Shader::GlobalMemoryUsage& usage, GPUVAddr address);
+
+    void SetupImage(const Tegra::Texture::TICEntry& tic, const VideoCommon::Shader::Image& entry);
+
+    std::size_t CalculateGraphicsStreamBufferSize(bool is_indexed) const;
+
+    std::size_t CalculateComputeStreamBufferSize() const;
+
+    std::size_t CalculateVertexArraysSize() const;
+
+    std::size_t CalculateIndexBufferSize() const;
+
+    Core::System& system;
+
+    NullTextureCache texture_cache;
+    NullShaderCache shader_cache;
+    NullBufferCache buffer_cache;
+
+    std::array<View, Maxwell::NumRenderTargets> color_attachments;
+    View zeta_attachment;
+};
+
+} // namespace Null
@@ -0,0 +1,120 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "core/core.h"
+#include "core/settings.h"
+#include "video_core/engines/kepler_compute.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_shader_cache.h"
+#include "video_core/shader/compiler_settings.h"
+#include "video_core/shader/memory_util.h"
+
+namespace Null {
+
+MICROPROFILE_DECLARE(Null_ShaderCache);
+
+using Tegra::Engines::ShaderType;
+using VideoCommon::Shader::GetShaderAddress;
+using VideoCommon::Shader::GetShaderCode;
+using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
+using VideoCommon::Shader::STAGE_MAIN_OFFSET;
+
+namespace {
+
+/// Gets the settings used to build the IR of guest shaders
+VideoCommon::Shader::CompilerSettings GetCompilerSettings() {
+    VideoCommon::Shader::CompilerSettings settings;
+    settings.optimize = Settings::values.use_shader_optimizations;
+    return settings;
+}
+
+} // Anonymous namespace
+
+CachedShader::CachedShader(Core::System& system, ShaderType stage, GPUVAddr gpu_addr,
+                           VAddr cpu_addr, u8* host_ptr, ProgramCode program_code, u32 main_offset)
+    : RasterizerCacheObject{host_ptr}, gpu_addr{gpu_addr}, cpu_addr{cpu_addr},
+      program_code{std::move(program_code)}, registry{stage, GetEngine(system, stage)},
+      shader_ir{this->program_code, main_offset, GetCompilerSettings(), registry} {}
+
+CachedShader::~CachedShader() = default;
+
+Tegra::Engines::ConstBufferEngineInterface& CachedShader::GetEngine(Core::System& system,
+                                                                    ShaderType stage) {
+    if (stage == ShaderType::Compute) {
+        return system.GPU().KeplerCompute();
+    } else {
+        return system.GPU().Maxwell3D();
+    }
+}
+
+NullShaderCache::NullShaderCache(Core::System& system, VideoCore::RasterizerInterface& rasterizer)
+    : RasterizerCache{rasterizer}, system{system} {}
+
+NullShaderCache::~NullShaderCache() = default;
+
+std::array<Shader, Maxwell::MaxShaderProgram> NullShaderCache::GetShaders() {
+    MICROPROFILE_SCOPE(Null_ShaderCache);
+
+    const auto& gpu = system.GPU().Maxwell3D();
+    auto& memory_manager = system.GPU().MemoryManager();
+
+    std::array<Shader, Maxwell::MaxShaderProgram> shaders;
+    for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        // Skip stages that are not enabled
+        if (!gpu.regs.IsShaderConfigEnabled(index)) {
+            continue;
+        }
+
+        const auto program{static_cast<Maxwell::ShaderProgram>(index)};
+        const GPUVAddr program_addr{GetShaderAddress(system, program)};
+        const auto host_ptr{memory_manager.GetPointer(program_addr)};
+        auto shader = TryGet(host_ptr);
+        if (!shader) {
+            // No shader found - decode a new one
+            const auto stage = static_cast<ShaderType>(index == 0 ? 0 : index - 1);
+            auto code = GetShaderCode(memory_manager, program_addr, host_ptr, false);
+
+            const std::optional cpu_addr = memory_manager.GpuToCpuAddress(program_addr);
+            ASSERT(cpu_addr);
+
+            shader = std::make_shared<CachedShader>(system, stage, program_addr, *cpu_addr,
+                                                    host_ptr, std::move(code), STAGE_MAIN_OFFSET);
+            Register(shader);
+        }
+        shaders[index] = std::move(shader);
+    }
+    return shaders;
+}
+
+Shader NullShaderCache::GetComputeKernel(GPUVAddr code_addr) {
+    MICROPROFILE_SCOPE(Null_ShaderCache);
+
+    auto& memory_manager = system.GPU().MemoryManager();
+    const auto host_ptr = memory_manager.GetPointer(code_addr);
+    auto kernel = TryGet(host_ptr);
+    if (kernel) {
+        return kernel;
+    }
+
+    const auto cpu_addr = memory_manager.GpuToCpuAddress(code_addr);
+    ASSERT(cpu_addr);
+
+    auto code = GetShaderCode(memory_manager, code_addr, host_ptr, true);
+    kernel = std::make_shared<CachedShader>(system, ShaderType::Compute, code_addr, *cpu_addr,
+                                            host_ptr, std::move(code), KERNEL_MAIN_OFFSET);
+    Register(kernel);
+    return kernel;
+}
+
+} // namespace Null
@@ -0,0 +1,85 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/engines/const_buffer_engine_interface.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/rasterizer_cache.h"
+#include "video_core/shader/registry.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace Core {
+class System;
+}
+
+namespace Null {
+
+class CachedShader;
+using Shader = std::shared_ptr<CachedShader>;
+using Maxwell = Tegra::Engines::Maxwell3D::Regs;
+
+using ProgramCode = std::vector<u64>;
+
+/// Guest shader decoded to IR, its resource usage is what the rasterizer binds on each draw
+class CachedShader final : public RasterizerCacheObject {
+public:
+    explicit CachedShader(Core::System& system, Tegra::Engines::ShaderType stage, GPUVAddr gpu_addr,
+                          VAddr cpu_addr, u8* host_ptr, ProgramCode program_code, u32 main_offset);
+    ~CachedShader();
+
+    GPUVAddr GetGpuAddr() const {
+        return gpu_addr;
+    }
+
+    VAddr GetCpuAddr() const override {
+        return cpu_addr;
+    }
+
+    std::size_t GetSizeInBytes() const override {
+        return program_code.size() * sizeof(u64);
+    }
+
+    const VideoCommon::Shader::ShaderIR& GetIR() const {
+        return shader_ir;
+    }
+
+private:
+    static Tegra::Engines::ConstBufferEngineInterface& GetEngine(Core::System& system,
+                                                                 Tegra::Engines::ShaderType stage);
+
+    GPUVAddr gpu_addr{};
+    VAddr cpu_addr{};
+    ProgramCode program_code;
+    VideoCommon::Shader::Registry registry;
+    VideoCommon::Shader::ShaderIR shader_ir;
+};
+
+/// Decodes guest shaders without building any host program
+class NullShaderCache final : public RasterizerCache<Shader> {
+public:
+    explicit NullShaderCache(Core::System& system, VideoCore::RasterizerInterface& rasterizer);
+    ~NullShaderCache();
+
+    /// Returns the shaders of the enabled graphics stages, indexed by program
+    std::array<Shader, Maxwell::MaxShaderProgram> GetShaders();
+
+    /// Returns the compute kernel at the given address
+    Shader GetComputeKernel(GPUVAddr code_addr);
+
+protected:
+    void FlushObjectInner(const Shader& object) override {}
+
+private:
+    Core::System& system;
+};
+
+} // namespace Null
@@ -0,0 +1,58 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "video_core/renderer_null/null_texture_cache.h"
+
+namespace Null {
+
+CachedSurface::CachedSurface(GPUVAddr gpu_addr, const SurfaceParams& params)
+    : SurfaceBase<View>{gpu_addr, params, false} {
+    main_view = CreateView(ViewParams(params.target, 0, static_cast<u32>(params.GetNumLayers()), 0,
+                                      params.num_levels));
+}
+
+CachedSurface::~CachedSurface() = default;
+
+void CachedSurface::UploadTexture(const std::vector<u8>& staging_buffer) {
+    host_data.assign(staging_buffer.begin(), staging_buffer.end());
+}
+
+void CachedSurface::DownloadTexture(std::vector<u8>& staging_buffer) {
+    // Surfaces that were never uploaded to are flushed as zeroes, like a freshly created image
+    const std::size_t size = std::min(host_data.size(), staging_buffer.size());
+    std::copy_n(host_data.begin(), size, staging_buffer.begin());
+    std::fill(staging_buffer.begin() + size, staging_buffer.end(), u8{0});
+}
+
+View CachedSurface::CreateView(const ViewParams& view_params) {
+    return views[view_params] = std::make_shared<CachedSurfaceView>(*this, view_params);
+}
+
+CachedSurfaceView::CachedSurfaceView(CachedSurface& surface, const ViewParams& params)
+    : VideoCommon::ViewBase{params}, surface{surface} {}
+
+CachedSurfaceView::~CachedSurfaceView() = default;
+
+NullTextureCache::NullTextureCache(Core::System& system, VideoCore::RasterizerInterface& rasterizer)
+    : TextureCache(system, rasterizer, false, false) {}
+
+NullTextureCache::~NullTextureCache() = default;
+
+Surface NullTextureCache::CreateSurface(GPUVAddr gpu_addr, const SurfaceParams& params) {
+    return std::make_shared<CachedSurface>(gpu_addr, params);
+}
+
+void NullTextureCache::ImageCopy(Surface& src_surface, Surface& dst_surface,
+                                 const VideoCommon::CopyParams& copy_params) {}
+
+void NullTextureCache::ImageBlit(View& src_view, View& dst_view,
+                                 const Tegra::Engines::Fermi2D::Config& copy_config) {}
+
+void NullTextureCache::BufferCopy(Surface& src_surface, Surface& dst_surface) {}
+
+} // namespace Null
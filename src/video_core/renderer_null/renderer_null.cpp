@@ -0,0 +1,49 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+#include "video_core/renderer_null/renderer_null.h"
+
+namespace Null {
+
+RendererNull::RendererNull(Core::Frontend::EmuWindow& window, Core::System& system)
+    : RendererBase(window), system{system} {}
+
+RendererNull::~RendererNull() {
+    ShutDown();
+}
+
+bool RendererNull::Init() {
+    rasterizer = std::make_unique<RasterizerNull>(system);
+    LOG_INFO(Render, "Using the null renderer, nothing will be drawn");
+    return true;
+}
+
+void RendererNull::ShutDown() {}
+
+void RendererNull::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    render_window.PollEvents();
+
+    if (!framebuffer) {
+        return;
+    }
+
+    // Look up the presented surface like the other renderers, its contents are never read
+    const VAddr framebuffer_addr = framebuffer->address + framebuffer->offset;
+    rasterizer->AccelerateDisplay(*framebuffer, framebuffer_addr, framebuffer->stride);
+
+    m_current_frame++;
+    rasterizer->TickFrame();
+}
+
+bool RendererNull::TryPresent(int timeout_ms) {
+    return false;
+}
+
+} // namespace Null
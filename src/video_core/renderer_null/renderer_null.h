@@ -0,0 +1,33 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "video_core/renderer_base.h"
+
+namespace Core {
+class System;
+}
+
+namespace Null {
+
+/**
+ * Renderer without a host graphics API. Guest commands go through the engines and the texture,
+ * buffer and shader caches as usual, but nothing is drawn or presented.
+ */
+class RendererNull final : public VideoCore::RendererBase {
+public:
+    explicit RendererNull(Core::Frontend::EmuWindow& window, Core::System& system);
+    ~RendererNull() override;
+
+    bool Init() override;
+    void ShutDown() override;
+    void SwapBuffers(const Tegra::FramebufferConfig* framebuffer) override;
+    bool TryPresent(int timeout_ms) override;
+
+private:
+    Core::System& system;
+};
+
+} // namespace Null
@@ -343,6 +343,7 @@ void RasterizerOpenGL::ConfigureFramebuffers() {
     }
     gpu.dirty.flags[VideoCommon::Dirty::RenderTargets] = false;
 
+    texture_cache.UpdateRenderTargetScale();
     texture_cache.GuardRenderTargets(true);
 
     View depth_surface = texture_cache.GetDepthBufferSurface(true);
@@ -376,6 +377,11 @@ void RasterizerOpenGL::ConfigureFramebuffers() {
     texture_cache.GuardRenderTargets(false);
 
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_cache.GetFramebuffer(key));
+
+    if (UpdateRenderScale(key)) {
+        SyncViewport();
+        SyncScissorTest();
+    }
 }
 
 void RasterizerOpenGL::ConfigureClearFramebuffer(bool using_color_fb, bool using_depth_fb,
@@ -383,6 +389,9 @@ void RasterizerOpenGL::ConfigureClearFramebuffer(bool using_color_fb, bool using
     auto& gpu = system.GPU().Maxwell3D();
     const auto& regs = gpu.regs;
 
+    if (gpu.dirty.flags[VideoCommon::Dirty::RenderTargets]) {
+        texture_cache.UpdateRenderTargetScale();
+    }
     texture_cache.GuardRenderTargets(true);
     View color_surface;
     if (using_color_fb) {
@@ -403,6 +412,32 @@ void RasterizerOpenGL::ConfigureClearFramebuffer(bool using_color_fb, bool using
 
     state_tracker.NotifyFramebuffer();
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_cache.GetFramebuffer(key));
+
+    if (UpdateRenderScale(key) && regs.clear_flags.scissor) {
+        SyncScissorTest();
+    }
+}
+
+bool RasterizerOpenGL::UpdateRenderScale(const FramebufferCacheKey& key) {
+    // The texture cache keeps every attachment of a framebuffer at the same scale
+    u32 scale = 1;
+    if (key.zeta) {
+        scale = key.zeta->GetScale();
+    }
+    for (const auto& color : key.colors) {
+        if (color) {
+            ASSERT(!key.zeta || color->GetScale() == scale);
+            scale = color->GetScale();
+            break;
+        }
+    }
+    if (scale == render_scale) {
+        return false;
+    }
+    render_scale = scale;
+    state_tracker.NotifyViewports();
+    state_tracker.NotifyScissors();
+    return true;
 }
 
 void RasterizerOpenGL::Clear() {
@@ -939,8 +974,9 @@ void RasterizerOpenGL::SyncViewport() {
 
             const auto& src = regs.viewport_transform[i];
             const Common::Rectangle<f32> rect{src.GetRect()};
-            glViewportIndexedf(static_cast<GLuint>(i), rect.left, rect.bottom, rect.GetWidth(),
-                               rect.GetHeight());
+            const auto scale = static_cast<f32>(render_scale);
+            glViewportIndexedf(static_cast<GLuint>(i), rect.left * scale, rect.bottom * scale,
+                               rect.GetWidth() * scale, rect.GetHeight() * scale);
 
             const GLdouble reduce_z = regs.depth_mode == Maxwell::DepthMode::MinusOneToOne;
             const GLdouble near_depth = src.translate_z - src.scale_z * reduce_z;
@@ -1282,8 +1318,9 @@ void RasterizerOpenGL::SyncScissorTest() {
         const auto& src = regs.scissor_test[index];
         if (src.enable) {
             glEnablei(GL_SCISSOR_TEST, static_cast<GLuint>(index));
-            glScissorIndexed(static_cast<GLuint>(index), src.min_x, src.min_y,
-                             src.max_x - src.min_x, src.max_y - src.min_y);
+            glScissorIndexed(static_cast<GLuint>(index), src.min_x * render_scale,
+                             src.min_y * render_scale, (src.max_x - src.min_x) * render_scale,
+                             (src.max_y - src.min_y) * render_scale);
         } else {
             glDisablei(GL_SCISSOR_TEST, static_cast<GLuint>(index));
         }
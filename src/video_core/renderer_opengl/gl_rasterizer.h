@@ -90,6 +90,9 @@ private:
 
     void ConfigureClearFramebuffer(bool using_color_fb, bool using_depth_fb, bool using_stencil_fb);
 
+    /// Sets the scale of the bound render targets, returns true when it has changed.
+    bool UpdateRenderScale(const FramebufferCacheKey& key);
+
     /// Configures the current constbuffers to use for the draw command.
     void SetupDrawConstBuffers(std::size_t stage_index, const Shader& shader);
 
@@ -241,6 +244,9 @@ private:
     std::size_t num_queued_commands = 0;
 
     u32 last_clip_distance_mask = 0;
+
+    /// Resolution scale of the bound render targets, applied to viewports and scissors.
+    u32 render_scale = 1;
 };
 
 } // namespace OpenGL
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <initializer_list>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -61,6 +63,9 @@ struct TextureDerivates {};
 using TextureArgument = std::pair<Type, Node>;
 using TextureIR = std::variant<TextureOffset, TextureDerivates, TextureArgument>;
 
+/// Predicate indices fit in four bits
+constexpr std::size_t NUM_PREDICATE_NAMES = 16;
+
 constexpr u32 MAX_CONSTBUFFER_ELEMENTS =
     static_cast<u32>(Maxwell::MaxConstBufferSize) / (4 * sizeof(float));
 
@@ -83,8 +88,30 @@ layout (std140, binding = {}) uniform vs_config {{
 }};
 )";
 
+/// Initial capacity of the emitted source, enough for most guest shaders without reallocating
+constexpr std::size_t SHADER_SOURCE_RESERVE = 64 * 1024;
+
+/// Buffer handed to the writers on this thread, it keeps its capacity between decompilations
+thread_local std::string reusable_shader_source;
+
 class ShaderWriter final {
 public:
+    ShaderWriter() {
+        shader_source.swap(reusable_shader_source);
+        shader_source.clear();
+        shader_source.reserve(SHADER_SOURCE_RESERVE);
+    }
+
+    ~ShaderWriter() {
+        if (shader_source.capacity() > reusable_shader_source.capacity()) {
+            shader_source.clear();
+            shader_source.swap(reusable_shader_source);
+        }
+    }
+
+    ShaderWriter(const ShaderWriter&) = delete;
+    ShaderWriter& operator=(const ShaderWriter&) = delete;
+
     void AddExpression(std::string_view text) {
         DEBUG_ASSERT(scope >= 0);
         if (!text.empty()) {
@@ -100,7 +127,12 @@ public:
     // etc).
     template <typename... Args>
     void AddLine(std::string_view text, Args&&... args) {
-        AddExpression(fmt::format(text, std::forward<Args>(args)...));
+        DEBUG_ASSERT(scope >= 0);
+        if (!text.empty()) {
+            AppendIndentation();
+        }
+        // Format in place instead of building a temporary string for each line
+        fmt::format_to(std::back_inserter(shader_source), text, std::forward<Args>(args)...);
         AddNewLine();
     }
 
@@ -113,8 +145,9 @@ public:
         return fmt::format("tmp{}", temporary_index++);
     }
 
-    std::string GetResult() {
-        return std::move(shader_source);
+    /// Returns a tightly sized copy of the source, the writer keeps its buffer for reuse
+    std::string GetResult() const {
+        return shader_source;
     }
 
     s32 scope = 0;
@@ -128,6 +161,32 @@ private:
     u32 temporary_index = 1;
 };
 
+/// Lazily formats and caches indexed names like "gpr4" or "cbuf2_vertex", so each name is only
+/// formatted once per shader. The table never grows, references to its names stay valid.
+class NameTable final {
+public:
+    explicit NameTable(std::string_view name, std::string_view suffix, std::size_t size)
+        : name{name}, suffix{suffix}, names(size) {}
+
+    const std::string& Get(std::size_t index) {
+        ASSERT(index < names.size());
+        std::string& entry = names[index];
+        if (entry.empty()) {
+            if (suffix.empty()) {
+                entry = fmt::format("{}{}", name, index);
+            } else {
+                entry = fmt::format("{}{}_{}", name, index, suffix);
+            }
+        }
+        return entry;
+    }
+
+private:
+    std::string_view name;
+    std::string_view suffix;
+    std::vector<std::string> names;
+};
+
 class Expression final {
 public:
     Expression(std::string code, Type type) : code{std::move(code)}, type{type} {
@@ -139,7 +198,7 @@ public:
         return type;
     }
 
-    std::string GetCode() const {
+    const std::string& GetCode() const {
         return code;
     }
 
@@ -147,108 +206,108 @@ public:
         ASSERT(type == Type::Void);
     }
 
-    std::string As(Type type) const {
-        switch (type) {
-        case Type::Bool:
-            return AsBool();
-        case Type::Bool2:
-            return AsBool2();
-        case Type::Float:
-            return AsFloat();
-        case Type::Int:
-            return AsInt();
-        case Type::Uint:
-            return AsUint();
-        case Type::HalfFloat:
-            return AsHalfFloat();
-        default:
-            UNREACHABLE_MSG("Invalid type");
-            return code;
-        }
+    std::string As(Type target) const {
+        std::string result;
+        AppendAs(result, target);
+        return result;
+    }
+
+    /// Appends the expression converted to the given type, without building the converted string
+    void AppendAs(std::string& out, Type target) const {
+        const auto [prefix, suffix] = GetConversion(target);
+        out.reserve(out.size() + prefix.size() + code.size() + suffix.size());
+        out += prefix;
+        out += code;
+        out += suffix;
     }
 
     std::string AsBool() const {
-        switch (type) {
-        case Type::Bool:
-            return code;
-        default:
-            UNREACHABLE_MSG("Incompatible types");
-            return code;
-        }
+        return As(Type::Bool);
     }
 
     std::string AsBool2() const {
-        switch (type) {
-        case Type::Bool2:
-            return code;
-        default:
-            UNREACHABLE_MSG("Incompatible types");
-            return code;
-        }
+        return As(Type::Bool2);
     }
 
     std::string AsFloat() const {
-        switch (type) {
-        case Type::Float:
-            return code;
-        case Type::Uint:
-            return fmt::format("utof({})", code);
-        case Type::Int:
-            return fmt::format("itof({})", code);
-        case Type::HalfFloat:
-            return fmt::format("utof(packHalf2x16({}))", code);
-        default:
-            UNREACHABLE_MSG("Incompatible types");
-            return code;
-        }
+        return As(Type::Float);
     }
 
     std::string AsInt() const {
-        switch (type) {
-        case Type::Float:
-            return fmt::format("ftoi({})", code);
-        case Type::Uint:
-            return fmt::format("int({})", code);
-        case Type::Int:
-            return code;
-        case Type::HalfFloat:
-            return fmt::format("int(packHalf2x16({}))", code);
-        default:
-            UNREACHABLE_MSG("Incompatible types");
-            return code;
-        }
+        return As(Type::Int);
     }
 
     std::string AsUint() const {
-        switch (type) {
-        case Type::Float:
-            return fmt::format("ftou({})", code);
-        case Type::Uint:
-            return code;
-        case Type::Int:
-            return fmt::format("uint({})", code);
-        case Type::HalfFloat:
-            return fmt::format("packHalf2x16({})", code);
-        default:
-            UNREACHABLE_MSG("Incompatible types");
-            return code;
-        }
+        return As(Type::Uint);
     }
 
     std::string AsHalfFloat() const {
-        switch (type) {
+        return As(Type::HalfFloat);
+    }
+
+    /// Returns the code wrapped around the expression to convert it to the target type
+    std::pair<std::string_view, std::string_view> GetConversion(Type target) const {
+        if (target == type && type != Type::Void) {
+            return {};
+        }
+        switch (target) {
         case Type::Float:
-            return fmt::format("unpackHalf2x16(ftou({}))", code);
-        case Type::Uint:
-            return fmt::format("unpackHalf2x16({})", code);
+            switch (type) {
+            case Type::Uint:
+                return {"utof(", ")"};
+            case Type::Int:
+                return {"itof(", ")"};
+            case Type::HalfFloat:
+                return {"utof(packHalf2x16(", "))"};
+            default:
+                break;
+            }
+            break;
         case Type::Int:
-            return fmt::format("unpackHalf2x16(int({}))", code);
+            switch (type) {
+            case Type::Float:
+                return {"ftoi(", ")"};
+            case Type::Uint:
+                return {"int(", ")"};
+            case Type::HalfFloat:
+                return {"int(packHalf2x16(", "))"};
+            default:
+                break;
+            }
+            break;
+        case Type::Uint:
+            switch (type) {
+            case Type::Float:
+                return {"ftou(", ")"};
+            case Type::Int:
+                return {"uint(", ")"};
+            case Type::HalfFloat:
+                return {"packHalf2x16(", ")"};
+            default:
+                break;
+            }
+            break;
         case Type::HalfFloat:
-            return code;
+            switch (type) {
+            case Type::Float:
+                return {"unpackHalf2x16(ftou(", "))"};
+            case Type::Uint:
+                return {"unpackHalf2x16(", ")"};
+            case Type::Int:
+                return {"unpackHalf2x16(int(", "))"};
+            default:
+                break;
+            }
+            break;
+        case Type::Bool:
+        case Type::Bool2:
+            break;
         default:
-            UNREACHABLE_MSG("Incompatible types");
-            return code;
+            UNREACHABLE_MSG("Invalid type");
+            return {};
         }
+        UNREACHABLE_MSG("Incompatible types");
+        return {};
     }
 
 private:
@@ -413,7 +472,21 @@ public:
     explicit GLSLDecompiler(const Device& device, const ShaderIR& ir, const Registry& registry,
                             ShaderType stage, std::string_view identifier, std::string_view suffix)
         : device{device}, ir{ir}, registry{registry}, stage{stage},
-          identifier{identifier}, suffix{suffix}, header{ir.GetHeader()} {
+          identifier{identifier}, suffix{suffix}, header{ir.GetHeader()},
+          register_names{"gpr", suffix, Register::NumRegisters},
+          custom_variable_names{"custom_var", suffix, ir.GetNumCustomVariables()},
+          predicate_names{"pred", suffix, NUM_PREDICATE_NAMES},
+          const_buffer_names{"cbuf", suffix, Maxwell::MaxConstBuffers} {
+        constexpr std::array InternalFlagNames = {"zero_flag", "sign_flag", "carry_flag",
+                                                  "overflow_flag"};
+        static_assert(InternalFlagNames.size() == static_cast<std::size_t>(InternalFlag::Amount));
+        for (std::size_t flag = 0; flag < internal_flag_names.size(); ++flag) {
+            if (suffix.empty()) {
+                internal_flag_names[flag] = InternalFlagNames[flag];
+            } else {
+                internal_flag_names[flag] = fmt::format("{}_{}", InternalFlagNames[flag], suffix);
+            }
+        }
         if (stage != ShaderType::Compute) {
             transform_feedback = BuildTransformFeedback(registry.GetGraphicsInfo());
         }
@@ -1282,49 +1355,57 @@ private:
         }
     }
 
+    /// Formats a call to func with the operands of the operation converted to the given types
+    std::string GenerateCall(Operation operation, std::string_view func,
+                             std::initializer_list<Type> types) {
+        std::string call{func};
+        call += '(';
+        std::size_t index = 0;
+        for (const Type type : types) {
+            if (index != 0) {
+                call += ", ";
+            }
+            VisitOperand(operation, index++).AppendAs(call, type);
+        }
+        call += ')';
+        return call;
+    }
+
     Expression GenerateUnary(Operation operation, std::string_view func, Type result_type,
                              Type type_a) {
-        std::string op_str = fmt::format("{}({})", func, VisitOperand(operation, 0).As(type_a));
-        return ApplyPrecise(operation, std::move(op_str), result_type);
+        return ApplyPrecise(operation, GenerateCall(operation, func, {type_a}), result_type);
     }
 
     Expression GenerateBinaryInfix(Operation operation, std::string_view func, Type result_type,
                                    Type type_a, Type type_b) {
-        const std::string op_a = VisitOperand(operation, 0).As(type_a);
-        const std::string op_b = VisitOperand(operation, 1).As(type_b);
-        std::string op_str = fmt::format("({} {} {})", op_a, func, op_b);
+        std::string op_str{"("};
+        VisitOperand(operation, 0).AppendAs(op_str, type_a);
+        op_str += ' ';
+        op_str += func;
+        op_str += ' ';
+        VisitOperand(operation, 1).AppendAs(op_str, type_b);
+        op_str += ')';
 
         return ApplyPrecise(operation, std::move(op_str), result_type);
     }
 
     Expression GenerateBinaryCall(Operation operation, std::string_view func, Type result_type,
                                   Type type_a, Type type_b) {
-        const std::string op_a = VisitOperand(operation, 0).As(type_a);
-        const std::string op_b = VisitOperand(operation, 1).As(type_b);
-        std::string op_str = fmt::format("{}({}, {})", func, op_a, op_b);
-
-        return ApplyPrecise(operation, std::move(op_str), result_type);
+        return ApplyPrecise(operation, GenerateCall(operation, func, {type_a, type_b}),
+                            result_type);
     }
 
     Expression GenerateTernary(Operation operation, std::string_view func, Type result_type,
                                Type type_a, Type type_b, Type type_c) {
-        const std::string op_a = VisitOperand(operation, 0).As(type_a);
-        const std::string op_b = VisitOperand(operation, 1).As(type_b);
-        const std::string op_c = VisitOperand(operation, 2).As(type_c);
-        std::string op_str = fmt::format("{}({}, {}, {})", func, op_a, op_b, op_c);
-
-        return ApplyPrecise(operation, std::move(op_str), result_type);
+        return ApplyPrecise(operation, GenerateCall(operation, func, {type_a, type_b, type_c}),
+                            result_type);
     }
 
     Expression GenerateQuaternary(Operation operation, const std::string& func, Type result_type,
                                   Type type_a, Type type_b, Type type_c, Type type_d) {
-        const std::string op_a = VisitOperand(operation, 0).As(type_a);
-        const std::string op_b = VisitOperand(operation, 1).As(type_b);
-        const std::string op_c = VisitOperand(operation, 2).As(type_c);
-        const std::string op_d = VisitOperand(operation, 3).As(type_d);
-        std::string op_str = fmt::format("{}({}, {}, {}, {})", func, op_a, op_b, op_c, op_d);
-
-        return ApplyPrecise(operation, std::move(op_str), result_type);
+        return ApplyPrecise(operation,
+                            GenerateCall(operation, func, {type_a, type_b, type_c, type_d}),
+                            result_type);
     }
 
     std::string GenerateTexture(Operation operation, const std::string& function_suffix,
@@ -1566,7 +1647,9 @@ private:
             UNREACHABLE_MSG("Assign called without a proper target");
         }
 
-        code.AddLine("{} = {};", target.GetCode(), Visit(src).As(target.GetType()));
+        const Expression value = Visit(src);
+        const auto [prefix, suffix] = value.GetConversion(target.GetType());
+        code.AddLine("{} = {}{}{};", target.GetCode(), prefix, value.GetCode(), suffix);
         return {};
     }
 
@@ -2508,16 +2591,16 @@ private:
     };
     static_assert(operation_decompilers.size() == static_cast<std::size_t>(OperationCode::Amount));
 
-    std::string GetRegister(u32 index) const {
-        return AppendSuffix(index, "gpr");
+    const std::string& GetRegister(u32 index) const {
+        return register_names.Get(index);
     }
 
-    std::string GetCustomVariable(u32 index) const {
-        return AppendSuffix(index, "custom_var");
+    const std::string& GetCustomVariable(u32 index) const {
+        return custom_variable_names.Get(index);
     }
 
-    std::string GetPredicate(Tegra::Shader::Pred pred) const {
-        return AppendSuffix(static_cast<u32>(pred), "pred");
+    const std::string& GetPredicate(Tegra::Shader::Pred pred) const {
+        return predicate_names.Get(static_cast<std::size_t>(pred));
     }
 
     std::string GetGenericInputAttribute(Attribute::Index attribute) const {
@@ -2535,8 +2618,8 @@ private:
         return fmt::format("{}[{}]", description.name, element - description.first_element);
     }
 
-    std::string GetConstBuffer(u32 index) const {
-        return AppendSuffix(index, "cbuf");
+    const std::string& GetConstBuffer(u32 index) const {
+        return const_buffer_names.Get(index);
     }
 
     std::string GetGlobalMemory(const GlobalMemoryBase& descriptor) const {
@@ -2560,17 +2643,10 @@ private:
         }
     }
 
-    std::string GetInternalFlag(InternalFlag flag) const {
-        constexpr std::array InternalFlagNames = {"zero_flag", "sign_flag", "carry_flag",
-                                                  "overflow_flag"};
-        const auto index = static_cast<u32>(flag);
-        ASSERT(index < static_cast<u32>(InternalFlag::Amount));
-
-        if (suffix.empty()) {
-            return InternalFlagNames[index];
-        } else {
-            return fmt::format("{}_{}", InternalFlagNames[index], suffix);
-        }
+    const std::string& GetInternalFlag(InternalFlag flag) const {
+        const auto index = static_cast<std::size_t>(flag);
+        ASSERT(index < internal_flag_names.size());
+        return internal_flag_names[index];
     }
 
     std::string GetSampler(const Sampler& sampler) const {
@@ -2619,6 +2695,12 @@ private:
     const Header header;
     std::unordered_map<u8, VaryingTFB> transform_feedback;
 
+    mutable NameTable register_names;
+    mutable NameTable custom_variable_names;
+    mutable NameTable predicate_names;
+    mutable NameTable const_buffer_names;
+    std::array<std::string, static_cast<std::size_t>(InternalFlag::Amount)> internal_flag_names;
+
     ShaderWriter code;
 
     std::optional<u32> max_input_vertices;
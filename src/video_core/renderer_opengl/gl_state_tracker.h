@@ -128,6 +128,21 @@ public:
         flags[OpenGL::Dirty::Viewport0] = true;
     }
 
+    void NotifyViewports() {
+        auto& flags = system.GPU().Maxwell3D().dirty.flags;
+        flags[OpenGL::Dirty::Viewports] = true;
+        flags[OpenGL::Dirty::ViewportTransform] = true;
+    }
+
+    void NotifyScissors() {
+        auto& flags = system.GPU().Maxwell3D().dirty.flags;
+        flags[OpenGL::Dirty::Scissors] = true;
+        for (std::size_t index = OpenGL::Dirty::Scissor0; index <= OpenGL::Dirty::Scissor15;
+             ++index) {
+            flags[index] = true;
+        }
+    }
+
     void NotifyScissor0() {
         auto& flags = system.GPU().Maxwell3D().dirty.flags;
         flags[OpenGL::Dirty::Scissors] = true;
@@ -5,6 +5,7 @@
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/common_types.h"
+#include "common/math_util.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "core/core.h"
@@ -202,8 +203,26 @@ void ApplyTextureDefaults(const SurfaceParams& params, GLuint texture) {
     }
 }
 
+/// Attaches a blit region to a framebuffer, detaching what previous blits left attached
+void AttachBlitRegion(GLuint framebuffer, GLenum attachment, const BlitRegion& region) {
+    glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, 0, 0);
+    glNamedFramebufferTexture(framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, 0, 0);
+
+    const auto level = static_cast<GLint>(region.level);
+    if (region.target == GL_TEXTURE_2D) {
+        glNamedFramebufferTexture(framebuffer, attachment, region.texture, level);
+    } else {
+        glNamedFramebufferTextureLayer(framebuffer, attachment, region.texture, level,
+                                       static_cast<GLint>(region.layer));
+    }
+}
+
+Common::Rectangle<u32> ScaleRect(const Common::Rectangle<u32>& rect, u32 scale) {
+    return {rect.left * scale, rect.top * scale, rect.right * scale, rect.bottom * scale};
+}
+
 OGLTexture CreateTexture(const SurfaceParams& params, GLenum target, GLenum internal_format,
-                         OGLBuffer& texture_buffer) {
+                         OGLBuffer& texture_buffer, u32 scale) {
     OGLTexture texture;
     texture.Create(target);
 
@@ -219,8 +238,8 @@ OGLTexture CreateTexture(const SurfaceParams& params, GLenum target, GLenum inte
         break;
     case SurfaceTarget::Texture2D:
     case SurfaceTarget::TextureCubemap:
-        glTextureStorage2D(texture.handle, params.emulated_levels, internal_format, params.width,
-                           params.height);
+        glTextureStorage2D(texture.handle, params.emulated_levels, internal_format,
+                           params.width * scale, params.height * scale);
         break;
     case SurfaceTarget::Texture3D:
     case SurfaceTarget::Texture2DArray:
@@ -239,9 +258,10 @@ OGLTexture CreateTexture(const SurfaceParams& params, GLenum target, GLenum inte
 
 } // Anonymous namespace
 
-CachedSurface::CachedSurface(const GPUVAddr gpu_addr, const SurfaceParams& params,
-                             bool is_astc_supported)
-    : VideoCommon::SurfaceBase<View>(gpu_addr, params, is_astc_supported) {
+CachedSurface::CachedSurface(TextureCacheOpenGL& texture_cache, const GPUVAddr gpu_addr,
+                             const SurfaceParams& params, bool is_astc_supported, u32 scale)
+    : VideoCommon::SurfaceBase<View>(gpu_addr, params, is_astc_supported),
+      texture_cache{texture_cache}, scale{scale} {
     if (is_converted) {
         internal_format = params.srgb_conversion ? GL_SRGB8_ALPHA8 : GL_RGBA8;
         format = GL_RGBA;
@@ -254,7 +274,7 @@ CachedSurface::CachedSurface(const GPUVAddr gpu_addr, const SurfaceParams& param
         is_compressed = params.IsCompressed();
     }
     target = GetTextureTarget(params.target);
-    texture = CreateTexture(params, target, internal_format, texture_buffer);
+    texture = CreateTexture(params, target, internal_format, texture_buffer, scale);
     DecorateSurfaceName();
     main_view = CreateViewInner(
         ViewParams(params.target, 0, params.is_layered ? params.depth : 1, 0, params.num_levels),
@@ -275,6 +295,15 @@ void CachedSurface::DownloadTexture(std::vector<u8>& staging_buffer) {
 
     SCOPE_EXIT({ glPixelStorei(GL_PACK_ROW_LENGTH, 0); });
 
+    OGLTexture native_texture;
+    GLuint handle = texture.handle;
+    if (scale != 1) {
+        // Scaled surfaces are brought back to guest resolution before reading them
+        native_texture = CreateNativeTexture();
+        BlitScaled(texture.handle, scale, native_texture.handle, 1);
+        handle = native_texture.handle;
+    }
+
     for (u32 level = 0; level < params.emulated_levels; ++level) {
         glPixelStorei(GL_PACK_ALIGNMENT, std::min(8U, params.GetRowAlignment(level, is_converted)));
         glPixelStorei(GL_PACK_ROW_LENGTH, static_cast<GLint>(params.GetMipWidth(level)));
@@ -283,9 +312,9 @@ void CachedSurface::DownloadTexture(std::vector<u8>& staging_buffer) {
         u8* const mip_data = staging_buffer.data() + mip_offset;
         const GLsizei size = static_cast<GLsizei>(params.GetHostMipmapSize(level));
         if (is_compressed) {
-            glGetCompressedTextureImage(texture.handle, level, size, mip_data);
+            glGetCompressedTextureImage(handle, level, size, mip_data);
         } else {
-            glGetTextureImage(texture.handle, level, format, type, size, mip_data);
+            glGetTextureImage(handle, level, format, type, size, mip_data);
         }
     }
 }
@@ -293,12 +322,33 @@ void CachedSurface::DownloadTexture(std::vector<u8>& staging_buffer) {
 void CachedSurface::UploadTexture(const std::vector<u8>& staging_buffer) {
     MICROPROFILE_SCOPE(OpenGL_Texture_Upload);
     SCOPE_EXIT({ glPixelStorei(GL_UNPACK_ROW_LENGTH, 0); });
+    if (scale != 1) {
+        // Scaled surfaces are uploaded at guest resolution and stretched to their host size
+        const OGLTexture native_texture = CreateNativeTexture();
+        UploadTextureMipmap(native_texture.handle, 0, staging_buffer);
+        BlitScaled(native_texture.handle, 1, texture.handle, scale);
+        return;
+    }
     for (u32 level = 0; level < params.emulated_levels; ++level) {
-        UploadTextureMipmap(level, staging_buffer);
+        UploadTextureMipmap(texture.handle, level, staging_buffer);
     }
 }
 
-void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& staging_buffer) {
+OGLTexture CachedSurface::CreateNativeTexture() const {
+    ASSERT(!params.IsBuffer());
+    OGLBuffer unused_buffer;
+    return CreateTexture(params, target, internal_format, unused_buffer, 1);
+}
+
+void CachedSurface::BlitScaled(GLuint src_texture, u32 src_scale, GLuint dst_texture,
+                               u32 dst_scale) const {
+    const Common::Rectangle<u32> rect{0, 0, params.width, params.height};
+    texture_cache.BlitRegions(params.type, {src_texture, target, 0, 0, ScaleRect(rect, src_scale)},
+                              {dst_texture, target, 0, 0, ScaleRect(rect, dst_scale)});
+}
+
+void CachedSurface::UploadTextureMipmap(GLuint handle, u32 level,
+                                        const std::vector<u8>& staging_buffer) {
     glPixelStorei(GL_UNPACK_ALIGNMENT, std::min(8U, params.GetRowAlignment(level, is_converted)));
     glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(params.GetMipWidth(level)));
 
@@ -308,7 +358,7 @@ void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& stagin
         const auto image_size{static_cast<GLsizei>(params.GetHostMipmapSize(level))};
         switch (params.target) {
         case SurfaceTarget::Texture2D:
-            glCompressedTextureSubImage2D(texture.handle, level, 0, 0,
+            glCompressedTextureSubImage2D(handle, level, 0, 0,
                                           static_cast<GLsizei>(params.GetMipWidth(level)),
                                           static_cast<GLsizei>(params.GetMipHeight(level)),
                                           internal_format, image_size, buffer);
@@ -316,7 +366,7 @@ void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& stagin
         case SurfaceTarget::Texture3D:
         case SurfaceTarget::Texture2DArray:
         case SurfaceTarget::TextureCubeArray:
-            glCompressedTextureSubImage3D(texture.handle, level, 0, 0, 0,
+            glCompressedTextureSubImage3D(handle, level, 0, 0, 0,
                                           static_cast<GLsizei>(params.GetMipWidth(level)),
                                           static_cast<GLsizei>(params.GetMipHeight(level)),
                                           static_cast<GLsizei>(params.GetMipDepth(level)),
@@ -325,7 +375,7 @@ void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& stagin
         case SurfaceTarget::TextureCubemap: {
             const std::size_t layer_size{params.GetHostLayerSize(level)};
             for (std::size_t face = 0; face < params.depth; ++face) {
-                glCompressedTextureSubImage3D(texture.handle, level, 0, 0, static_cast<GLint>(face),
+                glCompressedTextureSubImage3D(handle, level, 0, 0, static_cast<GLint>(face),
                                               static_cast<GLsizei>(params.GetMipWidth(level)),
                                               static_cast<GLsizei>(params.GetMipHeight(level)), 1,
                                               internal_format, static_cast<GLsizei>(layer_size),
@@ -340,7 +390,7 @@ void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& stagin
     } else {
         switch (params.target) {
         case SurfaceTarget::Texture1D:
-            glTextureSubImage1D(texture.handle, level, 0, params.GetMipWidth(level), format, type,
+            glTextureSubImage1D(handle, level, 0, params.GetMipWidth(level), format, type,
                                 buffer);
             break;
         case SurfaceTarget::TextureBuffer:
@@ -350,20 +400,20 @@ void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& stagin
             break;
         case SurfaceTarget::Texture1DArray:
         case SurfaceTarget::Texture2D:
-            glTextureSubImage2D(texture.handle, level, 0, 0, params.GetMipWidth(level),
+            glTextureSubImage2D(handle, level, 0, 0, params.GetMipWidth(level),
                                 params.GetMipHeight(level), format, type, buffer);
             break;
         case SurfaceTarget::Texture3D:
         case SurfaceTarget::Texture2DArray:
         case SurfaceTarget::TextureCubeArray:
             glTextureSubImage3D(
-                texture.handle, level, 0, 0, 0, static_cast<GLsizei>(params.GetMipWidth(level)),
+                handle, level, 0, 0, 0, static_cast<GLsizei>(params.GetMipWidth(level)),
                 static_cast<GLsizei>(params.GetMipHeight(level)),
                 static_cast<GLsizei>(params.GetMipDepth(level)), format, type, buffer);
             break;
         case SurfaceTarget::TextureCubemap:
             for (std::size_t face = 0; face < params.depth; ++face) {
-                glTextureSubImage3D(texture.handle, level, 0, 0, static_cast<GLint>(face),
+                glTextureSubImage3D(handle, level, 0, 0, static_cast<GLint>(face),
                                     params.GetMipWidth(level), params.GetMipHeight(level), 1,
                                     format, type, buffer);
                 buffer += params.GetHostLayerSize(level);
@@ -483,7 +533,7 @@ OGLTextureView CachedSurfaceView::CreateTextureView() const {
 TextureCacheOpenGL::TextureCacheOpenGL(Core::System& system,
                                        VideoCore::RasterizerInterface& rasterizer,
                                        const Device& device, StateTracker& state_tracker)
-    : TextureCacheBase{system, rasterizer, device.HasASTC()}, state_tracker{state_tracker} {
+    : TextureCacheBase{system, rasterizer, device.HasASTC(), true}, state_tracker{state_tracker} {
     src_framebuffer.Create();
     dst_framebuffer.Create();
 }
@@ -491,7 +541,49 @@ TextureCacheOpenGL::TextureCacheOpenGL(Core::System& system,
 TextureCacheOpenGL::~TextureCacheOpenGL() = default;
 
 Surface TextureCacheOpenGL::CreateSurface(GPUVAddr gpu_addr, const SurfaceParams& params) {
-    return std::make_shared<CachedSurface>(gpu_addr, params, is_astc_supported);
+    const u32 scale = params.is_scaled ? resolution_scale : 1;
+    return std::make_shared<CachedSurface>(*this, gpu_addr, params, is_astc_supported, scale);
+}
+
+void TextureCacheOpenGL::BlitRegions(SurfaceType type, const BlitRegion& src,
+                                     const BlitRegion& dst) {
+    GLenum attachment;
+    GLbitfield mask;
+    switch (type) {
+    case SurfaceType::ColorTexture:
+        attachment = GL_COLOR_ATTACHMENT0;
+        mask = GL_COLOR_BUFFER_BIT;
+        break;
+    case SurfaceType::Depth:
+        attachment = GL_DEPTH_ATTACHMENT;
+        mask = GL_DEPTH_BUFFER_BIT;
+        break;
+    case SurfaceType::DepthStencil:
+        attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+        mask = GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+        break;
+    default:
+        UNREACHABLE_MSG("Invalid surface type={}", static_cast<u32>(type));
+        return;
+    }
+
+    state_tracker.NotifyScissor0();
+    state_tracker.NotifyRasterizeEnable();
+    state_tracker.NotifyFramebufferSRGB();
+
+    glDisable(GL_FRAMEBUFFER_SRGB);
+    glDisable(GL_RASTERIZER_DISCARD);
+    glDisablei(GL_SCISSOR_TEST, 0);
+
+    AttachBlitRegion(src_framebuffer.handle, attachment, src);
+    AttachBlitRegion(dst_framebuffer.handle, attachment, dst);
+
+    glBlitNamedFramebuffer(src_framebuffer.handle, dst_framebuffer.handle,
+                           static_cast<GLint>(src.rect.left), static_cast<GLint>(src.rect.top),
+                           static_cast<GLint>(src.rect.right), static_cast<GLint>(src.rect.bottom),
+                           static_cast<GLint>(dst.rect.left), static_cast<GLint>(dst.rect.top),
+                           static_cast<GLint>(dst.rect.right), static_cast<GLint>(dst.rect.bottom),
+                           mask, GL_NEAREST);
 }
 
 void TextureCacheOpenGL::ImageCopy(Surface& src_surface, Surface& dst_surface,
@@ -506,11 +598,31 @@ void TextureCacheOpenGL::ImageCopy(Surface& src_surface, Surface& dst_surface,
     const auto src_target = src_surface->GetTarget();
     const auto dst_handle = dst_surface->GetTexture();
     const auto dst_target = dst_surface->GetTarget();
-    glCopyImageSubData(src_handle, src_target, copy_params.source_level, copy_params.source_x,
-                       copy_params.source_y, copy_params.source_z, dst_handle, dst_target,
-                       copy_params.dest_level, copy_params.dest_x, copy_params.dest_y,
-                       copy_params.dest_z, copy_params.width, copy_params.height,
-                       copy_params.depth);
+    const u32 src_scale = src_surface->GetScale();
+    const u32 dst_scale = dst_surface->GetScale();
+    if (src_scale != dst_scale) {
+        // Copies can't change the size of the texels, stretch them one layer at a time
+        const Common::Rectangle<u32> src_rect{copy_params.source_x, copy_params.source_y,
+                                              copy_params.source_x + copy_params.width,
+                                              copy_params.source_y + copy_params.height};
+        const Common::Rectangle<u32> dst_rect{copy_params.dest_x, copy_params.dest_y,
+                                              copy_params.dest_x + copy_params.width,
+                                              copy_params.dest_y + copy_params.height};
+        for (u32 layer = 0; layer < copy_params.depth; ++layer) {
+            BlitRegions(src_params.type,
+                        {src_handle, src_target, copy_params.source_level,
+                         copy_params.source_z + layer, ScaleRect(src_rect, src_scale)},
+                        {dst_handle, dst_target, copy_params.dest_level, copy_params.dest_z + layer,
+                         ScaleRect(dst_rect, dst_scale)});
+        }
+        return;
+    }
+    glCopyImageSubData(src_handle, src_target, copy_params.source_level,
+                       copy_params.source_x * src_scale, copy_params.source_y * src_scale,
+                       copy_params.source_z, dst_handle, dst_target, copy_params.dest_level,
+                       copy_params.dest_x * dst_scale, copy_params.dest_y * dst_scale,
+                       copy_params.dest_z, copy_params.width * src_scale,
+                       copy_params.height * src_scale, copy_params.depth);
 }
 
 void TextureCacheOpenGL::ImageBlit(View& src_view, View& dst_view,
@@ -567,8 +679,8 @@ void TextureCacheOpenGL::ImageBlit(View& src_view, View& dst_view,
         buffers = GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
     }
 
-    const Common::Rectangle<u32>& src_rect = copy_config.src_rect;
-    const Common::Rectangle<u32>& dst_rect = copy_config.dst_rect;
+    const Common::Rectangle<u32> src_rect = ScaleRect(copy_config.src_rect, src_view->GetScale());
+    const Common::Rectangle<u32> dst_rect = ScaleRect(copy_config.dst_rect, dst_view->GetScale());
     const bool is_linear = copy_config.filter == Tegra::Engines::Fermi2D::Filter::Linear;
 
     glBlitFramebuffer(static_cast<GLint>(src_rect.left), static_cast<GLint>(src_rect.top),
@@ -585,11 +697,30 @@ void TextureCacheOpenGL::BufferCopy(Surface& src_surface, Surface& dst_surface)
     const auto& dst_params = dst_surface->GetSurfaceParams();
     UNIMPLEMENTED_IF(src_params.num_levels > 1 || dst_params.num_levels > 1);
 
+    // Surfaces of different scales are copied at guest resolution, through native textures
+    const u32 src_scale = src_surface->GetScale();
+    const u32 dst_scale = dst_surface->GetScale();
+    const u32 scale = src_scale == dst_scale ? src_scale : 1;
+
+    GLuint src_texture = src_surface->GetTexture();
+    OGLTexture src_native;
+    if (src_scale != scale) {
+        src_native = src_surface->CreateNativeTexture();
+        src_surface->BlitScaled(src_texture, src_scale, src_native.handle, 1);
+        src_texture = src_native.handle;
+    }
+    GLuint dst_texture = dst_surface->GetTexture();
+    OGLTexture dst_native;
+    if (dst_scale != scale) {
+        dst_native = dst_surface->CreateNativeTexture();
+        dst_texture = dst_native.handle;
+    }
+
     const auto source_format = GetFormatTuple(src_params.pixel_format);
     const auto dest_format = GetFormatTuple(dst_params.pixel_format);
 
-    const std::size_t source_size = src_surface->GetHostSizeInBytes();
-    const std::size_t dest_size = dst_surface->GetHostSizeInBytes();
+    const std::size_t source_size = src_surface->GetHostSizeInBytes() * scale * scale;
+    const std::size_t dest_size = dst_surface->GetHostSizeInBytes() * scale * scale;
 
     const std::size_t buffer_size = std::max(source_size, dest_size);
 
@@ -598,18 +729,17 @@ void TextureCacheOpenGL::BufferCopy(Surface& src_surface, Surface& dst_surface)
     glBindBuffer(GL_PIXEL_PACK_BUFFER, copy_pbo_handle);
 
     if (src_surface->IsCompressed()) {
-        glGetCompressedTextureImage(src_surface->GetTexture(), 0, static_cast<GLsizei>(source_size),
-                                    nullptr);
+        glGetCompressedTextureImage(src_texture, 0, static_cast<GLsizei>(source_size), nullptr);
     } else {
-        glGetTextureImage(src_surface->GetTexture(), 0, source_format.format, source_format.type,
+        glGetTextureImage(src_texture, 0, source_format.format, source_format.type,
                           static_cast<GLsizei>(source_size), nullptr);
     }
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, copy_pbo_handle);
 
-    const GLsizei width = static_cast<GLsizei>(dst_params.width);
-    const GLsizei height = static_cast<GLsizei>(dst_params.height);
+    const GLsizei width = static_cast<GLsizei>(dst_params.width * scale);
+    const GLsizei height = static_cast<GLsizei>(dst_params.height * scale);
     const GLsizei depth = static_cast<GLsizei>(dst_params.depth);
     if (dst_surface->IsCompressed()) {
         LOG_CRITICAL(HW_GPU, "Compressed buffer copy is unimplemented!");
@@ -617,22 +747,22 @@ void TextureCacheOpenGL::BufferCopy(Surface& src_surface, Surface& dst_surface)
     } else {
         switch (dst_params.target) {
         case SurfaceTarget::Texture1D:
-            glTextureSubImage1D(dst_surface->GetTexture(), 0, 0, width, dest_format.format,
-                                dest_format.type, nullptr);
+            glTextureSubImage1D(dst_texture, 0, 0, width, dest_format.format, dest_format.type,
+                                nullptr);
             break;
         case SurfaceTarget::Texture2D:
-            glTextureSubImage2D(dst_surface->GetTexture(), 0, 0, 0, width, height,
-                                dest_format.format, dest_format.type, nullptr);
+            glTextureSubImage2D(dst_texture, 0, 0, 0, width, height, dest_format.format,
+                                dest_format.type, nullptr);
             break;
         case SurfaceTarget::Texture3D:
         case SurfaceTarget::Texture2DArray:
         case SurfaceTarget::TextureCubeArray:
-            glTextureSubImage3D(dst_surface->GetTexture(), 0, 0, 0, 0, width, height, depth,
-                                dest_format.format, dest_format.type, nullptr);
+            glTextureSubImage3D(dst_texture, 0, 0, 0, 0, width, height, depth, dest_format.format,
+                                dest_format.type, nullptr);
             break;
         case SurfaceTarget::TextureCubemap:
-            glTextureSubImage3D(dst_surface->GetTexture(), 0, 0, 0, 0, width, height, depth,
-                                dest_format.format, dest_format.type, nullptr);
+            glTextureSubImage3D(dst_texture, 0, 0, 0, 0, width, height, depth, dest_format.format,
+                                dest_format.type, nullptr);
             break;
         default:
             LOG_CRITICAL(Render_OpenGL, "Unimplemented surface target={}",
@@ -642,6 +772,10 @@ void TextureCacheOpenGL::BufferCopy(Surface& src_surface, Surface& dst_surface)
     }
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
+    if (dst_native.handle != 0) {
+        dst_surface->BlitScaled(dst_native.handle, 1, dst_surface->GetTexture(), dst_scale);
+    }
+
     glTextureBarrier();
 }
 
@@ -14,6 +14,7 @@
 #include <glad/glad.h>
 
 #include "common/common_types.h"
+#include "common/math_util.h"
 #include "video_core/engines/shader_bytecode.h"
 #include "video_core/renderer_opengl/gl_device.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
@@ -33,11 +34,21 @@ using Surface = std::shared_ptr<CachedSurface>;
 using View = std::shared_ptr<CachedSurfaceView>;
 using TextureCacheBase = VideoCommon::TextureCache<Surface, View>;
 
+/// Region of a texture level and layer used as the source or the destination of a blit
+struct BlitRegion {
+    GLuint texture;
+    GLenum target;
+    u32 level;
+    u32 layer;
+    Common::Rectangle<u32> rect;
+};
+
 class CachedSurface final : public VideoCommon::SurfaceBase<View> {
     friend CachedSurfaceView;
 
 public:
-    explicit CachedSurface(GPUVAddr gpu_addr, const SurfaceParams& params, bool is_astc_supported);
+    explicit CachedSurface(TextureCacheOpenGL& texture_cache, GPUVAddr gpu_addr,
+                           const SurfaceParams& params, bool is_astc_supported, u32 scale);
     ~CachedSurface();
 
     void UploadTexture(const std::vector<u8>& staging_buffer) override;
@@ -55,6 +66,17 @@ public:
         return is_compressed;
     }
 
+    /// Returns the factor the host texture is larger than the guest surface on each dimension
+    u32 GetScale() const {
+        return scale;
+    }
+
+    /// Creates a texture with the dimensions of the guest surface
+    OGLTexture CreateNativeTexture() const;
+
+    /// Blits the whole first level of a texture into another of a different scale
+    void BlitScaled(GLuint src_texture, u32 src_scale, GLuint dst_texture, u32 dst_scale) const;
+
 protected:
     void DecorateSurfaceName() override;
 
@@ -62,7 +84,9 @@ protected:
     View CreateViewInner(const ViewParams& view_key, bool is_proxy);
 
 private:
-    void UploadTextureMipmap(u32 level, const std::vector<u8>& staging_buffer);
+    void UploadTextureMipmap(GLuint handle, u32 level, const std::vector<u8>& staging_buffer);
+
+    TextureCacheOpenGL& texture_cache;
 
     GLenum internal_format{};
     GLenum format{};
@@ -70,6 +94,7 @@ private:
     bool is_compressed{};
     GLenum target{};
     u32 view_count{};
+    u32 scale{};
 
     OGLTexture texture;
     OGLBuffer texture_buffer;
@@ -109,6 +134,10 @@ public:
         return surface.GetSurfaceParams();
     }
 
+    u32 GetScale() const {
+        return surface.GetScale();
+    }
+
 private:
     u32 EncodeSwizzle(Tegra::Texture::SwizzleSource x_source,
                       Tegra::Texture::SwizzleSource y_source,
@@ -135,6 +164,11 @@ public:
                                 const Device& device, StateTracker& state_tracker);
     ~TextureCacheOpenGL();
 
+    /// Blits between two regions of different sizes, used to move texels in and out of scaled
+    /// surfaces
+    void BlitRegions(VideoCore::Surface::SurfaceType type, const BlitRegion& src,
+                     const BlitRegion& dst);
+
 protected:
     Surface CreateSurface(GPUVAddr gpu_addr, const SurfaceParams& params) override;
 
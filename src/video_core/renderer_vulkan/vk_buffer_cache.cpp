@@ -86,6 +86,10 @@ const vk::Buffer* VKBufferCache::GetEmptyBuffer(std::size_t size) {
     return &*empty.handle;
 }
 
+u64 VKBufferCache::GetCommandBufferTick() const {
+    return scheduler.Ticks();
+}
+
 void VKBufferCache::UploadBlockData(const Buffer& buffer, std::size_t offset, std::size_t size,
                                     const u8* data) {
     const auto& staging = staging_pool.GetUnusedBuffer(size, true);
@@ -55,6 +55,8 @@ public:
 protected:
     void WriteBarrier() override {}
 
+    u64 GetCommandBufferTick() const override;
+
     Buffer CreateBlock(CacheAddr cache_addr, std::size_t size) override;
 
     const vk::Buffer* ToHandle(const Buffer& buffer) override;
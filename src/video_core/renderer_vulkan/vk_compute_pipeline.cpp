@@ -34,9 +34,8 @@ vk::DescriptorSet VKComputePipeline::CommitDescriptorSet() {
     if (!descriptor_template) {
         return {};
     }
-    const auto set = descriptor_allocator.Commit(scheduler.GetFence());
-    update_descriptor_queue.Send(*descriptor_template, set);
-    return set;
+    return descriptor_allocator.CommitCached(scheduler, update_descriptor_queue,
+                                             *descriptor_template);
 }
 
 UniqueDescriptorSetLayout VKComputePipeline::CreateDescriptorSetLayout() const {
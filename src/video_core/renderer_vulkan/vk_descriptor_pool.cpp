@@ -3,13 +3,18 @@
 // Refer to the license.txt file included.
 
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "common/cityhash.h"
 #include "common/common_types.h"
+#include "common/logging/log.h"
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_device.h"
 #include "video_core/renderer_vulkan/vk_resource_manager.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
 
 namespace Vulkan {
 
@@ -26,6 +31,42 @@ vk::DescriptorSet DescriptorAllocator::Commit(VKFence& fence) {
     return *descriptors[CommitResource(fence)];
 }
 
+vk::DescriptorSet DescriptorAllocator::CommitCached(
+    VKScheduler& scheduler, VKUpdateDescriptorQueue& update_descriptor_queue,
+    vk::DescriptorUpdateTemplate update_template) {
+    if (const u64 ticks = scheduler.Ticks(); cache_ticks != ticks) {
+        cache.clear();
+        last_set = nullptr;
+        cache_ticks = ticks;
+    }
+
+    update_descriptor_queue.ResolveEntries(lookup_key.entries);
+
+    // Consecutive draws usually bind the same resources, compare with the last set before hashing
+    if (last_set && lookup_key.entries == last_key.entries) {
+        ++descriptor_pool.stats.cache_hits;
+        return last_set;
+    }
+
+    lookup_key.hash = static_cast<std::size_t>(
+        Common::CityHash64(reinterpret_cast<const char*>(lookup_key.entries.data()),
+                           lookup_key.entries.size() * sizeof(DescriptorUpdateEntry)));
+    vk::DescriptorSet set;
+    if (const auto it = cache.find(lookup_key); it != cache.end()) {
+        ++descriptor_pool.stats.cache_hits;
+        set = it->second;
+    } else {
+        set = Commit(scheduler.GetFence());
+        update_descriptor_queue.Send(update_template, set);
+        cache.emplace(lookup_key, set);
+        ++descriptor_pool.stats.sets_written;
+    }
+
+    std::swap(lookup_key, last_key);
+    last_set = set;
+    return set;
+}
+
 void DescriptorAllocator::Allocate(std::size_t begin, std::size_t end) {
     auto new_sets = descriptor_pool.AllocateDescriptors(layout, end - begin);
     descriptors.insert(descriptors.end(), std::make_move_iterator(new_sets.begin()),
@@ -37,6 +78,13 @@ VKDescriptorPool::VKDescriptorPool(const VKDevice& device)
 
 VKDescriptorPool::~VKDescriptorPool() = default;
 
+void VKDescriptorPool::TickFrame() {
+    last_frame_stats = std::exchange(stats, {});
+    LOG_TRACE(Render_Vulkan, "Descriptor sets: {} written, {} cached, {} allocated",
+              last_frame_stats.sets_written, last_frame_stats.cache_hits,
+              last_frame_stats.sets_allocated);
+}
+
 vk::DescriptorPool VKDescriptorPool::AllocateNewPool() {
     static constexpr u32 num_sets = 0x20000;
     static constexpr vk::DescriptorPoolSize pool_sizes[] = {
@@ -77,6 +125,8 @@ std::vector<UniqueDescriptorSet> VKDescriptorPool::AllocateDescriptors(
         vk::throwResultException(result, "vk::Device::allocateDescriptorSetsUnique");
     }
 
+    stats.sets_allocated += count;
+
     vk::PoolFree deleter(dev, active_pool, dld);
     std::vector<UniqueDescriptorSet> unique_sets;
     unique_sets.reserve(count);
@@ -5,15 +5,25 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_resource_manager.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
 
 namespace Vulkan {
 
 class VKDescriptorPool;
+class VKScheduler;
+
+/// Descriptor set counters of a frame
+struct DescriptorStats {
+    u64 sets_allocated = 0; ///< Sets allocated from the driver
+    u64 sets_written = 0;   ///< Sets committed and written for a draw or dispatch
+    u64 cache_hits = 0;     ///< Draws and dispatches that bound a set written earlier
+};
 
 class DescriptorAllocator final : public VKFencedPool {
 public:
@@ -24,14 +34,46 @@ public:
 
     vk::DescriptorSet Commit(VKFence& fence);
 
+    /**
+     * Returns a set holding the descriptors queued for the current draw. Sets are cached by their
+     * contents, a set written earlier in the current command buffer with the same descriptors is
+     * returned without writing a new one. The last returned set is checked first, without hashing.
+     */
+    vk::DescriptorSet CommitCached(VKScheduler& scheduler,
+                                   VKUpdateDescriptorQueue& update_descriptor_queue,
+                                   vk::DescriptorUpdateTemplate update_template);
+
 protected:
     void Allocate(std::size_t begin, std::size_t end) override;
 
 private:
+    struct CacheKey {
+        std::size_t hash = 0;
+        std::vector<DescriptorUpdateEntry> entries;
+
+        bool operator==(const CacheKey& rhs) const noexcept {
+            return hash == rhs.hash && entries == rhs.entries;
+        }
+    };
+
+    struct CacheKeyHash {
+        std::size_t operator()(const CacheKey& key) const noexcept {
+            return key.hash;
+        }
+    };
+
     VKDescriptorPool& descriptor_pool;
     const vk::DescriptorSetLayout layout;
 
     std::vector<UniqueDescriptorSet> descriptors;
+
+    /// Sets written in the command buffer of cache_ticks. Sets are protected by the fence of that
+    /// command buffer, so they can't be reused once it has been submitted.
+    std::unordered_map<CacheKey, vk::DescriptorSet, CacheKeyHash> cache;
+    u64 cache_ticks = 0;
+    CacheKey lookup_key; ///< Reused to look up the cache without allocating
+    CacheKey last_key;   ///< Descriptors of last_set
+    vk::DescriptorSet last_set;
 };
 
 class VKDescriptorPool final {
@@ -41,6 +83,14 @@ public:
     explicit VKDescriptorPool(const VKDevice& device);
     ~VKDescriptorPool();
 
+    /// Stores the counters of the finished frame and starts counting a new one
+    void TickFrame();
+
+    /// Returns the counters of the last finished frame
+    const DescriptorStats& GetFrameStats() const {
+        return last_frame_stats;
+    }
+
 private:
     vk::DescriptorPool AllocateNewPool();
 
@@ -51,6 +101,9 @@ private:
 
     std::vector<UniqueDescriptorPool> pools;
     vk::DescriptorPool active_pool;
+
+    DescriptorStats stats;
+    DescriptorStats last_frame_stats;
 };
 
 } // namespace Vulkan
\ No newline at end of file
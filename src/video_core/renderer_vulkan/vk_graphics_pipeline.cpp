@@ -23,11 +23,13 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 
 namespace {
 
-vk::StencilOpState GetStencilFaceState(const FixedPipelineState::StencilFace& face) {
-    return vk::StencilOpState(MaxwellToVK::StencilOp(face.action_stencil_fail),
-                              MaxwellToVK::StencilOp(face.action_depth_pass),
-                              MaxwellToVK::StencilOp(face.action_depth_fail),
-                              MaxwellToVK::ComparisonOp(face.test_func), 0, 0, 0);
+template <std::size_t Position>
+vk::StencilOpState GetStencilFaceState(
+    const FixedPipelineState::DepthStencil::StencilFace<Position>& face) {
+    return vk::StencilOpState(MaxwellToVK::StencilOp(face.ActionStencilFail()),
+                              MaxwellToVK::StencilOp(face.ActionDepthPass()),
+                              MaxwellToVK::StencilOp(face.ActionDepthFail()),
+                              MaxwellToVK::ComparisonOp(face.TestFunc()), 0, 0, 0);
 }
 
 bool SupportsPrimitiveRestart(vk::PrimitiveTopology topology) {
@@ -67,9 +69,8 @@ vk::DescriptorSet VKGraphicsPipeline::CommitDescriptorSet() {
     if (!descriptor_template) {
         return {};
     }
-    const auto set = descriptor_allocator.Commit(scheduler.GetFence());
-    update_descriptor_queue.Send(*descriptor_template, set);
-    return set;
+    return descriptor_allocator.CommitCached(scheduler, update_descriptor_queue,
+                                             *descriptor_template);
 }
 
 UniqueDescriptorSetLayout VKGraphicsPipeline::CreateDescriptorSetLayout(
@@ -135,35 +136,39 @@ std::vector<UniqueShaderModule> VKGraphicsPipeline::CreateShaderModules(
 UniquePipeline VKGraphicsPipeline::CreatePipeline(const RenderPassParams& renderpass_params,
                                                   const SPIRVProgram& program) const {
     const auto& vi = fixed_state.vertex_input;
-    const auto& ia = fixed_state.input_assembly;
     const auto& ds = fixed_state.depth_stencil;
     const auto& cd = fixed_state.color_blending;
-    const auto& ts = fixed_state.tessellation;
     const auto& rs = fixed_state.rasterizer;
 
     std::vector<vk::VertexInputBindingDescription> vertex_bindings;
     std::vector<vk::VertexInputBindingDivisorDescriptionEXT> vertex_binding_divisors;
-    for (std::size_t i = 0; i < vi.num_bindings; ++i) {
-        const auto& binding = vi.bindings[i];
-        const bool instanced = binding.divisor != 0;
+    for (u32 index = 0; index < static_cast<u32>(vi.bindings.size()); ++index) {
+        const auto& binding = vi.bindings[index];
+        if (!binding.enabled) {
+            continue;
+        }
+        const u32 divisor = vi.binding_divisors[index];
+        const bool instanced = divisor != 0;
         const auto rate = instanced ? vk::VertexInputRate::eInstance : vk::VertexInputRate::eVertex;
-        vertex_bindings.emplace_back(binding.index, binding.stride, rate);
+        vertex_bindings.emplace_back(index, binding.stride, rate);
         if (instanced) {
-            vertex_binding_divisors.emplace_back(binding.index, binding.divisor);
+            vertex_binding_divisors.emplace_back(index, divisor);
         }
     }
 
     std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
     const auto& input_attributes = program[0]->entries.attributes;
-    for (std::size_t i = 0; i < vi.num_attributes; ++i) {
-        const auto& attribute = vi.attributes[i];
-        if (input_attributes.find(attribute.index) == input_attributes.end()) {
+    for (u32 index = 0; index < static_cast<u32>(vi.attributes.size()); ++index) {
+        const auto& attribute = vi.attributes[index];
+        if (!attribute.enabled) {
+            continue;
+        }
+        if (input_attributes.find(index) == input_attributes.end()) {
             // Skip attributes not used by the vertex shaders.
             continue;
         }
-        vertex_attributes.emplace_back(attribute.index, attribute.buffer,
-                                       MaxwellToVK::VertexFormat(attribute.type, attribute.size),
-                                       attribute.offset);
+        const auto format = MaxwellToVK::VertexFormat(attribute.Type(), attribute.Size());
+        vertex_attributes.emplace_back(index, attribute.buffer, format, attribute.offset);
     }
 
     vk::PipelineVertexInputStateCreateInfo vertex_input_ci(
@@ -176,12 +181,12 @@ UniquePipeline VKGraphicsPipeline::CreatePipeline(const RenderPassParams& render
         vertex_input_ci.pNext = &vertex_input_divisor_ci;
     }
 
-    const auto primitive_topology = MaxwellToVK::PrimitiveTopology(device, ia.topology);
+    const auto primitive_topology = MaxwellToVK::PrimitiveTopology(device, rs.Topology());
     const vk::PipelineInputAssemblyStateCreateInfo input_assembly_ci(
         {}, primitive_topology,
-        ia.primitive_restart_enable && SupportsPrimitiveRestart(primitive_topology));
+        rs.primitive_restart_enable && SupportsPrimitiveRestart(primitive_topology));
 
-    const vk::PipelineTessellationStateCreateInfo tessellation_ci({}, ts.patch_control_points);
+    const vk::PipelineTessellationStateCreateInfo tessellation_ci({}, rs.patch_control_points);
 
     const vk::PipelineViewportStateCreateInfo viewport_ci({}, Maxwell::NumViewports, nullptr,
                                                           Maxwell::NumViewports, nullptr);
@@ -189,24 +194,24 @@ UniquePipeline VKGraphicsPipeline::CreatePipeline(const RenderPassParams& render
     // TODO(Rodrigo): Find out what's the default register value for front face
     const vk::PipelineRasterizationStateCreateInfo rasterizer_ci(
         {}, rs.depth_clamp_enable, false, vk::PolygonMode::eFill,
-        rs.cull_enable ? MaxwellToVK::CullFace(rs.cull_face) : vk::CullModeFlagBits::eNone,
-        MaxwellToVK::FrontFace(rs.front_face), rs.depth_bias_enable, 0.0f, 0.0f, 0.0f, 1.0f);
+        rs.cull_enable ? MaxwellToVK::CullFace(rs.CullFace()) : vk::CullModeFlagBits::eNone,
+        MaxwellToVK::FrontFace(rs.FrontFace()), rs.depth_bias_enable, 0.0f, 0.0f, 0.0f, 1.0f);
 
     const vk::PipelineMultisampleStateCreateInfo multisampling_ci(
         {}, vk::SampleCountFlagBits::e1, false, 0.0f, nullptr, false, false);
 
     const vk::CompareOp depth_test_compare = ds.depth_test_enable
-                                                 ? MaxwellToVK::ComparisonOp(ds.depth_test_function)
+                                                 ? MaxwellToVK::ComparisonOp(ds.DepthTestFunc())
                                                  : vk::CompareOp::eAlways;
 
     const vk::PipelineDepthStencilStateCreateInfo depth_stencil_ci(
         {}, ds.depth_test_enable, ds.depth_write_enable, depth_test_compare, ds.depth_bounds_enable,
-        ds.stencil_enable, GetStencilFaceState(ds.front_stencil),
-        GetStencilFaceState(ds.back_stencil), 0.0f, 0.0f);
+        ds.stencil_enable, GetStencilFaceState(ds.front), GetStencilFaceState(ds.back), 0.0f,
+        0.0f);
 
     std::array<vk::PipelineColorBlendAttachmentState, Maxwell::NumRenderTargets> cb_attachments;
-    const std::size_t num_attachments =
-        std::min(cd.attachments_count, renderpass_params.color_attachments.size());
+    const std::size_t num_attachments = std::min<std::size_t>(
+        cd.attachments_count, renderpass_params.color_attachments.size());
     for (std::size_t i = 0; i < num_attachments; ++i) {
         constexpr std::array component_table{
             vk::ColorComponentFlagBits::eR, vk::ColorComponentFlagBits::eG,
@@ -214,17 +219,19 @@ UniquePipeline VKGraphicsPipeline::CreatePipeline(const RenderPassParams& render
         const auto& blend = cd.attachments[i];
 
         vk::ColorComponentFlags color_components{};
+        const std::array mask = blend.Mask();
         for (std::size_t j = 0; j < component_table.size(); ++j) {
-            if (blend.components[j])
+            if (mask[j])
                 color_components |= component_table[j];
         }
 
         cb_attachments[i] = vk::PipelineColorBlendAttachmentState(
-            blend.enable, MaxwellToVK::BlendFactor(blend.src_rgb_func),
-            MaxwellToVK::BlendFactor(blend.dst_rgb_func),
-            MaxwellToVK::BlendEquation(blend.rgb_equation),
-            MaxwellToVK::BlendFactor(blend.src_a_func), MaxwellToVK::BlendFactor(blend.dst_a_func),
-            MaxwellToVK::BlendEquation(blend.a_equation), color_components);
+            blend.enable, MaxwellToVK::BlendFactor(blend.SourceRGBFactor()),
+            MaxwellToVK::BlendFactor(blend.DestRGBFactor()),
+            MaxwellToVK::BlendEquation(blend.EquationRGB()),
+            MaxwellToVK::BlendFactor(blend.SourceAlphaFactor()),
+            MaxwellToVK::BlendFactor(blend.DestAlphaFactor()),
+            MaxwellToVK::BlendEquation(blend.EquationAlpha()), color_components);
     }
     const vk::PipelineColorBlendStateCreateInfo color_blending_ci({}, false, vk::LogicOp::eCopy,
                                                                   static_cast<u32>(num_attachments),
@@ -309,13 +309,13 @@ void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     query_cache.UpdateCounters();
 
     const auto& gpu = system.GPU().Maxwell3D();
-    GraphicsPipelineCacheKey key{GetFixedPipelineState(gpu.regs)};
+    UpdateFixedPipelineState(gpu.regs);
+    GraphicsPipelineCacheKey key{fixed_state};
 
     buffer_cache.Map(CalculateGraphicsStreamBufferSize(is_indexed));
 
     BufferBindings buffer_bindings;
-    const DrawParameters draw_params =
-        SetupGeometry(key.fixed_state, buffer_bindings, is_indexed, is_instanced);
+    const DrawParameters draw_params = SetupGeometry(buffer_bindings, is_indexed, is_instanced);
 
     update_descriptor_queue.Acquire();
     sampled_views.clear();
@@ -523,6 +523,7 @@ void RasterizerVulkan::FlushCommands() {
 void RasterizerVulkan::TickFrame() {
     draw_counter = 0;
     update_descriptor_queue.TickFrame();
+    descriptor_pool.TickFrame();
     buffer_cache.TickFrame();
     staging_pool.TickFrame();
 }
@@ -664,8 +665,22 @@ std::tuple<vk::Framebuffer, vk::Extent2D> RasterizerVulkan::ConfigureFramebuffer
     return {*framebuffer, vk::Extent2D{key.width, key.height}};
 }
 
-RasterizerVulkan::DrawParameters RasterizerVulkan::SetupGeometry(FixedPipelineState& fixed_state,
-                                                                 BufferBindings& buffer_bindings,
+void RasterizerVulkan::UpdateFixedPipelineState(const Maxwell& regs) {
+    if (state_tracker.TouchVertexInput()) {
+        fixed_state.vertex_input.Fill(regs);
+    }
+    if (state_tracker.TouchRasterizer()) {
+        fixed_state.rasterizer.Fill(regs);
+    }
+    if (state_tracker.TouchDepthStencil()) {
+        fixed_state.depth_stencil.Fill(regs);
+    }
+    if (state_tracker.TouchColorBlending()) {
+        fixed_state.color_blending.Fill(regs);
+    }
+}
+
+RasterizerVulkan::DrawParameters RasterizerVulkan::SetupGeometry(BufferBindings& buffer_bindings,
                                                                  bool is_indexed,
                                                                  bool is_instanced) {
     MICROPROFILE_SCOPE(Vulkan_Geometry);
@@ -673,7 +688,7 @@ RasterizerVulkan::DrawParameters RasterizerVulkan::SetupGeometry(FixedPipelineSt
     const auto& gpu = system.GPU().Maxwell3D();
     const auto& regs = gpu.regs;
 
-    SetupVertexArrays(fixed_state.vertex_input, buffer_bindings);
+    SetupVertexArrays(buffer_bindings);
 
     const u32 base_instance = regs.vb_base_instance;
     const u32 num_instances = is_instanced ? gpu.mme_draw.instance_count : 1;
@@ -784,24 +799,9 @@ void RasterizerVulkan::EndTransformFeedback() {
         [](auto cmdbuf, auto& dld) { cmdbuf.endTransformFeedbackEXT(0, {}, {}, dld); });
 }
 
-void RasterizerVulkan::SetupVertexArrays(FixedPipelineState::VertexInput& vertex_input,
-                                         BufferBindings& buffer_bindings) {
+void RasterizerVulkan::SetupVertexArrays(BufferBindings& buffer_bindings) {
     const auto& regs = system.GPU().Maxwell3D().regs;
 
-    for (u32 index = 0; index < static_cast<u32>(Maxwell::NumVertexAttributes); ++index) {
-        const auto& attrib = regs.vertex_attrib_format[index];
-        if (!attrib.IsValid()) {
-            continue;
-        }
-
-        const auto& buffer = regs.vertex_array[attrib.buffer];
-        ASSERT(buffer.IsEnabled());
-
-        vertex_input.attributes[vertex_input.num_attributes++] =
-            FixedPipelineState::VertexAttribute(index, attrib.buffer, attrib.type, attrib.size,
-                                                attrib.offset);
-    }
-
     for (u32 index = 0; index < static_cast<u32>(Maxwell::NumVertexArrays); ++index) {
         const auto& vertex_array = regs.vertex_array[index];
         if (!vertex_array.IsEnabled()) {
@@ -814,10 +814,6 @@ void RasterizerVulkan::SetupVertexArrays(FixedPipelineState::VertexInput& vertex
         ASSERT(end > start);
         const std::size_t size{end - start + 1};
         const auto [buffer, offset] = buffer_cache.UploadMemory(start, size);
-
-        vertex_input.bindings[vertex_input.num_bindings++] = FixedPipelineState::VertexBinding(
-            index, vertex_array.stride,
-            regs.instanced_arrays.IsInstancingEnabled(index) ? vertex_array.divisor : 0);
         buffer_bindings.AddVertexBinding(buffer, offset);
     }
 }
@@ -156,9 +156,12 @@ private:
 
     std::tuple<vk::Framebuffer, vk::Extent2D> ConfigureFramebuffers(vk::RenderPass renderpass);
 
+    /// Refills the groups of the fixed pipeline state whose registers have been written.
+    void UpdateFixedPipelineState(const Maxwell& regs);
+
     /// Setups geometry buffers and state.
-    DrawParameters SetupGeometry(FixedPipelineState& fixed_state, BufferBindings& buffer_bindings,
-                                 bool is_indexed, bool is_instanced);
+    DrawParameters SetupGeometry(BufferBindings& buffer_bindings, bool is_indexed,
+                                 bool is_instanced);
 
     /// Setup descriptors in the graphics pipeline.
     void SetupShaderDescriptors(const std::array<Shader, Maxwell::MaxShaderProgram>& shaders);
@@ -175,8 +178,7 @@ private:
 
     bool WalkAttachmentOverlaps(const CachedSurfaceView& attachment);
 
-    void SetupVertexArrays(FixedPipelineState::VertexInput& vertex_input,
-                           BufferBindings& buffer_bindings);
+    void SetupVertexArrays(BufferBindings& buffer_bindings);
 
     void SetupIndexBuffer(BufferBindings& buffer_bindings, DrawParameters& params, bool is_indexed);
 
@@ -263,6 +265,9 @@ private:
     VKSamplerCache sampler_cache;
     VKQueryCache query_cache;
 
+    /// Fixed pipeline state of the last draw, kept up to date through dirty flags
+    FixedPipelineState fixed_state{};
+
     std::array<View, Maxwell::NumRenderTargets> color_attachments;
     View zeta_attachment;
 
@@ -75,6 +75,72 @@ void SetupDirtyStencilProperties(Tables& tables) {
     table[OFF(stencil_back_func_mask)] = StencilProperties;
 }
 
+void SetupDirtyShaders(Tables& tables) {
+    FillBlock(tables[0], OFF(shader_config[0]), NUM(shader_config[0]) * Regs::MaxShaderProgram,
+              Shaders);
+    FillBlock(tables[0], OFF(code_address), NUM(code_address), Shaders);
+}
+
+void SetupDirtyVertexInput(Tables& tables) {
+    auto& table = tables[0];
+    FillBlock(table, OFF(vertex_attrib_format), NUM(vertex_attrib_format), VertexInput);
+    FillBlock(table, OFF(vertex_array), NUM(vertex_array[0]) * Regs::NumVertexArrays, VertexInput);
+    FillBlock(table, OFF(instanced_arrays), NUM(instanced_arrays), VertexInput);
+}
+
+void SetupDirtyRasterizer(Tables& tables) {
+    auto& table = tables[0];
+    FillBlock(table, OFF(draw), NUM(draw), Rasterizer);
+    FillBlock(table, OFF(primitive_restart), NUM(primitive_restart), Rasterizer);
+    FillBlock(table, OFF(view_volume_clip_control), NUM(view_volume_clip_control), Rasterizer);
+    FillBlock(table, OFF(screen_y_control), NUM(screen_y_control), Rasterizer);
+    FillBlock(table, OFF(tess_mode), NUM(tess_mode), Rasterizer);
+    table[OFF(point_size)] = Rasterizer;
+    table[OFF(patch_vertices)] = Rasterizer;
+    table[OFF(polygon_offset_point_enable)] = Rasterizer;
+    table[OFF(polygon_offset_line_enable)] = Rasterizer;
+    table[OFF(polygon_offset_fill_enable)] = Rasterizer;
+    table[OFF(cull_test_enabled)] = Rasterizer;
+    table[OFF(front_face)] = Rasterizer;
+    table[OFF(cull_face)] = Rasterizer;
+    table[OFF(depth_mode)] = Rasterizer;
+
+    // The front face is flipped depending on the sign of the first viewport's scale
+    tables[1][OFF(viewport_transform) + offsetof(Regs::ViewportTransform, scale_y) / sizeof(u32)] =
+        Rasterizer;
+}
+
+void SetupDirtyDepthStencil(Tables& tables) {
+    auto& table = tables[0];
+    table[OFF(depth_test_enable)] = DepthStencil;
+    table[OFF(depth_write_enabled)] = DepthStencil;
+    table[OFF(depth_bounds_enable)] = DepthStencil;
+    table[OFF(depth_test_func)] = DepthStencil;
+    table[OFF(stencil_enable)] = DepthStencil;
+    table[OFF(stencil_front_op_fail)] = DepthStencil;
+    table[OFF(stencil_front_op_zfail)] = DepthStencil;
+    table[OFF(stencil_front_op_zpass)] = DepthStencil;
+    table[OFF(stencil_front_func_func)] = DepthStencil;
+    table[OFF(stencil_back_op_fail)] = DepthStencil;
+    table[OFF(stencil_back_op_zfail)] = DepthStencil;
+    table[OFF(stencil_back_op_zpass)] = DepthStencil;
+    table[OFF(stencil_back_func_func)] = DepthStencil;
+
+    // The first table already marks this register for the dynamic stencil properties
+    tables[1][OFF(stencil_two_side_enable)] = DepthStencil;
+}
+
+void SetupDirtyColorBlending(Tables& tables) {
+    auto& table = tables[0];
+    table[OFF(color_mask_common)] = ColorBlending;
+    table[OFF(independent_blend_enable)] = ColorBlending;
+    FillBlock(table, OFF(color_mask), NUM(color_mask), ColorBlending);
+    FillBlock(table, OFF(rt_control), NUM(rt_control), ColorBlending);
+    FillBlock(table, OFF(blend), NUM(blend), ColorBlending);
+    FillBlock(table, OFF(independent_blend), NUM(independent_blend[0]) * Regs::NumRenderTargets,
+              ColorBlending);
+}
+
 } // Anonymous namespace
 
 StateTracker::StateTracker(Core::System& system)
@@ -90,6 +156,11 @@ void StateTracker::Initialize() {
     SetupDirtyBlendConstants(tables);
     SetupDirtyDepthBounds(tables);
     SetupDirtyStencilProperties(tables);
+    SetupDirtyShaders(tables);
+    SetupDirtyVertexInput(tables);
+    SetupDirtyRasterizer(tables);
+    SetupDirtyDepthStencil(tables);
+    SetupDirtyColorBlending(tables);
 }
 
 void StateTracker::InvalidateCommandBufferState() {
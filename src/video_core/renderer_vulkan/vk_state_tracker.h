@@ -26,6 +26,14 @@ enum : u8 {
     DepthBounds,
     StencilProperties,
 
+    Shaders,
+
+    // Groups of the fixed pipeline state
+    VertexInput,
+    Rasterizer,
+    DepthStencil,
+    ColorBlending,
+
     Last
 };
 static_assert(Last <= std::numeric_limits<u8>::max());
@@ -64,6 +72,22 @@ public:
         return Exchange(Dirty::StencilProperties, false);
     }
 
+    bool TouchVertexInput() {
+        return Exchange(Dirty::VertexInput, false);
+    }
+
+    bool TouchRasterizer() {
+        return Exchange(Dirty::Rasterizer, false);
+    }
+
+    bool TouchDepthStencil() {
+        return Exchange(Dirty::DepthStencil, false);
+    }
+
+    bool TouchColorBlending() {
+        return Exchange(Dirty::ColorBlending, false);
+    }
+
 private:
     bool Exchange(std::size_t id, bool new_value) const noexcept {
         auto& flags = system.GPU().Maxwell3D().dirty.flags;
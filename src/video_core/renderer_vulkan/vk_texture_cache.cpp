@@ -389,7 +389,7 @@ VKTextureCache::VKTextureCache(Core::System& system, VideoCore::RasterizerInterf
                                const VKDevice& device, VKResourceManager& resource_manager,
                                VKMemoryManager& memory_manager, VKScheduler& scheduler,
                                VKStagingBufferPool& staging_pool)
-    : TextureCache(system, rasterizer, device.IsOptimalAstcSupported()), device{device},
+    : TextureCache(system, rasterizer, device.IsOptimalAstcSupported(), false), device{device},
       resource_manager{resource_manager}, memory_manager{memory_manager}, scheduler{scheduler},
       staging_pool{staging_pool} {}
 
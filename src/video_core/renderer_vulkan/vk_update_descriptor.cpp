@@ -37,15 +37,7 @@ void VKUpdateDescriptorQueue::Send(vk::DescriptorUpdateTemplate update_template,
 
     const auto payload_start = payload.data() + payload.size();
     for (const auto& entry : entries) {
-        if (const auto image = std::get_if<vk::DescriptorImageInfo>(&entry)) {
-            payload.push_back(*image);
-        } else if (const auto buffer = std::get_if<Buffer>(&entry)) {
-            payload.emplace_back(*buffer->buffer, buffer->offset, buffer->size);
-        } else if (const auto texel = std::get_if<vk::BufferView>(&entry)) {
-            payload.push_back(*texel);
-        } else {
-            UNREACHABLE();
-        }
+        payload.push_back(ResolveEntry(entry));
     }
 
     scheduler.Record([dev = device.GetLogical(), payload_start, set,
@@ -54,4 +46,23 @@ void VKUpdateDescriptorQueue::Send(vk::DescriptorUpdateTemplate update_template,
     });
 }
 
+void VKUpdateDescriptorQueue::ResolveEntries(std::vector<DescriptorUpdateEntry>& resolved) const {
+    resolved.clear();
+    for (const auto& entry : entries) {
+        resolved.push_back(ResolveEntry(entry));
+    }
+}
+
+DescriptorUpdateEntry VKUpdateDescriptorQueue::ResolveEntry(const Variant& entry) {
+    if (const auto image = std::get_if<vk::DescriptorImageInfo>(&entry)) {
+        return *image;
+    } else if (const auto buffer = std::get_if<Buffer>(&entry)) {
+        return {*buffer->buffer, buffer->offset, buffer->size};
+    } else if (const auto texel = std::get_if<vk::BufferView>(&entry)) {
+        return *texel;
+    }
+    UNREACHABLE();
+    return DescriptorUpdateEntry{};
+}
+
 } // namespace Vulkan
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstring>
 #include <type_traits>
 #include <variant>
+#include <vector>
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
@@ -18,22 +21,41 @@ class VKScheduler;
 
 class DescriptorUpdateEntry {
 public:
-    explicit DescriptorUpdateEntry() : image{} {}
+    explicit DescriptorUpdateEntry() : raw{} {}
 
-    DescriptorUpdateEntry(vk::DescriptorImageInfo image) : image{image} {}
+    // The storage is zeroed and members are assigned one by one, so padding compares equal
+    DescriptorUpdateEntry(vk::DescriptorImageInfo image_) : raw{} {
+        image.sampler = image_.sampler;
+        image.imageView = image_.imageView;
+        image.imageLayout = image_.imageLayout;
+    }
+
+    DescriptorUpdateEntry(vk::Buffer buffer_, vk::DeviceSize offset, vk::DeviceSize size)
+        : raw{} {
+        buffer = vk::DescriptorBufferInfo{buffer_, offset, size};
+    }
+
+    DescriptorUpdateEntry(vk::BufferView texel_buffer_) : raw{} {
+        texel_buffer = texel_buffer_;
+    }
 
-    DescriptorUpdateEntry(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize size)
-        : buffer{buffer, offset, size} {}
+    bool operator==(const DescriptorUpdateEntry& rhs) const noexcept {
+        return std::memcmp(raw.data(), rhs.raw.data(), sizeof(raw)) == 0;
+    }
 
-    DescriptorUpdateEntry(vk::BufferView texel_buffer) : texel_buffer{texel_buffer} {}
+    bool operator!=(const DescriptorUpdateEntry& rhs) const noexcept {
+        return !operator==(rhs);
+    }
 
 private:
     union {
+        std::array<u64, 3> raw;
         vk::DescriptorImageInfo image;
         vk::DescriptorBufferInfo buffer;
         vk::BufferView texel_buffer;
     };
 };
+static_assert(sizeof(DescriptorUpdateEntry) == sizeof(vk::DescriptorBufferInfo));
 
 class VKUpdateDescriptorQueue final {
 public:
@@ -46,6 +68,9 @@ public:
 
     void Send(vk::DescriptorUpdateTemplate update_template, vk::DescriptorSet set);
 
+    /// Writes the descriptors of the current draw to resolved, as they would be sent
+    void ResolveEntries(std::vector<DescriptorUpdateEntry>& resolved) const;
+
     void AddSampledImage(vk::Sampler sampler, vk::ImageView image_view) {
         entries.emplace_back(vk::DescriptorImageInfo{sampler, image_view, {}});
     }
@@ -73,6 +98,9 @@ private:
         std::size_t size{};
     };
     using Variant = std::variant<vk::DescriptorImageInfo, Buffer, vk::BufferView>;
+
+    static DescriptorUpdateEntry ResolveEntry(const Variant& entry);
+
     // Old gcc versions don't consider this trivially copyable.
     // static_assert(std::is_trivially_copyable_v<Variant>);
 
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -36,7 +37,7 @@ void ASTZipper::PushBack(const ASTNode new_node) {
     if (last) {
         last->next = new_node;
     }
-    new_node->next.reset();
+    new_node->next = nullptr;
     last = new_node;
     if (!first) {
         first = new_node;
@@ -46,7 +47,7 @@ void ASTZipper::PushBack(const ASTNode new_node) {
 
 void ASTZipper::PushFront(const ASTNode new_node) {
     ASSERT(new_node->manager == nullptr);
-    new_node->previous.reset();
+    new_node->previous = nullptr;
     new_node->next = first;
     if (first) {
         first->previous = new_node;
@@ -99,19 +100,19 @@ void ASTZipper::InsertBefore(const ASTNode new_node, const ASTNode at_node) {
 void ASTZipper::DetachTail(ASTNode node) {
     ASSERT(node->manager == this);
     if (node == first) {
-        first.reset();
-        last.reset();
+        first = nullptr;
+        last = nullptr;
         return;
     }
 
     last = node->previous;
-    last->next.reset();
-    node->previous.reset();
+    last->next = nullptr;
+    node->previous = nullptr;
 
     ASTNode current = std::move(node);
     while (current) {
         current->manager = nullptr;
-        current->parent.reset();
+        current->parent = nullptr;
         current = current->next;
     }
 }
@@ -134,13 +135,13 @@ void ASTZipper::DetachSegment(const ASTNode start, const ASTNode end) {
     } else {
         post->previous = prev;
     }
-    start->previous.reset();
-    end->next.reset();
+    start->previous = nullptr;
+    end->next = nullptr;
     ASTNode current = start;
     bool found = false;
     while (current) {
         current->manager = nullptr;
-        current->parent.reset();
+        current->parent = nullptr;
         found |= current == end;
         current = current->next;
     }
@@ -151,8 +152,8 @@ void ASTZipper::DetachSingle(const ASTNode node) {
     ASSERT(node->manager == this);
     const ASTNode prev = node->previous;
     const ASTNode post = node->next;
-    node->previous.reset();
-    node->next.reset();
+    node->previous = nullptr;
+    node->next = nullptr;
     if (!prev) {
         first = post;
     } else {
@@ -165,7 +166,7 @@ void ASTZipper::DetachSingle(const ASTNode node) {
     }
 
     node->manager = nullptr;
-    node->parent.reset();
+    node->parent = nullptr;
 }
 
 void ASTZipper::Remove(const ASTNode node) {
@@ -178,7 +179,7 @@ void ASTZipper::Remove(const ASTNode node) {
     if (next) {
         next->previous = previous;
     }
-    node->parent.reset();
+    node->parent = nullptr;
     node->manager = nullptr;
     if (node == last) {
         last = previous;
@@ -381,6 +382,28 @@ ASTManager::~ASTManager() {
     Clear();
 }
 
+ASTManager::ASTManager(ASTManager&& other) noexcept
+    : full_decompile{other.full_decompile}, disable_else_derivation{other.disable_else_derivation},
+      labels_map(std::move(other.labels_map)), labels_count{other.labels_count},
+      labels(std::move(other.labels)), gotos(std::move(other.gotos)),
+      variables{other.variables}, program{std::exchange(other.program, nullptr)},
+      main_node{std::exchange(other.main_node, nullptr)},
+      false_condition{std::exchange(other.false_condition, nullptr)} {}
+
+ASTManager& ASTManager::operator=(ASTManager&& other) noexcept {
+    full_decompile = other.full_decompile;
+    disable_else_derivation = other.disable_else_derivation;
+    labels_map = std::move(other.labels_map);
+    labels_count = other.labels_count;
+    labels = std::move(other.labels);
+    gotos = std::move(other.gotos);
+    variables = other.variables;
+    program = std::exchange(other.program, nullptr);
+    main_node = std::exchange(other.main_node, nullptr);
+    false_condition = std::exchange(other.false_condition, nullptr);
+    return *this;
+}
+
 void ASTManager::Init() {
     main_node = ASTBase::Make<ASTProgram>(ASTNode{});
     program = std::get_if<ASTProgram>(main_node->GetInnerData());
@@ -679,71 +702,12 @@ void ASTManager::MoveOutward(ASTNode goto_node) {
     goto_node->SetParent(grandpa);
 }
 
-class ASTClearer {
-public:
-    ASTClearer() = default;
-
-    void operator()(const ASTProgram& ast) {
-        ASTNode current = ast.nodes.GetFirst();
-        while (current) {
-            Visit(current);
-            current = current->GetNext();
-        }
-    }
-
-    void operator()(const ASTIfThen& ast) {
-        ASTNode current = ast.nodes.GetFirst();
-        while (current) {
-            Visit(current);
-            current = current->GetNext();
-        }
-    }
-
-    void operator()(const ASTIfElse& ast) {
-        ASTNode current = ast.nodes.GetFirst();
-        while (current) {
-            Visit(current);
-            current = current->GetNext();
-        }
-    }
-
-    void operator()([[maybe_unused]] const ASTBlockEncoded& ast) {}
-
-    void operator()(ASTBlockDecoded& ast) {
-        ast.nodes.clear();
-    }
-
-    void operator()([[maybe_unused]] const ASTVarSet& ast) {}
-
-    void operator()([[maybe_unused]] const ASTLabel& ast) {}
-
-    void operator()([[maybe_unused]] const ASTGoto& ast) {}
-
-    void operator()(const ASTDoWhile& ast) {
-        ASTNode current = ast.nodes.GetFirst();
-        while (current) {
-            Visit(current);
-            current = current->GetNext();
-        }
-    }
-
-    void operator()([[maybe_unused]] const ASTReturn& ast) {}
-
-    void operator()([[maybe_unused]] const ASTBreak& ast) {}
-
-    void Visit(const ASTNode& node) {
-        std::visit(*this, *node->GetInnerData());
-        node->Clear();
-    }
-};
-
 void ASTManager::Clear() {
     if (!main_node) {
         return;
     }
-    ASTClearer clearer{};
-    clearer.Visit(main_node);
-    main_node.reset();
+    // The nodes themselves are owned by the arena they were created in, only drop the references
+    main_node = nullptr;
     program = nullptr;
     labels_map.clear();
     labels.clear();
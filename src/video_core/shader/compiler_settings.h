@@ -21,6 +21,7 @@ std::string CompileDepthAsString(CompileDepth cd);
 struct CompilerSettings {
     CompileDepth depth{CompileDepth::NoFlowStack};
     bool disable_else_derivation{true};
+    bool optimize{false}; ///< Run the IR optimization passes before handing it to a backend
 };
 
 } // namespace VideoCommon::Shader
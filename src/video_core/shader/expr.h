@@ -4,10 +4,10 @@
 
 #pragma once
 
-#include <memory>
 #include <variant>
 
 #include "video_core/engines/shader_bytecode.h"
+#include "video_core/shader/node_arena.h"
 
 namespace VideoCommon::Shader {
 
@@ -25,7 +25,7 @@ class ExprVar;
 
 using ExprData = std::variant<ExprVar, ExprCondCode, ExprPredicate, ExprNot, ExprOr, ExprAnd,
                               ExprBoolean, ExprGprEqual>;
-using Expr = std::shared_ptr<ExprData>;
+using Expr = ExprData*;
 
 class ExprAnd final {
 public:
@@ -138,7 +138,7 @@ public:
 template <typename T, typename... Args>
 Expr MakeExpr(Args&&... args) {
     static_assert(std::is_convertible_v<T, ExprData>);
-    return std::make_shared<ExprData>(T(std::forward<Args>(args)...));
+    return NodeArena::Current().Create<ExprData>(T(std::forward<Args>(args)...));
 }
 
 bool ExprAreEqual(const Expr& first, const Expr& second);
@@ -241,7 +241,7 @@ class CommentNode;
 using NodeData = std::variant<OperationNode, ConditionalNode, GprNode, CustomVarNode, ImmediateNode,
                               InternalFlagNode, PredicateNode, AbufNode, PatchNode, CbufNode,
                               LmemNode, SmemNode, GmemNode, CommentNode>;
-using Node = std::shared_ptr<NodeData>;
+using Node = NodeData*;
 using Node4 = std::array<Node, 4>;
 using NodeBlock = std::vector<Node>;
 
@@ -0,0 +1,56 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "video_core/shader/node_arena.h"
+
+namespace VideoCommon::Shader {
+
+namespace {
+
+/// Size of the blocks objects are carved from, big enough to hold a small shader in one block
+constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+thread_local NodeArena* current_arena = nullptr;
+
+} // Anonymous namespace
+
+NodeArena::Scope::Scope(NodeArena& arena) : previous{current_arena} {
+    current_arena = &arena;
+}
+
+NodeArena::Scope::~Scope() {
+    current_arena = previous;
+}
+
+NodeArena::NodeArena() = default;
+
+NodeArena::~NodeArena() {
+    // Destroy objects in the reverse order they were created in
+    for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+        it->function(it->object);
+    }
+}
+
+NodeArena& NodeArena::Current() {
+    ASSERT_MSG(current_arena, "Creating a shader node without an arena in scope");
+    return *current_arena;
+}
+
+void* NodeArena::AllocateSlow(std::size_t size, std::size_t alignment) {
+    ASSERT(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    const std::size_t new_block_size = std::max(size, BLOCK_SIZE);
+    blocks.emplace_back(new u8[new_block_size]);
+    block_base = blocks.back().get();
+    block_size = new_block_size;
+    block_used = size;
+    return block_base;
+}
+
+} // namespace VideoCommon::Shader
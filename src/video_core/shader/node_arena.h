@@ -0,0 +1,78 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCommon::Shader {
+
+/// Bump allocator owning the nodes, expressions and AST nodes of a shader IR.
+/// Objects are never freed individually, they are all destroyed together with the arena.
+class NodeArena final {
+public:
+    /// Makes an arena the one new nodes are allocated from in the current thread
+    class Scope final {
+    public:
+        explicit Scope(NodeArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        NodeArena* previous;
+    };
+
+    NodeArena();
+    ~NodeArena();
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    /// Returns the arena in scope on the current thread
+    static NodeArena& Current();
+
+    template <typename T, typename... Args>
+    T* Create(Args&&... args) {
+        void* const memory = Allocate(sizeof(T), alignof(T));
+        T* const object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.push_back({[](void* pointer) { static_cast<T*>(pointer)->~T(); }, object});
+        }
+        return object;
+    }
+
+private:
+    struct Destructor {
+        void (*function)(void*);
+        void* object;
+    };
+
+    void* Allocate(std::size_t size, std::size_t alignment) {
+        const std::size_t offset = (block_used + alignment - 1) & ~(alignment - 1);
+        if (offset + size > block_size) {
+            return AllocateSlow(size, alignment);
+        }
+        block_used = offset + size;
+        return block_base + offset;
+    }
+
+    void* AllocateSlow(std::size_t size, std::size_t alignment);
+
+    std::vector<std::unique_ptr<u8[]>> blocks;
+    std::vector<Destructor> destructors;
+    u8* block_base = nullptr;
+    std::size_t block_size = 0;
+    std::size_t block_used = 0;
+};
+
+} // namespace VideoCommon::Shader
@@ -0,0 +1,953 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/shader/ast.h"
+#include "video_core/shader/node.h"
+#include "video_core/shader/node_helper.h"
+#include "video_core/shader/optimize.h"
+#include "video_core/shader/shader_ir.h"
+
+MICROPROFILE_DEFINE(Shader_CopyPropagation, "GPU", "Shader copy propagation",
+                    MP_RGB(128, 192, 255));
+MICROPROFILE_DEFINE(Shader_ConstantFolding, "GPU", "Shader constant folding",
+                    MP_RGB(128, 192, 255));
+MICROPROFILE_DEFINE(Shader_CbufDeduplication, "GPU", "Shader cbuf deduplication",
+                    MP_RGB(128, 192, 255));
+MICROPROFILE_DEFINE(Shader_DeadCodeElimination, "GPU", "Shader dead code elimination",
+                    MP_RGB(128, 192, 255));
+
+namespace VideoCommon::Shader {
+
+using Tegra::Shader::Pred;
+using Tegra::Shader::Register;
+
+namespace {
+
+constexpr std::size_t NUM_REGISTERS = 256;
+
+using RegisterSet = std::bitset<NUM_REGISTERS>;
+
+/// Known values of registers in the current block, each one is an immediate or another register
+using CopyTable = std::unordered_map<u32, Node>;
+
+bool IsAssign(OperationCode code) {
+    return code == OperationCode::Assign || code == OperationCode::LogicalAssign;
+}
+
+/// Returns true when the operation can leave the current block
+bool IsControlFlow(OperationCode code) {
+    switch (code) {
+    case OperationCode::Branch:
+    case OperationCode::BranchIndirect:
+    case OperationCode::PopFlowStack:
+    case OperationCode::Exit:
+    case OperationCode::Discard:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns true when evaluating the operation as a value has side effects
+bool HasSideEffects(OperationCode code) {
+    return code >= OperationCode::AtomicImageAdd && code <= OperationCode::AtomicIXor;
+}
+
+/// Returns the register written by a top level assignment, if any
+std::optional<u32> GetAssignedRegister(const Node& node) {
+    const auto operation = std::get_if<OperationNode>(&*node);
+    if (!operation || operation->GetCode() != OperationCode::Assign) {
+        return std::nullopt;
+    }
+    const auto gpr = std::get_if<GprNode>(&*(*operation)[0]);
+    if (!gpr || gpr->GetIndex() == Register::ZeroIndex) {
+        return std::nullopt;
+    }
+    return gpr->GetIndex();
+}
+
+/// Returns true when the destination of an assignment is not read, only written
+bool IsPlainDestination(const Node& dest) {
+    return std::holds_alternative<GprNode>(*dest) || std::holds_alternative<CustomVarNode>(*dest) ||
+           std::holds_alternative<PredicateNode>(*dest) ||
+           std::holds_alternative<InternalFlagNode>(*dest);
+}
+
+/// Calls func on every node referenced by the meta of an operation
+template <typename Func>
+void ForEachMetaNode(const Meta& meta, Func&& func) {
+    const auto call = [&func](const Node& node) {
+        if (node) {
+            func(node);
+        }
+    };
+    if (const auto texture = std::get_if<MetaTexture>(&meta)) {
+        call(texture->array);
+        call(texture->depth_compare);
+        for (const Node& node : texture->aoffi) {
+            call(node);
+        }
+        for (const Node& node : texture->ptp) {
+            call(node);
+        }
+        for (const Node& node : texture->derivates) {
+            call(node);
+        }
+        call(texture->bias);
+        call(texture->lod);
+        call(texture->component);
+        call(texture->index);
+    } else if (const auto image = std::get_if<MetaImage>(&meta)) {
+        for (const Node& node : image->values) {
+            call(node);
+        }
+    }
+}
+
+/// Calls func on every child of an expression. The code of conditionals is not visited.
+template <typename Func>
+void ForEachChild(const Node& node, Func&& func) {
+    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        ForEachMetaNode(operation->GetMeta(), func);
+        const bool skip_dest = IsAssign(operation->GetCode());
+        for (std::size_t i = 0; i < operation->GetOperandsCount(); ++i) {
+            const Node& operand = (*operation)[i];
+            if (i == 0 && skip_dest && IsPlainDestination(operand)) {
+                continue;
+            }
+            func(operand);
+        }
+    } else if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+        func(conditional->GetCondition());
+    } else if (const auto abuf = std::get_if<AbufNode>(&*node)) {
+        if (abuf->IsPhysicalBuffer()) {
+            func(abuf->GetPhysicalAddress());
+        }
+        if (abuf->GetBuffer()) {
+            func(abuf->GetBuffer());
+        }
+    } else if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
+        func(cbuf->GetOffset());
+    } else if (const auto lmem = std::get_if<LmemNode>(&*node)) {
+        func(lmem->GetAddress());
+    } else if (const auto smem = std::get_if<SmemNode>(&*node)) {
+        func(smem->GetAddress());
+    } else if (const auto gmem = std::get_if<GmemNode>(&*node)) {
+        func(gmem->GetRealAddress());
+        func(gmem->GetBaseAddress());
+    }
+}
+
+/// Rebuilds an operation's meta with its nodes rewritten, returns nothing when none changed
+template <typename Func>
+std::optional<Meta> RewriteMeta(const Meta& meta, Func&& rewrite) {
+    bool changed = false;
+    const auto apply = [&](Node& node) {
+        if (!node) {
+            return;
+        }
+        Node result = rewrite(node);
+        changed |= result != node;
+        node = result;
+    };
+    if (const auto texture = std::get_if<MetaTexture>(&meta)) {
+        MetaTexture result = *texture;
+        apply(result.array);
+        apply(result.depth_compare);
+        for (Node& node : result.aoffi) {
+            apply(node);
+        }
+        for (Node& node : result.ptp) {
+            apply(node);
+        }
+        for (Node& node : result.derivates) {
+            apply(node);
+        }
+        apply(result.bias);
+        apply(result.lod);
+        apply(result.component);
+        apply(result.index);
+        if (changed) {
+            return Meta{std::move(result)};
+        }
+    } else if (const auto image = std::get_if<MetaImage>(&meta)) {
+        MetaImage result = *image;
+        for (Node& node : result.values) {
+            apply(node);
+        }
+        if (changed) {
+            return Meta{std::move(result)};
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * Rebuilds an expression with its children replaced by rewrite(child).
+ * Nodes are shared between statements, so they are never modified in place.
+ * @returns The same node when no child changed
+ */
+template <typename Func>
+Node RewriteChildren(const Node& node, Func&& rewrite) {
+    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        const std::size_t count = operation->GetOperandsCount();
+        const bool skip_dest = IsAssign(operation->GetCode());
+
+        std::vector<Node> operands;
+        operands.reserve(count);
+        bool changed = false;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Node& operand = (*operation)[i];
+            if (i == 0 && skip_dest && IsPlainDestination(operand)) {
+                operands.push_back(operand);
+                continue;
+            }
+            operands.push_back(rewrite(operand));
+            changed |= operands.back() != operand;
+        }
+        std::optional<Meta> meta = RewriteMeta(operation->GetMeta(), rewrite);
+        if (!changed && !meta) {
+            return node;
+        }
+        Node result = MakeNode<OperationNode>(operation->GetCode(),
+                                              meta ? std::move(*meta) : operation->GetMeta(),
+                                              std::move(operands));
+        if (const auto amend_index = operation->GetAmendIndex()) {
+            std::get_if<OperationNode>(&*result)->SetAmendIndex(*amend_index);
+        }
+        return result;
+    }
+    if (const auto abuf = std::get_if<AbufNode>(&*node)) {
+        const Node buffer = abuf->GetBuffer() ? rewrite(abuf->GetBuffer()) : Node{};
+        if (abuf->IsPhysicalBuffer()) {
+            const Node address = rewrite(abuf->GetPhysicalAddress());
+            if (address == abuf->GetPhysicalAddress() && buffer == abuf->GetBuffer()) {
+                return node;
+            }
+            return MakeNode<AbufNode>(address, buffer);
+        }
+        if (buffer == abuf->GetBuffer()) {
+            return node;
+        }
+        return MakeNode<AbufNode>(abuf->GetIndex(), abuf->GetElement(), buffer);
+    }
+    if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
+        const Node offset = rewrite(cbuf->GetOffset());
+        // Backends only know how to address constant buffers with immediates or operations
+        if (offset == cbuf->GetOffset() || (!std::holds_alternative<ImmediateNode>(*offset) &&
+                                            !std::holds_alternative<OperationNode>(*offset))) {
+            return node;
+        }
+        return MakeNode<CbufNode>(cbuf->GetIndex(), offset);
+    }
+    if (const auto lmem = std::get_if<LmemNode>(&*node)) {
+        const Node address = rewrite(lmem->GetAddress());
+        return address == lmem->GetAddress() ? node : MakeNode<LmemNode>(address);
+    }
+    if (const auto smem = std::get_if<SmemNode>(&*node)) {
+        const Node address = rewrite(smem->GetAddress());
+        return address == smem->GetAddress() ? node : MakeNode<SmemNode>(address);
+    }
+    if (const auto gmem = std::get_if<GmemNode>(&*node)) {
+        const Node real_address = rewrite(gmem->GetRealAddress());
+        const Node base_address = rewrite(gmem->GetBaseAddress());
+        if (real_address == gmem->GetRealAddress() && base_address == gmem->GetBaseAddress()) {
+            return node;
+        }
+        return MakeNode<GmemNode>(real_address, base_address, gmem->GetDescriptor());
+    }
+    return node;
+}
+
+/// Rewrites an expression bottom-up, calling transform on every node after its children
+template <typename Func>
+Node Transform(const Node& node, Func& transform) {
+    const auto recurse = [&transform](const Node& child) { return Transform(child, transform); };
+    return transform(RewriteChildren(node, recurse));
+}
+
+/// Rebuilds a conditional with a new condition and code, keeping its amend
+Node RebuildConditional(const ConditionalNode& conditional, Node condition, NodeBlock code) {
+    Node result = Conditional(std::move(condition), std::move(code));
+    if (const auto amend_index = conditional.GetAmendIndex()) {
+        std::get_if<ConditionalNode>(&*result)->SetAmendIndex(*amend_index);
+    }
+    return result;
+}
+
+/// Calls func with every register read by a statement, including its nested code and amends
+template <typename Func>
+void ForEachRegisterRead(const Node& node, const std::vector<Node>& amend_code, Func&& func) {
+    if (const auto gpr = std::get_if<GprNode>(&*node)) {
+        func(gpr->GetIndex());
+        return;
+    }
+    std::optional<std::size_t> amend_index;
+    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        amend_index = operation->GetAmendIndex();
+    } else if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+        amend_index = conditional->GetAmendIndex();
+        for (const Node& child : conditional->GetCode()) {
+            ForEachRegisterRead(child, amend_code, func);
+        }
+    }
+    if (amend_index) {
+        ForEachRegisterRead(amend_code[*amend_index], amend_code, func);
+    }
+    ForEachChild(node, [&](const Node& child) { ForEachRegisterRead(child, amend_code, func); });
+}
+
+/// Collects the registers written anywhere in a block, including nested code
+void CollectWrittenRegisters(const NodeBlock& block, RegisterSet& written) {
+    for (const Node& node : block) {
+        if (const auto reg = GetAssignedRegister(node)) {
+            written.set(*reg);
+        } else if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+            CollectWrittenRegisters(conditional->GetCode(), written);
+        }
+    }
+}
+
+/// Returns true when a statement or its nested code can leave the block
+bool ContainsControlFlow(const Node& node) {
+    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        return IsControlFlow(operation->GetCode());
+    }
+    if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+        for (const Node& child : conditional->GetCode()) {
+            if (ContainsControlFlow(child)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// Returns true when an expression can be dropped without changing the behaviour of the shader
+bool IsPure(const Node& node) {
+    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        if (HasSideEffects(operation->GetCode()) || operation->GetAmendIndex()) {
+            return false;
+        }
+    }
+    bool pure = true;
+    ForEachChild(node, [&pure](const Node& child) { pure = pure && IsPure(child); });
+    return pure;
+}
+
+std::optional<u32> GetImmediate(const Node& node) {
+    if (const auto immediate = std::get_if<ImmediateNode>(&*node)) {
+        return immediate->GetValue();
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> GetConstantPredicate(const Node& node) {
+    const auto predicate = std::get_if<PredicateNode>(&*node);
+    if (!predicate) {
+        return std::nullopt;
+    }
+    switch (predicate->GetIndex()) {
+    case Pred::UnusedIndex:
+        return !predicate->IsNegated();
+    case Pred::NeverExecute:
+        return predicate->IsNegated();
+    default:
+        return std::nullopt;
+    }
+}
+
+Node MakeConstantPredicate(bool value) {
+    return MakeNode<PredicateNode>(value ? Pred::UnusedIndex : Pred::NeverExecute, false);
+}
+
+std::optional<u32> FoldUnary(OperationCode code, u32 a) {
+    switch (code) {
+    case OperationCode::INegate:
+        return 0U - a;
+    case OperationCode::IBitwiseNot:
+    case OperationCode::UBitwiseNot:
+        return ~a;
+    case OperationCode::ICastUnsigned:
+    case OperationCode::UCastSigned:
+        return a;
+    case OperationCode::FNegate:
+        return a ^ 0x80000000U;
+    case OperationCode::FAbsolute:
+        return a & 0x7fffffffU;
+    case OperationCode::FCastInteger: {
+        const f32 value = static_cast<f32>(static_cast<s32>(a));
+        u32 result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+    case OperationCode::FCastUInteger: {
+        const f32 value = static_cast<f32>(a);
+        u32 result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<u32> FoldBinary(OperationCode code, u32 a, u32 b) {
+    const auto sa = static_cast<s32>(a);
+    const auto sb = static_cast<s32>(b);
+    switch (code) {
+    case OperationCode::IAdd:
+    case OperationCode::UAdd:
+        return a + b;
+    case OperationCode::IMul:
+    case OperationCode::UMul:
+        return a * b;
+    case OperationCode::IMin:
+        return static_cast<u32>(std::min(sa, sb));
+    case OperationCode::IMax:
+        return static_cast<u32>(std::max(sa, sb));
+    case OperationCode::UMin:
+        return std::min(a, b);
+    case OperationCode::UMax:
+        return std::max(a, b);
+    case OperationCode::IBitwiseAnd:
+    case OperationCode::UBitwiseAnd:
+        return a & b;
+    case OperationCode::IBitwiseOr:
+    case OperationCode::UBitwiseOr:
+        return a | b;
+    case OperationCode::IBitwiseXor:
+    case OperationCode::UBitwiseXor:
+        return a ^ b;
+    case OperationCode::ILogicalShiftLeft:
+    case OperationCode::ULogicalShiftLeft:
+        return b < 32 ? std::optional<u32>{a << b} : std::nullopt;
+    case OperationCode::ILogicalShiftRight:
+    case OperationCode::ULogicalShiftRight:
+        return b < 32 ? std::optional<u32>{a >> b} : std::nullopt;
+    case OperationCode::IArithmeticShiftRight:
+        return b < 32 ? std::optional<u32>{static_cast<u32>(sa >> b)} : std::nullopt;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<bool> FoldComparison(OperationCode code, u32 a, u32 b) {
+    const auto sa = static_cast<s32>(a);
+    const auto sb = static_cast<s32>(b);
+    switch (code) {
+    case OperationCode::LogicalILessThan:
+        return sa < sb;
+    case OperationCode::LogicalIEqual:
+    case OperationCode::LogicalUEqual:
+        return a == b;
+    case OperationCode::LogicalILessEqual:
+        return sa <= sb;
+    case OperationCode::LogicalIGreaterThan:
+        return sa > sb;
+    case OperationCode::LogicalINotEqual:
+    case OperationCode::LogicalUNotEqual:
+        return a != b;
+    case OperationCode::LogicalIGreaterEqual:
+        return sa >= sb;
+    case OperationCode::LogicalULessThan:
+        return a < b;
+    case OperationCode::LogicalULessEqual:
+        return a <= b;
+    case OperationCode::LogicalUGreaterThan:
+        return a > b;
+    case OperationCode::LogicalUGreaterEqual:
+        return a >= b;
+    default:
+        return std::nullopt;
+    }
+}
+
+/// Returns the operand of a unary operation that undoes code, if node is one
+Node GetInverseOperand(OperationCode code, const Node& node) {
+    const auto operation = std::get_if<OperationNode>(&*node);
+    if (!operation || operation->GetOperandsCount() != 1 || operation->GetAmendIndex()) {
+        return nullptr;
+    }
+    const OperationCode inner = operation->GetCode();
+    switch (code) {
+    case OperationCode::FNegate:
+    case OperationCode::IBitwiseNot:
+    case OperationCode::UBitwiseNot:
+    case OperationCode::LogicalNegate:
+        return inner == code ? (*operation)[0] : nullptr;
+    case OperationCode::ICastUnsigned:
+        return inner == OperationCode::UCastSigned ? (*operation)[0] : nullptr;
+    case OperationCode::UCastSigned:
+        return inner == OperationCode::ICastUnsigned ? (*operation)[0] : nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+} // Anonymous namespace
+
+Node FoldOperation(const OperationNode& operation) {
+    if (operation.GetAmendIndex()) {
+        return nullptr;
+    }
+    const OperationCode code = operation.GetCode();
+    const std::size_t count = operation.GetOperandsCount();
+
+    if (count == 1) {
+        if (const auto a = GetImmediate(operation[0])) {
+            if (const auto result = FoldUnary(code, *a)) {
+                return Immediate(*result);
+            }
+        }
+        if (code == OperationCode::LogicalNegate) {
+            if (const auto a = GetConstantPredicate(operation[0])) {
+                return MakeConstantPredicate(!*a);
+            }
+        }
+        return GetInverseOperand(code, operation[0]);
+    }
+    if (count != 2) {
+        return nullptr;
+    }
+    const Node& op_a = operation[0];
+    const Node& op_b = operation[1];
+
+    if (code == OperationCode::LogicalAnd || code == OperationCode::LogicalOr ||
+        code == OperationCode::LogicalXor) {
+        const auto a = GetConstantPredicate(op_a);
+        const auto b = GetConstantPredicate(op_b);
+        if (a && b) {
+            switch (code) {
+            case OperationCode::LogicalAnd:
+                return MakeConstantPredicate(*a && *b);
+            case OperationCode::LogicalOr:
+                return MakeConstantPredicate(*a || *b);
+            default:
+                return MakeConstantPredicate(*a != *b);
+            }
+        }
+        if (!a && !b) {
+            return nullptr;
+        }
+        const bool constant = a ? *a : *b;
+        const Node& other = a ? op_b : op_a;
+        if (code == OperationCode::LogicalXor) {
+            return constant ? nullptr : other;
+        }
+        // true && x == x, false || x == x
+        if (constant == (code == OperationCode::LogicalAnd)) {
+            return other;
+        }
+        return IsPure(other) ? MakeConstantPredicate(constant) : nullptr;
+    }
+
+    const auto a = GetImmediate(op_a);
+    const auto b = GetImmediate(op_b);
+    if (a && b) {
+        if (const auto result = FoldBinary(code, *a, *b)) {
+            return Immediate(*result);
+        }
+        if (const auto result = FoldComparison(code, *a, *b)) {
+            return MakeConstantPredicate(*result);
+        }
+        return nullptr;
+    }
+    switch (code) {
+    case OperationCode::IAdd:
+    case OperationCode::UAdd:
+    case OperationCode::IBitwiseOr:
+    case OperationCode::UBitwiseOr:
+    case OperationCode::IBitwiseXor:
+    case OperationCode::UBitwiseXor:
+        // x + 0 == x, x | 0 == x, x ^ 0 == x
+        if (a == 0U) {
+            return op_b;
+        }
+        if (b == 0U) {
+            return op_a;
+        }
+        return nullptr;
+    case OperationCode::ILogicalShiftLeft:
+    case OperationCode::ULogicalShiftLeft:
+    case OperationCode::ILogicalShiftRight:
+    case OperationCode::ULogicalShiftRight:
+    case OperationCode::IArithmeticShiftRight:
+        return b == 0U ? op_a : nullptr;
+    case OperationCode::IMul:
+    case OperationCode::UMul:
+        if (a == 1U) {
+            return op_b;
+        }
+        if (b == 1U) {
+            return op_a;
+        }
+        [[fallthrough]];
+    case OperationCode::IBitwiseAnd:
+    case OperationCode::UBitwiseAnd:
+        // x * 0 == 0, x & 0 == 0
+        if ((a == 0U && IsPure(op_b)) || (b == 0U && IsPure(op_a))) {
+            return Immediate(0U);
+        }
+        return nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+namespace {
+
+struct CopyPropagation {
+    void PropagateBlock(NodeBlock& block, CopyTable& table) {
+        for (Node& node : block) {
+            auto substitute = [&](const Node& expression) {
+                if (const auto gpr = std::get_if<GprNode>(&*expression)) {
+                    if (const auto it = table.find(gpr->GetIndex()); it != table.end()) {
+                        ++changes;
+                        return it->second;
+                    }
+                }
+                return expression;
+            };
+
+            if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+                Node condition = Transform(conditional->GetCondition(), substitute);
+                NodeBlock code = conditional->GetCode();
+                CopyTable inner_table = table;
+                PropagateBlock(code, inner_table);
+                if (condition != conditional->GetCondition() || code != conditional->GetCode()) {
+                    node = RebuildConditional(*conditional, std::move(condition), std::move(code));
+                }
+                RegisterSet written;
+                CollectWrittenRegisters(std::get_if<ConditionalNode>(&*node)->GetCode(), written);
+                for (u32 reg = 0; reg < NUM_REGISTERS; ++reg) {
+                    if (written[reg]) {
+                        Invalidate(table, reg);
+                    }
+                }
+                continue;
+            }
+
+            node = Transform(node, substitute);
+
+            const auto reg = GetAssignedRegister(node);
+            if (!reg) {
+                continue;
+            }
+            Invalidate(table, *reg);
+            const Node& value = (*std::get_if<OperationNode>(&*node))[1];
+            if (std::holds_alternative<ImmediateNode>(*value)) {
+                table.insert_or_assign(*reg, value);
+            } else if (const auto gpr = std::get_if<GprNode>(&*value)) {
+                if (gpr->GetIndex() != Register::ZeroIndex && gpr->GetIndex() != *reg) {
+                    table.insert_or_assign(*reg, value);
+                }
+            }
+        }
+    }
+
+    /// Forgets what is known about a register and the copies made from it
+    static void Invalidate(CopyTable& table, u32 reg) {
+        table.erase(reg);
+        for (auto it = table.begin(); it != table.end();) {
+            const auto gpr = std::get_if<GprNode>(&*it->second);
+            if (gpr && gpr->GetIndex() == reg) {
+                it = table.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    u32 changes = 0;
+};
+
+struct ConstantFolding {
+    void FoldBlock(NodeBlock& block) {
+        auto fold = [this](const Node& node) {
+            const auto operation = std::get_if<OperationNode>(&*node);
+            if (!operation) {
+                return node;
+            }
+            if (Node result = FoldOperation(*operation)) {
+                ++changes;
+                return result;
+            }
+            return node;
+        };
+
+        NodeBlock result;
+        result.reserve(block.size());
+        for (const Node& node : block) {
+            const auto conditional = std::get_if<ConditionalNode>(&*node);
+            if (!conditional) {
+                result.push_back(Transform(node, fold));
+                continue;
+            }
+            Node condition = Transform(conditional->GetCondition(), fold);
+            NodeBlock code = conditional->GetCode();
+            FoldBlock(code);
+
+            const auto constant = GetConstantPredicate(condition);
+            if (constant && !conditional->GetAmendIndex()) {
+                ++changes;
+                if (*constant) {
+                    result.insert(result.end(), code.begin(), code.end());
+                }
+                continue;
+            }
+            if (condition != conditional->GetCondition() || code != conditional->GetCode()) {
+                result.push_back(
+                    RebuildConditional(*conditional, std::move(condition), std::move(code)));
+            } else {
+                result.push_back(node);
+            }
+        }
+        block = std::move(result);
+    }
+
+    u32 changes = 0;
+};
+
+struct CbufDeduplication {
+    using Key = CbufVariables::key_type;
+
+    explicit CbufDeduplication(CbufVariables& variables, const std::function<u32()>& new_variable)
+        : variables{variables}, new_variable{new_variable} {}
+
+    void DeduplicateBlock(NodeBlock& block) {
+        std::map<Key, u32> uses;
+        for (const Node& node : block) {
+            CountUses(node, uses);
+        }
+
+        std::map<Key, Node> loads;
+        NodeBlock prologue;
+        for (const auto& [key, count] : uses) {
+            if (count < 2) {
+                continue;
+            }
+            auto [it, is_new] = variables.try_emplace(key);
+            if (is_new) {
+                it->second = new_variable();
+            }
+            const Node variable = MakeNode<CustomVarNode>(it->second);
+            prologue.push_back(Operation(OperationCode::Assign, variable,
+                                         MakeNode<CbufNode>(key.first, Immediate(key.second))));
+            loads.emplace(key, variable);
+            changes += count - 1;
+        }
+        if (loads.empty()) {
+            return;
+        }
+
+        auto replace = [&loads](const Node& node) {
+            if (const auto key = GetKey(node)) {
+                if (const auto it = loads.find(*key); it != loads.end()) {
+                    return it->second;
+                }
+            }
+            return node;
+        };
+        ReplaceInBlock(block, replace);
+        block.insert(block.begin(), prologue.begin(), prologue.end());
+    }
+
+    static std::optional<Key> GetKey(const Node& node) {
+        const auto cbuf = std::get_if<CbufNode>(&*node);
+        if (!cbuf) {
+            return std::nullopt;
+        }
+        const auto offset = GetImmediate(cbuf->GetOffset());
+        if (!offset) {
+            return std::nullopt;
+        }
+        return Key{cbuf->GetIndex(), *offset};
+    }
+
+    static void CountUses(const Node& node, std::map<Key, u32>& uses) {
+        if (const auto key = GetKey(node)) {
+            ++uses[*key];
+            return;
+        }
+        if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+            for (const Node& child : conditional->GetCode()) {
+                CountUses(child, uses);
+            }
+        }
+        ForEachChild(node, [&uses](const Node& child) { CountUses(child, uses); });
+    }
+
+    template <typename Func>
+    static void ReplaceInBlock(NodeBlock& block, Func& replace) {
+        for (Node& node : block) {
+            const auto conditional = std::get_if<ConditionalNode>(&*node);
+            if (!conditional) {
+                node = Transform(node, replace);
+                continue;
+            }
+            Node condition = Transform(conditional->GetCondition(), replace);
+            NodeBlock code = conditional->GetCode();
+            ReplaceInBlock(code, replace);
+            node = RebuildConditional(*conditional, std::move(condition), std::move(code));
+        }
+    }
+
+    CbufVariables& variables;
+    const std::function<u32()>& new_variable;
+    u32 changes = 0;
+};
+
+struct DeadCodeElimination {
+    explicit DeadCodeElimination(const std::vector<Node>& amend_code) : amend_code{amend_code} {}
+
+    void EliminateBlock(NodeBlock& block) {
+        // Registers that are written again further down the block before being read
+        RegisterSet overwritten;
+        std::vector<bool> keep(block.size(), true);
+        for (std::size_t index = block.size(); index-- > 0;) {
+            const Node& node = block[index];
+            if (ContainsControlFlow(node)) {
+                overwritten.reset();
+            }
+            if (const auto reg = GetAssignedRegister(node)) {
+                const auto& operation = *std::get_if<OperationNode>(&*node);
+                if (overwritten[*reg] && !operation.GetAmendIndex() && IsPure(operation[1])) {
+                    keep[index] = false;
+                    ++changes;
+                    continue;
+                }
+                overwritten.set(*reg);
+            }
+            ForEachRegisterRead(node, amend_code,
+                                [&overwritten](u32 reg) { overwritten.reset(reg); });
+        }
+        if (std::find(keep.begin(), keep.end(), false) == keep.end()) {
+            return;
+        }
+        NodeBlock result;
+        result.reserve(block.size());
+        for (std::size_t index = 0; index < block.size(); ++index) {
+            if (keep[index]) {
+                result.push_back(block[index]);
+            }
+        }
+        block = std::move(result);
+    }
+
+    const std::vector<Node>& amend_code;
+    u32 changes = 0;
+};
+
+void CollectASTBlocks(ASTNode node, std::vector<NodeBlock*>& blocks) {
+    if (const auto decoded = std::get_if<ASTBlockDecoded>(node->GetInnerData())) {
+        blocks.push_back(&decoded->nodes);
+        return;
+    }
+    if (ASTZipper* const zipper = node->GetSubNodes()) {
+        for (ASTNode child = zipper->GetFirst(); child; child = child->GetNext()) {
+            CollectASTBlocks(child, blocks);
+        }
+    }
+}
+
+/// Runs a pass over every block, accumulating its execution time and changes in the statistics
+template <typename Func>
+void RunPass(OptimizationStats::Pass& stats, const std::vector<NodeBlock*>& blocks, Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (NodeBlock* const block : blocks) {
+        stats.changes += func(*block);
+    }
+    stats.time += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+} // Anonymous namespace
+
+u32 PropagateCopies(NodeBlock& block) {
+    CopyPropagation pass;
+    CopyTable table;
+    pass.PropagateBlock(block, table);
+    return pass.changes;
+}
+
+u32 FoldConstants(NodeBlock& block) {
+    ConstantFolding pass;
+    pass.FoldBlock(block);
+    return pass.changes;
+}
+
+u32 DeduplicateCbufLoads(NodeBlock& block, CbufVariables& variables,
+                         const std::function<u32()>& new_variable) {
+    CbufDeduplication pass{variables, new_variable};
+    pass.DeduplicateBlock(block);
+    return pass.changes;
+}
+
+u32 EliminateDeadStores(NodeBlock& block, const std::vector<Node>& amend_code) {
+    DeadCodeElimination pass{amend_code};
+    pass.EliminateBlock(block);
+    return pass.changes;
+}
+
+void ShaderIR::Optimize() {
+    // Guest registers stay live across blocks in both backends, so every pass works within a
+    // block and keeps whatever the following blocks might read.
+    std::vector<NodeBlock*> blocks;
+    if (decompiled) {
+        CollectASTBlocks(program_manager.GetProgram(), blocks);
+    } else {
+        for (auto& [label, block] : basic_blocks) {
+            blocks.push_back(&block);
+        }
+    }
+
+    {
+        MICROPROFILE_SCOPE(Shader_CopyPropagation);
+        RunPass(optimization_stats.copy_propagation, blocks, PropagateCopies);
+    }
+    {
+        MICROPROFILE_SCOPE(Shader_ConstantFolding);
+        RunPass(optimization_stats.constant_folding, blocks, FoldConstants);
+    }
+    {
+        MICROPROFILE_SCOPE(Shader_CbufDeduplication);
+        CbufVariables variables;
+        const std::function<u32()> new_variable = [this] { return NewCustomVariable(); };
+        RunPass(optimization_stats.cbuf_deduplication, blocks, [&](NodeBlock& block) {
+            return DeduplicateCbufLoads(block, variables, new_variable);
+        });
+    }
+    {
+        MICROPROFILE_SCOPE(Shader_DeadCodeElimination);
+        RunPass(optimization_stats.dead_code_elimination, blocks,
+                [this](NodeBlock& block) { return EliminateDeadStores(block, amend_code); });
+    }
+
+    const auto& stats = optimization_stats;
+    LOG_DEBUG(HW_GPU,
+              "Optimized shader: {} copies propagated ({} us), {} nodes folded ({} us), {} cbuf "
+              "loads removed ({} us), {} dead stores removed ({} us)",
+              stats.copy_propagation.changes, stats.copy_propagation.time.count(),
+              stats.constant_folding.changes, stats.constant_folding.time.count(),
+              stats.cbuf_deduplication.changes, stats.cbuf_deduplication.time.count(),
+              stats.dead_code_elimination.changes, stats.dead_code_elimination.time.count());
+}
+
+} // namespace VideoCommon::Shader
@@ -0,0 +1,46 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/shader/node.h"
+
+namespace VideoCommon::Shader {
+
+/// Custom variables holding constant buffer slots, keyed by buffer index and offset
+using CbufVariables = std::map<std::pair<u32, u32>, u32>;
+
+/// Simplifies an operation whose operands have already been folded, returns nullptr if it can't
+Node FoldOperation(const OperationNode& operation);
+
+/**
+ * The passes below are run by ShaderIR::Optimize on every block of a shader. Guest registers stay
+ * live across blocks, so they only rewrite what is provably unused or redundant within a block.
+ * @returns The number of nodes rewritten or removed
+ */
+
+/// Forwards immediates and register copies to the reads that follow them in the block
+u32 PropagateCopies(NodeBlock& block);
+
+/// Folds operations on constants and removes conditionals with a constant condition
+u32 FoldConstants(NodeBlock& block);
+
+/**
+ * Loads constant buffer slots read more than once in a block into custom variables.
+ * @param variables Variables already assigned to slots, shared by the blocks of a shader
+ * @param new_variable Creates a new custom variable and returns its index
+ */
+u32 DeduplicateCbufLoads(NodeBlock& block, CbufVariables& variables,
+                         const std::function<u32()>& new_variable);
+
+/// Removes register stores that are overwritten in the block before being read
+u32 EliminateDeadStores(NodeBlock& block, const std::vector<Node>& amend_code);
+
+} // namespace VideoCommon::Shader
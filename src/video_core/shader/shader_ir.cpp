@@ -27,8 +27,12 @@ using Tegra::Shader::Register;
 ShaderIR::ShaderIR(const ProgramCode& program_code, u32 main_offset, CompilerSettings settings,
                    Registry& registry)
     : program_code{program_code}, main_offset{main_offset}, settings{settings}, registry{registry} {
+    NodeArena::Scope arena_scope{arena};
     Decode();
     PostDecode();
+    if (settings.optimize) {
+        Optimize();
+    }
 }
 
 ShaderIR::~ShaderIR() = default;
@@ -356,6 +360,8 @@ OperationCode ShaderIR::GetPredicateCombiner(PredOperation operation) {
 }
 
 Node ShaderIR::GetConditionCode(Tegra::Shader::ConditionCode cc) const {
+    // This is also called by the decompilers, after the IR has been built
+    NodeArena::Scope arena_scope{arena};
     switch (cc) {
     case Tegra::Shader::ConditionCode::NEU:
         return GetInternalFlag(InternalFlag::Zero, true);
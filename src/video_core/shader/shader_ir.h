@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <list>
 #include <map>
 #include <optional>
@@ -19,6 +20,7 @@
 #include "video_core/shader/ast.h"
 #include "video_core/shader/compiler_settings.h"
 #include "video_core/shader/node.h"
+#include "video_core/shader/node_arena.h"
 #include "video_core/shader/registry.h"
 
 namespace VideoCommon::Shader {
@@ -66,6 +68,19 @@ struct GlobalMemoryUsage {
     bool is_written{};
 };
 
+/// Statistics of the optimization passes run on a shader
+struct OptimizationStats {
+    struct Pass {
+        std::chrono::microseconds time{}; ///< Time spent running the pass
+        u32 changes{};                    ///< Number of nodes rewritten or removed by the pass
+    };
+
+    Pass copy_propagation;
+    Pass constant_folding;
+    Pass cbuf_deduplication;
+    Pass dead_code_elimination;
+};
+
 class ShaderIR final {
 public:
     explicit ShaderIR(const ProgramCode& program_code, u32 main_offset, CompilerSettings settings,
@@ -188,6 +203,10 @@ public:
         return num_custom_variables;
     }
 
+    const OptimizationStats& GetOptimizationStats() const {
+        return optimization_stats;
+    }
+
 private:
     friend class ASTDecoder;
 
@@ -201,6 +220,9 @@ private:
     void Decode();
     void PostDecode();
 
+    /// Runs the optimization passes over the decoded blocks
+    void Optimize();
+
     NodeBlock DecodeRange(u32 begin, u32 end);
     void DecodeRangeInner(NodeBlock& bb, u32 begin, u32 end);
     void InsertControlFlow(NodeBlock& bb, const ShaderBlock& block);
@@ -433,11 +455,15 @@ private:
     u32 coverage_begin{};
     u32 coverage_end{};
 
+    /// Owns every node, expression and AST node of this IR, it has to outlive their references
+    mutable NodeArena arena;
+
     std::map<u32, NodeBlock> basic_blocks;
     NodeBlock global_code;
     ASTManager program_manager{true, true};
     std::vector<Node> amend_code;
     u32 num_custom_variables{};
+    OptimizationStats optimization_stats;
 
     std::set<u32> used_registers;
     std::set<Tegra::Shader::Pred> used_predicates;
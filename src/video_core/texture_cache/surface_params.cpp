@@ -72,6 +72,7 @@ SurfaceParams SurfaceParams::CreateForTexture(const FormatLookupTable& lookup_ta
                                               const Tegra::Texture::TICEntry& tic,
                                               const VideoCommon::Shader::Sampler& entry) {
     SurfaceParams params;
+    params.is_scaled = false;
     params.is_tiled = tic.IsTiled();
     params.srgb_conversion = tic.IsSrgbConversionEnabled();
     params.block_width = params.is_tiled ? tic.BlockWidth() : 0,
@@ -128,6 +129,7 @@ SurfaceParams SurfaceParams::CreateForImage(const FormatLookupTable& lookup_tabl
                                             const Tegra::Texture::TICEntry& tic,
                                             const VideoCommon::Shader::Image& entry) {
     SurfaceParams params;
+    params.is_scaled = false;
     params.is_tiled = tic.IsTiled();
     params.srgb_conversion = tic.IsSrgbConversionEnabled();
     params.block_width = params.is_tiled ? tic.BlockWidth() : 0,
@@ -169,6 +171,7 @@ SurfaceParams SurfaceParams::CreateForDepthBuffer(Core::System& system) {
     const auto& regs = system.GPU().Maxwell3D().regs;
     regs.zeta_width, regs.zeta_height, regs.zeta.format, regs.zeta.memory_layout.type;
     SurfaceParams params;
+    params.is_scaled = false;
     params.is_tiled = regs.zeta.memory_layout.type ==
                       Tegra::Engines::Maxwell3D::Regs::InvMemoryLayout::BlockLinear;
     params.srgb_conversion = false;
@@ -194,6 +197,7 @@ SurfaceParams SurfaceParams::CreateForDepthBuffer(Core::System& system) {
 SurfaceParams SurfaceParams::CreateForFramebuffer(Core::System& system, std::size_t index) {
     const auto& config{system.GPU().Maxwell3D().regs.rt[index]};
     SurfaceParams params;
+    params.is_scaled = false;
     params.is_tiled =
         config.memory_layout.type == Tegra::Engines::Maxwell3D::Regs::InvMemoryLayout::BlockLinear;
     params.srgb_conversion = config.format == Tegra::RenderTargetFormat::BGRA8_SRGB ||
@@ -359,11 +363,12 @@ std::size_t SurfaceParams::GetInnerMipmapMemorySize(u32 level, bool as_host_size
 }
 
 bool SurfaceParams::operator==(const SurfaceParams& rhs) const {
-    return std::tie(is_tiled, block_width, block_height, block_depth, tile_width_spacing, width,
-                    height, depth, pitch, num_levels, pixel_format, type, target) ==
-           std::tie(rhs.is_tiled, rhs.block_width, rhs.block_height, rhs.block_depth,
-                    rhs.tile_width_spacing, rhs.width, rhs.height, rhs.depth, rhs.pitch,
-                    rhs.num_levels, rhs.pixel_format, rhs.type, rhs.target);
+    return std::tie(is_tiled, is_scaled, block_width, block_height, block_depth,
+                    tile_width_spacing, width, height, depth, pitch, num_levels, pixel_format, type,
+                    target) ==
+           std::tie(rhs.is_tiled, rhs.is_scaled, rhs.block_width, rhs.block_height,
+                    rhs.block_depth, rhs.tile_width_spacing, rhs.width, rhs.height, rhs.depth,
+                    rhs.pitch, rhs.num_levels, rhs.pixel_format, rhs.type, rhs.target);
 }
 
 std::string SurfaceParams::TargetName() const {
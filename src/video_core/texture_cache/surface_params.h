@@ -248,6 +248,7 @@ public:
     bool is_tiled;
     bool srgb_conversion;
     bool is_layered;
+    bool is_scaled;
     u32 block_width;
     u32 block_height;
     u32 block_depth;
@@ -6,11 +6,13 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/icl/interval_map.hpp>
@@ -87,6 +89,11 @@ public:
             return a->GetModificationTick() < b->GetModificationTick();
         });
         for (const auto& surface : surfaces) {
+            if (surface->IsModified() && surface->GetSurfaceParams().is_scaled) {
+                // The CPU reads this render target, render to it at native resolution from now on
+                unscaled_addresses.insert(surface->GetGpuAddr());
+                MarkRenderTargetsDirty();
+            }
             FlushSurface(surface);
         }
     }
@@ -165,7 +172,8 @@ public:
             SetEmptyDepthBuffer();
             return {};
         }
-        const auto depth_params{SurfaceParams::CreateForDepthBuffer(system)};
+        auto depth_params{SurfaceParams::CreateForDepthBuffer(system)};
+        depth_params.is_scaled = render_targets_scaled;
         auto surface_view = GetSurface(gpu_addr, cache_addr, depth_params, preserve_contents, true);
         if (depth_buffer.target)
             depth_buffer.target->MarkAsRenderTarget(false, NO_RT);
@@ -206,9 +214,9 @@ public:
             return {};
         }
 
-        auto surface_view =
-            GetSurface(gpu_addr, cache_addr, SurfaceParams::CreateForFramebuffer(system, index),
-                       preserve_contents, true);
+        auto params{SurfaceParams::CreateForFramebuffer(system, index)};
+        params.is_scaled = render_targets_scaled;
+        auto surface_view = GetSurface(gpu_addr, cache_addr, params, preserve_contents, true);
         if (render_targets[index].target)
             render_targets[index].target->MarkAsRenderTarget(false, NO_RT);
         render_targets[index].target = surface_view.first;
@@ -218,6 +226,22 @@ public:
         return surface_view.second;
     }
 
+    /**
+     * Decides the scale the render targets bound by the guest are rendered at. A framebuffer has a
+     * single scale, so if any of its attachments must stay at native resolution all of them do.
+     * Must be called before the render targets are looked up, when they may have changed.
+     */
+    void UpdateRenderTargetScale() {
+        std::lock_guard lock{mutex};
+        const bool scaled = IsFramebufferScalable();
+        if (scaled == render_targets_scaled) {
+            return;
+        }
+        render_targets_scaled = scaled;
+        // Render targets that were not changed by the guest have to be recreated at the new scale
+        MarkRenderTargetsDirty();
+    }
+
     void MarkColorBufferInUse(std::size_t index) {
         if (auto& render_target = render_targets[index].target) {
             render_target->MarkAsModified(true, Tick());
@@ -290,8 +314,10 @@ public:
 
 protected:
     explicit TextureCache(Core::System& system, VideoCore::RasterizerInterface& rasterizer,
-                          bool is_astc_supported)
-        : system{system}, is_astc_supported{is_astc_supported}, rasterizer{rasterizer} {
+                          bool is_astc_supported, bool is_scaling_supported)
+        : system{system}, is_astc_supported{is_astc_supported},
+          resolution_scale{is_scaling_supported ? GetResolutionScaleSetting() : 1U},
+          rasterizer{rasterizer} {
         for (std::size_t i = 0; i < Tegra::Engines::Maxwell3D::Regs::NumRenderTargets; i++) {
             SetEmptyColorBuffer(i);
         }
@@ -325,6 +351,17 @@ protected:
     // and reading it from a separate buffer.
     virtual void BufferCopy(TSurface& src_surface, TSurface& dst_surface) = 0;
 
+    /// Forces every render target to be looked up again on the next draw
+    void MarkRenderTargetsDirty() {
+        auto& dirty = system.GPU().Maxwell3D().dirty;
+        dirty.flags[VideoCommon::Dirty::ZetaBuffer] = true;
+        for (std::size_t index = 0; index < Tegra::Engines::Maxwell3D::Regs::NumRenderTargets;
+             ++index) {
+            dirty.flags[VideoCommon::Dirty::ColorBuffer0 + index] = true;
+        }
+        dirty.flags[VideoCommon::Dirty::RenderTargets] = true;
+    }
+
     void ManageRenderTargetUnregister(TSurface& surface) {
         auto& dirty = system.GPU().Maxwell3D().dirty;
         const u32 index = surface->GetRenderTarget();
@@ -363,6 +400,10 @@ protected:
         if (!guard_render_targets && surface->IsRenderTarget()) {
             ManageRenderTargetUnregister(surface);
         }
+        if (!unscaled_addresses.empty() && !surface->GetSurfaceParams().is_scaled) {
+            // The native resolution surface is gone, what replaces it may be scaled again
+            unscaled_addresses.erase(surface->GetGpuAddr());
+        }
         const std::size_t size = surface->GetSizeInBytes();
         const VAddr cpu_addr = surface->GetCpuAddr();
         rasterizer.UpdatePagesCachedCount(cpu_addr, size, -1);
@@ -383,6 +424,7 @@ protected:
 
     Core::System& system;
     const bool is_astc_supported;
+    const u32 resolution_scale;
 
 private:
     enum class RecycleStrategy : u32 {
@@ -509,16 +551,17 @@ private:
                                               bool is_render) {
         const auto gpu_addr = current_surface->GetGpuAddr();
         const auto& cr_params = current_surface->GetSurfaceParams();
-        TSurface new_surface;
+        SurfaceParams new_params = params;
+        if (!is_render) {
+            // Sampling a render target keeps it at the resolution it was rendered at
+            new_params.is_scaled = cr_params.is_scaled && IsScalable(gpu_addr, new_params);
+        }
         if (cr_params.pixel_format != params.pixel_format && !is_render &&
             GetSiblingFormat(cr_params.pixel_format) == params.pixel_format) {
-            SurfaceParams new_params = params;
             new_params.pixel_format = cr_params.pixel_format;
             new_params.type = cr_params.type;
-            new_surface = GetUncachedSurface(gpu_addr, new_params);
-        } else {
-            new_surface = GetUncachedSurface(gpu_addr, params);
         }
+        TSurface new_surface = GetUncachedSurface(gpu_addr, new_params);
         const auto& final_params = new_surface->GetSurfaceParams();
         if (cr_params.type != final_params.type) {
             BufferCopy(current_surface, new_surface);
@@ -548,6 +591,10 @@ private:
                                                      const SurfaceParams& params, bool is_render) {
         const bool is_mirage = !current_surface->MatchFormat(params.pixel_format);
         const bool matches_target = current_surface->MatchTarget(params.target);
+        if (is_render && current_surface->GetSurfaceParams().is_scaled != params.is_scaled) {
+            // Bound render targets must share a resolution, recreate it at the requested one
+            return RebuildSurface(current_surface, params, is_render);
+        }
         const auto match_check = [&]() -> std::pair<TSurface, TView> {
             if (matches_target) {
                 return {current_surface, current_surface->GetMainView()};
@@ -1087,6 +1134,49 @@ private:
         return {};
     }
 
+    /// Returns the scale factor from the settings, where auto keeps surfaces at native resolution
+    static u32 GetResolutionScaleSetting() {
+        return static_cast<u32>(std::max(1.0f, std::round(Settings::values.resolution_factor)));
+    }
+
+    /**
+     * Returns true when a render target with the given parameters can be allocated at a higher
+     * resolution. Only single level 2D block linear surfaces are scaled, linear surfaces and
+     * surfaces the CPU has read back are kept at native resolution.
+     */
+    bool IsScalable(GPUVAddr gpu_addr, const SurfaceParams& params) const {
+        if (resolution_scale == 1 || !params.is_tiled || params.num_levels != 1 ||
+            params.target != SurfaceTarget::Texture2D || params.IsCompressed()) {
+            return false;
+        }
+        return unscaled_addresses.count(gpu_addr) == 0;
+    }
+
+    /// Returns true when every render target bound by the guest can be scaled.
+    bool IsFramebufferScalable() const {
+        if (resolution_scale == 1) {
+            return false;
+        }
+        const auto& regs = system.GPU().Maxwell3D().regs;
+        const auto zeta_addr = regs.zeta.Address();
+        if (regs.zeta_enable && zeta_addr != 0 &&
+            !IsScalable(zeta_addr, SurfaceParams::CreateForDepthBuffer(system))) {
+            return false;
+        }
+        const std::size_t count = std::min<std::size_t>(
+            regs.rt_control.count, Tegra::Engines::Maxwell3D::Regs::NumRenderTargets);
+        for (std::size_t index = 0; index < count; ++index) {
+            const auto& config = regs.rt[index];
+            if (config.Address() == 0 || config.format == Tegra::RenderTargetFormat::NONE) {
+                continue;
+            }
+            if (!IsScalable(config.Address(), SurfaceParams::CreateForFramebuffer(system, index))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     constexpr PixelFormat GetSiblingFormat(PixelFormat format) const {
         return siblings_table[static_cast<std::size_t>(format)];
     }
@@ -1165,6 +1255,12 @@ private:
 
     std::vector<TSurface> sampled_textures;
 
+    /// Addresses of render targets read by the CPU, they are not scaled while their native
+    /// resolution surface is registered
+    std::unordered_set<GPUVAddr> unscaled_addresses;
+    /// Whether the render targets bound by the guest are rendered at resolution_scale
+    bool render_targets_scaled = false;
+
     /// This cache stores null surfaces in order to be used as a placeholder
     /// for invalid texture calls.
     std::unordered_map<u32, TSurface> invalid_cache;
@@ -458,6 +458,11 @@ bool GRenderWindow::InitRenderTarget() {
             return false;
         }
         break;
+    case Settings::RendererBackend::Null:
+        // Config falls back to OpenGL, this is only reached if the setting was changed directly
+        QMessageBox::critical(this, tr("Null renderer not available!"),
+                              tr("The null renderer can only be used with yuzu-cmd."));
+        return false;
     }
 
     child_widget->resize(Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height);
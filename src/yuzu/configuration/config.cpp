@@ -409,6 +409,10 @@ void Config::ReadAudioValues() {
         ReadSetting(QStringLiteral("enable_audio_stretching"), true).toBool();
     Settings::values.enable_realtime_audio =
         ReadSetting(QStringLiteral("enable_realtime_audio"), true).toBool();
+    Settings::values.enable_low_latency_audio =
+        ReadSetting(QStringLiteral("enable_low_latency_audio"), false).toBool();
+    Settings::values.audio_stretch_threshold =
+        static_cast<u16>(ReadSetting(QStringLiteral("audio_stretch_threshold"), 5).toInt());
     Settings::values.audio_device_id =
         ReadSetting(QStringLiteral("output_device"), QStringLiteral("auto"))
             .toString()
@@ -493,6 +497,8 @@ void Config::ReadDataStorageValues() {
                     QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir)))
             .toString()
             .toStdString());
+    Settings::values.use_extracted_content_cache =
+        ReadSetting(QStringLiteral("use_extracted_content_cache"), false).toBool();
     Settings::values.gamecard_inserted =
         ReadSetting(QStringLiteral("gamecard_inserted"), false).toBool();
     Settings::values.gamecard_current_game =
@@ -531,6 +537,10 @@ void Config::ReadDebuggingValues() {
         ReadSetting(QStringLiteral("program_args"), QStringLiteral("")).toString().toStdString();
     Settings::values.dump_exefs = ReadSetting(QStringLiteral("dump_exefs"), false).toBool();
     Settings::values.dump_nso = ReadSetting(QStringLiteral("dump_nso"), false).toBool();
+    Settings::values.dump_audio_renderer =
+        ReadSetting(QStringLiteral("dump_audio_renderer"), false).toBool();
+    Settings::values.dump_gpu_commands =
+        ReadSetting(QStringLiteral("dump_gpu_commands"), false).toBool();
     Settings::values.reporting_services =
         ReadSetting(QStringLiteral("reporting_services"), false).toBool();
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
@@ -628,6 +638,10 @@ void Config::ReadRendererValues() {
 
     Settings::values.renderer_backend =
         static_cast<Settings::RendererBackend>(ReadSetting(QStringLiteral("backend"), 0).toInt());
+    if (Settings::values.renderer_backend == Settings::RendererBackend::Null) {
+        // The null renderer has no window to present to, the Qt frontend does not offer it
+        Settings::values.renderer_backend = Settings::RendererBackend::OpenGL;
+    }
     Settings::values.renderer_debug = ReadSetting(QStringLiteral("debug"), false).toBool();
     Settings::values.vulkan_device = ReadSetting(QStringLiteral("vulkan_device"), 0).toInt();
     Settings::values.resolution_factor =
@@ -639,6 +653,8 @@ void Config::ReadRendererValues() {
     Settings::values.frame_limit = ReadSetting(QStringLiteral("frame_limit"), 100).toInt();
     Settings::values.use_disk_shader_cache =
         ReadSetting(QStringLiteral("use_disk_shader_cache"), true).toBool();
+    Settings::values.use_shader_optimizations =
+        ReadSetting(QStringLiteral("use_shader_optimizations"), false).toBool();
     Settings::values.use_accurate_gpu_emulation =
         ReadSetting(QStringLiteral("use_accurate_gpu_emulation"), false).toBool();
     Settings::values.use_asynchronous_gpu_emulation =
@@ -917,6 +933,10 @@ void Config::SaveAudioValues() {
                  Settings::values.enable_audio_stretching, true);
     WriteSetting(QStringLiteral("enable_realtime_audio"), Settings::values.enable_realtime_audio,
                  true);
+    WriteSetting(QStringLiteral("enable_low_latency_audio"),
+                 Settings::values.enable_low_latency_audio, false);
+    WriteSetting(QStringLiteral("audio_stretch_threshold"),
+                 Settings::values.audio_stretch_threshold, 5);
     WriteSetting(QStringLiteral("output_device"),
                  QString::fromStdString(Settings::values.audio_device_id), QStringLiteral("auto"));
     WriteSetting(QStringLiteral("volume"), Settings::values.volume, 1.0f);
@@ -973,6 +993,8 @@ void Config::SaveDataStorageValues() {
     WriteSetting(QStringLiteral("cache_directory"),
                  QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir)),
                  QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir)));
+    WriteSetting(QStringLiteral("use_extracted_content_cache"),
+                 Settings::values.use_extracted_content_cache, false);
     WriteSetting(QStringLiteral("gamecard_inserted"), Settings::values.gamecard_inserted, false);
     WriteSetting(QStringLiteral("gamecard_current_game"), Settings::values.gamecard_current_game,
                  false);
@@ -1004,6 +1026,9 @@ void Config::SaveDebuggingValues() {
                  QString::fromStdString(Settings::values.program_args), QStringLiteral(""));
     WriteSetting(QStringLiteral("dump_exefs"), Settings::values.dump_exefs, false);
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
+    WriteSetting(QStringLiteral("dump_audio_renderer"), Settings::values.dump_audio_renderer,
+                 false);
+    WriteSetting(QStringLiteral("dump_gpu_commands"), Settings::values.dump_gpu_commands, false);
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
 
     qt_config->endGroup();
@@ -1081,6 +1106,8 @@ void Config::SaveRendererValues() {
     WriteSetting(QStringLiteral("frame_limit"), Settings::values.frame_limit, 100);
     WriteSetting(QStringLiteral("use_disk_shader_cache"), Settings::values.use_disk_shader_cache,
                  true);
+    WriteSetting(QStringLiteral("use_shader_optimizations"),
+                 Settings::values.use_shader_optimizations, false);
     WriteSetting(QStringLiteral("use_accurate_gpu_emulation"),
                  Settings::values.use_accurate_gpu_emulation, false);
     WriteSetting(QStringLiteral("use_asynchronous_gpu_emulation"),
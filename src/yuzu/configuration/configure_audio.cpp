@@ -23,12 +23,15 @@ ConfigureAudio::ConfigureAudio(QWidget* parent)
             &ConfigureAudio::SetVolumeIndicatorText);
     connect(ui->output_sink_combo_box, qOverload<int>(&QComboBox::currentIndexChanged), this,
             &ConfigureAudio::UpdateAudioDevices);
+    connect(ui->toggle_low_latency_audio, &QCheckBox::toggled, ui->stretch_threshold_spinbox,
+            &QSpinBox::setEnabled);
 
     SetConfiguration();
 
     const bool is_powered_on = Core::System::GetInstance().IsPoweredOn();
     ui->output_sink_combo_box->setEnabled(!is_powered_on);
     ui->audio_device_combo_box->setEnabled(!is_powered_on);
+    ui->toggle_low_latency_audio->setEnabled(!is_powered_on);
 }
 
 ConfigureAudio::~ConfigureAudio() = default;
@@ -43,6 +46,9 @@ void ConfigureAudio::SetConfiguration() {
 
     ui->toggle_audio_stretching->setChecked(Settings::values.enable_audio_stretching);
     ui->toggle_realtime_audio->setChecked(Settings::values.enable_realtime_audio);
+    ui->toggle_low_latency_audio->setChecked(Settings::values.enable_low_latency_audio);
+    ui->stretch_threshold_spinbox->setValue(Settings::values.audio_stretch_threshold);
+    ui->stretch_threshold_spinbox->setEnabled(Settings::values.enable_low_latency_audio);
     ui->volume_slider->setValue(Settings::values.volume * ui->volume_slider->maximum());
     SetVolumeIndicatorText(ui->volume_slider->sliderPosition());
 }
@@ -86,6 +92,9 @@ void ConfigureAudio::ApplyConfiguration() {
             .toStdString();
     Settings::values.enable_audio_stretching = ui->toggle_audio_stretching->isChecked();
     Settings::values.enable_realtime_audio = ui->toggle_realtime_audio->isChecked();
+    Settings::values.enable_low_latency_audio = ui->toggle_low_latency_audio->isChecked();
+    Settings::values.audio_stretch_threshold =
+        static_cast<u16>(ui->stretch_threshold_spinbox->value());
     Settings::values.audio_device_id =
         ui->audio_device_combo_box->itemText(ui->audio_device_combo_box->currentIndex())
             .toStdString();
@@ -72,6 +72,7 @@ void ConfigureFilesystem::setConfiguration() {
     ui->dump_nso->setChecked(Settings::values.dump_nso);
 
     ui->cache_game_list->setChecked(UISettings::values.cache_game_list);
+    ui->use_extracted_content_cache->setChecked(Settings::values.use_extracted_content_cache);
 
     SetComboBoxFromData(ui->nand_size, Settings::values.nand_total_size);
     SetComboBoxFromData(ui->usrnand_size, Settings::values.nand_user_size);
@@ -98,6 +99,7 @@ void ConfigureFilesystem::applyConfiguration() {
     Settings::values.dump_nso = ui->dump_nso->isChecked();
 
     UISettings::values.cache_game_list = ui->cache_game_list->isChecked();
+    Settings::values.use_extracted_content_cache = ui->use_extracted_content_cache->isChecked();
 
     Settings::values.nand_total_size = static_cast<Settings::NANDTotalSize>(
         ui->nand_size->itemData(ui->nand_size->currentIndex()).toULongLong());
@@ -475,8 +475,13 @@ void GMainWindow::InitializeWidgets() {
     emu_frametime_label->setToolTip(
         tr("Time taken to emulate a Switch frame, not counting framelimiting or v-sync. For "
            "full-speed emulation this should be at most 16.67 ms."));
+    audio_latency_label = new QLabel();
+    audio_latency_label->setToolTip(
+        tr("Time between audio being rendered and heard. Only measured with low latency audio "
+           "output enabled."));
 
-    for (auto& label : {emu_speed_label, game_fps_label, emu_frametime_label}) {
+    for (auto& label :
+         {emu_speed_label, game_fps_label, emu_frametime_label, audio_latency_label}) {
         label->setVisible(false);
         label->setFrameStyle(QFrame::NoFrame);
         label->setContentsMargins(4, 0, 4, 0);
@@ -1089,6 +1094,7 @@ void GMainWindow::ShutdownGame() {
     emu_speed_label->setVisible(false);
     game_fps_label->setVisible(false);
     emu_frametime_label->setVisible(false);
+    audio_latency_label->setVisible(false);
     async_status_button->setEnabled(true);
 #ifdef HAS_VULKAN
     renderer_status_button->setEnabled(true);
@@ -1986,10 +1992,13 @@ void GMainWindow::UpdateStatusBar() {
     }
     game_fps_label->setText(tr("Game: %1 FPS").arg(results.game_fps, 0, 'f', 0));
     emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    audio_latency_label->setText(
+        tr("Audio: %1 ms").arg(results.audio_latency * 1000.0, 0, 'f', 0));
 
     emu_speed_label->setVisible(true);
     game_fps_label->setVisible(true);
     emu_frametime_label->setVisible(true);
+    audio_latency_label->setVisible(results.audio_latency > 0.0);
 }
 
 void GMainWindow::OnCoreError(Core::System::ResultStatus result, std::string details) {
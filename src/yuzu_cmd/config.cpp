@@ -315,6 +315,8 @@ void Config::ReadValues() {
     // Data Storage
     Settings::values.use_virtual_sd =
         sdl2_config->GetBoolean("Data Storage", "use_virtual_sd", true);
+    Settings::values.use_extracted_content_cache =
+        sdl2_config->GetBoolean("Data Storage", "use_extracted_content_cache", false);
     FileUtil::GetUserPath(FileUtil::UserPath::NANDDir,
                           sdl2_config->Get("Data Storage", "nand_directory",
                                            FileUtil::GetUserPath(FileUtil::UserPath::NANDDir)));
@@ -388,6 +390,8 @@ void Config::ReadValues() {
         static_cast<u16>(sdl2_config->GetInteger("Renderer", "frame_limit", 100));
     Settings::values.use_disk_shader_cache =
         sdl2_config->GetBoolean("Renderer", "use_disk_shader_cache", false);
+    Settings::values.use_shader_optimizations =
+        sdl2_config->GetBoolean("Renderer", "use_shader_optimizations", false);
     Settings::values.use_accurate_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_accurate_gpu_emulation", false);
     Settings::values.use_asynchronous_gpu_emulation =
@@ -406,6 +410,10 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Audio", "enable_audio_stretching", true);
     Settings::values.enable_realtime_audio =
         sdl2_config->GetBoolean("Audio", "enable_realtime_audio", true);
+    Settings::values.enable_low_latency_audio =
+        sdl2_config->GetBoolean("Audio", "enable_low_latency_audio", false);
+    Settings::values.audio_stretch_threshold =
+        static_cast<u16>(sdl2_config->GetInteger("Audio", "audio_stretch_threshold", 5));
     Settings::values.audio_device_id = sdl2_config->Get("Audio", "output_device", "auto");
     Settings::values.volume = static_cast<float>(sdl2_config->GetReal("Audio", "volume", 1));
 
@@ -424,6 +432,10 @@ void Config::ReadValues() {
     Settings::values.program_args = sdl2_config->Get("Debugging", "program_args", "");
     Settings::values.dump_exefs = sdl2_config->GetBoolean("Debugging", "dump_exefs", false);
     Settings::values.dump_nso = sdl2_config->GetBoolean("Debugging", "dump_nso", false);
+    Settings::values.dump_audio_renderer =
+        sdl2_config->GetBoolean("Debugging", "dump_audio_renderer", false);
+    Settings::values.dump_gpu_commands =
+        sdl2_config->GetBoolean("Debugging", "dump_gpu_commands", false);
     Settings::values.reporting_services =
         sdl2_config->GetBoolean("Debugging", "reporting_services", false);
     Settings::values.quest_flag = sdl2_config->GetBoolean("Debugging", "quest_flag", false);
@@ -99,7 +99,7 @@ use_multi_core=
 
 [Renderer]
 # Which backend API to use.
-# 0 (default): OpenGL, 1: Vulkan
+# 0 (default): OpenGL, 1: Vulkan, 2: Null (draws nothing, for measuring the GPU emulation)
 backend =
 
 # Enable graphics API debugging mode.
@@ -146,6 +146,10 @@ frame_limit =
 # 0 (default): Off, 1 : On
 use_disk_shader_cache =
 
+# Whether to optimize the shader IR before generating host shaders
+# 0 (default): Off, 1 : On
+use_shader_optimizations =
+
 # Whether to use accurate GPU emulation
 # 0 (default): Off (fast), 1 : On (slow)
 use_accurate_gpu_emulation =
@@ -206,6 +210,16 @@ enable_audio_stretching =
 # 0: No, 1 (default): Yes
 enable_realtime_audio =
 
+# Whether or not to size the audio output queue from the measured timing of the output device
+# and release audio buffers as the device consumes them. This greatly reduces audio latency.
+# 0 (default): No, 1: Yes
+enable_low_latency_audio =
+
+# In low latency mode, how far the emulated audio rate has to drift from the output rate before
+# audio stretching is applied, in percent.
+# 5 (default)
+audio_stretch_threshold =
+
 # Which audio device to use.
 # auto (default): Auto-select
 output_device =
@@ -219,6 +233,12 @@ volume =
 # 1 (default): Yes, 0: No
 use_virtual_sd =
 
+# Whether to keep decrypted and patched copies of game RomFS images in the cache directory.
+# The first boot of a game writes its image, which takes time and disk space; later boots read it
+# directly instead of decrypting and patching the game's files.
+# 1: Yes, 0 (default): No
+use_extracted_content_cache =
+
 # Whether or not to enable gamecard emulation
 # 1: Yes, 0 (default): No
 gamecard_inserted =
@@ -282,6 +302,10 @@ gdbstub_port=24689
 dump_exefs=false
 # Determines whether or not yuzu will dump all NSOs it attempts to load while loading them
 dump_nso=false
+# Determines whether or not yuzu will record audio renderer updates for replay by yuzu-audio-harness
+dump_audio_renderer=false
+# Determines whether or not yuzu will record GPU command lists for replay by yuzu-gpu-replay
+dump_gpu_commands=false
 # Determines whether or not yuzu will report to the game that the emulated console is in Kiosk Mode
 # false: Retail/Normal Mode (default), true: Kiosk Mode
 quest_flag =
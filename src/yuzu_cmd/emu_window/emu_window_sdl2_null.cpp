@@ -0,0 +1,59 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdlib>
+#include <string>
+
+#include <SDL.h>
+#include <fmt/format.h>
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "core/settings.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
+
+EmuWindow_SDL2_Null::EmuWindow_SDL2_Null(Core::System& system, bool fullscreen)
+    : EmuWindow_SDL2{system, fullscreen} {
+    const std::string window_title = fmt::format("yuzu {} | {}-{} (Null)", Common::g_build_name,
+                                                 Common::g_scm_branch, Common::g_scm_desc);
+    render_window =
+        SDL_CreateWindow(window_title.c_str(),
+                         SDL_WINDOWPOS_UNDEFINED, // x position
+                         SDL_WINDOWPOS_UNDEFINED, // y position
+                         Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height,
+                         SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+
+    if (render_window == nullptr) {
+        LOG_CRITICAL(Frontend, "Failed to create SDL2 window! {}", SDL_GetError());
+        exit(1);
+    }
+
+    if (fullscreen) {
+        Fullscreen();
+    }
+
+    OnResize();
+    OnMinimalClientAreaChangeRequest(GetActiveConfig().min_client_area_size);
+    SDL_PumpEvents();
+    LOG_INFO(Frontend, "yuzu Version: {} | {}-{} (Null)", Common::g_build_name,
+             Common::g_scm_branch, Common::g_scm_desc);
+    Settings::LogSettings();
+}
+
+EmuWindow_SDL2_Null::~EmuWindow_SDL2_Null() = default;
+
+void EmuWindow_SDL2_Null::Present() {
+    // Nothing is ever rendered
+}
+
+void EmuWindow_SDL2_Null::RetrieveVulkanHandlers(void* get_instance_proc_addr, void* instance,
+                                                 void* surface) const {
+    // Should not have been called from the null renderer
+    UNREACHABLE();
+}
+
+std::unique_ptr<Core::Frontend::GraphicsContext> EmuWindow_SDL2_Null::CreateSharedContext() const {
+    // The GPU thread has no context to make current
+    return std::make_unique<Core::Frontend::GraphicsContext>();
+}
@@ -0,0 +1,24 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include "core/frontend/emu_window.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2.h"
+
+/// Window for the null renderer, it has no graphics context and nothing is presented to it
+class EmuWindow_SDL2_Null final : public EmuWindow_SDL2 {
+public:
+    explicit EmuWindow_SDL2_Null(Core::System& system, bool fullscreen);
+    ~EmuWindow_SDL2_Null();
+
+    void Present() override;
+
+    /// Ignored by the null renderer
+    void RetrieveVulkanHandlers(void* get_instance_proc_addr, void* instance,
+                                void* surface) const override;
+
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override;
+};
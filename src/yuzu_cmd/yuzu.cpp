@@ -32,6 +32,7 @@
 #include "yuzu_cmd/config.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
 #ifdef HAS_VULKAN
 #include "yuzu_cmd/emu_window/emu_window_sdl2_vk.h"
 #endif
@@ -192,6 +193,9 @@ int main(int argc, char** argv) {
         LOG_CRITICAL(Frontend, "Vulkan backend has not been compiled!");
         return 1;
 #endif
+    case Settings::RendererBackend::Null:
+        emu_window = std::make_unique<EmuWindow_SDL2_Null>(system, fullscreen);
+        break;
     }
 
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
@@ -0,0 +1,326 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+// Replays GPU captures recorded with the dump_gpu_commands setting, without a game or the CPU
+// emulation, and reports how long the GPU thread spent on each frame.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/vfs_real.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/hle/service/filesystem/filesystem.h"
+#include "core/memory.h"
+#include "core/settings.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
+#ifdef HAS_VULKAN
+#include "yuzu_cmd/emu_window/emu_window_sdl2_vk.h"
+#endif
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Guest memory backing the regions mapped to the GPU in a capture. The GPU memory manager expects
+ * a mapped region to be contiguous in host memory, so all regions are reserved before replaying
+ * and overlapping ones share a single allocation, mapped into the otherwise empty process.
+ */
+class GuestMemory {
+public:
+    void Reserve(VAddr address, u64 size) {
+        VAddr start{address & ~Memory::PAGE_MASK};
+        VAddr end{Common::AlignUp(address + size, Memory::PAGE_SIZE)};
+
+        auto iter = ranges.upper_bound(start);
+        if (iter != ranges.begin() && std::prev(iter)->second >= start) {
+            --iter;
+            start = iter->first;
+        }
+        while (iter != ranges.end() && iter->first <= end) {
+            end = std::max(end, iter->second);
+            iter = ranges.erase(iter);
+        }
+        ranges.emplace(start, end);
+    }
+
+    bool Map(Kernel::Process& process) {
+        for (const auto& [start, end] : ranges) {
+            auto& allocation = allocations.emplace_back(end - start);
+            const auto result = process.VMManager().MapBackingMemory(
+                start, allocation.data(), allocation.size(), Kernel::MemoryState::Heap);
+            if (result.Failed()) {
+                LOG_CRITICAL(HW_GPU, "Failed to map guest memory {:016X}-{:016X}", start, end);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    /// Reserved ranges, keyed by their start address and holding their end address
+    std::map<VAddr, VAddr> ranges;
+    std::vector<std::vector<u8>> allocations;
+};
+
+/// Returns the value at the given percentile of a sorted list
+double Percentile(const std::vector<double>& sorted, double percentile) {
+    const std::size_t index{static_cast<std::size_t>(percentile * (sorted.size() - 1) + 0.5)};
+    return sorted[index];
+}
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <capture>\n"
+                 "-r, --renderer=NAME   Replay with the opengl (default), vulkan or null renderer\n"
+                 "-o, --output=FILE     Write the time spent on each frame to FILE as CSV\n"
+                 "-s, --shader-optimizations\n"
+                 "                      Compile shaders with the decompiler's optimizations\n"
+                 "-h, --help            Display this help and exit\n";
+}
+
+void InitializeLogging() {
+    Log::Filter log_filter(Log::Level::Info);
+    Log::SetGlobalFilter(log_filter);
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    InitializeLogging();
+
+    std::string capture_path;
+    std::string output_path;
+    bool use_shader_optimizations = false;
+    Settings::values.renderer_backend = Settings::RendererBackend::OpenGL;
+
+    int option_index = 0;
+    static struct option long_options[] = {
+        {"renderer", required_argument, 0, 'r'},
+        {"output", required_argument, 0, 'o'},
+        {"shader-optimizations", no_argument, 0, 's'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "r:o:sh", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'r':
+                if (std::string(optarg) == "opengl") {
+                    Settings::values.renderer_backend = Settings::RendererBackend::OpenGL;
+                } else if (std::string(optarg) == "vulkan") {
+                    Settings::values.renderer_backend = Settings::RendererBackend::Vulkan;
+                } else if (std::string(optarg) == "null") {
+                    Settings::values.renderer_backend = Settings::RendererBackend::Null;
+                } else {
+                    PrintHelp(argv[0]);
+                    return -1;
+                }
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 's':
+                use_shader_optimizations = true;
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            default:
+                PrintHelp(argv[0]);
+                return -1;
+            }
+        } else {
+            capture_path = argv[optind];
+            optind++;
+        }
+    }
+
+    if (capture_path.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    // Every region the capture maps has to be known before the first one is mapped
+    GuestMemory guest_memory;
+    {
+        Tegra::GPUCaptureReader reader{capture_path};
+        if (!reader.IsValid()) {
+            return -1;
+        }
+        Tegra::GPUCaptureRecord record;
+        while (reader.ReadRecord(record)) {
+            if (record.type == Tegra::GPUCaptureRecordType::Map) {
+                guest_memory.Reserve(record.cpu_addr, record.size);
+            }
+        }
+    }
+
+    // Process commands on this thread as soon as they are submitted, with nothing cached on disk
+    Settings::values.dump_gpu_commands = false;
+    Settings::values.use_asynchronous_gpu_emulation = false;
+    Settings::values.use_disk_shader_cache = false;
+    Settings::values.use_shader_optimizations = use_shader_optimizations;
+    Settings::values.use_vsync = false;
+    Settings::values.resolution_factor = 1.0f;
+
+    Core::System& system{Core::System::GetInstance()};
+
+    std::unique_ptr<EmuWindow_SDL2> emu_window;
+    switch (Settings::values.renderer_backend) {
+    case Settings::RendererBackend::OpenGL:
+        emu_window = std::make_unique<EmuWindow_SDL2_GL>(system, false);
+        break;
+    case Settings::RendererBackend::Vulkan:
+#ifdef HAS_VULKAN
+        emu_window = std::make_unique<EmuWindow_SDL2_VK>(system, false);
+        break;
+#else
+        LOG_CRITICAL(Frontend, "Vulkan backend has not been compiled!");
+        return 1;
+#endif
+    case Settings::RendererBackend::Null:
+        emu_window = std::make_unique<EmuWindow_SDL2_Null>(system, false);
+        break;
+    }
+
+    system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
+    system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
+    system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
+
+    if (system.LoadEmptyProcess(*emu_window) != Core::System::ResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to initialize the emulated system!");
+        return -1;
+    }
+    if (!guest_memory.Map(*system.CurrentProcess())) {
+        system.Shutdown();
+        return -1;
+    }
+
+    // Makes the GPU contexts current to this thread
+    system.GPU().Start();
+    auto& gpu = system.GPU();
+
+    Tegra::GPUCaptureReader reader{capture_path};
+    Tegra::GPUCaptureRecord record;
+    std::vector<double> frame_times;
+    Clock::duration frame_time{};
+    std::size_t frame_submissions{};
+    bool warned_submissions{};
+    while (emu_window->IsOpen() && reader.ReadRecord(record)) {
+        switch (record.type) {
+        case Tegra::GPUCaptureRecordType::Map:
+            gpu.MemoryManager().MapBufferEx(record.cpu_addr, record.gpu_addr, record.size);
+            break;
+        case Tegra::GPUCaptureRecordType::Unmap:
+            gpu.MemoryManager().UnmapBuffer(record.gpu_addr, record.size);
+            break;
+        case Tegra::GPUCaptureRecordType::Memory:
+            system.Memory().WriteBlock(record.cpu_addr, record.data.data(), record.data.size());
+            break;
+        case Tegra::GPUCaptureRecordType::CommandList: {
+            Tegra::CommandList entries(record.data.size() / sizeof(Tegra::CommandListHeader));
+            std::memcpy(entries.data(), record.data.data(),
+                        entries.size() * sizeof(Tegra::CommandListHeader));
+            if (++frame_submissions == 2 && !warned_submissions) {
+                // Captures only record mapped memory at the start of each frame, anything the
+                // game wrote to it between the submissions of a frame is not in the capture
+                LOG_WARNING(HW_GPU,
+                            "Frame {} has more than one submission, draws after the first may "
+                            "read buffer contents from the start of the frame",
+                            frame_times.size());
+                warned_submissions = true;
+            }
+            const auto start{Clock::now()};
+            gpu.PushGPUEntries(std::move(entries));
+            frame_time += Clock::now() - start;
+            break;
+        }
+        case Tegra::GPUCaptureRecordType::SwapBuffers: {
+            Tegra::FramebufferConfig framebuffer{};
+            const bool has_framebuffer{record.data.size() == sizeof(framebuffer)};
+            if (has_framebuffer) {
+                std::memcpy(&framebuffer, record.data.data(), sizeof(framebuffer));
+            }
+            const auto start{Clock::now()};
+            gpu.SwapBuffers(has_framebuffer ? &framebuffer : nullptr);
+            frame_time += Clock::now() - start;
+
+            frame_times.push_back(std::chrono::duration<double, std::milli>(frame_time).count());
+            frame_time = {};
+            frame_submissions = 0;
+            emu_window->PollEvents();
+            break;
+        }
+        default:
+            LOG_ERROR(HW_GPU, "Unknown capture record type {}", static_cast<u32>(record.type));
+            break;
+        }
+    }
+
+    system.Shutdown();
+
+    if (frame_times.empty()) {
+        LOG_CRITICAL(HW_GPU, "The capture holds no complete frame");
+        return -1;
+    }
+
+    if (!output_path.empty()) {
+        FileUtil::IOFile file{output_path, "w"};
+        if (!file.IsOpen()) {
+            LOG_CRITICAL(HW_GPU, "Failed to write frame times to {}", output_path);
+            return -1;
+        }
+        file.WriteString("frame,ms\n");
+        for (std::size_t frame = 0; frame < frame_times.size(); ++frame) {
+            file.WriteString(fmt::format("{},{:.3f}\n", frame, frame_times[frame]));
+        }
+    }
+
+    std::vector<double> sorted{frame_times};
+    std::sort(sorted.begin(), sorted.end());
+    double total_ms{};
+    for (const double time : frame_times) {
+        total_ms += time;
+    }
+    std::cout << fmt::format("Replayed {} frames in {:.1f} ms of GPU thread time\n",
+                             frame_times.size(), total_ms);
+    std::cout << fmt::format("Frame time: mean {:.3f} ms, min {:.3f} ms, max {:.3f} ms\n",
+                             total_ms / frame_times.size(), sorted.front(), sorted.back());
+    std::cout << fmt::format("Percentiles: p50 {:.3f} ms, p99 {:.3f} ms\n",
+                             Percentile(sorted, 0.5), Percentile(sorted, 0.99));
+    return 0;
+}
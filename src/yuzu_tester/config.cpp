@@ -84,6 +84,8 @@ void Config::ReadValues() {
     // Data Storage
     Settings::values.use_virtual_sd =
         sdl2_config->GetBoolean("Data Storage", "use_virtual_sd", true);
+    Settings::values.use_extracted_content_cache =
+        sdl2_config->GetBoolean("Data Storage", "use_extracted_content_cache", false);
     FileUtil::GetUserPath(FileUtil::UserPath::NANDDir,
                           sdl2_config->Get("Data Storage", "nand_directory",
                                            FileUtil::GetUserPath(FileUtil::UserPath::NANDDir)));
@@ -126,6 +128,8 @@ void Config::ReadValues() {
     Settings::values.frame_limit = 100;
     Settings::values.use_disk_shader_cache =
         sdl2_config->GetBoolean("Renderer", "use_disk_shader_cache", false);
+    Settings::values.use_shader_optimizations =
+        sdl2_config->GetBoolean("Renderer", "use_shader_optimizations", false);
     Settings::values.use_accurate_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_accurate_gpu_emulation", false);
     Settings::values.use_asynchronous_gpu_emulation =
@@ -139,6 +143,7 @@ void Config::ReadValues() {
     // Audio
     Settings::values.sink_id = "null";
     Settings::values.enable_audio_stretching = false;
+    Settings::values.enable_low_latency_audio = false;
     Settings::values.audio_device_id = "auto";
     Settings::values.volume = 0;
 
@@ -153,6 +158,10 @@ void Config::ReadValues() {
     Settings::values.program_args = "";
     Settings::values.dump_exefs = sdl2_config->GetBoolean("Debugging", "dump_exefs", false);
     Settings::values.dump_nso = sdl2_config->GetBoolean("Debugging", "dump_nso", false);
+    Settings::values.dump_audio_renderer =
+        sdl2_config->GetBoolean("Debugging", "dump_audio_renderer", false);
+    Settings::values.dump_gpu_commands =
+        sdl2_config->GetBoolean("Debugging", "dump_gpu_commands", false);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
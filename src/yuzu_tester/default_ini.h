@@ -42,6 +42,10 @@ use_vsync =
 # 0 (default): Off, 1 : On
 use_disk_shader_cache =
 
+# Whether to optimize the shader IR before generating host shaders
+# 0 (default): Off, 1 : On
+use_shader_optimizations =
+
 # Whether to use accurate GPU emulation
 # 0 (default): Off (fast), 1 : On (slow)
 use_accurate_gpu_emulation =
@@ -86,6 +90,10 @@ swap_screen =
 # 1 (default): Yes, 0: No
 use_virtual_sd =
 
+# Whether to keep decrypted and patched copies of game RomFS images in the cache directory.
+# 1: Yes, 0 (default): No
+use_extracted_content_cache =
+
 [System]
 # Whether the system is docked
 # 1: Yes, 0 (default): No
@@ -132,6 +140,10 @@ program_args=
 dump_exefs=false
 # Determines whether or not yuzu will dump all NSOs it attempts to load while loading them
 dump_nso=false
+# Determines whether or not yuzu will record audio renderer updates for replay by yuzu-audio-harness
+dump_audio_renderer=false
+# Determines whether or not yuzu will record GPU command lists for replay by yuzu-gpu-replay
+dump_gpu_commands=false
 
 [WebService]
 # Whether or not to enable telemetry